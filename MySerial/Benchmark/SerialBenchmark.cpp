@@ -0,0 +1,671 @@
+// ==========================================================
+// SerialBenchmark: per-frame CPU microbenchmarks for SerialCommunicator
+// ==========================================================
+// The kernels come from the shared protocol engine (../SerialProtocol.h/.cpp), the
+// same sources the communicator and the SerialLink library are built from
+// (DataFrame/AckFrame codec, checksum, payload pattern, WindowManager, SafeQueue).
+//
+// Output follows the Google Benchmark console layout; --json-out writes one NDJSON
+// record per benchmark so two builds (or two kernels) can be compared side by side.
+
+#include "../SerialProtocol.h"
+
+#include <cstdio>
+#include <functional>
+
+using namespace serialcomm;
+
+namespace {
+
+// ----------------------------------------------------------
+// Minimal benchmark harness
+// ----------------------------------------------------------
+
+// Keeps the compiler from discarding a computed value.
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(_MSC_VER)
+    static volatile char sink;
+    sink = *reinterpret_cast<const volatile char*>(&value);
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+// Per-run state. The benchmark body loops while keepRunning() returns true;
+// the harness grows the iteration count until a run lasts at least --min-time.
+class State {
+public:
+    State(long long arg, long long iterations)
+        : arg_(arg), maxIterations_(iterations), iterations_(0),
+          bytesProcessed_(0), itemsProcessed_(0), started_(false), elapsedNs_(0) {}
+
+    bool keepRunning() {
+        if (!started_) {
+            started_ = true;
+            start_ = std::chrono::steady_clock::now();
+        }
+        if (iterations_ < maxIterations_) {
+            iterations_++;
+            return true;
+        }
+        elapsedNs_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_).count();
+        return false;
+    }
+
+    long long arg() const { return arg_; }
+    long long iterations() const { return iterations_; }
+    long long elapsedNs() const { return elapsedNs_; }
+
+    void setBytesProcessed(long long bytes) { bytesProcessed_ = bytes; }
+    void setItemsProcessed(long long items) { itemsProcessed_ = items; }
+    long long bytesProcessed() const { return bytesProcessed_; }
+    long long itemsProcessed() const { return itemsProcessed_; }
+
+private:
+    long long arg_;
+    long long maxIterations_;
+    long long iterations_;
+    long long bytesProcessed_;
+    long long itemsProcessed_;
+    bool started_;
+    std::chrono::steady_clock::time_point start_;
+    long long elapsedNs_;
+};
+
+struct Benchmark {
+    std::string name;
+    std::function<void(State&)> body;
+    std::vector<long long> args;  // empty: run once without an argument
+};
+
+std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+void registerBenchmark(const std::string& name, std::function<void(State&)> body,
+                       const std::vector<long long>& args = std::vector<long long>()) {
+    Benchmark b;
+    b.name = name;
+    b.body = body;
+    b.args = args;
+    registry().push_back(b);
+}
+
+// Frame payload sizes: 16 B to 1 MB
+std::vector<long long> frameSizes() {
+    std::vector<long long> sizes;
+    for (long long size = 16; size <= 1024 * 1024; size *= 4) {
+        sizes.push_back(size);
+    }
+    return sizes;
+}
+
+std::string formatRate(double perSecond, const char* unit) {
+    const char* prefixes[] = {"", "k", "M", "G", "T"};
+    int index = 0;
+    while (perSecond >= 1000.0 && index < 4) {
+        perSecond /= 1000.0;
+        index++;
+    }
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.2f %s%s/s", perSecond, prefixes[index], unit);
+    return buffer;
+}
+
+struct RunResult {
+    std::string name;
+    long long iterations;
+    double nsPerIteration;
+    double bytesPerSecond;
+    double itemsPerSecond;
+};
+
+RunResult runBenchmark(const Benchmark& b, const std::string& name, long long arg, double minSeconds) {
+    long long iterations = 1;
+    for (;;) {
+        State state(arg, iterations);
+        b.body(state);
+
+        double seconds = state.elapsedNs() / 1e9;
+        if (seconds >= minSeconds || iterations >= 1000000000LL) {
+            RunResult r;
+            r.name = name;
+            r.iterations = state.iterations();
+            r.nsPerIteration = static_cast<double>(state.elapsedNs()) / state.iterations();
+            r.bytesPerSecond = seconds > 0 ? state.bytesProcessed() / seconds : 0.0;
+            r.itemsPerSecond = seconds > 0 ? state.itemsProcessed() / seconds : 0.0;
+            return r;
+        }
+
+        // Same growth rule as Google Benchmark: aim for minSeconds with 40% headroom, at most 10x per step
+        double multiplier = seconds > 0 ? minSeconds * 1.4 / seconds : 10.0;
+        if (multiplier > 10.0) multiplier = 10.0;
+        if (multiplier < 2.0) multiplier = 2.0;
+        iterations = static_cast<long long>(iterations * multiplier);
+    }
+}
+
+// ----------------------------------------------------------
+// Frame codec and checksum
+// ----------------------------------------------------------
+
+DataFrame makeFrame(long long payloadSize) {
+    DataFrame frame;
+    frame.frameNum = 12345;
+    frame.windowSize = WINDOW_SIZE_INIT;
+    frame.payload.resize(static_cast<size_t>(payloadSize));
+    fillPayload(frame.payload, PATTERN_ASCENDING);
+    frame.checksum = frame.calculateChecksum();
+    return frame;
+}
+
+void BM_DataFrameSerialize(State& state) {
+    DataFrame frame = makeFrame(state.arg());
+    std::vector<char> buffer;
+    while (state.keepRunning()) {
+        frame.serialize(buffer);
+        doNotOptimize(buffer.data());
+    }
+    state.setBytesProcessed(state.iterations() * (state.arg() + FRAME_OVERHEAD_V3));
+}
+
+void BM_DataFrameDeserialize(State& state) {
+    std::vector<char> buffer;
+    makeFrame(state.arg()).serialize(buffer);
+    DataFrame frame;
+    while (state.keepRunning()) {
+        bool ok = frame.deserialize(buffer.data(), static_cast<int>(buffer.size()));
+        doNotOptimize(ok);
+    }
+    state.setBytesProcessed(state.iterations() * static_cast<long long>(buffer.size()));
+}
+
+void BM_DataFrameChecksum(State& state) {
+    DataFrame frame = makeFrame(state.arg());
+    while (state.keepRunning()) {
+        uint16_t sum = frame.calculateChecksum();
+        doNotOptimize(sum);
+    }
+    state.setBytesProcessed(state.iterations() * state.arg());
+}
+
+// Receive path for one frame: deserialize + checksum + payload validation
+void BM_DataFrameReceivePath(State& state) {
+    std::vector<char> buffer;
+    makeFrame(state.arg()).serialize(buffer);
+    DataFrame frame;
+    while (state.keepRunning()) {
+        bool ok = frame.deserialize(buffer.data(), static_cast<int>(buffer.size())) &&
+                  frame.verifyChecksum() &&
+                  validatePayload(frame.payload, PATTERN_ASCENDING);
+        doNotOptimize(ok);
+    }
+    state.setBytesProcessed(state.iterations() * static_cast<long long>(buffer.size()));
+}
+
+// ----------------------------------------------------------
+// Payload pattern generation and validation
+// ----------------------------------------------------------
+
+void BM_PayloadFill(State& state) {
+    std::vector<char> payload(static_cast<size_t>(state.arg()));
+    while (state.keepRunning()) {
+        fillPayload(payload, PATTERN_DESCENDING);
+        doNotOptimize(payload.data());
+    }
+    state.setBytesProcessed(state.iterations() * state.arg());
+}
+
+void BM_PayloadValidate(State& state) {
+    std::vector<char> payload(static_cast<size_t>(state.arg()));
+    fillPayload(payload, PATTERN_DESCENDING);
+    while (state.keepRunning()) {
+        bool ok = validatePayload(payload, PATTERN_DESCENDING);
+        doNotOptimize(ok);
+    }
+    state.setBytesProcessed(state.iterations() * state.arg());
+}
+
+// ----------------------------------------------------------
+// LZ4 block codec (--compress)
+// ----------------------------------------------------------
+
+// Ramp payloads are highly repetitive; telemetry text is the realistic case
+void BM_Lz4CompressRamp(State& state) {
+    std::vector<char> payload(static_cast<size_t>(state.arg()));
+    fillPayload(payload, PATTERN_ASCENDING);
+    std::vector<char> out(payload.size());
+    while (state.keepRunning()) {
+        int n = lz4Compress(payload.data(), static_cast<int>(payload.size()), out.data(), static_cast<int>(out.size()));
+        doNotOptimize(n);
+    }
+    state.setBytesProcessed(state.iterations() * state.arg());
+}
+
+void BM_Lz4CompressTelemetry(State& state) {
+    std::vector<char> payload(static_cast<size_t>(state.arg()));
+    fillPayload(payload, PATTERN_TELEMETRY_UP);
+    std::vector<char> out(payload.size());
+    while (state.keepRunning()) {
+        int n = lz4Compress(payload.data(), static_cast<int>(payload.size()), out.data(), static_cast<int>(out.size()));
+        doNotOptimize(n);
+    }
+    state.setBytesProcessed(state.iterations() * state.arg());
+}
+
+void BM_Lz4DecompressTelemetry(State& state) {
+    std::vector<char> payload(static_cast<size_t>(state.arg()));
+    fillPayload(payload, PATTERN_TELEMETRY_UP);
+    std::vector<char> compressed(payload.size());
+    int n = lz4Compress(payload.data(), static_cast<int>(payload.size()), compressed.data(), static_cast<int>(compressed.size()));
+    if (n == 0) {
+        // Too small to compress: such frames go out uncompressed
+        while (state.keepRunning()) doNotOptimize(n);
+        return;
+    }
+    while (state.keepRunning()) {
+        int m = lz4Decompress(compressed.data(), n, payload.data(), static_cast<int>(payload.size()));
+        doNotOptimize(m);
+    }
+    state.setBytesProcessed(state.iterations() * state.arg());
+}
+
+// ----------------------------------------------------------
+// Reed-Solomon FEC (--fec), 16 parity bytes per codeword
+// ----------------------------------------------------------
+
+const int BENCH_FEC_PARITY = 16;
+
+void BM_FecEncode(State& state) {
+    std::vector<char> payload(static_cast<size_t>(state.arg()));
+    fillPayload(payload, PATTERN_ASCENDING);
+    std::vector<char> wire;
+    wire.reserve(fecEncodedSize(static_cast<int>(payload.size()), BENCH_FEC_PARITY));
+    while (state.keepRunning()) {
+        wire.clear();
+        fecAppend(wire, payload.data(), static_cast<int>(payload.size()), BENCH_FEC_PARITY);
+        doNotOptimize(wire.data());
+    }
+    state.setBytesProcessed(state.iterations() * state.arg());
+}
+
+// Receive path on a clean link: every codeword is checked, none needs correction
+void BM_FecRepairClean(State& state) {
+    std::vector<char> payload(static_cast<size_t>(state.arg()));
+    fillPayload(payload, PATTERN_ASCENDING);
+    std::vector<char> encoded;
+    fecAppend(encoded, payload.data(), static_cast<int>(payload.size()), BENCH_FEC_PARITY);
+    std::vector<char> wire(encoded.size());
+    while (state.keepRunning()) {
+        memcpy(wire.data(), encoded.data(), encoded.size());
+        int corrected = fecRepair(wire.data(), wire.data(), static_cast<int>(payload.size()), BENCH_FEC_PARITY);
+        doNotOptimize(corrected);
+    }
+    state.setBytesProcessed(state.iterations() * state.arg());
+}
+
+// Receive path with one corrupted byte in every codeword (worst case for a BER of ~1e-5 is far lighter)
+void BM_FecRepairOneErrorPerCodeword(State& state) {
+    std::vector<char> payload(static_cast<size_t>(state.arg()));
+    fillPayload(payload, PATTERN_ASCENDING);
+    std::vector<char> encoded;
+    fecAppend(encoded, payload.data(), static_cast<int>(payload.size()), BENCH_FEC_PARITY);
+    for (size_t i = 7; i < encoded.size(); i += RS_CODEWORD_MAX) {
+        encoded[i] ^= 0x5A;
+    }
+    std::vector<char> wire(encoded.size());
+    while (state.keepRunning()) {
+        memcpy(wire.data(), encoded.data(), encoded.size());
+        int corrected = fecRepair(wire.data(), wire.data(), static_cast<int>(payload.size()), BENCH_FEC_PARITY);
+        doNotOptimize(corrected);
+    }
+    state.setBytesProcessed(state.iterations() * state.arg());
+}
+
+// ----------------------------------------------------------
+// Fountain code (broadcast/listen), 64 source frames
+// ----------------------------------------------------------
+
+const int BENCH_FOUNTAIN_SOURCES = 64;
+
+std::vector<char> benchFountainSources(int datasize) {
+    std::vector<char> sources(static_cast<size_t>(datasize) * BENCH_FOUNTAIN_SOURCES);
+    for (int i = 0; i < BENCH_FOUNTAIN_SOURCES; ++i) {
+        fillSourcePayload(sources.data() + static_cast<size_t>(i) * datasize, datasize, PATTERN_ASCENDING, i);
+    }
+    return sources;
+}
+
+// One repair frame payload: neighbor selection plus XOR of 2 x sqrt(64) = 16 source frames
+void BM_FountainRepairFrame(State& state) {
+    const int datasize = static_cast<int>(state.arg());
+    std::vector<char> sources = benchFountainSources(datasize);
+    FountainCode code(BENCH_FOUNTAIN_SOURCES);
+    std::vector<int> neighbors;
+    std::vector<char> payload(datasize);
+    uint32_t symbolId = BENCH_FOUNTAIN_SOURCES;
+    while (state.keepRunning()) {
+        code.neighbors(symbolId++, neighbors);
+        std::fill(payload.begin(), payload.end(), 0);
+        for (int s : neighbors) {
+            xorInto(payload.data(), sources.data() + static_cast<size_t>(s) * datasize, datasize);
+        }
+        doNotOptimize(payload.data());
+    }
+    state.setBytesProcessed(state.iterations() * state.arg());
+}
+
+// Full decode of 64 source frames with every 10th source frame lost, fed repair frames until complete
+void BM_FountainDecode10PercentLoss(State& state) {
+    const int datasize = static_cast<int>(state.arg());
+    std::vector<char> sources = benchFountainSources(datasize);
+    FountainCode code(BENCH_FOUNTAIN_SOURCES);
+    std::vector<std::vector<char> > repairs;
+    std::vector<int> neighbors;
+    for (uint32_t id = BENCH_FOUNTAIN_SOURCES; id < 2 * BENCH_FOUNTAIN_SOURCES; ++id) {
+        code.neighbors(id, neighbors);
+        std::vector<char> payload(datasize, 0);
+        for (int s : neighbors) {
+            xorInto(payload.data(), sources.data() + static_cast<size_t>(s) * datasize, datasize);
+        }
+        repairs.push_back(payload);
+    }
+    while (state.keepRunning()) {
+        FountainDecoder decoder(BENCH_FOUNTAIN_SOURCES, datasize);
+        for (int i = 0; i < BENCH_FOUNTAIN_SOURCES; ++i) {
+            if (i % 10 != 0) decoder.addSymbol(i, sources.data() + static_cast<size_t>(i) * datasize);
+        }
+        for (size_t r = 0; r < repairs.size() && !decoder.complete(); ++r) {
+            decoder.addSymbol(static_cast<uint32_t>(BENCH_FOUNTAIN_SOURCES + r), repairs[r].data());
+        }
+        doNotOptimize(decoder.complete());
+    }
+    state.setBytesProcessed(state.iterations() * state.arg() * BENCH_FOUNTAIN_SOURCES);
+}
+
+// ----------------------------------------------------------
+// ACK frame
+// ----------------------------------------------------------
+
+void BM_AckFrameSerialize(State& state) {
+    AckFrame ack;
+    ack.baseFrameNum = 4096;
+    ack.bitmap = 0xA5A5A5A5u;
+    std::vector<char> buffer;
+    while (state.keepRunning()) {
+        ack.serialize(buffer);
+        doNotOptimize(buffer.data());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void BM_AckFrameDeserialize(State& state) {
+    AckFrame source;
+    source.baseFrameNum = 4096;
+    source.bitmap = 0xA5A5A5A5u;
+    std::vector<char> buffer;
+    source.serialize(buffer);
+    AckFrame ack;
+    while (state.keepRunning()) {
+        bool ok = ack.deserialize(buffer.data(), static_cast<int>(buffer.size()));
+        doNotOptimize(ok);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// 16 setAck (every other bit) + 32 isAcked over one bitmap; items = isAcked lookups
+void BM_AckFrameBitmap(State& state) {
+    while (state.keepRunning()) {
+        AckFrame ack;
+        ack.baseFrameNum = 4096;
+        for (int i = 0; i < 32; i += 2) {
+            ack.setAck(4096 + i);
+        }
+        int acked = 0;
+        for (int i = 0; i < 32; ++i) {
+            acked += ack.isAcked(4096 + i) ? 1 : 0;
+        }
+        doNotOptimize(acked);
+    }
+    state.setItemsProcessed(state.iterations() * 32);
+}
+
+void BM_SackFrameSerialize(State& state) {
+    SackAck sack;
+    sack.cumulativeAck = 4096;
+    sack.bitmapBase = 4096;
+    for (int i = 0; i < SackAck::WORDS; ++i) {
+        sack.bitmap[i] = 0xA5A5A5A5A5A5A5A5ull;
+    }
+    std::vector<char> buffer;
+    while (state.keepRunning()) {
+        sack.serialize(buffer);
+        doNotOptimize(buffer.data());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void BM_SackFrameDeserialize(State& state) {
+    SackAck source;
+    source.cumulativeAck = 4096;
+    source.bitmapBase = 4096;
+    for (int i = 0; i < SackAck::WORDS; ++i) {
+        source.bitmap[i] = 0xA5A5A5A5A5A5A5A5ull;
+    }
+    std::vector<char> buffer;
+    source.serialize(buffer);
+    SackAck sack;
+    while (state.keepRunning()) {
+        bool ok = sack.deserialize(buffer.data(), static_cast<int>(buffer.size()));
+        doNotOptimize(ok);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// ----------------------------------------------------------
+// WindowManager (arg = total frames per iteration)
+// ----------------------------------------------------------
+
+// Sender and ACK handling on one thread: getFramesToSend -> markAcked -> adjustWindow -> slideWindow
+void BM_WindowManager1Thread(State& state) {
+    const int totalFrames = static_cast<int>(state.arg());
+    while (state.keepRunning()) {
+        WindowManager window(totalFrames);
+        while (!window.isComplete()) {
+            std::vector<long long> frames = window.getFramesToSend();
+            for (size_t i = 0; i < frames.size(); ++i) {
+                window.markAcked(frames[i]);
+            }
+            window.adjustWindow(true, 100);
+            window.slideWindow();
+        }
+    }
+    state.setItemsProcessed(state.iterations() * totalFrames);
+}
+
+// Same thread split as TransmissionManager: a sender thread polls the window
+// while the ACK thread marks, adjusts and slides it, contending on windowMutex.
+void BM_WindowManager2Threads(State& state) {
+    const int totalFrames = static_cast<int>(state.arg());
+    while (state.keepRunning()) {
+        WindowManager window(totalFrames);
+        std::thread ackThread([&window]() {
+            while (!window.isComplete()) {
+                long long base = window.getBase();
+                int size = window.getWindowSize();
+                for (long long frameNum = base; frameNum < base + size; ++frameNum) {
+                    if (window.isInWindow(frameNum) && !window.isAcked(frameNum)) {
+                        window.markAcked(frameNum);
+                    }
+                }
+                window.adjustWindow(true, 100);
+                window.slideWindow();
+            }
+        });
+        long long polled = 0;
+        while (!window.isComplete()) {
+            polled += window.getFramesToSend().size();
+        }
+        ackThread.join();
+        doNotOptimize(polled);
+    }
+    state.setItemsProcessed(state.iterations() * totalFrames);
+}
+
+// ----------------------------------------------------------
+// FrameSizeController (--adaptive-size)
+// ----------------------------------------------------------
+
+// One recordOutcome per acknowledged or retransmitted frame, every 50th frame lost (a decision every 32 outcomes)
+void BM_FrameSizeControllerOutcome(State& state) {
+    FrameSizeController sizer(4096, ADAPTIVE_FRAME_MIN, ADAPTIVE_FRAME_MAX, FRAME_OVERHEAD_Z);
+    long long frame = 0;
+    while (state.keepRunning()) {
+        sizer.recordOutcome(sizer.current(), ++frame % 50 == 0);
+        doNotOptimize(sizer.current());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// ----------------------------------------------------------
+// SafeQueue (arg = element size in bytes)
+// ----------------------------------------------------------
+
+void BM_SafeQueue1Thread(State& state) {
+    SafeQueue<std::vector<char> > queue;
+    std::vector<char> item(static_cast<size_t>(state.arg()), 0x5A);
+    std::vector<char> out;
+    while (state.keepRunning()) {
+        queue.push(item);
+        queue.pop(out, 0);
+        doNotOptimize(out.data());
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setBytesProcessed(state.iterations() * state.arg());
+}
+
+// Producer/consumer handoff of 256 elements per iteration
+void BM_SafeQueue2Threads(State& state) {
+    const int batch = 256;
+    std::vector<char> item(static_cast<size_t>(state.arg()), 0x5A);
+    while (state.keepRunning()) {
+        SafeQueue<std::vector<char> > queue;
+        std::thread consumer([&queue, batch]() {
+            std::vector<char> out;
+            for (int i = 0; i < batch; ++i) {
+                queue.pop(out);
+            }
+        });
+        for (int i = 0; i < batch; ++i) {
+            queue.push(item);
+        }
+        consumer.join();
+    }
+    state.setItemsProcessed(state.iterations() * batch);
+    state.setBytesProcessed(state.iterations() * batch * state.arg());
+}
+
+void registerAll() {
+    const std::vector<long long> sizes = frameSizes();
+    registerBenchmark("BM_DataFrameSerialize", BM_DataFrameSerialize, sizes);
+    registerBenchmark("BM_DataFrameDeserialize", BM_DataFrameDeserialize, sizes);
+    registerBenchmark("BM_DataFrameChecksum", BM_DataFrameChecksum, sizes);
+    registerBenchmark("BM_DataFrameReceivePath", BM_DataFrameReceivePath, sizes);
+    registerBenchmark("BM_PayloadFill", BM_PayloadFill, sizes);
+    registerBenchmark("BM_PayloadValidate", BM_PayloadValidate, sizes);
+    registerBenchmark("BM_Lz4CompressRamp", BM_Lz4CompressRamp, sizes);
+    registerBenchmark("BM_Lz4CompressTelemetry", BM_Lz4CompressTelemetry, sizes);
+    registerBenchmark("BM_Lz4DecompressTelemetry", BM_Lz4DecompressTelemetry, sizes);
+    registerBenchmark("BM_FecEncode", BM_FecEncode, sizes);
+    registerBenchmark("BM_FecRepairClean", BM_FecRepairClean, sizes);
+    registerBenchmark("BM_FecRepairOneErrorPerCodeword", BM_FecRepairOneErrorPerCodeword, sizes);
+    registerBenchmark("BM_FountainRepairFrame", BM_FountainRepairFrame, sizes);
+    registerBenchmark("BM_FountainDecode10PercentLoss", BM_FountainDecode10PercentLoss, sizes);
+    registerBenchmark("BM_AckFrameSerialize", BM_AckFrameSerialize);
+    registerBenchmark("BM_AckFrameDeserialize", BM_AckFrameDeserialize);
+    registerBenchmark("BM_AckFrameBitmap", BM_AckFrameBitmap);
+    registerBenchmark("BM_SackFrameSerialize", BM_SackFrameSerialize);
+    registerBenchmark("BM_SackFrameDeserialize", BM_SackFrameDeserialize);
+    registerBenchmark("BM_WindowManager1Thread", BM_WindowManager1Thread, std::vector<long long>{256, 4096});
+    registerBenchmark("BM_WindowManager2Threads", BM_WindowManager2Threads, std::vector<long long>{256, 4096});
+    registerBenchmark("BM_FrameSizeControllerOutcome", BM_FrameSizeControllerOutcome);
+    registerBenchmark("BM_SafeQueue1Thread", BM_SafeQueue1Thread, sizes);
+    registerBenchmark("BM_SafeQueue2Threads", BM_SafeQueue2Threads, sizes);
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [--filter <substring>] [--min-time <seconds>] [--json-out <path>]" << std::endl;
+    std::cout << "  --filter <substring>   Run only benchmarks whose name contains <substring>" << std::endl;
+    std::cout << "  --min-time <seconds>   Minimum measuring time per benchmark (default 0.5)" << std::endl;
+    std::cout << "  --json-out <path>      Write one NDJSON record per benchmark" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    std::string jsonPath;
+    double minSeconds = 0.5;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (option == "--min-time" && i + 1 < argc) {
+            minSeconds = atof(argv[++i]);
+        } else if (option == "--json-out" && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::ofstream json;
+    if (!jsonPath.empty()) {
+        json.open(jsonPath.c_str(), std::ios::out | std::ios::trunc);
+        if (!json.is_open()) {
+            std::cerr << "Error: Unable to open " << jsonPath << std::endl;
+            return 1;
+        }
+    }
+
+    registerAll();
+
+    printf("%-40s %15s %12s %20s %20s\n", "Benchmark", "Time (ns)", "Iterations", "Bytes", "Items");
+    printf("%s\n", std::string(111, '-').c_str());
+
+    for (size_t i = 0; i < registry().size(); ++i) {
+        const Benchmark& b = registry()[i];
+        std::vector<long long> args = b.args;
+        bool hasArg = !args.empty();
+        if (!hasArg) args.push_back(0);
+
+        for (size_t a = 0; a < args.size(); ++a) {
+            std::string name = hasArg ? b.name + "/" + std::to_string(args[a]) : b.name;
+            if (!filter.empty() && name.find(filter) == std::string::npos) continue;
+
+            RunResult r = runBenchmark(b, name, args[a], minSeconds);
+            printf("%-40s %15.1f %12lld %20s %20s\n", r.name.c_str(), r.nsPerIteration, r.iterations,
+                   r.bytesPerSecond > 0 ? formatRate(r.bytesPerSecond, "B").c_str() : "",
+                   r.itemsPerSecond > 0 ? formatRate(r.itemsPerSecond, "item").c_str() : "");
+            fflush(stdout);
+
+            if (json.is_open()) {
+                JsonRecord record;
+                record.add("type", "benchmark")
+                      .add("name", r.name)
+                      .add("arg", args[a])
+                      .add("iterations", r.iterations)
+                      .add("nsPerIteration", r.nsPerIteration)
+                      .add("bytesPerSecond", r.bytesPerSecond)
+                      .add("itemsPerSecond", r.itemsPerSecond);
+                json << record.str() << std::endl;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,40 @@
+@echo off
+setlocal enabledelayedexpansion
+
+REM ========================================
+REM SerialBenchmark Compile Script
+REM ========================================
+
+REM Commands inside the if blocks use "|| goto :error": %ERRORLEVEL% there is expanded
+REM when the block is parsed, so it would still hold the result of "where".
+
+echo Compiling SerialBenchmark.cpp...
+
+where cmake >nul 2>nul
+if %ERRORLEVEL% EQU 0 (
+    cmake -S . -B build || goto :error
+    cmake --build build --config Release || goto :error
+    echo.
+    echo Build successful: build\Release\SerialBenchmark.exe
+    goto :end
+)
+
+where g++ >nul 2>nul
+if %ERRORLEVEL% EQU 0 (
+    echo CMake not found. Using MinGW g++ compiler...
+    g++ -std=c++11 SerialBenchmark.cpp ..\SerialProtocol.cpp -o SerialBenchmark.exe -static-libgcc -static-libstdc++ -O2 -lws2_32 || goto :error
+    echo.
+    echo Build successful: SerialBenchmark.exe
+    goto :end
+)
+
+echo ERROR: Neither CMake nor g++ found in PATH.
+goto :error
+
+:error
+pause
+exit /b 1
+
+:end
+pause
+exit /b 0
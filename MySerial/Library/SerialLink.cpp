@@ -0,0 +1,881 @@
+// ==========================================================
+// SerialLink: message-oriented library over the SerialCommunicator engine
+// ==========================================================
+// The frame codec, ChannelSender ARQ and ReceiveWindow ACK generation come from
+// the shared protocol engine (SerialProtocol.h/.cpp), so a link speaks the same
+// protocol as the benchmark sessions.
+//
+// Wire format (after the SYN / SYN-ACK handshake and a capabilities exchange):
+//   - every data frame uses the length-prefixed frame format on channel 0 and
+//     carries one fragment: [MessageLength(4)][Offset(4)][Data]
+//   - the link requires the engine's frame CRC32 (capability "frame crc"), which
+//     covers the whole frame including FrameNum: a header bit error must not file a
+//     valid payload under another sequence number (the real frame would then be
+//     discarded as a duplicate)
+//   - Offset is a multiple of the fragment size (negotiated frame payload - 8),
+//     and fragments of one message occupy consecutive sequence numbers, so the
+//     receiver finds a message's first sequence number from any of its fragments
+//   - Flags and WindowSize are always 0, which lets the reader reject a false
+//     SOF inside a payload before it reads a bogus body length worth of bytes
+//   - each direction has its own sequence space; ACKs use the negotiated format
+//     (SACK or 32-bit) with the engine's ACK CRC32, which the link requires from
+//     the peer, and travel interleaved with the peer's data frames
+//
+// The engine lives in namespace serialcomm, so its globals (log file, debug flags, live
+// counters) are not exported from the library. Each link sets its own LogSink on the threads that
+// run it, so console logging and the last error are per link rather than process-wide.
+
+#include "../SerialProtocol.h"
+
+#define SERIAL_LINK_BUILD
+#include "SerialLink.h"
+
+namespace seriallink {
+
+using namespace serialcomm;
+
+namespace {
+
+const int FRAGMENT_HEADER_SIZE = 4 + 4;      // [MessageLength(4)][Offset(4)]
+const int READER_POLL_MS = 100;              // reader/sender threads re-check the stop flag at least this often
+const size_t POOL_BUFFERS_MAX = 16;          // free buffers kept for reuse
+
+thread_local std::string openError;          // why the last Link::open on this thread failed
+
+struct Fragment {
+    uint32_t messageLength;
+    uint32_t offset;
+    const char* data;
+    int length;
+};
+
+// Validates a fragment's fields against the negotiated fragment size (integrity is the frame CRC's job)
+bool parseFragment(const char* body, uint32_t storedLength, int fragmentData, Fragment& fragment) {
+    if (storedLength < static_cast<uint32_t>(FRAGMENT_HEADER_SIZE)) return false;
+    memcpy(&fragment.messageLength, body, sizeof(uint32_t));
+    memcpy(&fragment.offset, body + 4, sizeof(uint32_t));
+    fragment.data = body + FRAGMENT_HEADER_SIZE;
+    fragment.length = static_cast<int>(storedLength) - FRAGMENT_HEADER_SIZE;
+    if (fragment.offset % fragmentData != 0) return false;
+    if (fragment.messageLength == 0) return fragment.offset == 0 && fragment.length == 0;
+    if (fragment.offset >= fragment.messageLength) return false;
+    return static_cast<uint32_t>(fragment.length) ==
+           std::min(static_cast<uint32_t>(fragmentData), fragment.messageLength - fragment.offset);
+}
+
+// Number of fragments (and sequence numbers) a message occupies
+long long fragmentCount(size_t messageLength, int fragmentData) {
+    return messageLength == 0 ? 1 : static_cast<long long>((messageLength + fragmentData - 1) / fragmentData);
+}
+
+// Puts back everything after the first byte, starting at the next frame start candidate
+void realignStream(SerialPort& serial, const char* buffer, int length) {
+    int next = 1;
+    while (next < length && buffer[next] != SOF && buffer[next] != SOF_ACK && buffer[next] != SOF_SYNC) {
+        next++;
+    }
+    serial.unread(buffer + next, length - next);
+}
+
+}  // namespace
+
+// ----------------------------------------------------------
+// Reassembly buffer pool
+// ----------------------------------------------------------
+
+// Buffers keep their largest size across reuse, so a recycled buffer is never cleared or reallocated
+class MessagePool {
+public:
+    std::vector<char> acquire(size_t size) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (size_t i = 0; i < free_.size(); ++i) {
+                if (free_[i].size() >= size) {
+                    std::vector<char> buffer;
+                    buffer.swap(free_[i]);
+                    free_.erase(free_.begin() + i);
+                    return buffer;
+                }
+            }
+        }
+        return std::vector<char>(std::max<size_t>(size, 1));
+    }
+
+    void release(std::vector<char>& buffer) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_.size() < POOL_BUFFERS_MAX) {
+            free_.push_back(std::vector<char>());
+            free_.back().swap(buffer);
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::vector<char> > free_;
+};
+
+// ----------------------------------------------------------
+// Message
+// ----------------------------------------------------------
+
+Message::Message() : data_(nullptr), size_(0) {}
+
+Message::Message(Message&& other) : data_(nullptr), size_(0) {
+    *this = std::move(other);
+}
+
+Message& Message::operator=(Message&& other) {
+    if (this != &other) {
+        reset();
+        pool_.swap(other.pool_);
+        buffer_.swap(other.buffer_);
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+Message::~Message() {
+    reset();
+}
+
+void Message::reset() {
+    if (pool_) {
+        pool_->release(buffer_);
+        pool_.reset();
+    }
+    std::vector<char>().swap(buffer_);
+    data_ = nullptr;
+    size_ = 0;
+}
+
+// ----------------------------------------------------------
+// Link implementation
+// ----------------------------------------------------------
+
+struct Link::Impl {
+    // A message being reassembled, keyed by the sequence number of its first fragment
+    struct Assembly {
+        char* data;                // final buffer (caller's or pooled), nullptr for dropped messages
+        size_t length;
+        std::vector<char> pooled;  // owns data when it came from the pool
+        long long fragments;
+        long long received;
+        Assembly() : data(nullptr), length(0), fragments(0), received(0) {}
+    };
+
+    Options options;
+    LogSink log;           // console logging and last error of this link (set on every thread that runs it)
+    SerialPort serial;
+    Capabilities agreed;
+    bool sack;
+    int framePayload;
+    int fragmentData;
+    int ackSize;           // ACK frame, CRC32 included
+    std::chrono::milliseconds lineTimeout;  // resend timeout from line time alone (before RTT samples)
+    DWORD frameReadTimeoutMs;
+    uint32_t syncSeq;      // this end's SYN number (duplicate SYNs after the handshake are answered again)
+
+    // Send side: fragments of one message stay contiguous (sendMutex), the sender thread drains the ChannelSender
+    // The reader thread never writes: its ACKs wait in pendingControl and go out ahead of the next data frame,
+    // so a reader is never stuck behind a full transmit buffer while the peer waits for it to drain the other way
+    std::mutex sendMutex;
+    std::mutex stateMutex;
+    std::condition_variable stateChanged;
+    std::unique_ptr<ChannelSender> sender;
+    std::vector<char> pendingControl;
+    long long srttUs;      // smoothed RTT of frames acknowledged after one transmission (0 = no sample yet)
+    long long messagesSent;
+
+    // Receive side (reader thread only, except the delivery settings and the queue)
+    std::unique_ptr<ReceiveWindow> window;
+    std::map<long long, Assembly> assemblies;
+    long long nextDelivery;
+    std::shared_ptr<MessagePool> pool;
+    std::mutex receiveMutex;
+    std::condition_variable messageReady;
+    std::deque<Message> queue;
+    Handler handler;
+    Allocator allocator;
+
+    std::atomic<bool> stopping;
+    std::atomic<long long> messagesReceived;
+    std::atomic<long long> messagesDropped;
+    std::atomic<long long> framesReceived;
+    std::atomic<long long> duplicateFrames;
+    std::atomic<long long> badFrames;
+    std::thread senderThread;
+    std::thread readerThread;
+
+    explicit Impl(const Options& opts)
+        : options(opts), sack(false), framePayload(0), fragmentData(0), ackSize(0), lineTimeout(0),
+          frameReadTimeoutMs(0), syncSeq(0), srttUs(0), messagesSent(0), nextDelivery(0), pool(std::make_shared<MessagePool>()),
+          stopping(false), messagesReceived(0), messagesDropped(0), framesReceived(0), duplicateFrames(0), badFrames(0) {
+        log.console = options.logToConsole;
+    }
+
+    ~Impl() {
+        stop();
+    }
+
+    bool failed() const { return serial.isLinkFailed(); }
+
+    std::string error() const {
+        std::lock_guard<std::mutex> lock(logMutex);
+        return log.lastError;
+    }
+
+    // Capabilities this end offers: full duplex marks a message link (benchmark servers advertise half duplex),
+    // frames are plain length-prefixed frames (no compression, FEC, compact header or channels)
+    Capabilities offer() const {
+        Capabilities caps = localCapabilities();
+        caps.maxWindow = std::max(WINDOW_SIZE_MIN, std::min(options.window, WINDOW_SIZE_MAX));
+        caps.maxPayload = std::max(FRAGMENT_HEADER_SIZE + 1, std::min(options.framePayload, FRAME_PAYLOAD_MAX));
+        caps.fullDuplex = true;
+        caps.compression = 0;
+        caps.fecParity = 0;
+        caps.adaptiveMax = 0;
+        caps.streaming = false;
+        caps.credits = false;
+        caps.compactHeader = false;
+        caps.channels = 1;
+        caps.controlRate = 0;
+        return caps;
+    }
+
+    // SERIAL_LINK_ACCEPT: answers every SYN (the peer resends until one SYN-ACK arrives) until its capabilities follow
+    bool acceptPeer() {
+        if (!serial.purge()) {
+            logMessage("Warning: Failed to purge buffers before waiting for SYN.");
+        }
+        syncSeq = randomSyncSeq();
+        SyncFrame syn;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(options.openTimeoutMs);
+        do {
+            if (!readSyncFrame(serial, syn, deadline)) {
+                logMessage("Error: No SYN from peer within " + std::to_string(options.openTimeoutMs / 1000) + " seconds.");
+                return false;
+            }
+        } while (syn.flags != SYNC_FLAG_SYN);
+
+        while (true) {
+            if (syn.flags == SYNC_FLAG_SYN && !sendSyncFrame(serial, SYNC_FLAG_SYN | SYNC_FLAG_ACK, syncSeq, syn.seq + 1)) {
+                logMessage("Error: Failed to send SYN-ACK to peer.");
+                return false;
+            }
+            char next;
+            if (serial.read(&next, 1, SYNC_TIMEOUT_MS) != 1) {
+                logMessage("Error: Peer sent no capabilities within " + std::to_string(SYNC_TIMEOUT_MS / 1000) + " seconds after SYN-ACK.");
+                return false;
+            }
+            if (next == SOF_CTRL) {
+                serial.unread(&next, 1);
+                return true;
+            }
+            syn.flags = 0;
+            if (next == SOF_SYNC && !readSyncFrame(serial, syn, std::chrono::steady_clock::now() +
+                                                   std::chrono::milliseconds(SYNC_TIMEOUT_MS), true)) {
+                logMessage("Error: Incomplete SYN from peer.");
+                return false;
+            }
+        }
+    }
+
+    // Handshake and capabilities exchange (the connecting end offers first, the accepting end answers)
+    bool handshake() {
+        const Capabilities local = offer();
+        Capabilities remote;
+        if (options.role == SERIAL_LINK_ACCEPT) {
+            if (!acceptPeer() || !readCapabilities(serial, remote, "peer") || !sendCapabilities(serial, local)) {
+                return false;
+            }
+        } else {
+            const ConnectResult connected = connectToServer(serial);
+            if (connected == CONNECT_NO_REPLY) {
+                logMessage("Error: Peer did not answer SYN (not started, or not a SerialLink endpoint).");
+            }
+            if (connected != CONNECT_OK || !sendCapabilities(serial, local) || !readCapabilities(serial, remote, "peer")) {
+                return false;
+            }
+        }
+        if (!remote.fullDuplex) {
+            logMessage("Error: Peer is not a message link endpoint (half-duplex capabilities).");
+            return false;
+        }
+        agreed = negotiateCapabilities(local, remote);
+        if (!agreed.ackCrc || !agreed.frameCrc) {
+            logMessage("Error: Peer does not protect ACK and data frames with a CRC32 (older SerialLink or communicator build).");
+            return false;
+        }
+        logMessage("Message link negotiated: " + describeCapabilities(agreed));
+
+        sack = agreed.sackFormats != 0;
+        framePayload = agreed.maxPayload;
+        fragmentData = framePayload - FRAGMENT_HEADER_SIZE;
+        ackSize = sack ? SackAck::wireSize(false, true) : AckFrame::wireSize(false, true);
+
+        // Full duplex: an ACK may wait behind the peer's own window of data frames, so allow two windows each way
+        const int frameBytes = dataFrameWireSize(framePayload, true, 0, true) + ackSize;
+        const double windowLineMs = static_cast<double>(agreed.maxWindow) * frameBytes * 10.0 * 1000.0 /
+                                    std::max(serial.getBaudRate(), 1);
+        lineTimeout = std::chrono::milliseconds(
+            std::max(RESEND_TIMEOUT_MIN_MS, static_cast<int>(std::min(4.0 * windowLineMs, 3600000.0))));
+        frameReadTimeoutMs = static_cast<DWORD>(std::max(READER_POLL_MS,
+            static_cast<int>(2.0 * frameBytes * 10.0 * 1000.0 / std::max(serial.getBaudRate(), 1))));
+
+        sender.reset(new ChannelSender(0, 0, 0, true, agreed.maxWindow));
+        window.reset(new ReceiveWindow(sack, 0, false, 0, true));
+        return true;
+    }
+
+    void start() {
+        senderThread = std::thread(&Impl::senderLoop, this);
+        readerThread = std::thread(&Impl::readerLoop, this);
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            stopping = true;
+        }
+        stateChanged.notify_all();
+        messageReady.notify_all();
+        if (senderThread.joinable()) senderThread.join();
+        if (readerThread.joinable()) readerThread.join();
+    }
+
+    // ------------------------------------------------------
+    // Send side
+    // ------------------------------------------------------
+
+    bool send(const char* data, size_t size) {
+        ScopedLogSink logScope(&log);
+        if (size > 0xFFFFFFFFu) {  // MessageLength is 32 bits
+            logMessage("Error: Message of " + std::to_string(size) + " bytes exceeds the 4 GB message limit.");
+            return false;
+        }
+        std::lock_guard<std::mutex> sendLock(sendMutex);
+        const uint32_t messageLength = static_cast<uint32_t>(size);
+        uint32_t offset = 0;
+        do {
+            char header[FRAGMENT_HEADER_SIZE];
+            const int length = static_cast<int>(std::min<uint32_t>(fragmentData, messageLength - offset));
+            memcpy(header, &messageLength, sizeof(uint32_t));
+            memcpy(header + 4, &offset, sizeof(uint32_t));
+            {
+                std::unique_lock<std::mutex> lock(stateMutex);
+                stateChanged.wait(lock, [this]() { return sender->queueSpace() > 0 || stopping || failed(); });
+                if (stopping || failed()) {
+                    logMessage(stopping ? "Error: Link closed while sending." : "Error: Link failed while sending.");
+                    return false;
+                }
+                sender->enqueue(header, FRAGMENT_HEADER_SIZE, data + offset, length, std::chrono::steady_clock::now());
+            }
+            stateChanged.notify_all();
+            offset += static_cast<uint32_t>(length);
+        } while (offset < messageLength);
+        std::lock_guard<std::mutex> lock(stateMutex);
+        messagesSent++;
+        return true;
+    }
+
+    bool flush(int timeoutMs) {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        return stateChanged.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]() {
+            return sender->unackedMessages() == 0 || stopping || failed();
+        }) && sender->unackedMessages() == 0;
+    }
+
+    // Resend timeout: the line-time bound, capped at 4x the smoothed RTT once there are samples
+    // (same rule as TransmissionManager; called with stateMutex held)
+    std::chrono::milliseconds resendTimeout() const {
+        if (srttUs == 0) return lineTimeout;
+        return std::min(lineTimeout, std::chrono::milliseconds(std::max<long long>(RESEND_TIMEOUT_MIN_MS, 4 * srttUs / 1000)));
+    }
+
+    // Called with stateMutex held
+    void markAcked(long long seq, std::chrono::steady_clock::time_point now) {
+        long long rttUs = sender->markAcked(seq, now);
+        if (rttUs >= 0) {
+            srttUs = (srttUs == 0) ? rttUs : srttUs + (rttUs - srttUs) / 8;
+        }
+    }
+
+    // Writes pending ACKs first, then frames chosen by the ChannelSender (overdue retransmissions first),
+    // sleeping until the next resend time or a change (new fragment, ACK to send or received) when idle
+    void senderLoop() {
+        ScopedLogSink logScope(&log);
+        std::vector<char> control;
+        std::vector<char> frame;
+        while (!stopping && !failed()) {
+            bool haveFrame = false;
+            {
+                std::unique_lock<std::mutex> lock(stateMutex);
+                auto now = std::chrono::steady_clock::now();
+                control.swap(pendingControl);
+                pendingControl.clear();
+                if (control.empty()) {
+                    const std::chrono::milliseconds timeout = resendTimeout();
+                    haveFrame = sender->takeFrame(now, timeout, frame);
+                    if (!haveFrame) {
+                        auto wake = std::min(sender->nextResend(timeout), now + std::chrono::milliseconds(READER_POLL_MS));
+                        stateChanged.wait_until(lock, wake);
+                        continue;
+                    }
+                }
+            }
+            if (!control.empty()) {
+                serial.write(control.data(), static_cast<int>(control.size()));  // a lost ACK shows up as a resend
+                continue;
+            }
+            stateChanged.notify_all();  // queue space for send()
+            serial.write(frame.data(), static_cast<int>(frame.size()));  // a failed write is retransmitted on timeout
+        }
+        stateChanged.notify_all();
+    }
+
+    // Hands bytes for the peer (ACK, SYN-ACK) from the reader thread to the sender thread
+    void queueControl(const char* data, size_t length) {
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            pendingControl.insert(pendingControl.end(), data, data + length);
+        }
+        stateChanged.notify_all();
+    }
+
+    // ------------------------------------------------------
+    // Receive side
+    // ------------------------------------------------------
+
+    // Demultiplexes the incoming stream by start byte: the peer's data frames, ACKs for this end's frames,
+    // and late handshake frames; anything else is noise and is skipped a byte at a time
+    void readerLoop() {
+        ScopedLogSink logScope(&log);
+        std::vector<char> frameBuffer(dataFrameWireSize(framePayload, true, 0, true));
+        std::vector<char> ackIn(ackSize);
+        std::vector<char> ackOut;
+        FecStats fec;
+        while (!stopping && !failed()) {
+            char first;
+            if (serial.read(&first, 1, READER_POLL_MS) != 1) continue;
+            if (first == SOF) {
+                if (peekFrameHeader(frameBuffer, first)) {
+                    receiveFrame(frameBuffer, ackOut, fec);
+                }
+            } else if (first == SOF_ACK) {
+                serial.unread(&first, 1);
+                receiveAck(ackIn);
+            } else if (first == SOF_SYNC) {
+                serial.unread(&first, 1);
+                SyncFrame sync;
+                if (readStreamSyncFrame(serial, sync, READER_POLL_MS) && sync.flags == SYNC_FLAG_SYN &&
+                    options.role == SERIAL_LINK_ACCEPT) {
+                    SyncFrame reply;
+                    reply.flags = SYNC_FLAG_SYN | SYNC_FLAG_ACK;
+                    reply.seq = syncSeq;
+                    reply.ack = sync.seq + 1;
+                    reply.serialize(ackOut);
+                    queueControl(ackOut.data(), ackOut.size());
+                }
+            }
+        }
+        messageReady.notify_all();
+        stateChanged.notify_all();
+    }
+
+    // Reads the fixed header after a SOF and checks the fields a link frame always has (Flags 0, WindowSize 0,
+    // StoredLength within the negotiated payload); a mismatch is a false SOF, so reading resumes at the next candidate.
+    // On success the header is put back for readDataFrame
+    bool peekFrameHeader(std::vector<char>& frameBuffer, char first) {
+        char* header = frameBuffer.data();
+        header[0] = first;
+        const int rest = FRAME_HEADER_Z - 1;
+        const int received = serial.read(header + 1, rest, frameReadTimeoutMs);
+        if (received != rest) {
+            serial.unread(header, 1 + std::max(received, 0));
+            return false;
+        }
+        uint16_t windowSize;
+        uint32_t storedLength;
+        memcpy(&windowSize, header + 5, sizeof(uint16_t));
+        memcpy(&storedLength, header + 10, sizeof(uint32_t));
+        if (header[9] != 0 || windowSize != 0 || storedLength < static_cast<uint32_t>(FRAGMENT_HEADER_SIZE) ||
+            storedLength > static_cast<uint32_t>(framePayload)) {
+            realignStream(serial, header, FRAME_HEADER_Z);
+            return false;
+        }
+        serial.unread(header, FRAME_HEADER_Z);
+        return true;
+    }
+
+    void receiveFrame(std::vector<char>& frameBuffer, std::vector<char>& ackOut, FecStats& fec) {
+        int length = readDataFrame(serial, frameBuffer, framePayload, true, 0, 0, fec, frameReadTimeoutMs, true);
+        if (length == FRAME_READ_SYNC) return;
+        if (length < 0) {
+            badFrames++;
+            return;
+        }
+
+        // The payload stays in frameBuffer: header, checksum and fragment fields are checked in place
+        DataFrame frame;
+        const char* body = nullptr;
+        uint32_t storedLength = 0;
+        Fragment fragment;
+        if (!frame.viewStored(frameBuffer.data(), length, body, storedLength) || frame.channel() != 0 ||
+            xorRotateChecksum(body, storedLength) != frame.checksum ||
+            !parseFragment(body, storedLength, fragmentData, fragment)) {
+            badFrames++;
+            realignStream(serial, frameBuffer.data(), length);
+            return;
+        }
+
+        // A fragment that disagrees with its message's length is not acknowledged (the sender resends it)
+        const long long seq = window->unwrap(frame.frameNum);
+        std::map<long long, Assembly>::const_iterator existing = assemblies.find(seq - fragment.offset / fragmentData);
+        if (existing != assemblies.end() && existing->second.length != fragment.messageLength) {
+            badFrames++;
+            return;
+        }
+        const bool isNew = window->acknowledge(seq, ackOut);
+        queueControl(ackOut.data(), ackOut.size());
+        if (!isNew) {
+            duplicateFrames++;
+            return;
+        }
+        framesReceived++;
+        acceptFragment(seq, fragment);
+    }
+
+    // Copies the fragment from the frame buffer into the message's final buffer (the only copy on the receive path)
+    void acceptFragment(long long seq, const Fragment& fragment) {
+        const long long first = seq - fragment.offset / fragmentData;
+        if (first < nextDelivery) {
+            badFrames++;
+            return;
+        }
+        std::map<long long, Assembly>::iterator it = assemblies.find(first);
+        if (it == assemblies.end()) {
+            it = assemblies.insert(std::make_pair(first, Assembly())).first;
+            startAssembly(it->second, fragment.messageLength);
+        }
+        Assembly& assembly = it->second;
+        if (assembly.data && fragment.length > 0) {
+            memcpy(assembly.data + fragment.offset, fragment.data, fragment.length);
+        }
+        assembly.received++;
+
+        // Deliver in send order: completed messages wait until every earlier message is complete
+        while (!assemblies.empty() && assemblies.begin()->first == nextDelivery &&
+               assemblies.begin()->second.received == assemblies.begin()->second.fragments) {
+            nextDelivery += assemblies.begin()->second.fragments;
+            deliver(assemblies.begin()->second);
+            assemblies.erase(assemblies.begin());
+        }
+    }
+
+    void startAssembly(Assembly& assembly, size_t length) {
+        assembly.length = length;
+        assembly.fragments = fragmentCount(length, fragmentData);
+        if (length > options.maxMessage) {
+            return;  // acknowledged so the sender moves on, but never stored
+        }
+        Allocator allocate;
+        {
+            std::lock_guard<std::mutex> lock(receiveMutex);
+            allocate = allocator;
+        }
+        if (allocate) {
+            assembly.data = static_cast<char*>(allocate(length));
+        }
+        if (!assembly.data) {
+            assembly.pooled = pool->acquire(length);
+            assembly.data = assembly.pooled.data();
+        }
+    }
+
+    void deliver(Assembly& assembly) {
+        if (!assembly.data) {
+            messagesDropped++;
+            logMessage("Warning: Dropped a " + std::to_string(assembly.length) + "-byte message (max message " +
+                       std::to_string(options.maxMessage) + " bytes).");
+            return;
+        }
+        messagesReceived++;
+        const bool pooled = !assembly.pooled.empty();
+        Handler handle;
+        {
+            std::lock_guard<std::mutex> lock(receiveMutex);
+            handle = handler;
+            if (!handle) {
+                queue.push_back(Message());
+                Message& message = queue.back();
+                if (pooled) {
+                    message.pool_ = pool;
+                    message.buffer_.swap(assembly.pooled);
+                }
+                message.data_ = assembly.data;
+                message.size_ = assembly.length;
+            }
+        }
+        if (!handle) {
+            messageReady.notify_one();
+            return;
+        }
+        handle(assembly.data, assembly.length);
+        if (pooled) {
+            pool->release(assembly.pooled);
+        }
+    }
+
+    // ACK for this end's frames: positions are unwrapped against the sender's window base
+    void receiveAck(std::vector<char>& ackIn) {
+        const int received = serial.read(ackIn.data(), ackSize, frameReadTimeoutMs);
+        if (received != ackSize) {
+            if (received > 0) serial.unread(ackIn.data(), received);
+            return;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (sack) {
+            SackAck ack;
+            if (!ack.deserialize(ackIn.data(), ackSize, true) || ack.channel != 0) {
+                badFrames++;
+                realignStream(serial, ackIn.data(), ackSize);
+                return;
+            }
+            std::lock_guard<std::mutex> lock(stateMutex);
+            const long long base = sender->base();
+            const long long cumulative = std::min(unwrapSequence(ack.cumulativeAck, base), sender->nextSequence());
+            for (long long seq = base; seq < cumulative; ++seq) {
+                markAcked(seq, now);
+            }
+            const long long bitmapBase = unwrapSequence(ack.bitmapBase, base);
+            for (int w = 0; w < SackAck::WORDS; ++w) {
+                uint64_t bits = ack.bitmap[w];
+                while (bits != 0) {
+                    markAcked(bitmapBase + w * 64 + lowestSetBit(bits), now);
+                    bits &= bits - 1;
+                }
+            }
+        } else {
+            AckFrame ack;
+            if (!ack.deserialize(ackIn.data(), ackSize, true) || ack.channel != 0) {
+                badFrames++;
+                realignStream(serial, ackIn.data(), ackSize);
+                return;
+            }
+            std::lock_guard<std::mutex> lock(stateMutex);
+            const long long first = unwrapSequence(ack.baseFrameNum, sender->base());
+            for (int i = 0; i < 32; ++i) {
+                if (ack.isAcked(ack.baseFrameNum + i)) {
+                    markAcked(first + i, now);
+                }
+            }
+        }
+        stateChanged.notify_all();
+    }
+};
+
+// ----------------------------------------------------------
+// Link
+// ----------------------------------------------------------
+
+Link::Link(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+Link::~Link() {}
+
+std::unique_ptr<Link> Link::open(const std::string& port, const Options& options) {
+    std::unique_ptr<Impl> impl(new Impl(options));
+    bool opened;
+    {
+        ScopedLogSink logScope(&impl->log);
+        opened = impl->serial.open(port, options.baudRate) && impl->handshake();
+    }
+    if (!opened) {
+        const std::string error = impl->error();
+        openError = error.empty() ? "Error: Failed to open " + port + "." : error;
+        return std::unique_ptr<Link>();
+    }
+    impl->start();
+    return std::unique_ptr<Link>(new Link(std::move(impl)));
+}
+
+std::string Link::lastError() {
+    return openError;
+}
+
+std::string Link::error() const {
+    return impl_->error();
+}
+
+bool Link::send(const void* message, size_t size) {
+    return impl_->send(static_cast<const char*>(message), size);
+}
+
+bool Link::flush(int timeoutMs) {
+    return impl_->flush(timeoutMs);
+}
+
+void Link::setReceiver(Handler handler, Allocator allocator) {
+    std::lock_guard<std::mutex> lock(impl_->receiveMutex);
+    impl_->handler = handler;
+    impl_->allocator = allocator;
+}
+
+bool Link::receive(Message& message, int timeoutMs) {
+    std::unique_lock<std::mutex> lock(impl_->receiveMutex);
+    Impl& impl = *impl_;
+    impl.messageReady.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&impl]() {
+        return !impl.queue.empty() || impl.stopping || impl.failed();
+    });
+    if (impl.queue.empty()) return false;
+    message = std::move(impl.queue.front());
+    impl.queue.pop_front();
+    return true;
+}
+
+bool Link::isFailed() const {
+    return impl_->failed();
+}
+
+Stats Link::stats() const {
+    Stats stats;
+    memset(&stats, 0, sizeof(stats));
+    {
+        std::lock_guard<std::mutex> lock(impl_->stateMutex);
+        const ChannelSender& sender = *impl_->sender;
+        stats.messages_sent = impl_->messagesSent;
+        stats.frames_sent = sender.sentMessages();
+        stats.frames_resent = sender.resentFrames();
+        stats.ack_latency_p50_ms = sender.latency().percentileMs(0.50);
+        stats.ack_latency_p99_ms = sender.latency().percentileMs(0.99);
+    }
+    stats.messages_received = impl_->messagesReceived;
+    stats.messages_dropped = impl_->messagesDropped;
+    stats.frames_received = impl_->framesReceived;
+    stats.duplicate_frames = impl_->duplicateFrames;
+    stats.bad_frames = impl_->badFrames;
+    stats.frame_payload = impl_->framePayload;
+    stats.window = impl_->agreed.maxWindow;
+    return stats;
+}
+
+}  // namespace seriallink
+
+// ==========================================================
+// C ABI
+// ==========================================================
+
+struct serial_link {
+    std::unique_ptr<seriallink::Link> link;
+    std::mutex mutex;
+    std::map<void*, seriallink::Message> outstanding;  // queue messages handed out by serial_link_receive
+};
+
+namespace {
+
+thread_local std::string cLastError;  // backing store for serial_link_last_error (per calling thread)
+
+// Records the failing link's own error for serial_link_last_error
+void setLinkError(serial_link* link) {
+    cLastError = link->link->error();
+    if (cLastError.empty()) cLastError = "Error: Link failed.";
+}
+
+}  // namespace
+
+extern "C" {
+
+void serial_link_default_options(serial_link_options* options) {
+    const seriallink::Options defaults;
+    options->baud_rate = defaults.baudRate;
+    options->role = defaults.role;
+    options->frame_payload = defaults.framePayload;
+    options->window = defaults.window;
+    options->max_message = defaults.maxMessage;
+    options->open_timeout_ms = defaults.openTimeoutMs;
+    options->log_to_console = defaults.logToConsole ? 1 : 0;
+}
+
+serial_link* serial_link_open(const char* port, const serial_link_options* options) {
+    seriallink::Options opts;
+    if (options) {
+        opts.baudRate = options->baud_rate;
+        opts.role = options->role;
+        opts.framePayload = options->frame_payload;
+        opts.window = options->window;
+        opts.maxMessage = options->max_message;
+        opts.openTimeoutMs = options->open_timeout_ms;
+        opts.logToConsole = options->log_to_console != 0;
+    }
+    std::unique_ptr<seriallink::Link> link = seriallink::Link::open(port, opts);
+    if (!link) {
+        cLastError = seriallink::Link::lastError();
+        return nullptr;
+    }
+    serial_link* handle = new serial_link;
+    handle->link = std::move(link);
+    return handle;
+}
+
+void serial_link_close(serial_link* link) {
+    delete link;
+}
+
+int serial_link_send(serial_link* link, const void* message, size_t size) {
+    if (link->link->send(message, size)) return 0;
+    setLinkError(link);
+    return -1;
+}
+
+int serial_link_flush(serial_link* link, int timeout_ms) {
+    if (link->link->flush(timeout_ms)) return 0;
+    if (link->link->isFailed()) {
+        setLinkError(link);
+    } else {
+        cLastError = "Error: Flush timed out after " + std::to_string(timeout_ms) + " ms.";
+    }
+    return -1;
+}
+
+void serial_link_set_receiver(serial_link* link, serial_link_message_fn deliver, serial_link_alloc_fn allocate, void* user) {
+    if (!deliver) {
+        link->link->setReceiver(seriallink::Link::Handler());
+        return;
+    }
+    seriallink::Link::Allocator allocator;
+    if (allocate) {
+        allocator = [allocate, user](size_t size) { return allocate(user, size); };
+    }
+    link->link->setReceiver([deliver, user](char* data, size_t size) { deliver(user, data, size); }, allocator);
+}
+
+int serial_link_receive(serial_link* link, void** data, size_t* size, int timeout_ms) {
+    seriallink::Message message;
+    if (!link->link->receive(message, timeout_ms)) {
+        if (!link->link->isFailed()) return 0;
+        setLinkError(link);
+        return -1;
+    }
+    *data = message.data();
+    *size = message.size();
+    std::lock_guard<std::mutex> lock(link->mutex);
+    link->outstanding[*data] = std::move(message);
+    return 1;
+}
+
+void serial_link_release(serial_link* link, void* data) {
+    std::lock_guard<std::mutex> lock(link->mutex);
+    link->outstanding.erase(data);
+}
+
+void serial_link_get_stats(serial_link* link, serial_link_stats* stats) {
+    *stats = link->link->stats();
+}
+
+const char* serial_link_last_error(void) {
+    return cLastError.c_str();
+}
+
+}  // extern "C"
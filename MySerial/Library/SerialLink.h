@@ -0,0 +1,191 @@
+// ==========================================================
+// SerialLink: message-oriented API over the SerialCommunicator ARQ engine
+// ==========================================================
+// A link is one full-duplex session on a serial port (or a "mem:" link).
+// Both ends send messages of any size up to the receiver's max_message;
+// messages larger than one frame are fragmented across data frames and
+// reassembled straight into the final buffer (caller-provided or pooled),
+// then delivered in send order through a callback or a receive queue.
+//
+// The C++ API lives in namespace seriallink; the C ABI below it wraps the
+// same object behind an opaque handle for callers in other languages.
+
+#ifndef SERIAL_LINK_H
+#define SERIAL_LINK_H
+
+#include <stddef.h>
+
+#if defined(_WIN32) && defined(SERIAL_LINK_SHARED)
+#ifdef SERIAL_LINK_BUILD
+#define SERIAL_LINK_API __declspec(dllexport)
+#else
+#define SERIAL_LINK_API __declspec(dllimport)
+#endif
+#else
+#define SERIAL_LINK_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Which side of the SYN / SYN-ACK handshake this end plays. */
+enum {
+    SERIAL_LINK_CONNECT = 0,  /* sends SYN until the peer answers */
+    SERIAL_LINK_ACCEPT = 1    /* waits for the peer's SYN */
+};
+
+typedef struct serial_link serial_link;
+
+typedef struct serial_link_options {
+    int baud_rate;          /* port speed (ignored by mem: links) */
+    int role;               /* SERIAL_LINK_CONNECT or SERIAL_LINK_ACCEPT */
+    int frame_payload;      /* bytes per data frame, 12-byte fragment header included (both ends agree on the smaller) */
+    int window;             /* frames in flight per direction (both ends agree on the smaller) */
+    size_t max_message;     /* largest message this end reassembles; larger ones are acknowledged and dropped */
+    int open_timeout_ms;    /* SERIAL_LINK_ACCEPT: how long to wait for the peer's SYN */
+    int log_to_console;     /* nonzero: this link's log lines also go to stdout */
+} serial_link_options;
+
+typedef struct serial_link_stats {
+    long long messages_sent;
+    long long messages_received;
+    long long messages_dropped;   /* larger than max_message */
+    long long frames_sent;        /* first transmissions */
+    long long frames_resent;
+    long long frames_received;    /* new frames accepted */
+    long long duplicate_frames;
+    long long bad_frames;         /* framing, checksum or fragment header errors */
+    double ack_latency_p50_ms;    /* fragment enqueue to ACK */
+    double ack_latency_p99_ms;
+    int frame_payload;            /* negotiated */
+    int window;                   /* negotiated */
+} serial_link_stats;
+
+/* Returns a buffer of at least size bytes for the next incoming message, or NULL to use the link's pool. */
+typedef void* (*serial_link_alloc_fn)(void* user, size_t size);
+/* Called on the link's reader thread once a message is complete. */
+typedef void (*serial_link_message_fn)(void* user, void* data, size_t size);
+
+SERIAL_LINK_API void serial_link_default_options(serial_link_options* options);
+
+/* Opens the port and runs the handshake; NULL on failure (see serial_link_last_error). */
+SERIAL_LINK_API serial_link* serial_link_open(const char* port, const serial_link_options* options);
+SERIAL_LINK_API void serial_link_close(serial_link* link);
+
+/* Queues a copy of the message; blocks while the send queue is full. 0 on success, -1 if the link failed. */
+SERIAL_LINK_API int serial_link_send(serial_link* link, const void* message, size_t size);
+/* Waits until every queued message is acknowledged. 0 on success, -1 on timeout or link failure. */
+SERIAL_LINK_API int serial_link_flush(serial_link* link, int timeout_ms);
+
+/* Callback delivery. With an allocator, data is the buffer it returned and belongs to the caller;
+   otherwise data is a pooled buffer that is only valid until the callback returns.
+   deliver = NULL switches back to the receive queue. */
+SERIAL_LINK_API void serial_link_set_receiver(serial_link* link, serial_link_message_fn deliver,
+                                              serial_link_alloc_fn allocate, void* user);
+/* Queue delivery. 1 = message in *data / *size (return it with serial_link_release), 0 = timeout, -1 = link failed. */
+SERIAL_LINK_API int serial_link_receive(serial_link* link, void** data, size_t* size, int timeout_ms);
+SERIAL_LINK_API void serial_link_release(serial_link* link, void* data);
+
+SERIAL_LINK_API void serial_link_get_stats(serial_link* link, serial_link_stats* stats);
+/* Error text of the last failed serial_link_* call on the calling thread (valid until that thread's next failure). */
+SERIAL_LINK_API const char* serial_link_last_error(void);
+
+#ifdef __cplusplus
+}  /* extern "C" */
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace seriallink {
+
+typedef serial_link_stats Stats;
+
+struct Options {
+    int baudRate;
+    int role;
+    int framePayload;
+    int window;
+    size_t maxMessage;
+    int openTimeoutMs;
+    bool logToConsole;
+
+    Options() : baudRate(115200), role(SERIAL_LINK_CONNECT), framePayload(1024), window(32),
+                maxMessage(16 * 1024 * 1024), openTimeoutMs(30000), logToConsole(false) {}
+};
+
+class MessagePool;
+
+// A message taken from the receive queue. Move-only; a pooled buffer goes back
+// to the link's pool when the Message is destroyed or reassigned.
+class Message {
+public:
+    Message();
+    Message(Message&& other);
+    Message& operator=(Message&& other);
+    ~Message();
+
+    char* data() { return data_; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    friend class Link;
+    Message(const Message&);
+    Message& operator=(const Message&);
+    void reset();
+
+    std::shared_ptr<MessagePool> pool_;  // set when buffer_ came from the pool
+    std::vector<char> buffer_;
+    char* data_;
+    size_t size_;
+};
+
+class Link {
+public:
+    typedef std::function<void*(size_t size)> Allocator;
+    typedef std::function<void(char* data, size_t size)> Handler;
+
+    // Opens the port and runs the handshake; nullptr on failure (see lastError()).
+    static std::unique_ptr<Link> open(const std::string& port, const Options& options = Options());
+    // Why the last open() on the calling thread failed.
+    static std::string lastError();
+
+    // Stops the link threads; messages not yet acknowledged are abandoned (call flush() first).
+    ~Link();
+
+    // Queues a copy of the message, fragmenting it if it does not fit one frame.
+    // Blocks while the send queue is full; false once the link has failed.
+    bool send(const void* message, size_t size);
+
+    // Waits until every queued message is acknowledged by the peer.
+    bool flush(int timeoutMs);
+
+    // Callback delivery (see serial_link_set_receiver); an empty handler selects the receive queue.
+    void setReceiver(Handler handler, Allocator allocator = Allocator());
+
+    // Queue delivery: true with the next message, false on timeout or link failure.
+    bool receive(Message& message, int timeoutMs);
+
+    bool isFailed() const;
+    // Last error logged by this link (empty if none).
+    std::string error() const;
+    Stats stats() const;
+
+private:
+    struct Impl;
+
+    explicit Link(std::unique_ptr<Impl> impl);
+    Link(const Link&);
+    Link& operator=(const Link&);
+
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace seriallink
+
+#endif  /* __cplusplus */
+
+#endif  /* SERIAL_LINK_H */
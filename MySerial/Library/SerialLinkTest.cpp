@@ -0,0 +1,169 @@
+// ==========================================================
+// SerialLinkTest: loopback test for the SerialLink library
+// ==========================================================
+// Two links run in this process over a mem: link (no hardware needed):
+//   1. C++ API, queue delivery: fragment boundaries (0 bytes, exactly one fragment,
+//      one byte over, max message, max message + 1 which is dropped)
+//   2. C++ API, callback delivery into caller-allocated buffers, in the other direction
+//   3. C ABI (SerialLinkTestC.c, compiled as C) against an echoing C++ peer
+//
+// Exit code 0 when every check passes.
+
+#include "SerialLink.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" int serialLinkTestCApi(const char* port, const char* badPort);
+
+namespace {
+
+const int FRAME_PAYLOAD = 256;
+const size_t FRAGMENT_DATA = FRAME_PAYLOAD - 8;   // frame payload minus the fragment header
+const size_t MAX_MESSAGE = 4096;
+const int TIMEOUT_MS = 10000;
+
+int failures = 0;
+
+#define CHECK(condition)                                                          \
+    do {                                                                          \
+        if (!(condition)) {                                                       \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++;                                                           \
+        }                                                                         \
+    } while (0)
+
+std::vector<char> makeMessage(size_t size, unsigned seed) {
+    std::vector<char> message(size);
+    for (size_t i = 0; i < size; ++i) message[i] = static_cast<char>(seed * 131u + i * 13u);
+    return message;
+}
+
+bool matches(const char* data, size_t size, unsigned seed) {
+    const std::vector<char> expected = makeMessage(size, seed);
+    return size == 0 || std::memcmp(data, expected.data(), size) == 0;
+}
+
+// Opens both ends of a mem: link (the accepting end waits on its own thread)
+bool openPair(const std::string& name, const seriallink::Options& connect, const seriallink::Options& accept,
+              std::unique_ptr<seriallink::Link>& a, std::unique_ptr<seriallink::Link>& b) {
+    seriallink::Options acceptOptions = accept;
+    acceptOptions.role = SERIAL_LINK_ACCEPT;
+    std::thread acceptor([&]() { b = seriallink::Link::open("mem:" + name + "/B", acceptOptions); });
+    a = seriallink::Link::open("mem:" + name + "/A", connect);
+    acceptor.join();
+    if (!a || !b) {
+        std::fprintf(stderr, "open failed: %s\n", seriallink::Link::lastError().c_str());
+        return false;
+    }
+    return true;
+}
+
+// 1 + 2: C++ API in both directions
+void testCppApi() {
+    seriallink::Options connect;
+    connect.framePayload = FRAME_PAYLOAD;
+    seriallink::Options accept = connect;
+    accept.maxMessage = MAX_MESSAGE;
+    std::unique_ptr<seriallink::Link> a, b;
+    if (!openPair("linktest", connect, accept, a, b)) {
+        failures++;
+        return;
+    }
+    CHECK(a->stats().frame_payload == FRAME_PAYLOAD);
+
+    // A -> B, queue delivery; MAX_MESSAGE + 1 is acknowledged but dropped by B
+    const size_t sizes[] = {0, 1, FRAGMENT_DATA - 1, FRAGMENT_DATA, FRAGMENT_DATA + 1, 3 * FRAGMENT_DATA,
+                            MAX_MESSAGE, MAX_MESSAGE + 1, 5};
+    const size_t count = sizeof(sizes) / sizeof(sizes[0]);
+    for (size_t i = 0; i < count; ++i) {
+        const std::vector<char> message = makeMessage(sizes[i], static_cast<unsigned>(i));
+        CHECK(a->send(message.data(), message.size()));
+    }
+    CHECK(a->flush(TIMEOUT_MS));
+    for (size_t i = 0; i < count; ++i) {
+        if (sizes[i] > MAX_MESSAGE) continue;
+        seriallink::Message message;
+        CHECK(b->receive(message, TIMEOUT_MS));
+        CHECK(message.size() == sizes[i]);
+        CHECK(message.size() == sizes[i] && matches(message.data(), message.size(), static_cast<unsigned>(i)));
+    }
+    const seriallink::Stats bStats = b->stats();
+    CHECK(bStats.messages_received == static_cast<long long>(count - 1));
+    CHECK(bStats.messages_dropped == 1);
+
+    // B -> A, callback delivery into buffers from the caller's allocator
+    std::mutex mutex;
+    std::vector<size_t> received;
+    int allocations = 0;
+    int mismatches = 0;
+    a->setReceiver(
+        [&](char* data, size_t size) {
+            std::lock_guard<std::mutex> lock(mutex);
+            const unsigned seed = static_cast<unsigned>(received.size());
+            received.push_back(size);
+            if (!matches(data, size, 1000u + seed)) mismatches++;
+            std::free(data);
+        },
+        [&](size_t size) -> void* {
+            std::lock_guard<std::mutex> lock(mutex);
+            allocations++;
+            return std::malloc(size ? size : 1);
+        });
+    const size_t callbackSizes[] = {0, FRAGMENT_DATA, 2 * FRAGMENT_DATA + 1, 100000};
+    const size_t callbackCount = sizeof(callbackSizes) / sizeof(callbackSizes[0]);
+    for (size_t i = 0; i < callbackCount; ++i) {
+        const std::vector<char> message = makeMessage(callbackSizes[i], 1000u + static_cast<unsigned>(i));
+        CHECK(b->send(message.data(), message.size()));
+    }
+    CHECK(b->flush(TIMEOUT_MS));
+    a.reset();  // joins the reader thread, so every callback has returned
+    b.reset();
+    CHECK(received.size() == callbackCount);
+    for (size_t i = 0; i < received.size() && i < callbackCount; ++i) {
+        CHECK(received[i] == callbackSizes[i]);
+    }
+    CHECK(allocations == static_cast<int>(callbackCount));
+    CHECK(mismatches == 0);
+}
+
+// 3: C ABI end connects, this end echoes
+void testCApi() {
+    seriallink::Options accept;
+    accept.role = SERIAL_LINK_ACCEPT;
+    accept.openTimeoutMs = TIMEOUT_MS;
+    std::thread echo([&]() {
+        std::unique_ptr<seriallink::Link> link = seriallink::Link::open("mem:linktestc/B", accept);
+        if (!link) return;
+        seriallink::Message message;
+        while (link->receive(message, 2000)) {
+            link->send(message.data(), message.size());
+        }
+        link->flush(TIMEOUT_MS);
+    });
+    CHECK(serialLinkTestCApi("mem:linktestc/A", "mem:linktestc-invalid") == 0);
+    echo.join();
+}
+
+}  // namespace
+
+int main() {
+    // Invalid port: open fails and the reason is kept for this thread
+    CHECK(!seriallink::Link::open("mem:no-side"));
+    CHECK(!seriallink::Link::lastError().empty());
+
+    testCppApi();
+    testCApi();
+
+    if (failures == 0) {
+        std::printf("SerialLinkTest: all checks passed\n");
+        return 0;
+    }
+    std::printf("SerialLinkTest: %d check(s) failed\n", failures);
+    return 1;
+}
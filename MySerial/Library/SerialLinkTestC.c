@@ -0,0 +1,131 @@
+/* ==========================================================
+ * SerialLinkTestC: C ABI half of the SerialLink loopback test
+ * ==========================================================
+ * Compiled as C so the header is checked from a C caller. The connecting end
+ * runs here; SerialLinkTest.cpp opens the accepting end and echoes every
+ * message back. */
+
+#include "SerialLink.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define C_FRAME_PAYLOAD 256
+#define C_FRAGMENT_DATA (C_FRAME_PAYLOAD - 8)
+
+/* Queue round: empty, one byte, exactly one fragment, one byte over, several fragments */
+static const size_t queueSizes[] = {0, 1, C_FRAGMENT_DATA, C_FRAGMENT_DATA + 1, 1000};
+/* Callback round (caller-provided buffers) */
+static const size_t callbackSizes[] = {C_FRAGMENT_DATA * 2, 7};
+
+#define COUNT(a) (sizeof(a) / sizeof((a)[0]))
+
+static void fillMessage(unsigned char* data, size_t size, unsigned seed) {
+    size_t i;
+    for (i = 0; i < size; ++i) data[i] = (unsigned char)(seed * 31u + i * 7u);
+}
+
+static int checkMessage(const unsigned char* data, size_t size, unsigned seed) {
+    size_t i;
+    for (i = 0; i < size; ++i) {
+        if (data[i] != (unsigned char)(seed * 31u + i * 7u)) return 0;
+    }
+    return 1;
+}
+
+static int sendMessage(serial_link* link, size_t size, unsigned seed) {
+    unsigned char* data = (unsigned char*)malloc(size ? size : 1);
+    int result;
+    fillMessage(data, size, seed);
+    result = serial_link_send(link, data, size);
+    free(data);
+    return result;
+}
+
+/* Callback state: written on the reader thread, read after serial_link_close joined it */
+typedef struct {
+    int delivered;
+    int allocated;
+    int failures;
+} CallbackState;
+
+static void* allocateMessage(void* user, size_t size) {
+    ((CallbackState*)user)->allocated++;
+    return malloc(size ? size : 1);
+}
+
+static void deliverMessage(void* user, void* data, size_t size) {
+    CallbackState* state = (CallbackState*)user;
+    const int index = state->delivered++;
+    if (index >= (int)COUNT(callbackSizes) || size != callbackSizes[index] ||
+        !checkMessage((const unsigned char*)data, size, 100u + (unsigned)index)) {
+        state->failures++;
+    }
+    free(data);
+}
+
+#define FAIL(message) do { fprintf(stderr, "C ABI: %s (%s)\n", message, serial_link_last_error()); goto done; } while (0)
+
+/* Returns 0 when every check passes */
+int serialLinkTestCApi(const char* port, const char* badPort) {
+    serial_link_options options;
+    serial_link* link = NULL;
+    serial_link_stats stats;
+    CallbackState state;
+    size_t i;
+    int wait;
+    int result = 1;
+
+    memset(&state, 0, sizeof(state));
+    serial_link_default_options(&options);
+    options.frame_payload = C_FRAME_PAYLOAD;
+    options.open_timeout_ms = 10000;
+
+    if (serial_link_open(badPort, &options) != NULL) FAIL("open of an invalid port succeeded");
+    if (serial_link_last_error()[0] == '\0') FAIL("no error text after a failed open");
+
+    link = serial_link_open(port, &options);
+    if (!link) FAIL("open failed");
+
+    for (i = 0; i < COUNT(queueSizes); ++i) {
+        if (sendMessage(link, queueSizes[i], (unsigned)i) != 0) FAIL("send failed");
+    }
+    for (i = 0; i < COUNT(queueSizes); ++i) {
+        void* data;
+        size_t size;
+        if (serial_link_receive(link, &data, &size, 10000) != 1) FAIL("echo not received");
+        if (size != queueSizes[i] || !checkMessage((const unsigned char*)data, size, (unsigned)i)) {
+            serial_link_release(link, data);
+            FAIL("echo does not match");
+        }
+        serial_link_release(link, data);
+    }
+
+    serial_link_set_receiver(link, deliverMessage, allocateMessage, &state);
+    for (i = 0; i < COUNT(callbackSizes); ++i) {
+        if (sendMessage(link, callbackSizes[i], 100u + (unsigned)i) != 0) FAIL("send failed");
+    }
+    if (serial_link_flush(link, 10000) != 0) FAIL("flush failed");
+    for (wait = 0; wait < 100; ++wait) {
+        void* data;
+        size_t size;
+        serial_link_get_stats(link, &stats);
+        if (stats.messages_received >= (long long)(COUNT(queueSizes) + COUNT(callbackSizes))) break;
+        serial_link_receive(link, &data, &size, 100);  /* callback mode: only waits */
+    }
+    serial_link_get_stats(link, &stats);
+    if (stats.frame_payload != C_FRAME_PAYLOAD) FAIL("frame payload not negotiated");
+    serial_link_close(link);
+    link = NULL;
+
+    if (state.delivered != (int)COUNT(callbackSizes) || state.allocated != (int)COUNT(callbackSizes) || state.failures != 0) {
+        fprintf(stderr, "C ABI: callback delivered %d, allocated %d, mismatched %d\n", state.delivered, state.allocated, state.failures);
+        goto done;
+    }
+    result = 0;
+
+done:
+    if (link) serial_link_close(link);
+    return result;
+}
@@ -0,0 +1,44 @@
+@echo off
+setlocal enabledelayedexpansion
+
+REM ========================================
+REM SerialLink Library Compile Script
+REM ========================================
+REM Commands inside the if blocks use "|| goto :error": %ERRORLEVEL% there is expanded
+REM when the block is parsed, so it would still hold the result of "where".
+
+echo Compiling SerialLink.cpp...
+
+where cmake >nul 2>nul
+if %ERRORLEVEL% EQU 0 (
+    cmake -S . -B build || goto :error
+    cmake --build build --config Release || goto :error
+    echo.
+    echo Build successful: build\Release\SerialLink.lib
+    echo Run the loopback test with: ctest --test-dir build -C Release --output-on-failure
+    goto :end
+)
+
+where g++ >nul 2>nul
+if %ERRORLEVEL% EQU 0 (
+    echo CMake not found. Using MinGW g++ compiler...
+    g++ -std=c++11 -c SerialLink.cpp -o SerialLink.o -O2 || goto :error
+    g++ -std=c++11 -c ..\SerialProtocol.cpp -o SerialProtocol.o -O2 || goto :error
+    ar rcs libSerialLink.a SerialLink.o SerialProtocol.o || goto :error
+    gcc -std=c99 -c SerialLinkTestC.c -o SerialLinkTestC.o -O2 || goto :error
+    g++ -std=c++11 SerialLinkTest.cpp SerialLinkTestC.o libSerialLink.a -o SerialLinkTest.exe -static-libgcc -static-libstdc++ -O2 -lws2_32 || goto :error
+    echo.
+    echo Build successful: libSerialLink.a ^(link applications with -lws2_32^), SerialLinkTest.exe
+    goto :end
+)
+
+echo ERROR: Neither CMake nor g++ found in PATH.
+goto :error
+
+:error
+pause
+exit /b 1
+
+:end
+pause
+exit /b 0
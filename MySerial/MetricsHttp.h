@@ -0,0 +1,149 @@
+// ==========================================================
+// MetricsHttp: Prometheus ؽƮ (0.0.4) ּ HTTP 
+// ==========================================================
+// SerialCommunicator(--metrics-port) TestRunner2 MetricsServer Բ 
+// 127.0.0.1 ϰ û ϳ ó (ũ 󵵰 Ƿ   )
+// Winsock ʱȭ(WSAStartup) ȣ 
+#pragma once
+
+#include <winsock2.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace metricshttp {
+
+// # HELP, # TYPE    ߰ (labels {}  ,   )
+inline void appendMetric(std::ostringstream& out, const char* name, const char* type,
+                         const char* help, double value, const std::string& labels = std::string()) {
+    out << "# HELP " << name << ' ' << help << '\n'
+        << "# TYPE " << name << ' ' << type << '\n'
+        << name;
+    if (!labels.empty()) out << '{' << labels << '}';
+    out << ' ' << std::setprecision(15) << value << '\n';
+}
+
+// GET /metrics Ǵ GET / û render()   ,   δ 404
+class Listener {
+public:
+    typedef std::function<std::string()> Renderer;
+
+    Listener() : listenSocket_(INVALID_SOCKET), stopped_(true) {}
+    ~Listener() { stop(); }
+
+    // ϸ error (WSA  ڵ )  false
+    bool start(int port, Renderer render, std::string& error) {
+        listenSocket_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (listenSocket_ == INVALID_SOCKET) {
+            error = "socket() failed. Error code: " + std::to_string(WSAGetLastError());
+            return false;
+        }
+
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);  //  ũ 
+        address.sin_port = htons(static_cast<u_short>(port));
+        if (bind(listenSocket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR ||
+            listen(listenSocket_, SOMAXCONN) == SOCKET_ERROR) {
+            error = "bind()/listen() failed on port " + std::to_string(port) +
+                    ". Error code: " + std::to_string(WSAGetLastError());
+            closesocket(listenSocket_);
+            listenSocket_ = INVALID_SOCKET;
+            return false;
+        }
+
+        render_ = render;
+        stopped_ = false;
+        thread_ = std::thread(&Listener::acceptLoop, this);
+        return true;
+    }
+
+    void stop() {
+        stopped_ = true;
+        if (thread_.joinable()) thread_.join();
+        if (listenSocket_ != INVALID_SOCKET) {
+            closesocket(listenSocket_);
+            listenSocket_ = INVALID_SOCKET;
+        }
+    }
+
+private:
+    // 200ms  select  ȣ Ȯ (stop() accept()    ʵ)
+    void acceptLoop() {
+        while (!stopped_) {
+            fd_set readSet;
+            FD_ZERO(&readSet);
+            FD_SET(listenSocket_, &readSet);
+            timeval timeout = {0, 200000};
+            if (select(static_cast<int>(listenSocket_) + 1, &readSet, nullptr, nullptr, &timeout) <= 0) {
+                continue;
+            }
+            SOCKET client = accept(listenSocket_, nullptr, nullptr);
+            if (client == INVALID_SOCKET) continue;
+            handleRequest(client);
+            closesocket(client);
+        }
+    }
+
+    // û  (\r\n\r\n) ִ 4KB, 1 ȿ 
+    static std::string readRequest(SOCKET client) {
+        std::string request;
+        char buffer[1024];
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < 4096 &&
+               std::chrono::steady_clock::now() < deadline) {
+            fd_set readSet;
+            FD_ZERO(&readSet);
+            FD_SET(client, &readSet);
+            timeval timeout = {0, 100000};
+            if (select(static_cast<int>(client) + 1, &readSet, nullptr, nullptr, &timeout) <= 0) continue;
+            int received = recv(client, buffer, sizeof(buffer), 0);
+            if (received <= 0) break;
+            request.append(buffer, received);
+        }
+        return request;
+    }
+
+    static void sendAll(SOCKET client, const std::string& response) {
+        const char* data = response.data();
+        int remaining = static_cast<int>(response.size());
+        while (remaining > 0) {
+            int sent = send(client, data, remaining, 0);
+            if (sent <= 0) break;
+            data += sent;
+            remaining -= sent;
+        }
+    }
+
+    void handleRequest(SOCKET client) {
+        const std::string request = readRequest(client);
+
+        std::string status = "200 OK";
+        std::string body;
+        if (request.compare(0, 13, "GET /metrics ") == 0 || request.compare(0, 6, "GET / ") == 0) {
+            body = render_();
+        } else {
+            status = "404 Not Found";
+            body = "Not Found\n";
+        }
+
+        sendAll(client, "HTTP/1.1 " + status + "\r\n"
+                        "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                        "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                        "Connection: close\r\n\r\n" + body);
+    }
+
+    SOCKET listenSocket_;
+    std::thread thread_;
+    std::atomic<bool> stopped_;
+    Renderer render_;
+};
+
+}  // namespace metricshttp
@@ -1,1063 +1,963 @@
-#include <iostream>
+// ==========================================================
+// SerialCommunicator: ø   CLI (client, server, bench, broadcast, listen )
+// ==========================================================
+// , , ARQ  ڵũ SerialProtocol.h/.cpp (Library, Benchmark )
+//    帧,  (JSON,  ), ǽð  Խ,    ó 
+#include "SerialProtocol.h"
+#include "MetricsHttp.h"
 
-// Windows.h min/max ũ 浹 
-#ifndef NOMINMAX
-#define NOMINMAX
-#endif
+#pragma comment(lib, "ws2_32.lib")
 
-#include <windows.h>
-#include <string>
-#include <vector>
-#include <thread>
-#include <chrono>
-#include <fstream>
-#include <iomanip>
-#include <ctime>
-#include <cstring>
-#include <algorithm>
-#include <atomic>
-#include <sstream>
-#include <mutex>
-#include <set>
-#include <map>
-#include <queue>
-#include <condition_variable>
-#include <memory>
+using namespace serialcomm;
 
-// ==========================================================
-// Protocol Version 4: ȭ Selective Repeat ARQ with Burst Transmission
-// 
-//  Ư¡:
-// - Selective Repeat ARQ: ̵     
-// -   ũ : Ʈũ ¿  4-32  ڵ 
-// - Ʈ  ACK: 32  ¸   Ȯ
-// - Ƽ : Sender/Receiver  и  ȭ
-// -  ACK :    ACK   ּȭ
-// - 3-way Handshake:  ȯ  Ȯ ȭ
-// - Burst :  ũ⿡  ȭ Ʈ 
-// ==========================================================
 
 // ==========================================================
-//  α 
+// ޸ Ҵ Ƚ  (bench  Ӵ Ҵ  )
 // ==========================================================
-std::ofstream logFile;      // α  Ʈ
-std::mutex logMutex;        // α  ȭ ؽ
-
-// Thread-safe α  Լ
-// ְܼ α Ͽ ÿ ޽ 
-void logMessage(const std::string& message) {
-    std::lock_guard<std::mutex> lock(logMutex);
-    auto t = std::time(nullptr);
-    auto tm = *std::localtime(&t);
-    logFile << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << " - " << message << std::endl;
-    std::cout << message << std::endl;
+//  operator new/delete ü μ ü ǹǷ CLI  Ͽ .
+// Library/Benchmark    Ƿ ȣƮ Ҵڸ ǵ帮 
+#ifndef SERIALCOMM_NO_ALLOCATION_COUNT
+#define SERIALCOMM_ALLOCATION_COUNT
+#endif
+
+#ifdef SERIALCOMM_ALLOCATION_COUNT
+// ü new/delete ȣ  ζεǸ GCC 11+ new free ¦ ߸ ϹǷ ζ 
+#ifdef _MSC_VER
+#define ALLOCATOR_NOINLINE __declspec(noinline)
+#else
+#define ALLOCATOR_NOINLINE __attribute__((noinline))
+#endif
+
+std::atomic<long long> allocationCount(0);
+
+ALLOCATOR_NOINLINE void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+ALLOCATOR_NOINLINE void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+ALLOCATOR_NOINLINE void operator delete(void* p) noexcept {
+    std::free(p);
 }
 
-//     (뷮    ڵ Ȱȭ)
-// DEBUG ũΰ ǵ  , debugMode true   α 
-bool debugMode = false;  //   Ȱȭ 
+ALLOCATOR_NOINLINE void operator delete[](void* p) noexcept {
+    std::free(p);
+}
 
-#ifdef DEBUG
-#define LOG_DEBUG(msg) logMessage("[DEBUG] " + std::string(msg))
+// C++14 ũ   (-fsized-deallocation)  free 
+ALLOCATOR_NOINLINE void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+ALLOCATOR_NOINLINE void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+#endif
+
+// ݱ Ҵ Ƚ (  忡 ׻ 0)
+inline long long allocationsSoFar() {
+#ifdef SERIALCOMM_ALLOCATION_COUNT
+    return allocationCount.load(std::memory_order_relaxed);
 #else
-#define LOG_DEBUG(msg) do { if (debugMode) logMessage("[DEBUG] " + std::string(msg)); } while(0)
+    return 0;
 #endif
+}
 
 // ==========================================================
-// Protocol V4   
+//  ɼ (  д ɼ SerialProtocol.h)
 // ==========================================================
-const int PROTOCOL_VERSION = 4;  //   
-
-//   Ʈ (  ĺ)
-const char SOF = 0x02;              // Start of Frame:    Ʈ
-const char SOF_ACK = 0x04;          // Start of ACK Frame: ACK   Ʈ
-const char EOF_BYTE = 0x03;         // End of Frame:    Ʈ
-
-// ̵  ũ  (  )
-const int WINDOW_SIZE_INIT = 16;    // ʱ  ũ ( )
-const int WINDOW_SIZE_MAX = 32;     // ִ  ũ ( )
-const int WINDOW_SIZE_MIN = 4;      // ּ  ũ ( )
-
-//   ŸӾƿ 
-const int MAX_RETRANSMIT_ATTEMPTS = 5;  // ִ  õ Ƚ
-const double TIMEOUT_SAFETY_FACTOR = 2.5;  // ŸӾƿ   ( ð 2.5)
-const int BASE_TIMEOUT_MS = 500;         // ⺻ ŸӾƿ (и)
-
-//   ũ 
-// V4    : [SOF(1)][FrameNum(4)][WindowSize(2)][Checksum(2)][Payload][EOF(1)]
-// : SOF(1) + FrameNum(4) + WindowSize(2) + Checksum(2) = 9 bytes
-// ƮϷ: EOF(1) = 1 byte
-//  : 10 bytes
-const int FRAME_HEADER_V3 = 1 + 4 + 2 + 2;  //   ũ: 9 bytes
-const int FRAME_TRAILER_V3 = 1;              //  ƮϷ ũ: 1 byte
-const int FRAME_OVERHEAD_V3 = FRAME_HEADER_V3 + FRAME_TRAILER_V3;  //  : 10 bytes
-
-// ACK  : [SOF_ACK(1)][ACK(3)][BaseFrameNum(4)][Bitmap(4)][EOF(1)] = 13 bytes
-// BaseFrameNum: Ʈ   ȣ
-// Bitmap: 32Ʈ ִ 32  ACK  ǥ
-const int ACK_FRAME_SIZE = 13;
-
-// READY ACK  : [SOF_ACK][R][E][A][D][Y][EOF] = 7 bytes
-// Phase 3  ȯ   ȭ ȣ
-const int READY_ACK_LEN = 7;
-const char READY_ACK[] = {0x04, 'R', 'E', 'A', 'D', 'Y', 0x03};
+bool autoDebugMode = true;  // 뷮 ӿ   ڵ Ȱȭ (bench 忡  ְ   )
+std::string windowPolicyName = "legacy";  //   å (--window-policy: legacy, aimd, bdp, fixed)
+bool compressPayloads = false;           // Ŭ̾Ʈ     (--compress)
+std::string payloadName = "ramp";        // Ŭ̾Ʈ ûϴ ׽Ʈ ̷ε (--payload: ramp, telemetry, messages)
+int fecParityRequested = 0;              // Ŭ̾Ʈ ûϴ ڵ RS иƼ Ʈ (--fec, 0 = FEC )
+double repairRatio = 0.5;                //  忡     ߰     (--repair-ratio)
+bool adaptiveFrameSize = false;          // Ŭ̾Ʈ   ũ⸦   (--adaptive-size)
+bool compactHeaderRequested = false;     // Ŭ̾Ʈ       (--compact-header)
+int controlRate = 0;                     // Ŭ̾Ʈ ûϴ  ä  ޽ ӵ (--control-rate, msg/s, 0 = ȭ  )
+std::string muxScheduleName = "strict";  // ۽  ä  (--mux: strict, wfq, fifo)
+int muxWeight = 4;                       //   ٿ ޽ ä ġ (--mux-weight, 뷮  = 1)
+int phaseDurationSeconds = 0;            // Ŭ̾Ʈ  ܰ躰  ð (--duration, , 0 = <num>  )
+int reportIntervalSeconds = 10;          // Ʈ    ֱ (--interval, )
+bool daemonMode = false;                 //  Ǹ  ʰ  Ŭ̾Ʈ ٸ  (--daemon)
+int daemonSessionLimit = 0;              //   ó   (--sessions, 0 =  )
 
 // ==========================================================
-//  ü 
+// ǽð   ޸ Խ (--stats-shm <name>)
 // ==========================================================
+//  Խ 尡 liveCounters 10Hz seqlock ȣ ü 
+// ܺ ʹ OpenFileMapping  νϽ ÿ  
+
+//  ޸ ̾ƿ ( 1,  ʵ little-endian, 8Ʈ )
+// б  (seqlock): sequence б  Ȧ̸ õ  ʵ   sequence Ȯ  ٸ õ
+const uint32_t LIVE_STATS_MAGIC = 0x534C4353;  // "SCLS"
+const uint32_t LIVE_STATS_VERSION = 1;
+const int LIVE_STATS_INTERVAL_MS = 100;        // Խ ֱ (10Hz)
+
+struct LiveStatsShm {
+    uint32_t magic;                // LIVE_STATS_MAGIC
+    uint32_t version;              // LIVE_STATS_VERSION
+    volatile uint32_t sequence;    // seqlock  ( ߿ Ȧ)
+    uint32_t processId;            // Խ μ ID
+    uint32_t phase;                // LivePhase
+    int32_t windowSize;            //  ۽  ũ
+    int64_t bytesSent;
+    int64_t bytesReceived;
+    int64_t framesSent;
+    int64_t framesAcked;
+    int64_t framesReceived;
+    int64_t retransmits;
+    int64_t errors;
+    double rttMs;                  // Ȱ RTT (ms)
+    uint64_t uptimeMs;             // Խ    ð (ms)
+    uint64_t publishCount;         // Խ Ƚ
+};
 
-// V4    ü
-//  ȣ,  ũ, üũ, ̷ε带 ϴ  
-struct DataFrame {
-    int frameNum;           //   ȣ (0 )
-    uint16_t windowSize;    //  ̵  ũ
-    uint16_t checksum;      // ̷ε  üũ (XOR Rotate )
-    std::vector<char> payload;  //   
-    
-    DataFrame() : frameNum(0), windowSize(0), checksum(0) {}
-    
-    // üũ  (XOR Rotate üũ)
-    // ̷ε  Ʈ XOR ϰ Ʈ ȸ Ͽ üũ 
-    uint16_t calculateChecksum() const {
-        uint16_t sum = 0;
-        for (size_t i = 0; i < payload.size(); ++i) {
-            sum ^= static_cast<uint8_t>(payload[i]);
-            sum = (sum << 1) | (sum >> 15);  // Rotate left (Ʈ  ȸ)
+class LiveStatsPublisher {
+public:
+    LiveStatsPublisher() : mapping_(NULL), shm_(nullptr), stopped_(false) {}
+    ~LiveStatsPublisher() { stop(); }
+
+    // ̸ ִ  ޸   Խ  
+    bool start(const std::string& name) {
+        mapping_ = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                      0, sizeof(LiveStatsShm), name.c_str());
+        if (mapping_ == NULL) {
+            logMessage("Error: Failed to create shared memory '" + name + "'. Error code: " + std::to_string(GetLastError()));
+            return false;
+        }
+        shm_ = static_cast<LiveStatsShm*>(MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(LiveStatsShm)));
+        if (shm_ == nullptr) {
+            logMessage("Error: Failed to map shared memory '" + name + "'. Error code: " + std::to_string(GetLastError()));
+            CloseHandle(mapping_);
+            mapping_ = NULL;
+            return false;
         }
-        return sum;
-    }
-    
-    //   Ʈ 迭 ȭ
-    // : [SOF(1)][FrameNum(4)][WindowSize(2)][Checksum(2)][Payload][EOF(1)]
-    void serialize(std::vector<char>& buffer) const {
-        buffer.clear();
-        buffer.reserve(FRAME_OVERHEAD_V3 + payload.size());
-        
-        buffer.push_back(SOF);
-        buffer.insert(buffer.end(), reinterpret_cast<const char*>(&frameNum), 
-                     reinterpret_cast<const char*>(&frameNum) + sizeof(int));
-        buffer.insert(buffer.end(), reinterpret_cast<const char*>(&windowSize), 
-                     reinterpret_cast<const char*>(&windowSize) + sizeof(uint16_t));
-        buffer.insert(buffer.end(), reinterpret_cast<const char*>(&checksum), 
-                     reinterpret_cast<const char*>(&checksum) + sizeof(uint16_t));
-        buffer.insert(buffer.end(), payload.begin(), payload.end());
-        buffer.push_back(EOF_BYTE);
-    }
-    
-    // Ʈ 迭κ   ȭ
-    // SOF/EOF    ʵ 
-    bool deserialize(const char* buffer, int length) {
-        if (length < FRAME_OVERHEAD_V3) return false;
-        if (buffer[0] != SOF || buffer[length - 1] != EOF_BYTE) return false;
-        
-        memcpy(&frameNum, buffer + 1, sizeof(int));
-        memcpy(&windowSize, buffer + 5, sizeof(uint16_t));
-        memcpy(&checksum, buffer + 7, sizeof(uint16_t));
-        
-        int payloadSize = length - FRAME_OVERHEAD_V3;
-        payload.resize(payloadSize);
-        memcpy(payload.data(), buffer + 9, payloadSize);
-        
-        return true;
-    }
-    
-    // üũ 
-    //  üũ  üũ Ͽ  Ἲ Ȯ
-    bool verifyChecksum() const {
-        return checksum == calculateChecksum();
-    }
-};
 
-// ACK  ü
-// Ʈ  ִ 32  ACK ¸   
-struct AckFrame {
-    int baseFrameNum;    // Ʈ  Ǵ  ȣ
-    uint32_t bitmap;     // 32Ʈ ִ 32  ACK ¸ Ʈ ǥ
-    
-    AckFrame() : baseFrameNum(0), bitmap(0) {}
-    
-    // ACK  Ʈ 迭 ȭ
-    // : [SOF_ACK(1)][ACK(3)][BaseFrameNum(4)][Bitmap(4)][EOF(1)]
-    void serialize(std::vector<char>& buffer) const {
-        buffer.clear();
-        buffer.resize(ACK_FRAME_SIZE);
-        
-        buffer[0] = SOF_ACK;
-        buffer[1] = 'A';
-        buffer[2] = 'C';
-        buffer[3] = 'K';
-        memcpy(buffer.data() + 4, &baseFrameNum, sizeof(int));
-        memcpy(buffer.data() + 8, &bitmap, sizeof(uint32_t));
-        buffer[12] = EOF_BYTE;
-    }
-    
-    // Ʈ 迭κ ACK  ȭ
-    // SOF_ACK/EOF  "ACK" ڿ   ʵ 
-    bool deserialize(const char* buffer, int length) {
-        if (length != ACK_FRAME_SIZE) return false;
-        if (buffer[0] != SOF_ACK || buffer[12] != EOF_BYTE) return false;
-        if (buffer[1] != 'A' || buffer[2] != 'C' || buffer[3] != 'K') return false;
-        
-        memcpy(&baseFrameNum, buffer + 4, sizeof(int));
-        memcpy(&bitmap, buffer + 8, sizeof(uint32_t));
-        
+        memset(shm_, 0, sizeof(LiveStatsShm));
+        shm_->magic = LIVE_STATS_MAGIC;
+        shm_->version = LIVE_STATS_VERSION;
+        shm_->processId = GetCurrentProcessId();
+        startTime_ = std::chrono::steady_clock::now();
+        stopped_ = false;
+        thread_ = std::thread(&LiveStatsPublisher::run, this);
+        logMessage("Live statistics published to shared memory '" + name + "' every " +
+                   std::to_string(LIVE_STATS_INTERVAL_MS) + " ms.");
         return true;
     }
-    
-    // Ư  ȣ ACKǾ Ȯ
-    // baseFrameNum  offset Ͽ Ʈʿ ش Ʈ Ȯ
-    bool isAcked(int frameNum) const {
-        int offset = frameNum - baseFrameNum;
-        if (offset < 0 || offset >= 32) return false;
-        return (bitmap & (1u << offset)) != 0;
-    }
-    
-    // Ư  ȣ  ACK 
-    // baseFrameNum  offset Ͽ Ʈ ش Ʈ 1 
-    void setAck(int frameNum) {
-        int offset = frameNum - baseFrameNum;
-        if (offset >= 0 && offset < 32) {
-            bitmap |= (1u << offset);
+
+    // Խ   (     Խ  )
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_ = true;
+        }
+        cv_.notify_all();
+        if (thread_.joinable()) thread_.join();
+        if (shm_ != nullptr) {
+            UnmapViewOfFile(shm_);
+            shm_ = nullptr;
+        }
+        if (mapping_ != NULL) {
+            CloseHandle(mapping_);
+            mapping_ = NULL;
         }
     }
-};
 
-// NAK  ü (ACK  ,   )
-// ACK  Ʈ  Ͽ NAK ¸ ǥ
-struct NakFrame {
-    int baseFrameNum;    // Ʈ   ȣ
-    uint32_t bitmap;     // 32Ʈ Ʈ (NAK  ǥ)
-    
-    NakFrame() : baseFrameNum(0), bitmap(0) {}
-    
-    // NAK  Ʈ 迭 ȭ
-    // : [SOF_ACK(1)][NAK(3)][BaseFrameNum(4)][Bitmap(4)][EOF(1)]
-    void serialize(std::vector<char>& buffer) const {
-        buffer.clear();
-        buffer.resize(ACK_FRAME_SIZE);
-        
-        buffer[0] = SOF_ACK;
-        buffer[1] = 'N';
-        buffer[2] = 'A';
-        buffer[3] = 'K';
-        memcpy(buffer.data() + 4, &baseFrameNum, sizeof(int));
-        memcpy(buffer.data() + 8, &bitmap, sizeof(uint32_t));
-        buffer[12] = EOF_BYTE;
-    }
-    
-    // Ʈ 迭κ NAK  ȭ
-    bool deserialize(const char* buffer, int length) {
-        if (length != ACK_FRAME_SIZE) return false;
-        if (buffer[0] != SOF_ACK || buffer[12] != EOF_BYTE) return false;
-        if (buffer[1] != 'N' || buffer[2] != 'A' || buffer[3] != 'K') return false;
-        
-        memcpy(&baseFrameNum, buffer + 4, sizeof(int));
-        memcpy(&bitmap, buffer + 8, sizeof(uint32_t));
-        
-        return true;
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            publish();
+            if (stopped_) break;
+            cv_.wait_for(lock, std::chrono::milliseconds(LIVE_STATS_INTERVAL_MS));
+        }
     }
-};
 
-// Ŭ̾Ʈ   ü
-// Phase 1 Ŭ̾Ʈ  ϴ   
-struct Settings {
-    int protocolVersion;  //   ( 4)
-    int datasize;          // Ӵ ̷ε ũ (bytes)
-    int num;               //    
-    int reserved;          //  ʵ (Ȯ)
-};
-
-//   ü
-// Phase 3 Ŭ̾Ʈ   ȯϴ   
-struct Results {
-    long long totalReceivedBytes;  //   Ʈ 
-    int receivedNum;               //   
-    int errorCount;                 //  ߻ Ƚ
-    int retransmitCount;            //  Ƚ
-    double elapsedSeconds;          //  ð ()
-    double throughputMBps;         // ó (MB/s)
-    double charactersPerSecond;    // ʴ   (CPS)
+    void publish() {
+        const LiveCounters& c = liveCounters;
+        shm_->sequence = shm_->sequence + 1;  // Ȧ:  
+        std::atomic_thread_fence(std::memory_order_release);
+        shm_->phase = static_cast<uint32_t>(c.phase.load(std::memory_order_relaxed));
+        shm_->windowSize = c.windowSize.load(std::memory_order_relaxed);
+        shm_->bytesSent = c.bytesSent.load(std::memory_order_relaxed);
+        shm_->bytesReceived = c.bytesReceived.load(std::memory_order_relaxed);
+        shm_->framesSent = c.framesSent.load(std::memory_order_relaxed);
+        shm_->framesAcked = c.framesAcked.load(std::memory_order_relaxed);
+        shm_->framesReceived = c.framesReceived.load(std::memory_order_relaxed);
+        shm_->retransmits = c.retransmits.load(std::memory_order_relaxed);
+        shm_->errors = c.errors.load(std::memory_order_relaxed);
+        shm_->rttMs = c.srttUs.load(std::memory_order_relaxed) / 1000.0;
+        shm_->uptimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime_).count();
+        shm_->publishCount = shm_->publishCount + 1;
+        std::atomic_thread_fence(std::memory_order_release);
+        shm_->sequence = shm_->sequence + 1;  // ¦:  Ϸ
+    }
+
+    HANDLE mapping_;
+    LiveStatsShm* shm_;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopped_;
+    std::chrono::steady_clock::time_point startTime_;
 };
 
 // ==========================================================
-// SerialPort Ŭ (Overlapped I/O  񵿱 ø )
+// Prometheus Ʈ Ʈ (--metrics-port <port>)
 // ==========================================================
-// Windows API Overlapped I/O Ͽ 񵿱 ø  
-// б/ ۾ ÿ   ,  ۾  ؽ ȣ
-class SerialPort {
+// MetricsHttp.h (127.0.0.1 ) GET /metrics û ؽƮ  (0.0.4) 
+//  liveCounters(relaxed  ī) Ƿ ۼ ο ߰  
+class MetricsEndpoint {
 public:
-    // :  ڵ ʱȭϰ OVERLAPPED ü 0 ʱȭ
-    SerialPort() : hComm(INVALID_HANDLE_VALUE), readEvent(NULL), writeEvent(NULL), baudRate(0) {
-        ZeroMemory(&readOverlapped, sizeof(OVERLAPPED));
-        ZeroMemory(&writeOverlapped, sizeof(OVERLAPPED));
-    }
-    
-    // Ҹ:   ڵ ϰ 
-    ~SerialPort() {
-        if (readEvent) CloseHandle(readEvent);
-        if (writeEvent) CloseHandle(writeEvent);
-        if (hComm != INVALID_HANDLE_VALUE) {
-            CloseHandle(hComm);
-        }
-    }
-    
-    // ø Ʈ   ʱȭ
-    // Overlapped I/O  Ʈ ,  Ķ ,  ũ 
-    bool open(const std::string& comport, int baudrate) {
-        std::string portName = "\\\\.\\" + comport;  // Windows COM10 ̻  ʿ
-        
-        // Overlapped I/O  ø Ʈ 
-        hComm = CreateFileA(portName.c_str(),
-                            GENERIC_READ | GENERIC_WRITE,
-                            0,
-                            NULL,
-                            OPEN_EXISTING,
-                            FILE_FLAG_OVERLAPPED,  // 񵿱 I/O 
-                            NULL);
-
-        if (hComm == INVALID_HANDLE_VALUE) {
-            logMessage("Error: Unable to open " + comport);
-            return false;
-        }
-
-        // б/ ۾ ϷḦ ˸ ̺Ʈ ü 
-        readEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
-        writeEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
-        
-        if (!readEvent || !writeEvent) {
-            logMessage("Error: Failed to create event objects");
-            CloseHandle(hComm);
-            hComm = INVALID_HANDLE_VALUE;
-            return false;
-        }
-
-        // OVERLAPPED ü ̺Ʈ ڵ 
-        readOverlapped.hEvent = readEvent;
-        writeOverlapped.hEvent = writeEvent;
+    MetricsEndpoint() : winsockStarted_(false) {}
+    ~MetricsEndpoint() { stop(); }
 
-        // DCB ü ʱȭ   Ʈ  б
-        DCB dcbSerialParams = { 0 };
-        dcbSerialParams.DCBlength = sizeof(dcbSerialParams);
+    bool start(int port, const std::string& role, const std::string& comport) {
+        labels_ = "role=\"" + role + "\",port=\"" + comport + "\"";
+        startTime_ = std::chrono::steady_clock::now();
 
-        if (!GetCommState(hComm, &dcbSerialParams)) {
-            logMessage("Error getting device state");
-            CloseHandle(hComm);
-            hComm = INVALID_HANDLE_VALUE;
+        WSADATA wsaData;
+        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+            logMessage("Error: WSAStartup failed for metrics endpoint.");
             return false;
         }
+        winsockStarted_ = true;
 
-        //  Ķ 
-        dcbSerialParams.BaudRate = baudrate;
-        dcbSerialParams.ByteSize = 8;           // 8Ʈ 
-        dcbSerialParams.StopBits = ONESTOPBIT; // 1  Ʈ
-        dcbSerialParams.Parity = NOPARITY;      // иƼ 
-        
-        // ܺ   ÷ο Ʈ Ȱȭ
-        // DTR/RTS Ȱȭϵ, CTS/DSR/XON/XOFF ÷ο Ʈ Ȱȭ
-        dcbSerialParams.fOutxCtsFlow = FALSE;   // CTS ÷ο Ʈ Ȱȭ
-        dcbSerialParams.fOutxDsrFlow = FALSE;   // DSR ÷ο Ʈ Ȱȭ
-        dcbSerialParams.fDtrControl = DTR_CONTROL_ENABLE;  // DTR Ȱȭ
-        dcbSerialParams.fRtsControl = RTS_CONTROL_ENABLE;  // RTS Ȱȭ
-        dcbSerialParams.fOutX = FALSE;          // XON/XOFF ۽ ÷ο Ʈ Ȱȭ
-        dcbSerialParams.fInX = FALSE;           // XON/XOFF  ÷ο Ʈ Ȱȭ
-
-        if (!SetCommState(hComm, &dcbSerialParams)) {
-            logMessage("Error setting device state");
-            CloseHandle(hComm);
-            hComm = INVALID_HANDLE_VALUE;
-            return false;
-        }
-
-        // ŸӾƿ : Overlapped I/O 0 Ͽ 񵿱 
-        COMMTIMEOUTS timeouts = { 0 };
-        timeouts.ReadIntervalTimeout = 0;
-        timeouts.ReadTotalTimeoutConstant = 0;
-        timeouts.ReadTotalTimeoutMultiplier = 0;
-        timeouts.WriteTotalTimeoutConstant = 0;
-        timeouts.WriteTotalTimeoutMultiplier = 0;
-
-        if (!SetCommTimeouts(hComm, &timeouts)) {
-            logMessage("Error setting timeouts");
-            CloseHandle(hComm);
-            hComm = INVALID_HANDLE_VALUE;
+        std::string error;
+        if (!listener_.start(port, [this]() { return render(); }, error)) {
+            logMessage("Error: Metrics endpoint " + error);
             return false;
         }
-
-        //     ũ⸦ 128KB 1MB 
-        if (!SetupComm(hComm, 1048576, 1048576)) {
-            logMessage("Warning: Failed to set buffer size to 1MB");
-        }
-
-        baudRate = baudrate;
-        
-        // Ʈ      
-        DWORD flags = PURGE_RXCLEAR | PURGE_TXCLEAR | PURGE_RXABORT | PURGE_TXABORT;
-        if (!PurgeComm(hComm, flags)) {
-            logMessage("Warning: Failed to purge buffers on open");
-        } else {
-            logMessage("Port buffers purged on open.");
-        }
-
+        logMessage("Prometheus metrics available at http://127.0.0.1:" + std::to_string(port) + "/metrics");
         return true;
     }
-    
-    //   (񵿱 Overlapped I/O)
-    //  ۾ writeMutex ȣǾ ÿ ϳ  ۾  
-    int write(const char* buffer, int length) {
-        std::lock_guard<std::mutex> lock(writeMutex);
-        
-        if (hComm == INVALID_HANDLE_VALUE) return -1;
 
-        DWORD bytesWritten = 0;
-        
-        // OVERLAPPED ü ʱȭ  ̺Ʈ 
-        ZeroMemory(&writeOverlapped, sizeof(OVERLAPPED));
-        writeOverlapped.hEvent = writeEvent;
-        ResetEvent(writeOverlapped.hEvent);
-        
-        // 񵿱  ۾ 
-        BOOL result = WriteFile(hComm, buffer, length, &bytesWritten, &writeOverlapped);
-        
-        if (!result) {
-            DWORD error = GetLastError();
-            if (error == ERROR_IO_PENDING) {
-                // 񵿱 ۾  ̹Ƿ Ϸ 
-                DWORD timeout = calculateTimeout(length);
-                DWORD waitResult = WaitForSingleObject(writeOverlapped.hEvent, timeout);
-                
-                if (waitResult == WAIT_OBJECT_0) {
-                    //  ۾ Ϸ,  Ȯ
-                    if (GetOverlappedResult(hComm, &writeOverlapped, &bytesWritten, FALSE)) {
-                        return bytesWritten;
-                    }
-                } else if (waitResult == WAIT_TIMEOUT) {
-                    // ŸӾƿ ߻, ۾ 
-                    logMessage("Error: Write timeout (" + std::to_string(timeout) + "ms)");
-                    CancelIo(hComm);
-                    return -1;
-                }
-            }
-            logMessage("Error writing to serial port: " + std::to_string(error));
-            return -1;
-        }
-        
-        //   Ϸ 
-        return bytesWritten;
-    }
-    
-    //  б (񵿱 Overlapped I/O)
-    // б ۾ readMutex ȣǾ ÿ ϳ б ۾  
-    // û ̸ŭ аų ŸӾƿ ߻  ݺ б 
-    int read(char* buffer, int length, DWORD timeoutMs = 0) {
-        std::lock_guard<std::mutex> lock(readMutex);
-        
-        if (hComm == INVALID_HANDLE_VALUE) return -1;
-
-        DWORD totalBytesRead = 0;
-        
-        // ŸӾƿ     ũ  ڵ 
-        if (timeoutMs == 0) {
-            timeoutMs = calculateTimeout(length);
-        }
-        
-        // û ̸ŭ   ݺ
-        while (totalBytesRead < length) {
-            DWORD bytesReadInThisCall = 0;
-            
-            // OVERLAPPED ü ʱȭ  ̺Ʈ 
-            ZeroMemory(&readOverlapped, sizeof(OVERLAPPED));
-            readOverlapped.hEvent = readEvent;
-            ResetEvent(readOverlapped.hEvent);
-            
-            // 񵿱 б ۾  ( ̸ŭ б)
-            BOOL result = ReadFile(hComm, 
-                                  buffer + totalBytesRead, 
-                                  length - totalBytesRead, 
-                                  &bytesReadInThisCall, 
-                                  &readOverlapped);
-            
-            if (!result) {
-                DWORD error = GetLastError();
-                if (error == ERROR_IO_PENDING) {
-                    // 񵿱 ۾  ̹Ƿ Ϸ 
-                    DWORD waitResult = WaitForSingleObject(readOverlapped.hEvent, timeoutMs);
-                    
-                    if (waitResult == WAIT_OBJECT_0) {
-                        // б ۾ Ϸ,  Ȯ
-                        if (GetOverlappedResult(hComm, &readOverlapped, &bytesReadInThisCall, FALSE)) {
-                            if (bytesReadInThisCall > 0) {
-                                totalBytesRead += bytesReadInThisCall;
-                            } else {
-                                //  ̻  Ͱ 
-                                break;
-                            }
-                        } else {
-                            return -1;
-                        }
-                    } else if (waitResult == WAIT_TIMEOUT) {
-                        // ŸӾƿ ߻
-                        if (totalBytesRead > 0) {
-                            // Ϻζ о ȯ
-                            break;
-                        }
-                        // ƹ͵   ۾ ϰ  ȯ
-                        CancelIo(hComm);
-                        return -1;
-                    }
-                } else {
-                    return -1;
-                }
-            } else {
-                //   Ϸ 
-                if (bytesReadInThisCall > 0) {
-                    totalBytesRead += bytesReadInThisCall;
-                } else {
-                    //  ̻  Ͱ 
-                    break;
-                }
-            }
+    void stop() {
+        listener_.stop();
+        if (winsockStarted_) {
+            WSACleanup();
+            winsockStarted_ = false;
         }
-        
-        return totalBytesRead;
-    }
-    
-    //   ÷
-    // ø Ʈ  ۿ ִ  ͸  
-    // Phase 3  ȯ  ȭ  
-    bool flush() {
-        std::lock_guard<std::mutex> lock(writeMutex);
-        if (hComm == INVALID_HANDLE_VALUE) return false;
-        return FlushFileBuffers(hComm) != 0;
     }
-    
-    //   Ʈ ȯ
-    int getBaudRate() const { return baudRate; }
 
 private:
-    HANDLE hComm;                    // ø Ʈ ڵ
-    OVERLAPPED readOverlapped;       // б ۾ OVERLAPPED ü
-    OVERLAPPED writeOverlapped;      //  ۾ OVERLAPPED ü
-    HANDLE readEvent;                // б ۾ Ϸ ̺Ʈ
-    HANDLE writeEvent;               //  ۾ Ϸ ̺Ʈ
-    std::mutex readMutex;            // б ۾ ȭ ؽ
-    std::mutex writeMutex;            //  ۾ ȭ ؽ
-    int baudRate;                    //  Ʈ 
-    
-    //  ũ  ŸӾƿ 
-    //  ð 2.5 + ⺻ ŸӾƿ(500ms) Ͽ  ŸӾƿ  
-    // ּ 200ms, ִ 60ʷ 
-    DWORD calculateTimeout(int dataSize) const {
-        if (baudRate == 0) return 5000;
-        
-        //  ð : ( ũ * 10Ʈ/Ʈ) / Ʈ * 1000ms *  
-        // 10Ʈ = 8Ʈ  + 1 ŸƮ Ʈ + 1  Ʈ
-        double transmitTime = (static_cast<double>(dataSize) * 10.0 / baudRate) * 1000.0 * TIMEOUT_SAFETY_FACTOR;
-        DWORD timeout = static_cast<DWORD>(transmitTime) + BASE_TIMEOUT_MS;
-        
-        if (timeout < 200) timeout = 200;    // ּ ŸӾƿ: 200ms
-        // 뷮     ŸӾƿ  (ִ 60)
-        if (timeout > 60000) timeout = 60000;  // ִ ŸӾƿ: 60 (ſ ū Ϳ)
-        
-        return timeout;
-    }
+    void appendMetric(std::ostringstream& out, const char* name, const char* type,
+                      const char* help, double value) const {
+        metricshttp::appendMetric(out, name, type, help, value, labels_);
+    }
+
+    std::string render() const {
+        const LiveCounters& c = liveCounters;
+        const auto relaxed = std::memory_order_relaxed;
+        std::ostringstream out;
+        appendMetric(out, "serialcomm_bytes_sent_total", "counter",
+                     "Bytes written to the serial port (data and ACK frames, including retransmissions).",
+                     static_cast<double>(c.bytesSent.load(relaxed)));
+        appendMetric(out, "serialcomm_bytes_received_total", "counter",
+                     "Bytes of validated data frames received.", static_cast<double>(c.bytesReceived.load(relaxed)));
+        appendMetric(out, "serialcomm_frames_sent_total", "counter",
+                     "Data frames written, including retransmissions.", static_cast<double>(c.framesSent.load(relaxed)));
+        appendMetric(out, "serialcomm_frames_acked_total", "counter",
+                     "Data frames acknowledged by the peer.", static_cast<double>(c.framesAcked.load(relaxed)));
+        appendMetric(out, "serialcomm_frames_received_total", "counter",
+                     "Data frames received and validated.", static_cast<double>(c.framesReceived.load(relaxed)));
+        appendMetric(out, "serialcomm_retransmits_total", "counter",
+                     "Data frames retransmitted.", static_cast<double>(c.retransmits.load(relaxed)));
+        appendMetric(out, "serialcomm_errors_total", "counter",
+                     "Receive errors (checksum, payload and frame errors).", static_cast<double>(c.errors.load(relaxed)));
+        appendMetric(out, "serialcomm_window_size", "gauge",
+                     "Current sliding window size in frames.", c.windowSize.load(relaxed));
+        appendMetric(out, "serialcomm_rtt_seconds", "gauge",
+                     "Smoothed time from first transmission to ACK.", c.srttUs.load(relaxed) / 1e6);
+        appendMetric(out, "serialcomm_phase", "gauge",
+                     "Current phase (0=idle, 1=settings, 2=phase1, 3=phase2, 4=results, 5=done).", c.phase.load(relaxed));
+        appendMetric(out, "serialcomm_uptime_seconds", "gauge", "Seconds since the metrics endpoint started.",
+                     std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime_).count());
+        return out.str();
+    }
+
+    metricshttp::Listener listener_;
+    bool winsockStarted_;
+    std::string labels_;
+    std::chrono::steady_clock::time_point startTime_;
 };
 
-// ==========================================================
-// WindowManager Ŭ: ̵  ˰    ũ 
-// ==========================================================
-// Selective Repeat ARQ  ̵ 츦 ϴ Ŭ
-// Thread-safe  Ƽ ȯ濡 ϰ  
-class WindowManager {
+//   ޽ ä (ȭ ): äθ   ϰ, ä   ä ACK ٷ 
+// ä ACK  ACK ũ⸦ Ƿ ũ  ǿ CreditLimit ڸ  (۽  ä ACK ũ )
+class ChannelReceiver {
 public:
-    // : ʱ  ũ ̽  ȣ ʱȭ
-    WindowManager(int totalFrames) 
-        : baseSeq(0),                    //    ȣ
-          windowSize(WINDOW_SIZE_INIT),  // ʱ  ũ (16 )
-          totalFrames(totalFrames),       // ü  
-          consecutiveSuccesses(0),       //   Ƚ ( Ȯ)
-          consecutiveFailures(0) {        //   Ƚ ( ҿ)
+    // pattern:  ޽  (۽  setControlTraffic   )
+    ChannelReceiver(int channels, bool sack, int fecParity, bool credits, bool ackCrc, PayloadPattern pattern)
+        : pattern_(pattern) {
+        for (int c = 1; c < channels; ++c) {
+            windows_.push_back(ReceiveWindow(sack, fecParity, credits, c, ackCrc));
+        }
     }
     
-    //   ̽  ȣ ȯ
-    int getBase() const {
-        std::lock_guard<std::mutex> lock(windowMutex);
-        return baseSeq;
+    //   FrameNum  : Flags(buffer[1]) äο شϴ    ġ
+    uint32_t reference(const char* buffer, const ReceiveWindow& bulk) const {
+        size_t channel = static_cast<size_t>(frameChannel(static_cast<uint8_t>(buffer[1])));
+        const ReceiveWindow& window = channel >= 1 && channel <= windows_.size() ? windows_[channel - 1] : bulk;
+        return static_cast<uint32_t>(window.nextExpected());
     }
     
-    //   ũ ȯ
-    int getWindowSize() const {
-        std::lock_guard<std::mutex> lock(windowMutex);
-        return windowSize;
+    //  ȣ ش ä(0̸ 뷮  Ʈ bulk)     (ReceiveWindow::plausible)
+    bool plausible(const DataFrame& frame, const ReceiveWindow& bulk) const {
+        return (frame.channel() == 0 ? bulk : windows_[frame.channel() - 1]).plausible(frame.frameNum);
     }
     
-    // Ư  ȣ     ִ Ȯ
-    bool isInWindow(int frameNum) const {
-        std::lock_guard<std::mutex> lock(windowMutex);
-        return (frameNum >= baseSeq && frameNum < baseSeq + windowSize);
+    // ä  ϳ ó (üũ  , frame.channel() 1..channels-1): ä ACK   ó  ޽ 
+    void receive(SerialPort& serial, const DataFrame& frame, std::vector<char>& ackBuffer, Results& results) {
+        ReceiveWindow& window = windows_[frame.channel() - 1];
+        long long seq = window.unwrap(frame.frameNum);
+        bool isNew = window.acknowledge(seq, ackBuffer);
+        if (serial.write(ackBuffer.data(), ackBuffer.size()) == static_cast<int>(ackBuffer.size())) {
+            LiveCounters::add(liveCounters.bytesSent, ackBuffer.size());
+        }
+        if (!isNew) return;
+        if (validatePayload(frame.payload, pattern_)) {
+            results.channelMessagesReceived++;
+        } else {
+            results.errorCount++;
+            results.payloadErrors++;
+            LiveCounters::add(liveCounters.errors, 1);
+            logMessage("Channel " + std::to_string(frame.channel()) + " message " + std::to_string(seq) +
+                       " payload validation failed");
+        }
     }
-    
-    // Ư  ȣ  ACK · ǥ
-    void markAcked(int frameNum) {
-        std::lock_guard<std::mutex> lock(windowMutex);
-        ackedFrames[frameNum] = true;
+
+private:
+    std::vector<ReceiveWindow> windows_;  // windows_[c - 1] = ä c
+    PayloadPattern pattern_;
+};
+
+// ۽   ä:  , ACK  , ۽ ȸ 
+// ȸ  8N1  Ʈ 10Ʈ 
+void fillTransmissionStats(Results& results, const TransmissionManager& tm, int baudrate, double txSeconds) {
+    const LatencyHistogram& latency = tm.ackLatency();
+    results.ackLatencySamples = latency.count();
+    results.ackLatencyP50Ms = latency.percentileMs(0.50);
+    results.ackLatencyP90Ms = latency.percentileMs(0.90);
+    results.ackLatencyP99Ms = latency.percentileMs(0.99);
+    results.ackLatencyMaxMs = latency.maxMs();
+    results.retransmitByReason[RETX_WRITE_ERROR] = results.retransmitCount;
+    results.retransmitByReason[RETX_UNACKED] = tm.resentFrames();
+    if (txSeconds > 0 && baudrate > 0) {
+        results.txLineUtilization = (tm.bytesWritten() * 10.0) / (baudrate * txSeconds);
+    }
+    
+    // ޽ ä (ȭ  ۽ )
+    const LatencyHistogram channelLatency = tm.channelLatency();
+    results.channelMessagesSent = tm.channelMessagesSent();
+    results.channelRetransmits = tm.channelResentFrames();
+    results.channelUnacked = tm.channelUnacked();
+    results.channelLatencyP50Ms = channelLatency.percentileMs(0.50);
+    results.channelLatencyP99Ms = channelLatency.percentileMs(0.99);
+    results.channelLatencyMaxMs = channelLatency.maxMs();
+    if (tm.channelRejected() > 0) {
+        logMessage("Warning: " + std::to_string(tm.channelRejected()) + " channel messages rejected (queue full).");
     }
-    
-    // Ư  ȣ ACKǾ Ȯ
-    bool isAcked(int frameNum) const {
-        std::lock_guard<std::mutex> lock(windowMutex);
-        auto it = ackedFrames.find(frameNum);
-        return (it != ackedFrames.end() && it->second);
+}
+
+// ǵ ACK İ ׿  ִ  
+void logAckFormat(bool sackAcks, int maxWindow) {
+    if (sackAcks) {
+        logMessage("ACK format: SACK (" + std::to_string(SACK_BITMAP_BITS) + "-bit bitmap), max window " +
+                   std::to_string(maxWindow));
+    } else {
+        logMessage("ACK format: 32-bit bitmap (peer did not negotiate SACK), max window " + std::to_string(maxWindow));
     }
-    
-    //  ̵: ӵ ACK Ӹŭ 츦  ̵
-    // ȯ: ̵  
-    int slideWindow() {
-        std::lock_guard<std::mutex> lock(windowMutex);
-        int slidCount = 0;
-        
-        // ̽   ACK Ӹŭ  ̵
-        while (baseSeq < totalFrames && ackedFrames[baseSeq]) {
-            ackedFrames.erase(baseSeq);
-            baseSeq++;
-            slidCount++;
-        }
-        
-        return slidCount;
+}
+
+// ǵ      (compactSequence:   FrameNum Ʈ , 0 =  )
+void logFrameHeaderMode(int compactSequence) {
+    if (compactSequence == 0) {
+        logMessage("Frame header: fixed (" + std::to_string(FRAME_OVERHEAD_V3) + " bytes per frame)");
+    } else {
+        logMessage("Frame header: compact, " + std::to_string(compactSequence * 8) + "-bit frame numbers (" +
+                   std::to_string(FRAME_OVERHEAD_COMPACT + compactSequence - 1) + " bytes per fixed-size frame)");
     }
-    
-    //    Ϸ  Ȯ (̽  ü   ʰ)
-    bool isComplete() const {
-        std::lock_guard<std::mutex> lock(windowMutex);
-        return baseSeq >= totalFrames;
+}
+
+// ǵ ȭ   (ȭ ʴ   )
+void logMuxMode(int channels, int controlRate, MuxSchedule schedule) {
+    if (channels <= 1) return;
+    logMessage("Multiplexing: " + std::to_string(channels - 1) + " message channel(s), schedule " + muxScheduleName +
+               (schedule == MUX_WFQ ? " (weight " + std::to_string(muxWeight) + ")" : std::string()) +
+               (controlRate > 0 ? ", control traffic " + std::to_string(controlRate) + " msg/s on channel 1" : std::string()));
+}
+
+// ǵ FEC   (FEC    )
+void logFecMode(int fecParity) {
+    if (fecParity == 0) return;
+    int dataPerCodeword = RS_CODEWORD_MAX - fecParity;
+    logMessage("FEC: RS(" + std::to_string(RS_CODEWORD_MAX) + "," + std::to_string(dataPerCodeword) +
+               "), corrects up to " + std::to_string(fecParity / 2) + " bytes per codeword, parity overhead " +
+               std::to_string(100.0 * fecParity / dataPerCodeword) + "%");
+}
+
+//   ũ  
+void logFrameSizeMode(const FrameSizeController& sizer) {
+    logMessage("Frame size: adaptive, starting at " + std::to_string(sizer.current()) + " bytes (range " +
+               std::to_string(sizer.minSize()) + "-" + std::to_string(sizer.maxSize()) + ")");
+}
+
+//   ũ   (  [TRACE] α׿ ϵ)
+void logFrameSizeDecisions(const FrameSizeController& sizer) {
+    int increases = 0, decreases = 0;
+    sizer.getDecisionCounts(increases, decreases);
+    logMessage("Frame size: " + std::to_string(increases) + " increases, " + std::to_string(decreases) +
+               " decreases, final " + std::to_string(sizer.current()) + " bytes");
+}
+
+//  å   (  [TRACE] α׿ ϵ)
+void logWindowDecisions(const WindowManager& windowMgr) {
+    int increases = 0, decreases = 0;
+    windowMgr.getDecisionCounts(increases, decreases);
+    logMessage(std::string("Window policy ") + windowMgr.getPolicyName() + ": " +
+               std::to_string(increases) + " increases, " + std::to_string(decreases) +
+               " decreases, final window " + std::to_string(windowMgr.getWindowSize()));
+    if (windowMgr.getCreditStalls() > 0) {
+        logMessage("Receiver credit held back new frames " + std::to_string(windowMgr.getCreditStalls()) + " times");
     }
-    
-    //   ũ 
-    // success:   
-    // rtt: Round Trip Time (պ ð, и)
-    void adjustWindow(bool success, double rtt) {
-        std::lock_guard<std::mutex> lock(windowMutex);
-        
-        if (success) {
-            consecutiveSuccesses++;
-            consecutiveFailures = 0;
-            
-            //    ũ Ȯ (  )
-            //  3ȸ    ũ⸦ 2  ( 5ȸ->3ȸ, 1.5->2 )
-            if (consecutiveSuccesses >= 3) {
-                int newSize = windowSize * 2;  //  : 1.5  2
-                if (newSize > WINDOW_SIZE_MAX) newSize = WINDOW_SIZE_MAX;
-                
-                if (newSize != windowSize) {
-                    LOG_DEBUG("Window size increased: " + std::to_string(windowSize) + 
-                             " -> " + std::to_string(newSize));
-                    windowSize = newSize;
-                }
-                consecutiveSuccesses = 0;
-            }
-            
-            // RTT   : RTT ʹ   ũ  (ȭ Ӱ谪)
-            // RTT > 2000ms: Ʈũ  ũǷ   ( 1000ms -> 2000ms ȭ)
-            if (rtt > 2000.0) {
-                int newSize = std::max(windowSize / 2, WINDOW_SIZE_MIN);
-                if (newSize != windowSize) {
-                    LOG_DEBUG("Window size decreased due to high RTT (" + 
-                             std::to_string(rtt) + "ms): " + std::to_string(windowSize) + 
-                             " -> " + std::to_string(newSize));
-                    windowSize = newSize;
-                }
-                consecutiveSuccesses = 0;
-            }
-            
-        } else {
-            //    ũ  (Multiplicative Decrease)
-            consecutiveFailures++;
-            consecutiveSuccesses = 0;
-            
-            //  3ȸ    ũ⸦   ( 2ȸ->3ȸ ȭϿ  )
-            if (consecutiveFailures >= 3) {
-                int newSize = std::max(windowSize / 2, WINDOW_SIZE_MIN);
-                if (newSize != windowSize) {
-                    LOG_DEBUG("Window size decreased due to failures: " + 
-                             std::to_string(windowSize) + " -> " + std::to_string(newSize));
-                    windowSize = newSize;
-                }
-                consecutiveFailures = 0;
-            }
+}
+
+// Ʈ  Ctrl+C ó: ù ° Ʈ  ϵ û ϰ,  ° ⺻ ó(μ ) ñ
+BOOL WINAPI streamStopHandler(DWORD ctrlType) {
+    if (ctrlType != CTRL_C_EVENT && ctrlType != CTRL_BREAK_EVENT) {
+        return FALSE;
+    }
+    return streamStopRequested.exchange(true) ? FALSE : TRUE;
+}
+
+// Ʈ   Ctrl+C ó⸦ ϰ,  Լ  
+class StreamStopScope {
+public:
+    explicit StreamStopScope(bool active) : active_(active) {
+        streamStopRequested = false;
+        if (active_) {
+            SetConsoleCtrlHandler(streamStopHandler, TRUE);
+            logMessage("Streaming session: press Ctrl+C to end the stream (a second Ctrl+C aborts).");
         }
     }
-    
-    //    ȯ (  ACK  ӵ)
-    std::vector<int> getFramesToSend() const {
-        std::lock_guard<std::mutex> lock(windowMutex);
-        std::vector<int> frames;
-        
-        //    ACK  Ӹ ߰
-        for (int i = baseSeq; i < baseSeq + windowSize && i < totalFrames; ++i) {
-            auto it = ackedFrames.find(i);
-            if (it == ackedFrames.end() || !it->second) {
-                frames.push_back(i);
-            }
+    ~StreamStopScope() {
+        if (active_) {
+            SetConsoleCtrlHandler(streamStopHandler, FALSE);
         }
-        
-        return frames;
     }
 
 private:
-    mutable std::mutex windowMutex;   //    ȭ ؽ
-    int baseSeq;                      //    ȣ
-    int windowSize;                   //   ũ ( )
-    int totalFrames;                  // ü  
-    std::map<int, bool> ackedFrames;  // Ӻ ACK  
-    int consecutiveSuccesses;         //   Ƚ ( Ȯ)
-    int consecutiveFailures;          //   Ƚ ( ҿ)
+    bool active_;
 };
 
+// Ȯ   ( Ʈ  ڿ ߰Ͽ  Ľ    )
+void logExtendedResults(const std::string& title, const Results& results) {
+    logMessage("\n" + title + " Extended Statistics:");
+    logMessage("  - Phase 1 time: " + std::to_string(results.phase1Seconds) + " seconds");
+    logMessage("  - Phase 2 time: " + std::to_string(results.phase2Seconds) + " seconds");
+    logMessage("  - ACK latency (ms): p50=" + std::to_string(results.ackLatencyP50Ms) + 
+               ", p90=" + std::to_string(results.ackLatencyP90Ms) + 
+               ", p99=" + std::to_string(results.ackLatencyP99Ms) + 
+               ", max=" + std::to_string(results.ackLatencyMaxMs) + 
+               " (" + std::to_string(results.ackLatencySamples) + " samples)");
+    logMessage("  - Retransmissions by reason: write_error=" + std::to_string(results.retransmitByReason[RETX_WRITE_ERROR]) + 
+               ", unacked=" + std::to_string(results.retransmitByReason[RETX_UNACKED]));
+    logMessage("  - Line utilization: tx=" + std::to_string(results.txLineUtilization * 100.0) + 
+               "%, rx=" + std::to_string(results.rxLineUtilization * 100.0) + "%");
+    logMessage("  - Errors by type: checksum=" + std::to_string(results.checksumErrors) + 
+               ", payload=" + std::to_string(results.payloadErrors) + 
+               ", frame=" + std::to_string(results.frameErrors));
+    logMessage("  - Payload: " + std::to_string(results.payloadBytesReceived) + " bytes, compression ratio " +
+               std::to_string(results.compressionRatio) + ", goodput " + std::to_string(results.goodputMBps) + " MB/s");
+    logMessage("  - FEC: corrected symbols=" + std::to_string(results.fecCorrectedSymbols) + 
+               ", repaired frames=" + std::to_string(results.fecRepairedFrames) + 
+               ", uncorrectable frames=" + std::to_string(results.fecUncorrectableFrames));
+    logMessage("  - Messages: " + std::to_string(results.messagesReceived) + " (" +
+               std::to_string(results.messageBytesReceived) + " bytes), " + std::to_string(results.messagesPerSecond) +
+               " msg/s, header efficiency " + std::to_string(results.headerEfficiency * 100.0) + "%");
+    logMessage("  - Message channels: sent=" + std::to_string(results.channelMessagesSent) +
+               ", received=" + std::to_string(results.channelMessagesReceived) +
+               ", retransmits=" + std::to_string(results.channelRetransmits) +
+               ", unacked=" + std::to_string(results.channelUnacked) +
+               ", latency (ms) p50=" + std::to_string(results.channelLatencyP50Ms) +
+               ", p99=" + std::to_string(results.channelLatencyP99Ms) +
+               ", max=" + std::to_string(results.channelLatencyMaxMs));
+}
+
+//  ܿ  : ̹ ,  ó,     ϱ  
+// Results ޸  ȯ ʰ  Ʈ JSON final ڵ忡 
+struct Instrumentation {
+    double settingsSeconds;         //  ȯ (Phase 0)
+    double readySyncSeconds;        // READY ȭ (Phase 3 )
+    double resultsExchangeSeconds;  // READY   ۼ
+    IoStats read;
+    IoStats write;
+    long long fixedSleeps;
+    double fixedSleepSeconds;
+    int linkReconnects;             //  Ʈ ٽ  Ƚ
+    double linkDownSeconds;         // Ʈ  ִ  ð
+
+    Instrumentation() : settingsSeconds(0), readySyncSeconds(0), resultsExchangeSeconds(0),
+                        fixedSleeps(0), fixedSleepSeconds(0), linkReconnects(0), linkDownSeconds(0) {}
+
+    void capture(SerialPort& serial) {
+        serial.getIoStats(read, write);
+        fixedSleeps = fixedSleepCount.load(std::memory_order_relaxed);
+        fixedSleepSeconds = fixedSleepMicros.load(std::memory_order_relaxed) / 1e6;
+        linkReconnects = serial.getReconnectCount();
+        linkDownSeconds = serial.getLinkDownSeconds();
+    }
+};
+
+void logIoStats(const std::string& name, const IoStats& io) {
+    logMessage("  - " + name + ": " + std::to_string(io.requests) + " requests, " +
+               std::to_string(io.calls) + " calls, " + std::to_string(io.bytes) + " bytes, partial=" +
+               std::to_string(io.partialCalls) + ", WAIT_TIMEOUT=" + std::to_string(io.waitTimeouts) +
+               ", CancelIo=" + std::to_string(io.cancelIoCalls) + ", errors=" + std::to_string(io.errors));
+    logMessage("      bytes/call p50=" + std::to_string(static_cast<long long>(io.bytesPerCall.percentile(0.50))) +
+               ", p99=" + std::to_string(static_cast<long long>(io.bytesPerCall.percentile(0.99))) +
+               ", max=" + std::to_string(io.bytesPerCall.maxValue()) +
+               "; completion (ms) p50=" + std::to_string(io.completionUs.percentileMs(0.50)) +
+               ", p99=" + std::to_string(io.completionUs.percentileMs(0.99)) +
+               ", max=" + std::to_string(io.completionUs.maxMs()) +
+               "; wait=" + std::to_string(io.waitUs / 1e6) + " s");
+}
+
+void logInstrumentation(const Results& local, const Instrumentation& inst) {
+    logMessage("\nI/O & Timing Diagnostics:");
+    logMessage("  - Phase time (s): settings=" + std::to_string(inst.settingsSeconds) +
+               ", phase1=" + std::to_string(local.phase1Seconds) +
+               ", phase2=" + std::to_string(local.phase2Seconds) +
+               ", ready_sync=" + std::to_string(inst.readySyncSeconds) +
+               ", results_exchange=" + std::to_string(inst.resultsExchangeSeconds));
+    logMessage("  - Fixed sleeps: " + std::to_string(inst.fixedSleeps) + " calls, " +
+               std::to_string(inst.fixedSleepSeconds) + " s");
+    logMessage("  - Link: " + std::to_string(inst.linkReconnects) + " reconnects, " +
+               std::to_string(inst.linkDownSeconds) + " s down");
+    logIoStats("Read", inst.read);
+    logIoStats("Write", inst.write);
+}
+
 // ==========================================================
-// ????????? ?? ????????? ?????? ????????? ???
+// JSON   (--json-out <path>)
 // ==========================================================
-template<typename T>
-class SafeQueue {
+// ʰ  Ʈ Խ Ľ ʵ  ٿ ϳ JSON ڵ(NDJSON) 
+// ڵ : "phase" (ܰ  ), "peer" ( ), "final" (׻  )
+//  ڵ ź(ø ) ü̸ Results ʵ ̸ ״ Ű 
+
+// Results  ʵ带 ڵ忡 ߰
+void addResultsFields(JsonRecord& record, const Results& results) {
+    record.add("totalReceivedBytes", results.totalReceivedBytes)
+          .add("receivedNum", results.receivedNum)
+          .add("errorCount", results.errorCount)
+          .add("checksumErrors", results.checksumErrors)
+          .add("payloadErrors", results.payloadErrors)
+          .add("frameErrors", results.frameErrors)
+          .add("retransmitCount", results.retransmitCount)
+          .add("retransmitWriteError", results.retransmitByReason[RETX_WRITE_ERROR])
+          .add("retransmitUnacked", results.retransmitByReason[RETX_UNACKED])
+          .add("elapsedSeconds", results.elapsedSeconds)
+          .add("throughputMBps", results.throughputMBps)
+          .add("charactersPerSecond", results.charactersPerSecond)
+          .add("ackLatencySamples", results.ackLatencySamples)
+          .add("ackLatencyP50Ms", results.ackLatencyP50Ms)
+          .add("ackLatencyP90Ms", results.ackLatencyP90Ms)
+          .add("ackLatencyP99Ms", results.ackLatencyP99Ms)
+          .add("ackLatencyMaxMs", results.ackLatencyMaxMs)
+          .add("phase1Seconds", results.phase1Seconds)
+          .add("phase2Seconds", results.phase2Seconds)
+          .add("txLineUtilization", results.txLineUtilization)
+          .add("rxLineUtilization", results.rxLineUtilization)
+          .add("payloadBytesReceived", results.payloadBytesReceived)
+          .add("compressionRatio", results.compressionRatio)
+          .add("goodputMBps", results.goodputMBps)
+          .add("fecCorrectedSymbols", results.fecCorrectedSymbols)
+          .add("fecRepairedFrames", results.fecRepairedFrames)
+          .add("fecUncorrectableFrames", results.fecUncorrectableFrames)
+          .add("messagesReceived", results.messagesReceived)
+          .add("messageBytesReceived", results.messageBytesReceived)
+          .add("messagesPerSecond", results.messagesPerSecond)
+          .add("headerEfficiency", results.headerEfficiency)
+          .add("channelMessagesSent", results.channelMessagesSent)
+          .add("channelMessagesReceived", results.channelMessagesReceived)
+          .add("channelRetransmits", results.channelRetransmits)
+          .add("channelUnacked", results.channelUnacked)
+          .add("channelLatencyP50Ms", results.channelLatencyP50Ms)
+          .add("channelLatencyP99Ms", results.channelLatencyP99Ms)
+          .add("channelLatencyMaxMs", results.channelLatencyMaxMs);
+}
+
+void addIoStatsFields(JsonRecord& record, const std::string& prefix, const IoStats& io) {
+    record.add(prefix + "Requests", io.requests)
+          .add(prefix + "Calls", io.calls)
+          .add(prefix + "Bytes", io.bytes)
+          .add(prefix + "PartialCalls", io.partialCalls)
+          .add(prefix + "WaitTimeouts", io.waitTimeouts)
+          .add(prefix + "CancelIoCalls", io.cancelIoCalls)
+          .add(prefix + "Errors", io.errors)
+          .add(prefix + "WaitSeconds", io.waitUs / 1e6)
+          .add(prefix + "BytesPerCallP50", io.bytesPerCall.percentile(0.50))
+          .add(prefix + "BytesPerCallP99", io.bytesPerCall.percentile(0.99))
+          .add(prefix + "BytesPerCallMax", static_cast<long long>(io.bytesPerCall.maxValue()))
+          .add(prefix + "CompletionP50Ms", io.completionUs.percentileMs(0.50))
+          .add(prefix + "CompletionP99Ms", io.completionUs.percentileMs(0.99))
+          .add(prefix + "CompletionMaxMs", io.completionUs.maxMs());
+}
+
+void addInstrumentationFields(JsonRecord& record, const Instrumentation& inst) {
+    record.add("settingsSeconds", inst.settingsSeconds)
+          .add("readySyncSeconds", inst.readySyncSeconds)
+          .add("resultsExchangeSeconds", inst.resultsExchangeSeconds)
+          .add("fixedSleepCount", inst.fixedSleeps)
+          .add("fixedSleepSeconds", inst.fixedSleepSeconds)
+          .add("linkReconnects", inst.linkReconnects)
+          .add("linkDownSeconds", inst.linkDownSeconds);
+    addIoStatsFields(record, "read", inst.read);
+    addIoStatsFields(record, "write", inst.write);
+}
+
+// NDJSON   ϱ
+// ڵ帶 flushϿ μ ߰ Ǿ ׶ ڵ  
+class ResultWriter {
 public:
-    void push(const T& item) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        queue_.push(item);
-        cv_.notify_one();
+    ResultWriter() : finalWritten_(false) {}
+
+    bool open(const std::string& path, const std::string& role) {
+        file_.open(path, std::ios_base::out | std::ios_base::trunc);
+        role_ = role;
+        return file_.is_open();
     }
-    
-    bool pop(T& item, int timeoutMs = -1) {
-        std::unique_lock<std::mutex> lock(mutex_);
-        
-        if (timeoutMs < 0) {
-            cv_.wait(lock, [this] { return !queue_.empty() || stopped_; });
-        } else {
-            if (!cv_.wait_for(lock, std::chrono::milliseconds(timeoutMs),
-                             [this] { return !queue_.empty() || stopped_; })) {
-                return false;  // Timeout
-            }
-        }
-        
-        if (stopped_ && queue_.empty()) {
-            return false;
-        }
-        
-        item = queue_.front();
-        queue_.pop();
-        return true;
+
+    bool isOpen() const { return file_.is_open(); }
+    bool finalWritten() const { return finalWritten_; }
+
+    // ܰ  ڵ: ܰ ̸, ҿ ð,    
+    void writePhase(const std::string& phase, double seconds, const Results& results) {
+        if (!isOpen()) return;
+        JsonRecord record;
+        record.add("type", "phase").add("role", role_).add("phase", phase).add("seconds", seconds);
+        addResultsFields(record, results);
+        write(record);
     }
-    
-    void stop() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        stopped_ = true;
-        cv_.notify_all();
+
+    //    ڵ
+    void writePeer(const std::string& peerRole, const Results& results) {
+        if (!isOpen()) return;
+        JsonRecord record;
+        record.add("type", "peer").add("role", peerRole);
+        addResultsFields(record, results);
+        write(record);
     }
-    
-    size_t size() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return queue_.size();
+
+    //  ڵ (): ׽Ʈ  +  
+    void writeFinal(JsonRecord& record) {
+        if (!isOpen()) return;
+        write(record);
+        finalWritten_ = true;
     }
 
-private:
-    mutable std::mutex mutex_;
-    std::condition_variable cv_;
-    std::queue<T> queue_;
-    bool stopped_ = false;
-};
+    //     : Ǹ final ڵ带 ϳ ϵ ʱȭ
+    void beginSession() { finalWritten_ = false; }
 
-// ==========================================================
-// ACK Batcher: Accumulates ACKs and sends them in batches
-// ==========================================================
-class AckBatcher {
-public:
-    AckBatcher(int batchSize = 5, int flushIntervalMs = 10) 
-        : batchSize_(batchSize), flushIntervalMs_(flushIntervalMs), pendingCount_(0) {
-        lastFlushTime_ = std::chrono::steady_clock::now();
+    //  ڵ ():  Ʈ    main 
+    void writeFailure(const std::string& error) {
+        if (!isOpen() || finalWritten_) return;
+        JsonRecord record;
+        record.add("type", "final").add("role", role_).add("status", "error").add("error", error);
+        write(record);
+        finalWritten_ = true;
     }
-    
-    // Add an ACK to the batch
-    void addAck(int frameNum, AckFrame& ackFrame) {
-        ackFrame.setAck(frameNum);
-        pendingCount_++;
+
+    JsonRecord beginFinal() const {
+        JsonRecord record;
+        record.add("type", "final").add("role", role_).add("status", "ok");
+        return record;
     }
-    
-    // Check if we should flush the batch
-    bool shouldFlush() const {
-        if (pendingCount_ >= batchSize_) return true;
-        
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastFlushTime_).count();
-        return (elapsed >= flushIntervalMs_ && pendingCount_ > 0);
+
+    //  ڵ (Ʈ , --interval ʸ)
+    JsonRecord beginInterval(const std::string& phase) const {
+        JsonRecord record;
+        record.add("type", "interval").add("role", role_).add("phase", phase);
+        return record;
     }
-    
-    // Flush the ACKs
-    void flush(SerialPort& serial, AckFrame& ackFrame, std::vector<char>& ackSendBuffer) {
-        if (pendingCount_ > 0) {
-            ackFrame.serialize(ackSendBuffer);
-            serial.write(ackSendBuffer.data(), ackSendBuffer.size());
-            
-            // CRITICAL: Reset bitmap after flush to avoid sending stale ACKs
-            ackFrame.bitmap = 0;
-            
-            pendingCount_ = 0;
-            lastFlushTime_ = std::chrono::steady_clock::now();
-        }
+
+    void writeInterval(const JsonRecord& record) {
+        if (!isOpen()) return;
+        write(record);
     }
-    
-    int getPendingCount() const { return pendingCount_; }
 
 private:
-    int batchSize_;
-    int flushIntervalMs_;
-    int pendingCount_;
-    std::chrono::steady_clock::time_point lastFlushTime_;
+    void write(const JsonRecord& record) {
+        file_ << record.str() << '\n';
+        file_.flush();
+    }
+
+    std::ofstream file_;
+    std::string role_;
+    bool finalWritten_;
 };
 
-// ==========================================================
-// TransmissionManager: Ƽ  ۽   
-// ==========================================================
-// Sender Thread Receiver Thread иϿ ÿ ۼ 
-//  ڿ Ͽ Selective Repeat ARQ  
-class TransmissionManager {
+ResultWriter resultWriter;  // --json-out  ÿ Ȱȭ
+
+//     
+// ۽ ܰ: ACK , ۽ Ʈ( ),  /  ܰ:  ,  Ʈ,  
+struct IntervalTotals {
+    long long frames;
+    long long bytes;
+    long long retransmits;
+    long long errors;
+    int window;  // ۽  ( ܰ   ӿ Ǹ  )
+    IntervalTotals() : frames(0), bytes(0), retransmits(0), errors(0), window(0) {}
+};
+
+// Ʈ   : --interval ʸ   ó, , , RTT , 츦
+// α׿ --json-out ڵ(type "interval") 
+//   ̸ ϹǷ  ð ϰ ޸𸮰 
+class IntervalReporter {
 public:
-    // : ø Ʈ,  ,  ,  ī  
-    TransmissionManager(SerialPort& serial, WindowManager& windowMgr, 
-                       std::vector<DataFrame>& frames, int& retransmitCount)
-        : serial_(serial), windowMgr_(windowMgr), frames_(frames), 
-          retransmitCount_(retransmitCount), stopped_(false) {}
+    explicit IntervalReporter(const std::string& phase)
+        : phase_(phase), start_(std::chrono::steady_clock::now()), lastTime_(start_),
+          nextReport_(start_ + std::chrono::seconds(reportIntervalSeconds)) {}
     
-    // ۽    
-    void start() {
-        stopped_ = false;
-        senderThread_ = std::thread(&TransmissionManager::senderThreadFunc, this);
-        receiverThread_ = std::thread(&TransmissionManager::receiverThreadFunc, this);
-    }
+    //   ð
+    std::chrono::steady_clock::time_point nextReport() const { return nextReport_; }
+    bool due() const { return std::chrono::steady_clock::now() >= nextReport_; }
     
-    // ۽     
-    void stop() {
-        stopped_ = true;
-        if (senderThread_.joinable()) senderThread_.join();
-        if (receiverThread_.joinable()) receiverThread_.join();
+    //      (totals:  , rtt:  ACK ,  ܰ nullptr)
+    void report(const IntervalTotals& totals, const LatencyHistogram* rtt = nullptr) {
+        auto now = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(now - lastTime_).count();
+        double elapsed = std::chrono::duration<double>(now - start_).count();
+        long long frames = totals.frames - last_.frames;
+        long long bytes = totals.bytes - last_.bytes;
+        long long retransmits = totals.retransmits - last_.retransmits;
+        long long errors = totals.errors - last_.errors;
+        double mbps = seconds > 0 ? (bytes / (1024.0 * 1024.0)) / seconds : 0.0;
+        
+        std::string line = "Interval " + phase_ + " +" + std::to_string(static_cast<long long>(elapsed + 0.5)) + " s: " +
+                           std::to_string(frames) + " frames (total " + std::to_string(totals.frames) + "), " +
+                           std::to_string(mbps) + " MB/s, retransmits " + std::to_string(retransmits) +
+                           ", errors " + std::to_string(errors);
+        if (rtt && rtt->count() > 0) {
+            line += ", RTT p50/p90/p99 " + std::to_string(rtt->percentileMs(0.50)) + "/" +
+                    std::to_string(rtt->percentileMs(0.90)) + "/" + std::to_string(rtt->percentileMs(0.99)) + " ms";
+        }
+        logMessage(line + ", window " + std::to_string(totals.window));
+        
+        JsonRecord record = resultWriter.beginInterval(phase_);
+        record.add("elapsedSeconds", elapsed)
+              .add("intervalSeconds", seconds)
+              .add("frames", frames)
+              .add("totalFrames", totals.frames)
+              .add("bytes", bytes)
+              .add("totalBytes", totals.bytes)
+              .add("throughputMBps", mbps)
+              .add("retransmits", retransmits)
+              .add("errors", errors)
+              .add("rttSamples", rtt ? rtt->count() : 0LL)
+              .add("rttP50Ms", rtt ? rtt->percentileMs(0.50) : 0.0)
+              .add("rttP90Ms", rtt ? rtt->percentileMs(0.90) : 0.0)
+              .add("rttP99Ms", rtt ? rtt->percentileMs(0.99) : 0.0)
+              .add("rttMaxMs", rtt ? rtt->maxMs() : 0.0)
+              .add("windowSize", totals.window);
+        resultWriter.writeInterval(record);
+        
+        last_ = totals;
+        lastTime_ = now;
+        nextReport_ = now + std::chrono::seconds(reportIntervalSeconds);
     }
-    
-    //    Ȯ
-    bool isStopped() const { return stopped_.load(); }
 
 private:
-    // ۽  Լ:   /Ȯ  Ʈ 
-    void senderThreadFunc() {
-        std::vector<char> sendBuffer;
-        std::vector<char> burstBuffer;
-        
-        //  ũ⿡  Ʈ   
-        int frameSize = frames_[0].payload.size() + FRAME_OVERHEAD_V3;
-        int maxBurstFrames = 16;  // ⺻
-        
-        // 뷮   Ʈ ũ⸦ Ͽ ŸӾƿ 
-        if (frameSize > 50000) {
-            maxBurstFrames = 1;  // ſ ū    ϳ 
-            logMessage("Large frame detected (" + std::to_string(frameSize) + 
-                      " bytes). Using single-frame transmission.");
-        } else if (frameSize > 10000) {
-            maxBurstFrames = 4;  // ū  ִ 4 Ʈ 
-        } else if (frameSize > 1000) {
-            maxBurstFrames = 8;  // ߰ ũ  ִ 8 Ʈ 
-        }
-        
-        //    Ϸ Ǵ  ȣ ݺ
-        while (!stopped_ && !windowMgr_.isComplete()) {
-            std::vector<int> framesToSend = windowMgr_.getFramesToSend();
-            
-            if (!framesToSend.empty()) {
-                // 뷮   Ʈ ũ 
-                int burstSize = std::min(static_cast<int>(framesToSend.size()), maxBurstFrames);
-                
-                // Ʈ :   ϳ ۿ    
-                burstBuffer.clear();
-                int estimatedSize = burstSize * frameSize;
-                burstBuffer.reserve(estimatedSize);
-                
-                //  ӵ ȭϿ Ʈ ۿ ߰
-                for (int i = 0; i < burstSize; ++i) {
-                    int frameNum = framesToSend[i];
-                    frames_[frameNum].windowSize = windowMgr_.getWindowSize();
-                    frames_[frameNum].serialize(sendBuffer);
-                    burstBuffer.insert(burstBuffer.end(), sendBuffer.begin(), sendBuffer.end());
-                }
-                
-                // Ʈ  
-                if (serial_.write(burstBuffer.data(), burstBuffer.size()) != burstBuffer.size()) {
-                    LOG_DEBUG("Error sending burst of " + std::to_string(burstSize) + " frames");
-                    retransmitCount_ += burstSize;
-                    windowMgr_.adjustWindow(false, 0);  //    ũ 
-                } else {
-                    LOG_DEBUG("Sent burst of " + std::to_string(burstSize) + " frames");
-                }
-                
-                //     ª 
-                std::this_thread::sleep_for(std::chrono::microseconds(100));
-            } else {
-                //     (10ms ڰ ACK ó ð )
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
-            }
-        }
-    }
-    
-    //   Լ: ACK  Ͽ   Ʈ
-    void receiverThreadFunc() {
-        std::vector<char> ackBuffer(ACK_FRAME_SIZE);
-        
-        //    Ϸ Ǵ  ȣ ݺ
-        while (!stopped_ && !windowMgr_.isComplete()) {
-            // ACK   (100ms ŸӾƿ)
-            int received = serial_.read(ackBuffer.data(), ACK_FRAME_SIZE, 100);
-            
-            if (received == ACK_FRAME_SIZE) {
-                AckFrame ackFrame;
-                if (ackFrame.deserialize(ackBuffer.data(), ACK_FRAME_SIZE)) {
-                    int ackedCount = 0;
-                    int totalFrames = frames_.size();
-                    
-                    // Ʈʿ ACK  Ȯ (ִ 32)
-                    for (int i = 0; i < 32; ++i) {
-                        int frameNum = ackFrame.baseFrameNum + i;
-                        if (frameNum >= totalFrames) break;
-                        
-                        // ACKǾ   ڿ ϵ  
-                        if (ackFrame.isAcked(frameNum) && !windowMgr_.isAcked(frameNum)) {
-                            windowMgr_.markAcked(frameNum);
-                            ackedCount++;
-                        }
-                    }
-                    
-                    // ο ACK   ũ   ̵
-                    if (ackedCount > 0) {
-                        windowMgr_.adjustWindow(true, 100);  // , RTT 100ms 
-                        windowMgr_.slideWindow();            //  ̵
-                    }
-                }
-            }
-        }
-    }
-    
-    SerialPort& serial_;              // ø Ʈ 
-    WindowManager& windowMgr_;        //   
-    std::vector<DataFrame>& frames_;  //   
-    int& retransmitCount_;            //  ī 
-    std::atomic<bool> stopped_;       //   ÷
-    std::thread senderThread_;         // ۽ 
-    std::thread receiverThread_;       //  
+    std::string phase_;                                 // ܰ ̸ (phase1, phase2)
+    std::chrono::steady_clock::time_point start_;       // ܰ  ð
+    std::chrono::steady_clock::time_point lastTime_;    //   ð
+    std::chrono::steady_clock::time_point nextReport_;  //   ð
+    IntervalTotals last_;                               //    
 };
 
-// ==========================================================
-// READY ACK ȭ Լ (Phase 3  ȯ)
-// ==========================================================
-// Phase 3  ȯ   ȭϱ  3-way handshake 
-
-// READY ACK 
-// 濡  ȯ غ Ϸ ȣ 
-bool sendReadyAck(SerialPort& serial) {
-    int sent = serial.write(READY_ACK, READY_ACK_LEN);
-    if (sent == READY_ACK_LEN) {
-        logMessage("READY ACK sent.");
-        return true;
-    }
-    logMessage("Error: Failed to send READY ACK.");
-    return false;
-}
-
-// READY ACK  
-// κ READY ACK    (ִ 30)
-bool waitForReadyAck(SerialPort& serial) {
-    logMessage("Waiting for READY ACK...");
-    
-    char ackBuffer[10];
-    int attempts = 0;
-    const int MAX_ATTEMPTS = 300;  // 300ȸ * 100ms = 30
-    
-    while (attempts < MAX_ATTEMPTS) {
-        int received = serial.read(ackBuffer, READY_ACK_LEN, 100);
-        
-        if (received == READY_ACK_LEN) {
-            // READY ACK  : [SOF_ACK][R][E][A][D][Y][EOF]
-            if (ackBuffer[0] == SOF_ACK && 
-                ackBuffer[1] == 'R' && 
-                ackBuffer[2] == 'E' && 
-                ackBuffer[3] == 'A' && 
-                ackBuffer[4] == 'D' && 
-                ackBuffer[5] == 'Y' && 
-                ackBuffer[6] == EOF_BYTE) {
-                logMessage("READY ACK received.");
-                return true;
+// ۽  : 찡 ̵    Ȳ ϰ,   ACKǸ true ȯ
+// Ʈ (num = 0) ̵帶  ʰ   ϸ, deadline(--duration) Ǹ Ʈ 
+//  Ʈ ٽ  ϸ false (LINK_CHECK_MS Ȯ)
+bool monitorTransmission(WindowManager& windowMgr, TransmissionManager& tm, int num, const std::string& phase,
+                         std::chrono::steady_clock::time_point deadline) {
+    IntervalReporter reporter(phase);
+    LatencyHistogram rtt;
+    bool ending = false;
+    long long lastBase = 0;
+    while (!windowMgr.isComplete()) {
+        if (tm.linkFailed()) {
+            return false;
+        }
+        if (num == 0) {
+            lastBase = windowMgr.waitForBaseChange(lastBase, ending ? reporter.nextReport()
+                                                                    : std::min(reporter.nextReport(), deadline));
+            if (!ending && std::chrono::steady_clock::now() >= deadline) {
+                ending = true;
+                logMessage("Phase duration reached: ending the stream.");
+                tm.endStream();
             }
+            if (reporter.due()) {
+                IntervalTotals totals;
+                totals.frames = lastBase;
+                totals.bytes = tm.bytesWritten();
+                totals.retransmits = tm.resentFrames() + tm.failedFrames();
+                totals.window = windowMgr.getWindowSize();
+                tm.takeIntervalLatency(rtt);
+                reporter.report(totals, &rtt);
+            }
+            continue;
         }
         
-        attempts++;
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
-    
-    logMessage("Error: Timeout waiting for READY ACK (30 seconds).");
-    return false;
-}
-
-// ==========================================================
-//   б (õ  )
-// ==========================================================
-// Phase 3   ϱ   Լ
-// κ б⳪ ŸӾƿ ߻  ڵ õ
-bool readResults(SerialPort& serial, Results& results, const std::string& source, int maxRetries = 3) {
-    const size_t RESULTS_SIZE = sizeof(Results);
-    
-    // ִ õ Ƚŭ ݺ õ
-    for (int attempt = 1; attempt <= maxRetries; ++attempt) {
-        logMessage("Attempting to read results from " + source + " (attempt " + std::to_string(attempt) + "/" + std::to_string(maxRetries) + ")...");
-        
-        // 15 ŸӾƿ  б õ
-        int bytesRead = serial.read(reinterpret_cast<char*>(&results), RESULTS_SIZE, 15000);
-        
-        if (bytesRead == RESULTS_SIZE) {
-            // ü   
-            logMessage("Results successfully received from " + source + " (" + std::to_string(bytesRead) + " bytes).");
-            return true;
-        } else if (bytesRead > 0) {
-            // κ б ߻: õ
-            logMessage("Warning: Partial read from " + source + " (" + std::to_string(bytesRead) + "/" + std::to_string(RESULTS_SIZE) + " bytes). Retrying...");
-        } else {
-            // ŸӾƿ Ǵ  ߻: õ
-            logMessage("Warning: Read timeout or error from " + source + " (attempt " + std::to_string(attempt) + "). Retrying...");
+        // 찡 ̵   (Ϸᵵ ̵ ǹǷ ȸ  Ȯοθ ֱ )
+        long long currentBase = windowMgr.waitForBaseChange(lastBase,
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(LINK_CHECK_MS));
+        if (currentBase == lastBase) {
+            continue;
         }
         
-        //  õ ƴϸ 500ms   õ
-        if (attempt < maxRetries) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        // Improved logging: show progress for small tests and milestones
+        if (currentBase % 100 == 0 || currentBase <= 10 || 
+            currentBase == num || num <= 20) {
+            logMessage("Progress: " + std::to_string(currentBase) + "/" + 
+                      std::to_string(num) + " frames acknowledged, window: " + 
+                      std::to_string(windowMgr.getWindowSize()));
         }
+        lastBase = currentBase;
     }
-    
-    logMessage("Error: Failed to receive results from " + source + " after " + std::to_string(maxRetries) + " attempts.");
-    return false;
+    return true;
 }
 
 // Լ 
-void clientMode(const std::string& comport, int baudrate, int datasize, int num);
+void clientMode(const std::string& comport, int baudrate, int datasize, int num, Results* report = nullptr);
 void serverMode(const std::string& comport, int baudrate);
+bool parseIntList(const std::string& text, std::vector<int>& values);
+bool benchMode(const std::vector<int>& datasizes, int num, const std::vector<int>& windows, const std::string& jsonPath);
+struct BroadcastResults;
+void broadcastMode(const std::string& comport, int baudrate, int datasize, int num, BroadcastResults* report = nullptr);
+void listenMode(const std::string& comport, int baudrate, BroadcastResults* report = nullptr);
+void benchBroadcastMode(const std::vector<int>& datasizes, int num, const std::string& jsonPath);
 
 // ==========================================================
 // Main
 // ==========================================================
+//   ( ڰ  )
+void printUsage() {
+    std::cerr << "Usage: program.exe <mode> [options]" << std::endl;
+    std::cerr << "Modes:" << std::endl;
+    std::cerr << "  client <comport> <baudrate> <datasize> <num>   num 0 = stream until Ctrl+C" << std::endl;
+    std::cerr << "  server <comport> <baudrate>" << std::endl;
+    std::cerr << "  bench [datasizes] [num] [windows]   e.g. bench 64,1024,4096 2000 8,32,256" << std::endl;
+    std::cerr << "  broadcast <comport> <baudrate> <datasize> <num>   one-way fountain-coded send (no ACKs)" << std::endl;
+    std::cerr << "  listen <comport> <baudrate>                       receive and decode a broadcast" << std::endl;
+    std::cerr << "Options:" << std::endl;
+    std::cerr << "  --json-out <path>   Write per-phase and final results as NDJSON records" << std::endl;
+    std::cerr << "  --stats-shm <name>  Publish live counters to named shared memory at 10 Hz" << std::endl;
+    std::cerr << "  --metrics-port <n>  Serve Prometheus metrics on http://127.0.0.1:<n>/metrics" << std::endl;
+    std::cerr << "  --window-policy <p> Window control policy: legacy (default), aimd, bdp, fixed" << std::endl;
+    std::cerr << "  --window-max <n>    Maximum window in frames (" << WINDOW_SIZE_MIN << "-" << WINDOW_SIZE_MAX << ")" << std::endl;
+    std::cerr << "  --compress          Offer per-frame LZ4 payload compression (client)" << std::endl;
+    std::cerr << "  --payload <p>       Test payload: ramp (default), telemetry (client)" << std::endl;
+    std::cerr << "  --fec <n>           Offer Reed-Solomon FEC with n parity bytes per 255-byte codeword (client, even, 2-" << FEC_PARITY_MAX << ")" << std::endl;
+    std::cerr << "  --adaptive-size     Offer adaptive frame size starting at datasize, grown/shrunk by observed loss (client)" << std::endl;
+    std::cerr << "  --compact-header    Offer the compact data frame header (truncated frame numbers, optional fields) (client)" << std::endl;
+    std::cerr << "  --control-rate <n>  Offer a multiplexed session and send n control messages/s on channel 1 (client)" << std::endl;
+    std::cerr << "  --mux <s>           Channel schedule for multiplexed sessions: strict (default), wfq, fifo" << std::endl;
+    std::cerr << "  --mux-weight <n>    WFQ channel bytes per bulk byte (default 4)" << std::endl;
+    std::cerr << "  --duration <s>      Stream each data phase for s seconds instead of num frames (client)" << std::endl;
+    std::cerr << "  --interval <s>      Interval report period for streaming sessions (default 10)" << std::endl;
+    std::cerr << "  --daemon            Keep the port open and serve clients back to back (server)" << std::endl;
+    std::cerr << "  --sessions <n>      Exit after n daemon sessions (server, default 0 = until Ctrl+C)" << std::endl;
+    std::cerr << "  --reconnect <s>     Keep reopening a lost port for up to s seconds and resume the session (default 60, 0 = fail)" << std::endl;
+    std::cerr << "  --inject-ber <r>    Flip bits on mem: links at bit error rate r (bench, e.g. 1e-5)" << std::endl;
+    std::cerr << "  --inject-disconnect <ms>  Drop mem: links every ms milliseconds for " << MEMORY_OUTAGE_MS << " ms (bench)" << std::endl;
+    std::cerr << "  --repair-ratio <r>  Repair frames per source frame sent after the source frames (broadcast, default 0.5)" << std::endl;
+    std::cerr << "  --broadcast         Benchmark broadcast/listen instead of client/server (bench)" << std::endl;
+}
+
 int main(int argc, char* argv[]) {
     if (argc < 2) {
-        std::cerr << "Usage: program.exe <mode> [options]" << std::endl;
-        std::cerr << "Modes:" << std::endl;
-        std::cerr << "  client <comport> <baudrate> <datasize> <num>" << std::endl;
-        std::cerr << "  server <comport> <baudrate>" << std::endl;
+        printUsage();
         return 1;
     }
 
-    std::string mode = argv[1];
+    // ɼ(--name value) ġ  и
+    std::vector<std::string> args;
+    std::string jsonOutPath;
+    std::string statsShmName;
+    int metricsPort = 0;
+    bool benchBroadcast = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--json-out" && i + 1 < argc) {
+            jsonOutPath = argv[++i];
+        } else if (arg == "--stats-shm" && i + 1 < argc) {
+            statsShmName = argv[++i];
+        } else if (arg == "--metrics-port" && i + 1 < argc) {
+            metricsPort = std::stoi(argv[++i]);
+        } else if (arg == "--window-policy" && i + 1 < argc) {
+            windowPolicyName = argv[++i];
+        } else if (arg == "--window-max" && i + 1 < argc) {
+            windowSizeLimit = std::stoi(argv[++i]);
+        } else if (arg == "--compress") {
+            compressPayloads = true;
+        } else if (arg == "--payload" && i + 1 < argc) {
+            payloadName = argv[++i];
+        } else if (arg == "--fec" && i + 1 < argc) {
+            fecParityRequested = std::stoi(argv[++i]);
+        } else if (arg == "--adaptive-size") {
+            adaptiveFrameSize = true;
+        } else if (arg == "--compact-header") {
+            compactHeaderRequested = true;
+        } else if (arg == "--control-rate" && i + 1 < argc) {
+            controlRate = std::stoi(argv[++i]);
+        } else if (arg == "--mux" && i + 1 < argc) {
+            muxScheduleName = argv[++i];
+        } else if (arg == "--mux-weight" && i + 1 < argc) {
+            muxWeight = std::stoi(argv[++i]);
+        } else if (arg == "--duration" && i + 1 < argc) {
+            phaseDurationSeconds = std::stoi(argv[++i]);
+        } else if (arg == "--interval" && i + 1 < argc) {
+            reportIntervalSeconds = std::stoi(argv[++i]);
+        } else if (arg == "--daemon") {
+            daemonMode = true;
+        } else if (arg == "--sessions" && i + 1 < argc) {
+            daemonSessionLimit = std::stoi(argv[++i]);
+        } else if (arg == "--reconnect" && i + 1 < argc) {
+            linkRecoverySeconds = std::stoi(argv[++i]);
+        } else if (arg == "--inject-ber" && i + 1 < argc) {
+            injectedBitErrorRate = atof(argv[++i]);
+        } else if (arg == "--inject-disconnect" && i + 1 < argc) {
+            injectedOutageIntervalMs = std::stoi(argv[++i]);
+        } else if (arg == "--repair-ratio" && i + 1 < argc) {
+            repairRatio = atof(argv[++i]);
+        } else if (arg == "--broadcast") {
+            benchBroadcast = true;
+        } else {
+            args.push_back(arg);
+        }
+    }
+
+    // ɼǸ ־  (: program --json-out x.json) 尡 
+    if (args.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    std::string mode = args[0];
     
     std::string comport = "";
-    if (mode == "client" && argc >= 3) {
-        comport = argv[2];
-    } else if (mode == "server" && argc >= 3) {
-        comport = argv[2];
+    if ((mode == "client" || mode == "broadcast") && args.size() >= 2) {
+        comport = args[1];
+    } else if ((mode == "server" || mode == "listen") && args.size() >= 2) {
+        comport = args[1];
     }
     
     auto now = std::time(nullptr);
@@ -1070,26 +970,146 @@ int main(int argc, char* argv[]) {
     std::string logFileName = logFileNameStream.str();
     logFile.open(logFileName, std::ios_base::app);
 
+    // bench     μ ǹǷ --json-out  ڵ常  
+    if (!jsonOutPath.empty() && mode != "bench" && !resultWriter.open(jsonOutPath, mode)) {
+        logMessage("Error: Failed to open JSON output file '" + jsonOutPath + "'.");
+        return 1;
+    }
+
+    if (!makeWindowPolicy(windowPolicyName, 0, 0)) {
+        logMessage("Error: Unknown window policy '" + windowPolicyName + "' (legacy, aimd, bdp, fixed).");
+        resultWriter.writeFailure(lastErrorMessage);
+        return 1;
+    }
+    if (payloadName != "ramp" && payloadName != "telemetry" && payloadName != "messages") {
+        logMessage("Error: Unknown payload '" + payloadName + "' (ramp, telemetry, messages).");
+        resultWriter.writeFailure(lastErrorMessage);
+        return 1;
+    }
+    if (fecParityRequested != 0 &&
+        (fecParityRequested < 2 || fecParityRequested > FEC_PARITY_MAX || fecParityRequested % 2 != 0)) {
+        logMessage("Error: --fec must be an even number of parity bytes between 2 and " + std::to_string(FEC_PARITY_MAX) + ".");
+        resultWriter.writeFailure(lastErrorMessage);
+        return 1;
+    }
+    MuxSchedule muxSchedule;
+    if (!parseMuxSchedule(muxScheduleName, muxSchedule)) {
+        logMessage("Error: Unknown mux schedule '" + muxScheduleName + "' (strict, wfq, fifo).");
+        resultWriter.writeFailure(lastErrorMessage);
+        return 1;
+    }
+    if (controlRate < 0 || controlRate > CONTROL_RATE_MAX || muxWeight < 1 || muxWeight > MUX_WEIGHT_MAX) {
+        logMessage("Error: --control-rate must be between 0 and " + std::to_string(CONTROL_RATE_MAX) +
+                   " and --mux-weight between 1 and " + std::to_string(MUX_WEIGHT_MAX) + ".");
+        resultWriter.writeFailure(lastErrorMessage);
+        return 1;
+    }
+    if (injectedBitErrorRate < 0.0 || injectedBitErrorRate >= 1.0) {
+        logMessage("Error: --inject-ber must be between 0 and 1.");
+        resultWriter.writeFailure(lastErrorMessage);
+        return 1;
+    }
+    if (repairRatio < 0.0 || repairRatio > 10.0) {
+        logMessage("Error: --repair-ratio must be between 0 and 10.");
+        resultWriter.writeFailure(lastErrorMessage);
+        return 1;
+    }
+    if (phaseDurationSeconds < 0 || reportIntervalSeconds < 1) {
+        logMessage("Error: --duration must not be negative and --interval must be at least 1 second.");
+        resultWriter.writeFailure(lastErrorMessage);
+        return 1;
+    }
+    if (daemonSessionLimit < 0) {
+        logMessage("Error: --sessions must not be negative.");
+        resultWriter.writeFailure(lastErrorMessage);
+        return 1;
+    }
+    if (linkRecoverySeconds < 0 || injectedOutageIntervalMs < 0) {
+        logMessage("Error: --reconnect and --inject-disconnect must not be negative.");
+        resultWriter.writeFailure(lastErrorMessage);
+        return 1;
+    }
+    if (windowSizeLimit < WINDOW_SIZE_MIN || windowSizeLimit > WINDOW_SIZE_MAX) {
+        logMessage("Error: --window-max must be between " + std::to_string(WINDOW_SIZE_MIN) +
+                   " and " + std::to_string(WINDOW_SIZE_MAX) + ".");
+        resultWriter.writeFailure(lastErrorMessage);
+        return 1;
+    }
+
+    LiveStatsPublisher statsPublisher;
+    if (!statsShmName.empty() && !statsPublisher.start(statsShmName)) {
+        return 1;
+    }
+
+    MetricsEndpoint metricsEndpoint;
+    if (metricsPort > 0 && !metricsEndpoint.start(metricsPort, mode, comport)) {
+        return 1;
+    }
+
+    int exitCode = 0;
     if (mode == "client") {
-        if (argc != 6) {
+        if (args.size() != 5) {
             logMessage("Error: Invalid arguments for client mode.");
+            resultWriter.writeFailure(lastErrorMessage);
             return 1;
         }
-        clientMode(argv[2], std::stoi(argv[3]), std::stoi(argv[4]), std::stoi(argv[5]));
+        clientMode(args[1], std::stoi(args[2]), std::stoi(args[3]), std::stoi(args[4]));
     } else if (mode == "server") {
-        if (argc != 4) {
+        if (args.size() != 3) {
             logMessage("Error: Invalid arguments for server mode.");
+            resultWriter.writeFailure(lastErrorMessage);
+            return 1;
+        }
+        serverMode(args[1], std::stoi(args[2]));
+    } else if (mode == "broadcast") {
+        if (args.size() != 5) {
+            logMessage("Error: Invalid arguments for broadcast mode.");
+            resultWriter.writeFailure(lastErrorMessage);
+            return 1;
+        }
+        broadcastMode(args[1], std::stoi(args[2]), std::stoi(args[3]), std::stoi(args[4]));
+    } else if (mode == "listen") {
+        if (args.size() != 3) {
+            logMessage("Error: Invalid arguments for listen mode.");
+            resultWriter.writeFailure(lastErrorMessage);
+            return 1;
+        }
+        listenMode(args[1], std::stoi(args[2]));
+    } else if (mode == "bench") {
+        std::vector<int> datasizes, windows;
+        if (args.size() > 4 ||
+            !parseIntList(args.size() > 1 ? args[1] : "64,1024,4096,16384", datasizes) ||
+            !parseIntList(args.size() > 3 ? args[3] : "8,32,256", windows)) {
+            logMessage("Error: Invalid arguments for bench mode.");
             return 1;
         }
-        serverMode(argv[2], std::stoi(argv[3]));
+        // bench ǥ ո   (num) ó ϹǷ ð  Ʈ  
+        if (phaseDurationSeconds > 0) {
+            logMessage("Error: --duration is not supported in bench mode; use [num] to set the frame count.");
+            return 1;
+        }
+        if (benchBroadcast) {
+            benchBroadcastMode(datasizes, args.size() > 2 ? std::stoi(args[2]) : 2000, jsonOutPath);
+        } else {
+            //     ڵ 1 (CI ȸ  FAILED  ġ ʵ)
+            if (!benchMode(datasizes, args.size() > 2 ? std::stoi(args[2]) : 2000, windows, jsonOutPath)) {
+                exitCode = 1;
+            }
+        }
     } else {
         logMessage("Error: Unknown mode '" + mode + "'");
+        resultWriter.writeFailure(lastErrorMessage);
         return 1;
     }
 
+    //  Ʈ     ڵ 
+    resultWriter.writeFailure(lastErrorMessage.empty() ? "Terminated before final report" : lastErrorMessage);
+    statsPublisher.stop();
+    metricsEndpoint.stop();
+
     logFile.close();
 
-    return 0;
+    return exitCode;
 }
 
 // ==========================================================
@@ -1098,14 +1118,25 @@ int main(int argc, char* argv[]) {
 // Phase 1: Ŭ̾Ʈ    
 // Phase 2:   Ŭ̾Ʈ  
 // Phase 3:  ȯ  Ʈ 
-void clientMode(const std::string& comport, int baudrate, int datasize, int num) {
+void clientMode(const std::string& comport, int baudrate, int datasize, int num, Results* report) {
     logMessage("--- Client Mode (Protocol V" + std::to_string(PROTOCOL_VERSION) + ") ---");
     logMessage("Configuration: datasize=" + std::to_string(datasize) + 
-               " bytes, frames=" + std::to_string(num) + 
-               ", window=" + std::to_string(WINDOW_SIZE_INIT) + "-" + std::to_string(WINDOW_SIZE_MAX));
+               " bytes, frames=" + (num == 0 ? std::string("stream") : std::to_string(num)) + 
+               ", window policy=" + windowPolicyName + ", max window=" + std::to_string(windowSizeLimit) +
+               ", payload=" + payloadName + ", compression=" + (compressPayloads ? "lz4" : "off") +
+               (phaseDurationSeconds > 0 ? ", duration=" + std::to_string(phaseDurationSeconds) + " s per phase" : ""));
+    
+    if (phaseDurationSeconds > 0 && num != 0) {
+        logMessage("Warning: --duration runs a streaming session; ignoring num=" + std::to_string(num) + ".");
+        num = 0;
+    }
+    if (num < 0) {
+        logMessage("Error: num must be 0 (stream until Ctrl+C) or a positive frame count.");
+        return;
+    }
     
     // 뷮      ڵ Ȱȭ
-    if (datasize > 10000) {
+    if (datasize > 10000 && autoDebugMode) {
         debugMode = true;
         logMessage("Large frame size detected (" + std::to_string(datasize) + 
                    " bytes). Enabling detailed logging.");
@@ -1118,13 +1149,26 @@ void clientMode(const std::string& comport, int baudrate, int datasize, int num)
     }
     logMessage("Port " + comport + " opened successfully at " + std::to_string(baudrate) + " bps.");
 
-    // Ʈ ȭ  (ܺ    ʿ)
-    logMessage("Waiting for port stabilization...");
-    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-
-    // Phase 0:    
-    Settings settings = {PROTOCOL_VERSION, datasize, num, 0};
+    // Phase 0: SYN / SYN-ACK  ȭ    
+    // (Ʈ ȭ  ð ٸ ʰ   Ȯ)
+    liveCounters.phase.store(LIVE_PHASE_SETTINGS, std::memory_order_relaxed);
+    auto settingsStart = std::chrono::high_resolution_clock::now();
     logMessage("Connecting to server...");
+    const ConnectResult connected = connectToServer(serial);
+    if (connected == CONNECT_FAILED) {
+        return;
+    }
+    // SYN-ACK  SYN ڵũ      :
+    //  Settings д  SYN Ʈ ŸӾƿ  ȸ  Ʈ ȭ ðŭ ٸ  Settings 
+    const bool legacyServer = (connected == CONNECT_NO_REPLY);
+    if (legacyServer) {
+        logMessage("Falling back to sending settings without SYN (server predates the SYN handshake?).");
+        serial.purge();
+        logMessage("Waiting for port stabilization...");
+        timedSleep(std::chrono::milliseconds(LEGACY_STABILIZATION_MS));
+        serial.purge();
+    }
+    Settings settings = {PROTOCOL_VERSION, datasize, num, SUPPORTED_FEATURES};
     logMessage("Sending settings to server...");
     if (serial.write(reinterpret_cast<char*>(&settings), sizeof(Settings)) != sizeof(Settings)) {
         logMessage("Error: Failed to send settings to server.");
@@ -1132,15 +1176,16 @@ void clientMode(const std::string& comport, int baudrate, int datasize, int num)
     }
     logMessage("Settings sent: protocol=" + std::to_string(PROTOCOL_VERSION) + 
                ", datasize=" + std::to_string(datasize) + ", num=" + std::to_string(num));
-
-    // ̺    ϷḦ ϱ  ª 
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if (legacyServer) {
+        //  Ŭ̾Ʈ   ̺  ð 
+        timedSleep(std::chrono::milliseconds(LEGACY_SETTINGS_DELAY_MS));
+    }
 
     // κ ACK  
     logMessage("Waiting for server acknowledgment...");
     logMessage("Waiting for ACK from server (timeout: 10 seconds)...");
     char ack[4];
-    int bytesRead = serial.read(ack, 3, 10000);
+    int bytesRead = readSettingsAck(serial, ack, std::chrono::steady_clock::now() + std::chrono::milliseconds(10000));
     if (bytesRead != 3) {
         logMessage("Error: Did not receive full ACK from server. Received " + 
                    std::to_string(bytesRead) + " bytes. (Timeout: 10 seconds)");
@@ -1156,176 +1201,437 @@ void clientMode(const std::string& comport, int baudrate, int datasize, int num)
         return;
     }
     logMessage("ACK received from server.");
+
+    //     (   ȸ Ƿ ŸӾƿ    )
+    int agreedFeatures = 0;
+    char featureReply[4];
+    if (readExact(serial, featureReply, sizeof(featureReply),
+                  std::chrono::steady_clock::now() + std::chrono::milliseconds(FEATURE_REPLY_TIMEOUT_MS))) {
+        agreedFeatures = static_cast<int>(getLE(featureReply, 4)) & SUPPORTED_FEATURES;
+    }
+    const bool tlvResults = (agreedFeatures & FEATURE_RESULTS_TLV) != 0;
+    logMessage(std::string("Result exchange format: ") + (tlvResults ? "TLV" : "legacy (server did not negotiate features)"));
+    
+    // ɷ :  ϸ   ϰ    
+    // ȸ  ڽ ɷ° ٽ   ʴ  õ ʵ 
+    Capabilities session = capabilitiesFromFeatures(agreedFeatures);
+    if (agreedFeatures & FEATURE_CAPABILITIES) {
+        Capabilities offer = localCapabilities();
+        offer.compression = compressPayloads ? offer.compression : 0;
+        offer.payloads = payloadName == "messages" ? PAYLOAD_MESSAGES : payloadName == "telemetry" ? PAYLOAD_TELEMETRY : PAYLOAD_RAMP;
+        offer.fecParity = fecParityRequested;
+        offer.adaptiveMax = adaptiveFrameSize ? std::max(datasize, ADAPTIVE_FRAME_MAX) : 0;
+        offer.streaming = num == 0;
+        offer.compactHeader = compactHeaderRequested;
+        offer.channels = controlRate > 0 ? 2 : 1;
+        offer.controlRate = controlRate;
+        Capabilities reply;
+        if (!sendCapabilities(serial, offer)) {
+            logMessage("Error: Failed to send capabilities to server.");
+            return;
+        }
+        LOG_DEBUG("Capabilities offered: " + describeCapabilities(offer));
+        if (!readCapabilities(serial, reply, "server")) {
+            return;
+        }
+        session = negotiateCapabilities(offer, reply);
+    }
+    logMessage(std::string("Session capabilities (") +
+               ((agreedFeatures & FEATURE_CAPABILITIES) ? "negotiated" : "from feature bits") + "): " +
+               describeCapabilities(session));
+    if (session.checksums == 0) {
+        logMessage("Error: No common checksum algorithm with server.");
+        return;
+    }
+    if (datasize > session.maxPayload) {
+        logMessage("Error: datasize " + std::to_string(datasize) + " exceeds the agreed maximum payload of " +
+                   std::to_string(session.maxPayload) + " bytes.");
+        return;
+    }
+    const bool streaming = num == 0;
+    if (streaming && !session.streaming) {
+        logMessage("Error: Server does not support streaming sessions (num = 0).");
+        return;
+    }
+    // --duration:  ܰ踶  ð phaseDurationSeconds ڿ Ʈ 
+    auto phaseDeadline = []() {
+        return phaseDurationSeconds > 0
+            ? std::chrono::steady_clock::now() + std::chrono::seconds(phaseDurationSeconds)
+            : std::chrono::steady_clock::time_point::max();
+    };
+    const bool sackAcks = session.sackFormats != 0;
+    const int maxWindow = session.maxWindow;
+    logAckFormat(sackAcks, maxWindow);
+    const bool compression = (session.compression & COMPRESSION_LZ4) != 0;
+    const PayloadPattern uplinkPattern = sessionPattern(session.payloads, true);
+    const PayloadPattern downlinkPattern = sessionPattern(session.payloads, false);
+    const int fecParity = session.fecParity;
+    const bool credits = session.credits;
+    const bool ackCrc = session.ackCrc;
+    const bool frameCrc = session.frameCrc;
+    const int compactSequence = session.compactHeader ? compactSequenceBytes(maxWindow) : 0;
+    const int channels = session.channels;
+    MuxSchedule muxSchedule = MUX_STRICT;
+    parseMuxSchedule(muxScheduleName, muxSchedule);
+    logFecMode(fecParity);
+    logFrameHeaderMode(compactSequence);
+    logMuxMode(channels, session.controlRate, muxSchedule);
+    if (compressPayloads && !compression) {
+        logMessage("Warning: Server did not agree to compression; sending uncompressed frames.");
+    }
+    if (fecParityRequested > 0 && fecParity == 0) {
+        logMessage("Warning: Server did not agree to FEC; corrupted frames will be retransmitted.");
+    }
+    if (controlRate > 0 && channels <= 1) {
+        logMessage("Warning: Server does not support multiplexed sessions; no control traffic will be sent.");
+    }
+    if (compactHeaderRequested && compactSequence == 0) {
+        logMessage(std::string("Warning: ") + (fecParity > 0 ? "FEC sessions keep the fixed header" : "Server did not agree to the compact header") +
+                   "; using " + std::to_string(FRAME_OVERHEAD_V3) + "-byte frame headers.");
+    }
+    //   ũ  Ӹ ̰ ٸ, Ʈ   Ʈ   ,
+    // ȭ  ª ä  Ƿ   (StoredLength ) 
+    const int adaptiveMax = session.adaptiveMax;
+    const bool lengthPrefixed = compression || adaptiveMax > 0 || streaming || channels > 1;
+    const int maxFramePayload = adaptiveMax > 0 ? adaptiveMax : datasize;
+    if (adaptiveFrameSize && adaptiveMax == 0) {
+        logMessage("Warning: Server did not agree to adaptive frame size; using fixed " + std::to_string(datasize) + "-byte frames.");
+    }
+    if ((payloadName == "telemetry" && !(session.payloads & PAYLOAD_TELEMETRY)) ||
+        (payloadName == "messages" && !(session.payloads & PAYLOAD_MESSAGES))) {
+        logMessage("Warning: Server does not support the " + payloadName + " payload; using the ramp pattern.");
+    }
     
     const int frameSize = datasize + FRAME_OVERHEAD_V3;
-    Results clientResults = {0, 0, 0, 0, 0.0, 0.0, 0.0};
+    Results clientResults = Results();
     
     auto startTime = std::chrono::high_resolution_clock::now();
+    Instrumentation instrumentation;
+    instrumentation.settingsSeconds = std::chrono::duration<double>(startTime - settingsStart).count();
+    resultWriter.writePhase("settings", instrumentation.settingsSeconds, clientResults);
+    StreamStopScope streamStop(streaming);
 
     // ===== Phase 1: Ŭ̾Ʈ     (Multi-threaded Transmission) =====
     // Ƽ  Selective Repeat ARQ  
     logMessage("Phase 1: Client transmitting with Multi-threaded Selective Repeat ARQ...");
+    liveCounters.phase.store(LIVE_PHASE_1, std::memory_order_relaxed);
     {
-        WindowManager windowMgr(num);
-        
-        // ????????? ????????? ????
-        std::vector<DataFrame> frames(num);
-        for (int i = 0; i < num; ++i) {
-            frames[i].frameNum = i;
-            frames[i].windowSize = WINDOW_SIZE_INIT;
-            frames[i].payload.resize(datasize);
-            
-            // ??????�ε� ?????? (0-255 �ݺ�)
-            for (int j = 0; j < datasize; ++j) {
-                frames[i].payload[j] = static_cast<char>(j % 256);
-            }
-            
-            frames[i].checksum = frames[i].calculateChecksum();
-        }
+        WindowManager windowMgr(streaming ? STREAM_FRAMES_UNBOUNDED : num, maxWindow,
+                                makeWindowPolicy(windowPolicyName, baudrate, frameSize));
+        logMessage(std::string("Window policy: ") + windowMgr.getPolicyName() +
+                   " (initial " + std::to_string(windowMgr.getWindowSize()) +
+                   ", max " + std::to_string(maxWindow) + ")");
         
         // Start multi-threaded transmission
-        TransmissionManager transmissionMgr(serial, windowMgr, frames, clientResults.retransmitCount);
-        transmissionMgr.start();
-        
-        // Monitor progress
-        int lastBase = 0;
-        while (!windowMgr.isComplete()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            
-            int currentBase = windowMgr.getBase();
-            if (currentBase != lastBase) {
-                // Improved logging: show progress for small tests and milestones
-                if (currentBase % 100 == 0 || currentBase <= 10 || 
-                    currentBase == num || num <= 20) {
-                    logMessage("Progress: " + std::to_string(currentBase) + "/" + 
-                              std::to_string(num) + " frames acknowledged, window: " + 
-                              std::to_string(windowMgr.getWindowSize()));
-                }
-                lastBase = currentBase;
-            }
+        //  TransmissionManager ó   غ (׽Ʈ : 0, 1, 2, ... )
+        TransmissionManager transmissionMgr(serial, windowMgr, datasize, uplinkPattern, compression, lengthPrefixed,
+                                            clientResults.retransmitCount, sackAcks, fecParity, credits);
+        FrameSizeController sizer(datasize, std::min(ADAPTIVE_FRAME_MIN, datasize), maxFramePayload, FRAME_OVERHEAD_Z);
+        if (adaptiveMax > 0) {
+            logFrameSizeMode(sizer);
+            transmissionMgr.setAdaptiveFrames(&sizer);
         }
+        transmissionMgr.setCompactHeader(compactSequence);
+        transmissionMgr.setAckCrc(ackCrc);
+        transmissionMgr.setFrameCrc(frameCrc);
+        transmissionMgr.setChannels(channels, muxSchedule, muxWeight);
+        transmissionMgr.setControlTraffic(session.controlRate, std::min(CONTROL_MESSAGE_SIZE, datasize),
+                                          sessionPattern(PAYLOAD_RAMP, true));
+        transmissionMgr.start();
+        bool transmitted = monitorTransmission(windowMgr, transmissionMgr, num, "phase1", phaseDeadline());
         
         transmissionMgr.stop();
-        logMessage("Phase 1 complete: All frames transmitted and acknowledged.");
+        if (!transmitted) {
+            return;  //  Ʈ ٽ   ( SerialPort )
+        }
+        clientResults.phase1Seconds = std::chrono::duration<double>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        fillTransmissionStats(clientResults, transmissionMgr, baudrate, clientResults.phase1Seconds);
+        if (streaming) {
+            logMessage("Phase 1 complete: stream of " + std::to_string(windowMgr.getTotalFrames() - 1) +
+                       " frames transmitted and acknowledged.");
+        } else {
+            logMessage("Phase 1 complete: All frames transmitted and acknowledged.");
+        }
+        logWindowDecisions(windowMgr);
+        if (adaptiveMax > 0) {
+            logFrameSizeDecisions(sizer);
+        }
     }
+    resultWriter.writePhase("phase1", clientResults.phase1Seconds, clientResults);
 
     // ===== Phase 2:   Ŭ̾Ʈ   ( ACK  ) =====
     //    ACK Ͽ  ּȭ
     logMessage("Phase 2: Client receiving with Selective Repeat ARQ and Immediate ACK...");
+    liveCounters.phase.store(LIVE_PHASE_2, std::memory_order_relaxed);
+    auto phase2Start = std::chrono::high_resolution_clock::now();
     {
-        std::map<int, DataFrame> receivedFrames;  //     
-        AckFrame ackFrame;
-        ackFrame.baseFrameNum = 0;
-        ackFrame.bitmap = 0;
+        ReceiveWindow receiveWindow(sackAcks, fecParity, credits, 0, ackCrc);  //     ǵ  ACK 
+        ChannelReceiver channelReceiver(channels, sackAcks, fecParity, credits, ackCrc, sessionPattern(PAYLOAD_RAMP, false));
         
-        std::vector<char> receiveBuffer(frameSize);
+        std::vector<char> receiveBuffer(dataFrameWireSize(maxFramePayload, lengthPrefixed, fecParity, frameCrc));
         std::vector<char> ackSendBuffer;
-        
-        int nextExpectedFrame = 0;
+        long long storedBytes = 0;  //   ȸ ̷ε Ʈ (  )
+        long long overheadBytes = 0;  //    ƮϷ Ʈ ( ȿ )
+        FecStats fecStats;
+        
+        // Ʈ  Ʈ     ġ  
+        long long endFrame = streaming ? STREAM_FRAMES_UNBOUNDED : num;
+        long long reportedFrames = 0;  //  Ȳ  ġ
+        IntervalReporter reporter("phase2");
+        int peerWindow = 0;  //   ӿ Ǹ ۽   ( )
+        const auto deadline = phaseDeadline();
+        bool stopSent = false;
+        unsigned linkGeneration = serial.getLinkGeneration();
         
         //    Ϸ ݺ
-        while (nextExpectedFrame < num) {
-            int received = serial.read(receiveBuffer.data(), frameSize, 3000);
+        while (receiveWindow.nextExpected() < endFrame) {
+            //  Ʈ ٽ   ( SerialPort )
+            if (serial.isLinkFailed()) {
+                return;
+            }
+            //   Ʈ ٽ : ۽     ˸
+            if (serial.getLinkGeneration() != linkGeneration) {
+                linkGeneration = serial.getLinkGeneration();
+                resumeReceiving(serial, receiveWindow.nextExpected(), nullptr);
+            }
+            
+            // Ʈ  û(Ctrl+C Ǵ --duration):  ACK  û Ǿ ۽  Ʈ    
+            if (streaming && !stopSent && (streamStopRequested || std::chrono::steady_clock::now() >= deadline)) {
+                receiveWindow.requestStop();
+                stopSent = true;
+                logMessage(std::string(streamStopRequested ? "Stream stop requested" : "Phase duration reached") +
+                           ": asking the server to end the stream.");
+            }
             
-            if (received == frameSize) {
+            int received = readDataFrame(serial, receiveBuffer, maxFramePayload, lengthPrefixed, compactSequence,
+                                         fecParity, fecStats, 3000, frameCrc);
+            
+            if (received == FRAME_READ_SYNC) {
+                SyncFrame sync;
+                if (readStreamSyncFrame(serial, sync, 3000)) {
+                    resumeReceiving(serial, receiveWindow.nextExpected(), &sync);
+                }
+                continue;
+            }
+            if (received == FRAME_READ_FEC_UNCORRECTABLE) {
+                // ACK ʰ : ۽   ð ٽ 
+                clientResults.errorCount++;
+                clientResults.frameErrors++;
+                LiveCounters::add(liveCounters.errors, 1);
+                logMessage("Frame dropped: uncorrectable FEC codeword");
+                continue;
+            }
+            if (received == FRAME_READ_CRC) {
+                //  ̷ε尡 ջ : ACK ʰ  (üũ  )
+                clientResults.errorCount++;
+                clientResults.checksumErrors++;
+                LiveCounters::add(liveCounters.errors, 1);
+                logMessage("Frame dropped: frame CRC mismatch");
+                continue;
+            }
+            if (received > 0) {
                 DataFrame frame;
-                if (frame.deserialize(receiveBuffer.data(), frameSize)) {
+                bool decoded = compactSequence > 0
+                    ? frame.deserializeCompact(receiveBuffer.data(), received, maxFramePayload, adaptiveMax > 0,
+                                               channelReceiver.reference(receiveBuffer.data(), receiveWindow))
+                    : lengthPrefixed
+                    ? frame.deserializeCompressed(receiveBuffer.data(), received, maxFramePayload, adaptiveMax > 0)
+                    : frame.deserialize(receiveBuffer.data(), received);
+                decoded = decoded && frame.channel() < channels;  //   ä 谡 ߳ 
+                if (decoded) {
                     // SOF/EOF  Ϸ ( ACK )
-                    if (receiveBuffer[0] == SOF && receiveBuffer[frameSize - 1] == EOF_BYTE) {
-                        //    ACK  (  Ͽ  ּȭ)
-                        //   ȣ base Ͽ ACK ùٸ ۵ǵ 
-                        ackFrame.baseFrameNum = frame.frameNum;
-                        ackFrame.bitmap = 0;
-                        ackFrame.setAck(frame.frameNum);
-                        ackFrame.serialize(ackSendBuffer);
-                        serial.write(ackSendBuffer.data(), ackSendBuffer.size());
+                    if (receiveBuffer[0] == SOF && receiveBuffer[received - 1] == EOF_BYTE) {
+                        // üũ  ʴ  ACK ʰ  (ջ  ACKϸ ۽  ٽ  )
+                        // FEC ǿ readDataFrame   ̷ε 
+                        if (!frame.verifyChecksum()) {
+                            clientResults.errorCount++;
+                            clientResults.checksumErrors++;
+                            LiveCounters::add(liveCounters.errors, 1);
+                            logMessage("Frame " + std::to_string(frame.frameNum) + " checksum validation failed");
+                            discardFrame(serial, receiveBuffer.data(), received, fecParity);
+                            continue;
+                        }
+                        //    ȣ: üũ 쿬  ߳ б̹Ƿ ACK 
+                        if (!channelReceiver.plausible(frame, receiveWindow)) {
+                            clientResults.errorCount++;
+                            clientResults.frameErrors++;
+                            LiveCounters::add(liveCounters.errors, 1);
+                            logMessage("Frame " + std::to_string(frame.frameNum) + " outside the receive window (frame boundary lost)");
+                            discardFrame(serial, receiveBuffer.data(), received, fecParity);
+                            continue;
+                        }
+                        
+                        // ޽ ä : ä ACK  ޽  (뷮   迡  )
+                        if (frame.channel() != 0) {
+                            channelReceiver.receive(serial, frame, ackSendBuffer, clientResults);
+                            continue;
+                        }
+                        
+                        //    ACK  (̷ε   Ͽ  ּȭ)
+                        // 32Ʈ ACK   ȣ base, SACK  ACK + Ʈ 
+                        long long seq = receiveWindow.unwrap(frame.frameNum);
+                        bool isNew = receiveWindow.acknowledge(seq, ackSendBuffer, credits ? receiveCredit(serial, received) : 0);
+                        if (frame.hasWindowSize()) {
+                            peerWindow = frame.windowSize;
+                        }
+                        if (serial.write(ackSendBuffer.data(), ackSendBuffer.size()) == static_cast<int>(ackSendBuffer.size())) {
+                            LiveCounters::add(liveCounters.bytesSent, ackSendBuffer.size());
+                        }
                         
                         // ߺ  Ȯ
-                        if (receivedFrames.find(frame.frameNum) != receivedFrames.end()) {
-                            LOG_DEBUG("Duplicate frame " + std::to_string(frame.frameNum) + " received");
+                        if (!isNew) {
+                            LOG_DEBUG("Duplicate frame " + std::to_string(seq) + " received");
                             continue;
                         }
                         
-                        // üũ  (Out-of-order  ϹǷ, üũ  Ŀ  ۿ )
-                        if (frame.verifyChecksum()) {
-                            // ̷ε  
-                            bool payloadOk = true;
-                            for (size_t j = 0; j < frame.payload.size(); ++j) {
-                                if (frame.payload[j] != static_cast<char>(255 - (j % 256))) {
-                                    payloadOk = false;
-                                    break;
-                                }
+                        // Ʈ  : ̷ε   ġ ˸ (Ʈ  ƴϸ )
+                        if (frame.endOfStream()) {
+                            if (streaming) {
+                                endFrame = seq + 1;
+                                logMessage("End of stream received after " + std::to_string(seq) + " frames.");
                             }
+                            continue;
+                        }
+                        
+                        // ̷ε   (Out-of-order  ϹǷ    ۿ )
+                        int messages = 0;
+                        int messageBytes = 0;
+                        bool payloadOk = validatePayload(frame.payload, downlinkPattern, &messages, &messageBytes);
+                        
+                        if (payloadOk) {
+                            clientResults.receivedNum++;
+                            clientResults.totalReceivedBytes += received;
+                            clientResults.payloadBytesReceived += frame.payload.size();
+                            clientResults.messagesReceived += messages;
+                            clientResults.messageBytesReceived += messageBytes;
+                            storedBytes += received - frame.overhead;
+                            overheadBytes += frame.overhead;
+                            LiveCounters::add(liveCounters.bytesReceived, received);
+                            LiveCounters::add(liveCounters.framesReceived, 1);
                             
-                            if (payloadOk) {
-                                receivedFrames[frame.frameNum] = frame;
-                                clientResults.totalReceivedBytes += received;
-                                
-                                // ????????? ??????????????? ó��????? ?????? ��??? ????????? ????????????
-                                while (receivedFrames.find(nextExpectedFrame) != receivedFrames.end()) {
-                                    clientResults.receivedNum++;
-                                    nextExpectedFrame++;
-                                    
-                                    if (nextExpectedFrame % 100 == 0 || nextExpectedFrame <= 10) {
-                                        logMessage("Progress: " + std::to_string(nextExpectedFrame) + 
-                                                  "/" + std::to_string(num) + " frames received and validated");
-                                    }
-                                }
-                                // ACK already sent before validation
-                            } else {
-                                clientResults.errorCount++;
-                                logMessage("Frame " + std::to_string(frame.frameNum) + " payload validation failed");
-                            }
+                            // ACK already sent before validation
                         } else {
                             clientResults.errorCount++;
-                            logMessage("Frame " + std::to_string(frame.frameNum) + " checksum validation failed");
+                            clientResults.payloadErrors++;
+                            LiveCounters::add(liveCounters.errors, 1);
+                            logMessage("Frame " + std::to_string(frame.frameNum) + " payload validation failed");
                         }
                     }
                 } else {
                     clientResults.errorCount++;
+                    clientResults.frameErrors++;
+                    LiveCounters::add(liveCounters.errors, 1);
                     logMessage("Frame deserialization failed");
+                    discardFrame(serial, receiveBuffer.data(), received, fecParity);
                 }
             } else {
                 // Log timeout for debugging
-                if (received == 0 && nextExpectedFrame < num) {
-                    LOG_DEBUG("Read timeout at frame " + std::to_string(nextExpectedFrame));
+                if (received < 0) {
+                    LOG_DEBUG("Read timeout at frame " + std::to_string(receiveWindow.nextExpected()));
+                }
+            }
+            
+            //     Ȳ  (Ʈ   ֱ⸶  )
+            if (streaming) {
+                if (reporter.due()) {
+                    IntervalTotals totals;
+                    totals.frames = clientResults.receivedNum;
+                    totals.bytes = clientResults.totalReceivedBytes;
+                    totals.errors = clientResults.errorCount;
+                    totals.window = peerWindow;
+                    reporter.report(totals);
+                }
+                continue;
+            }
+            while (reportedFrames < receiveWindow.nextExpected()) {
+                reportedFrames++;
+                if (reportedFrames % 100 == 0 || reportedFrames <= 10) {
+                    logMessage("Progress: " + std::to_string(reportedFrames) + 
+                              "/" + std::to_string(num) + " frames received and validated");
                 }
             }
         }
         
-        logMessage("Phase 2 complete: All frames received and validated.");
+        if (streaming) {
+            logMessage("Phase 2 complete: stream of " + std::to_string(endFrame - 1) + " frames received.");
+        } else {
+            logMessage("Phase 2 complete: All frames received and validated.");
+        }
+        if (storedBytes > 0) {
+            clientResults.compressionRatio = static_cast<double>(clientResults.payloadBytesReceived) / storedBytes;
+        }
+        if (clientResults.receivedNum > 0) {
+            clientResults.headerEfficiency = static_cast<double>(clientResults.messageBytesReceived) /
+                (clientResults.payloadBytesReceived + overheadBytes);
+        }
+        clientResults.fecCorrectedSymbols = fecStats.correctedSymbols;
+        clientResults.fecRepairedFrames = fecStats.repairedFrames;
+        clientResults.fecUncorrectableFrames = fecStats.uncorrectableFrames;
     }
 
     auto endTime = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> elapsed = endTime - startTime;
     clientResults.elapsedSeconds = elapsed.count();
+    clientResults.phase2Seconds = std::chrono::duration<double>(endTime - phase2Start).count();
+    if (clientResults.phase2Seconds > 0) {
+        clientResults.rxLineUtilization = (clientResults.totalReceivedBytes * 10.0) / (baudrate * clientResults.phase2Seconds);
+    }
     
     if (clientResults.elapsedSeconds > 0) {
         clientResults.throughputMBps = (clientResults.totalReceivedBytes / (1024.0 * 1024.0)) / clientResults.elapsedSeconds;
         clientResults.charactersPerSecond = clientResults.totalReceivedBytes / clientResults.elapsedSeconds;
+        clientResults.goodputMBps = (clientResults.payloadBytesReceived / (1024.0 * 1024.0)) / clientResults.elapsedSeconds;
+        clientResults.messagesPerSecond = clientResults.messagesReceived / clientResults.elapsedSeconds;
     }
 
     logMessage("Data exchange complete.");
     logMessage("Performance: " + std::to_string(clientResults.throughputMBps) + " MB/s, " + 
                std::to_string(clientResults.charactersPerSecond) + " chars/s (CPS)");
+    if (compression) {
+        logMessage("Compression: ratio " + std::to_string(clientResults.compressionRatio) + ", goodput " +
+                   std::to_string(clientResults.goodputMBps) + " MB/s");
+    }
+    if (fecParity > 0) {
+        logMessage("FEC: " + std::to_string(clientResults.fecCorrectedSymbols) + " symbols corrected, " +
+                   std::to_string(clientResults.fecRepairedFrames) + " frames repaired, " +
+                   std::to_string(clientResults.fecUncorrectableFrames) + " uncorrectable");
+    }
+    if (report) {
+        *report = clientResults;  // bench : Phase 1/2  ϹǷ  ȯ  
+    }
     
-    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    resultWriter.writePhase("phase2", clientResults.phase2Seconds, clientResults);
     
     // ===== Phase 3:  ȯ (3-way Handshake) =====
-    // 3-way handshake  Ȯ ȭ   ȯ
-    if (!sendReadyAck(serial)) {
-        logMessage("Error: Failed to synchronize with server.");
-        return;
+    //  Phase 2 ۽ 带     READY ACK Ƿ, װ  ڿ  READY ACK 
+    //  ACK  忡    (    ȣ )
+    // SYN ڵũ   1   Ŭ̾Ʈ READY ACK  ٸǷ  Ŭ̾Ʈ  
+    auto exchangeStart = std::chrono::high_resolution_clock::now();
+    liveCounters.phase.store(LIVE_PHASE_RESULTS, std::memory_order_relaxed);
+    if (legacyServer) {
+        timedSleep(std::chrono::milliseconds(LEGACY_STABILIZATION_MS));
+        if (!sendReadyAck(serial)) {
+            logMessage("Error: Failed to synchronize with server.");
+            return;
+        }
     }
-    
     if (!waitForReadyAck(serial)) {
         logMessage("Error: Server not ready for result exchange.");
         return;
     }
     
+    if (!legacyServer && !sendReadyAck(serial)) {
+        logMessage("Error: Failed to synchronize with server.");
+        return;
+    }
+    
+    auto syncEnd = std::chrono::high_resolution_clock::now();
+    instrumentation.readySyncSeconds = std::chrono::duration<double>(syncEnd - exchangeStart).count();
+    resultWriter.writePhase("ready_sync", instrumentation.readySyncSeconds, clientResults);
     logMessage("Synchronization complete. Starting result exchange.");
-    //  READY ACK      (3-way handshake Ϸ)
-    if (serial.write(reinterpret_cast<char*>(&clientResults), sizeof(Results)) != sizeof(Results)) {
+    // READY ACK ȯ     (3-way handshake Ϸ)
+    if (!sendResults(serial, clientResults, tlvResults)) {
         logMessage("Error: Failed to send results to server.");
     } else {
         logMessage("Client results sent to server.");
@@ -1337,24 +1643,30 @@ void clientMode(const std::string& comport, int baudrate, int datasize, int num)
 
     // κ   (õ  )
     Results serverResults;
-    if (!readResults(serial, serverResults, "server", 3)) {
+    if (!readResults(serial, serverResults, "server", tlvResults)) {
         logMessage("Error: Failed to receive results from server.");
         return;
     }
     
     logMessage("Results received from server.");
+    instrumentation.resultsExchangeSeconds = std::chrono::duration<double>(
+        std::chrono::high_resolution_clock::now() - syncEnd).count();
+    resultWriter.writePhase("results_exchange", instrumentation.resultsExchangeSeconds, clientResults);
+    instrumentation.capture(serial);
+    resultWriter.writePeer("server", serverResults);
         
         logMessage("=== Final Client Report ===");
         logMessage("Test Configuration:");
         logMessage("  - Data size: " + std::to_string(datasize) + " bytes");
-        logMessage("  - Frame count: " + std::to_string(num));
+        logMessage("  - Frame count: " + (streaming ? std::string("stream") : std::to_string(num)));
         logMessage("  - Protocol version: " + std::to_string(PROTOCOL_VERSION));
         
         logMessage("\nClient Transmission Results:");
         logMessage("  - Retransmissions: " + std::to_string(clientResults.retransmitCount));
         
         logMessage("\nClient Reception Results:");
-        logMessage("  - Received frames: " + std::to_string(clientResults.receivedNum) + "/" + std::to_string(num));
+        logMessage("  - Received frames: " + std::to_string(clientResults.receivedNum) +
+                   (streaming ? std::string(" (stream)") : "/" + std::to_string(num)));
         logMessage("  - Total bytes: " + std::to_string(clientResults.totalReceivedBytes));
         logMessage("  - Errors: " + std::to_string(clientResults.errorCount));
         logMessage("  - Elapsed time: " + std::to_string(clientResults.elapsedSeconds) + " seconds");
@@ -1362,7 +1674,8 @@ void clientMode(const std::string& comport, int baudrate, int datasize, int num)
         logMessage("  - CPS (chars/sec): " + std::to_string(clientResults.charactersPerSecond));
         
         logMessage("\nServer Reception Results:");
-        logMessage("  - Received frames: " + std::to_string(serverResults.receivedNum) + "/" + std::to_string(num));
+        logMessage("  - Received frames: " + std::to_string(serverResults.receivedNum) +
+                   (streaming ? std::string(" (stream)") : "/" + std::to_string(num)));
         logMessage("  - Total bytes: " + std::to_string(serverResults.totalReceivedBytes));
         logMessage("  - Errors: " + std::to_string(serverResults.errorCount));
         logMessage("  - Retransmissions: " + std::to_string(serverResults.retransmitCount));
@@ -1370,7 +1683,28 @@ void clientMode(const std::string& comport, int baudrate, int datasize, int num)
         logMessage("  - Throughput: " + std::to_string(serverResults.throughputMBps) + " MB/s");
         logMessage("  - CPS (chars/sec): " + std::to_string(serverResults.charactersPerSecond));
         
+        logExtendedResults("Client", clientResults);
+        if (tlvResults) {
+            logExtendedResults("Server", serverResults);
+        }
+        logInstrumentation(clientResults, instrumentation);
+        
         logMessage("=========================");
+
+    JsonRecord finalRecord = resultWriter.beginFinal();
+    finalRecord.add("protocolVersion", PROTOCOL_VERSION)
+               .add("baudrate", baudrate)
+               .add("datasize", datasize)
+               .add("frames", num)
+               .add("stream", streaming)
+               .add("durationSeconds", phaseDurationSeconds)
+               .add("expectedBytes", static_cast<long long>(frameSize) * num)
+               .add("adaptiveFrameMax", adaptiveMax)
+               .add("resultFormat", tlvResults ? "tlv" : "legacy");
+    addResultsFields(finalRecord, clientResults);
+    addInstrumentationFields(finalRecord, instrumentation);
+    resultWriter.writeFinal(finalRecord);
+    liveCounters.phase.store(LIVE_PHASE_DONE, std::memory_order_relaxed);
 }
 
 // ==========================================================
@@ -1382,34 +1716,68 @@ void clientMode(const std::string& comport, int baudrate, int datasize, int num)
 // Phase 1: Ŭ̾Ʈ    
 // Phase 2:   Ŭ̾Ʈ  
 // Phase 3:  ȯ  Ʈ 
-void serverMode(const std::string& comport, int baudrate) {
-    logMessage("--- Server Mode (Protocol V" + std::to_string(PROTOCOL_VERSION) + ") ---");
-    SerialPort serial;
-    if (!serial.open(comport, baudrate)) {
-        return;
+//    : Ŭ̾Ʈ    
+// ù Ʈ ª ֱ ٸ(ŸӾƿ    б⸦ ص Ҵ Ʈ ),  acceptClient 
+// ߰   õ  Ʈ  ٽ  (Ʈ  ٽ   쿡 false)
+bool waitForDaemonSettings(SerialPort& serial, Settings& settings) {
+    char* raw = reinterpret_cast<char*>(&settings);
+    while (true) {
+        if (serial.read(raw, 1, DAEMON_POLL_MS) != 1) {
+            if (serial.isLinkFailed()) return false;
+            continue;
+        }
+        if (acceptClient(serial, settings)) {
+            return true;
+        }
+        logMessage("Discarding stray bytes while waiting for a client.");
+        serial.purge();
     }
-    logMessage("Server waiting for a client on " + comport + "...");
-    logMessage("Please start the client within 60 seconds.");
+}
 
+//  Ŭ̾Ʈ  ( ȯ  Ʈ)
+//   α׸  ȯϸ,  忡 ȣ    غ
+void serveSession(SerialPort& serial, const std::string& comport, int baudrate) {
     // Ŭ̾Ʈκ    
     Settings settings;
-    logMessage("Waiting for client settings (timeout: 60 seconds)...");
-    if (serial.read(reinterpret_cast<char*>(&settings), sizeof(Settings), 60000) != sizeof(Settings)) {
-        logMessage("Error: Failed to receive settings from client. Connection timed out (60 seconds).");
-        logMessage("Possible causes:");
-        logMessage("  1. Client not started or wrong COM port");
-        logMessage("  2. Baud rate mismatch");
-        logMessage("  3. Connection cable issue");
-        return;
+    auto settingsStart = std::chrono::high_resolution_clock::now();
+    logMessage("Server waiting for a client on " + comport + "...");
+    if (daemonMode) {
+        if (!waitForDaemonSettings(serial, settings)) {
+            return;  //  Ʈ ٽ   ( SerialPort )
+        }
+        settingsStart = std::chrono::high_resolution_clock::now();  //   ð  ȯ ð 
+    } else {
+        logMessage("Please start the client within 60 seconds.");
+        logMessage("Waiting for client settings (timeout: 60 seconds)...");
+        if (serial.read(reinterpret_cast<char*>(&settings), 1, 60000) != 1) {
+            logMessage("Error: Failed to receive settings from client. Connection timed out (60 seconds).");
+            logMessage("Possible causes:");
+            logMessage("  1. Client not started or wrong COM port");
+            logMessage("  2. Baud rate mismatch");
+            logMessage("  3. Connection cable issue");
+            return;
+        }
+        if (!acceptClient(serial, settings)) {
+            logMessage("Error: Failed to receive settings from client.");
+            return;
+        }
     }
     
     //   Ȯ
-    if (settings.protocolVersion != PROTOCOL_VERSION) {
+    // ɷ  ϴ  ο Ŭ̾Ʈ ޾Ƶ̰,      
+    const bool offersCapabilities = (settings.reserved & FEATURE_CAPABILITIES) != 0;
+    if (settings.protocolVersion != PROTOCOL_VERSION &&
+        !(offersCapabilities && settings.protocolVersion > PROTOCOL_VERSION)) {
         logMessage("Error: Protocol version mismatch! Client: " + std::to_string(settings.protocolVersion) + 
                    ", Server: " + std::to_string(PROTOCOL_VERSION));
         return;
     }
+    if (settings.protocolVersion != PROTOCOL_VERSION) {
+        logMessage("Client protocol V" + std::to_string(settings.protocolVersion) + " is newer; continuing with V" +
+                   std::to_string(PROTOCOL_VERSION) + " through capability negotiation.");
+    }
     
+    liveCounters.phase.store(LIVE_PHASE_SETTINGS, std::memory_order_relaxed);
     logMessage("Client connected. Settings: protocol=" + std::to_string(settings.protocolVersion) + 
                ", datasize=" + std::to_string(settings.datasize) + ", num=" + std::to_string(settings.num));
 
@@ -1420,138 +1788,342 @@ void serverMode(const std::string& comport, int baudrate) {
     }
     logMessage("ACK sent to client.");
 
+    //  : Ŭ̾Ʈ  Ʈ  쿡   ȸ ( Ŭ̾Ʈ reserved == 0)
+    const int agreedFeatures = settings.reserved & SUPPORTED_FEATURES;
+    if (settings.reserved != 0) {
+        std::vector<char> featureReply;
+        putLE(featureReply, static_cast<uint32_t>(agreedFeatures), 4);
+        if (serial.write(featureReply.data(), featureReply.size()) != static_cast<int>(featureReply.size())) {
+            logMessage("Error: Failed to send feature reply to client.");
+            return;
+        }
+    }
+    const bool tlvResults = (agreedFeatures & FEATURE_RESULTS_TLV) != 0;
+    logMessage(std::string("Result exchange format: ") + (tlvResults ? "TLV" : "legacy (client did not negotiate features)"));
+    
+    // ɷ : Ŭ̾Ʈ Ȱ ڽ ɷ¿      ȸ
+    Capabilities session = capabilitiesFromFeatures(agreedFeatures);
+    if (agreedFeatures & FEATURE_CAPABILITIES) {
+        Capabilities offer;
+        if (!readCapabilities(serial, offer, "client")) {
+            return;
+        }
+        LOG_DEBUG("Capabilities offered by client: " + describeCapabilities(offer));
+        session = negotiateCapabilities(localCapabilities(), offer);
+        if (!sendCapabilities(serial, session)) {
+            logMessage("Error: Failed to send capabilities to client.");
+            return;
+        }
+    }
+    logMessage(std::string("Session capabilities (") +
+               ((agreedFeatures & FEATURE_CAPABILITIES) ? "negotiated" : "from feature bits") + "): " +
+               describeCapabilities(session));
+    if (session.checksums == 0) {
+        logMessage("Error: No common checksum algorithm with client.");
+        return;
+    }
+    if (settings.datasize <= 0 || settings.datasize > session.maxPayload) {
+        logMessage("Error: Client datasize " + std::to_string(settings.datasize) + " is outside the agreed payload limit (1-" +
+                   std::to_string(session.maxPayload) + " bytes).");
+        return;
+    }
+    if (settings.num < 0 || (settings.num == 0 && !session.streaming)) {
+        logMessage("Error: Client frame count " + std::to_string(settings.num) + " is not valid for this session.");
+        return;
+    }
+    const bool sackAcks = session.sackFormats != 0;
+    const int maxWindow = session.maxWindow;
+    logAckFormat(sackAcks, maxWindow);
+    const bool compression = (session.compression & COMPRESSION_LZ4) != 0;
+    const PayloadPattern uplinkPattern = sessionPattern(session.payloads, true);
+    const PayloadPattern downlinkPattern = sessionPattern(session.payloads, false);
+    const int fecParity = session.fecParity;
+    const bool credits = session.credits;
+    const bool ackCrc = session.ackCrc;
+    const bool frameCrc = session.frameCrc;
+    const int compactSequence = session.compactHeader ? compactSequenceBytes(maxWindow) : 0;
+    const int channels = session.channels;
+    MuxSchedule muxSchedule = MUX_STRICT;
+    parseMuxSchedule(muxScheduleName, muxSchedule);
+    logFecMode(fecParity);
+    logFrameHeaderMode(compactSequence);
+    logMuxMode(channels, session.controlRate, muxSchedule);
+
     const int datasize = settings.datasize;
+    const int adaptiveMax = session.adaptiveMax;
     const int num = settings.num;
+    const bool streaming = num == 0;  // Ʈ :  ̵ Ctrl+C   
+    const bool lengthPrefixed = compression || adaptiveMax > 0 || streaming || channels > 1;
+    const int maxFramePayload = adaptiveMax > 0 ? adaptiveMax : datasize;
     const int frameSize = datasize + FRAME_OVERHEAD_V3;
-    Results serverResults = {0, 0, 0, 0, 0.0, 0.0, 0.0};
+    Results serverResults = Results();
     
     auto startTime = std::chrono::high_resolution_clock::now();
+    Instrumentation instrumentation;
+    instrumentation.settingsSeconds = std::chrono::duration<double>(startTime - settingsStart).count();
+    resultWriter.writePhase("settings", instrumentation.settingsSeconds, serverResults);
+    StreamStopScope streamStop(streaming);
 
     // ===== Phase 1: Ŭ̾Ʈ     ( ACK  ) =====
     //    ACK Ͽ  ּȭ
     logMessage("Phase 1: Server receiving with Selective Repeat ARQ and Immediate ACK...");
+    liveCounters.phase.store(LIVE_PHASE_1, std::memory_order_relaxed);
     {
-        std::map<int, DataFrame> receivedFrames;  //     
-        AckFrame ackFrame;
-        ackFrame.baseFrameNum = 0;
-        ackFrame.bitmap = 0;
+        ReceiveWindow receiveWindow(sackAcks, fecParity, credits, 0, ackCrc);  //     ǵ  ACK 
+        ChannelReceiver channelReceiver(channels, sackAcks, fecParity, credits, ackCrc, sessionPattern(PAYLOAD_RAMP, true));
         
-        std::vector<char> receiveBuffer(frameSize);
+        std::vector<char> receiveBuffer(dataFrameWireSize(maxFramePayload, lengthPrefixed, fecParity, frameCrc));
         std::vector<char> ackSendBuffer;
-        
-        int nextExpectedFrame = 0;
+        long long storedBytes = 0;  //   ȸ ̷ε Ʈ (  )
+        long long overheadBytes = 0;  //    ƮϷ Ʈ ( ȿ )
+        FecStats fecStats;
+        
+        // Ʈ  Ʈ     ġ  
+        long long endFrame = streaming ? STREAM_FRAMES_UNBOUNDED : num;
+        long long reportedFrames = 0;  //  Ȳ  ġ
+        IntervalReporter reporter("phase1");
+        int peerWindow = 0;  //   ӿ Ǹ ۽   ( )
+        const auto deadline = std::chrono::steady_clock::time_point::max();
+        bool stopSent = false;
+        unsigned linkGeneration = serial.getLinkGeneration();
         
         //    Ϸ ݺ
-        while (nextExpectedFrame < num) {
-            int received = serial.read(receiveBuffer.data(), frameSize, 3000);
+        while (receiveWindow.nextExpected() < endFrame) {
+            //  Ʈ ٽ   ( SerialPort )
+            if (serial.isLinkFailed()) {
+                return;
+            }
+            //   Ʈ ٽ : ۽     ˸
+            if (serial.getLinkGeneration() != linkGeneration) {
+                linkGeneration = serial.getLinkGeneration();
+                resumeReceiving(serial, receiveWindow.nextExpected(), nullptr);
+            }
+            
+            // Ʈ  û(Ctrl+C Ǵ --duration):  ACK  û Ǿ ۽  Ʈ    
+            if (streaming && !stopSent && (streamStopRequested || std::chrono::steady_clock::now() >= deadline)) {
+                receiveWindow.requestStop();
+                stopSent = true;
+                logMessage(std::string(streamStopRequested ? "Stream stop requested" : "Phase duration reached") +
+                           ": asking the client to end the stream.");
+            }
+            
+            int received = readDataFrame(serial, receiveBuffer, maxFramePayload, lengthPrefixed, compactSequence,
+                                         fecParity, fecStats, 3000, frameCrc);
             
-            if (received == frameSize) {
+            if (received == FRAME_READ_SYNC) {
+                SyncFrame sync;
+                if (readStreamSyncFrame(serial, sync, 3000)) {
+                    resumeReceiving(serial, receiveWindow.nextExpected(), &sync);
+                }
+                continue;
+            }
+            if (received == FRAME_READ_FEC_UNCORRECTABLE) {
+                // ACK ʰ : ۽   ð ٽ 
+                serverResults.errorCount++;
+                serverResults.frameErrors++;
+                LiveCounters::add(liveCounters.errors, 1);
+                logMessage("Frame dropped: uncorrectable FEC codeword");
+                continue;
+            }
+            if (received == FRAME_READ_CRC) {
+                //  ̷ε尡 ջ : ACK ʰ  (üũ  )
+                serverResults.errorCount++;
+                serverResults.checksumErrors++;
+                LiveCounters::add(liveCounters.errors, 1);
+                logMessage("Frame dropped: frame CRC mismatch");
+                continue;
+            }
+            if (received > 0) {
                 DataFrame frame;
-                if (frame.deserialize(receiveBuffer.data(), frameSize)) {
-                    if (receiveBuffer[0] == SOF && receiveBuffer[frameSize - 1] == EOF_BYTE) {
-                        //    ACK  (  Ͽ  ּȭ)
-                        //   ȣ base Ͽ ACK ùٸ ۵ǵ 
-                        ackFrame.baseFrameNum = frame.frameNum;
-                        ackFrame.bitmap = 0;
-                        ackFrame.setAck(frame.frameNum);
-                        ackFrame.serialize(ackSendBuffer);
-                        serial.write(ackSendBuffer.data(), ackSendBuffer.size());
+                bool decoded = compactSequence > 0
+                    ? frame.deserializeCompact(receiveBuffer.data(), received, maxFramePayload, adaptiveMax > 0,
+                                               channelReceiver.reference(receiveBuffer.data(), receiveWindow))
+                    : lengthPrefixed
+                    ? frame.deserializeCompressed(receiveBuffer.data(), received, maxFramePayload, adaptiveMax > 0)
+                    : frame.deserialize(receiveBuffer.data(), received);
+                decoded = decoded && frame.channel() < channels;  //   ä 谡 ߳ 
+                if (decoded) {
+                    if (receiveBuffer[0] == SOF && receiveBuffer[received - 1] == EOF_BYTE) {
+                        // üũ  ʴ  ACK ʰ  (ջ  ACKϸ ۽  ٽ  )
+                        // FEC ǿ readDataFrame   ̷ε 
+                        if (!frame.verifyChecksum()) {
+                            serverResults.errorCount++;
+                            serverResults.checksumErrors++;
+                            LiveCounters::add(liveCounters.errors, 1);
+                            logMessage("Frame " + std::to_string(frame.frameNum) + " checksum validation failed");
+                            discardFrame(serial, receiveBuffer.data(), received, fecParity);
+                            continue;
+                        }
+                        //    ȣ: üũ 쿬  ߳ б̹Ƿ ACK 
+                        if (!channelReceiver.plausible(frame, receiveWindow)) {
+                            serverResults.errorCount++;
+                            serverResults.frameErrors++;
+                            LiveCounters::add(liveCounters.errors, 1);
+                            logMessage("Frame " + std::to_string(frame.frameNum) + " outside the receive window (frame boundary lost)");
+                            discardFrame(serial, receiveBuffer.data(), received, fecParity);
+                            continue;
+                        }
+                        
+                        // ޽ ä : ä ACK  ޽  (뷮   迡  )
+                        if (frame.channel() != 0) {
+                            channelReceiver.receive(serial, frame, ackSendBuffer, serverResults);
+                            continue;
+                        }
+                        
+                        //    ACK  (̷ε   Ͽ  ּȭ)
+                        // 32Ʈ ACK   ȣ base, SACK  ACK + Ʈ 
+                        long long seq = receiveWindow.unwrap(frame.frameNum);
+                        bool isNew = receiveWindow.acknowledge(seq, ackSendBuffer, credits ? receiveCredit(serial, received) : 0);
+                        if (frame.hasWindowSize()) {
+                            peerWindow = frame.windowSize;
+                        }
+                        if (serial.write(ackSendBuffer.data(), ackSendBuffer.size()) == static_cast<int>(ackSendBuffer.size())) {
+                            LiveCounters::add(liveCounters.bytesSent, ackSendBuffer.size());
+                        }
                         
                         // Check for duplicate frame
-                        if (receivedFrames.find(frame.frameNum) != receivedFrames.end()) {
-                            LOG_DEBUG("Duplicate frame " + std::to_string(frame.frameNum) + " received");
+                        if (!isNew) {
+                            LOG_DEBUG("Duplicate frame " + std::to_string(seq) + " received");
                             continue;
                         }
                         
-                        if (frame.verifyChecksum()) {
-                            bool payloadOk = true;
-                            for (size_t j = 0; j < frame.payload.size(); ++j) {
-                                if (frame.payload[j] != static_cast<char>(j % 256)) {
-                                    payloadOk = false;
-                                    break;
-                                }
+                        // Ʈ  : ̷ε   ġ ˸ (Ʈ  ƴϸ )
+                        if (frame.endOfStream()) {
+                            if (streaming) {
+                                endFrame = seq + 1;
+                                logMessage("End of stream received after " + std::to_string(seq) + " frames.");
                             }
+                            continue;
+                        }
+                        
+                        int messages = 0;
+                        int messageBytes = 0;
+                        bool payloadOk = validatePayload(frame.payload, uplinkPattern, &messages, &messageBytes);
+                        
+                        if (payloadOk) {
+                            serverResults.receivedNum++;
+                            serverResults.totalReceivedBytes += received;
+                            serverResults.payloadBytesReceived += frame.payload.size();
+                            serverResults.messagesReceived += messages;
+                            serverResults.messageBytesReceived += messageBytes;
+                            storedBytes += received - frame.overhead;
+                            overheadBytes += frame.overhead;
+                            LiveCounters::add(liveCounters.bytesReceived, received);
+                            LiveCounters::add(liveCounters.framesReceived, 1);
                             
-                            if (payloadOk) {
-                                receivedFrames[frame.frameNum] = frame;
-                                serverResults.totalReceivedBytes += received;
-                                
-                                while (receivedFrames.find(nextExpectedFrame) != receivedFrames.end()) {
-                                    serverResults.receivedNum++;
-                                    nextExpectedFrame++;
-                                    
-                                    if (nextExpectedFrame % 100 == 0 || nextExpectedFrame <= 10) {
-                                        logMessage("Progress: " + std::to_string(nextExpectedFrame) + 
-                                                  "/" + std::to_string(num) + " frames received and validated");
-                                    }
-                                }
-                                // ACK already sent before validation
-                            } else {
-                                serverResults.errorCount++;
-                                logMessage("Frame " + std::to_string(frame.frameNum) + " payload validation failed");
-                            }
+                            // ACK already sent before validation
                         } else {
                             serverResults.errorCount++;
-                            logMessage("Frame " + std::to_string(frame.frameNum) + " checksum validation failed");
+                            serverResults.payloadErrors++;
+                            LiveCounters::add(liveCounters.errors, 1);
+                            logMessage("Frame " + std::to_string(frame.frameNum) + " payload validation failed");
                         }
                     }
+                } else {
+                    serverResults.errorCount++;
+                    serverResults.frameErrors++;
+                    LiveCounters::add(liveCounters.errors, 1);
+                    logMessage("Frame deserialization failed");
+                    discardFrame(serial, receiveBuffer.data(), received, fecParity);
                 }
             } else {
                 // Log timeout for debugging
-                if (received == 0 && nextExpectedFrame < num) {
-                    LOG_DEBUG("Read timeout at frame " + std::to_string(nextExpectedFrame));
+                if (received < 0) {
+                    LOG_DEBUG("Read timeout at frame " + std::to_string(receiveWindow.nextExpected()));
+                }
+            }
+            
+            //     Ȳ  (Ʈ   ֱ⸶  )
+            if (streaming) {
+                if (reporter.due()) {
+                    IntervalTotals totals;
+                    totals.frames = serverResults.receivedNum;
+                    totals.bytes = serverResults.totalReceivedBytes;
+                    totals.errors = serverResults.errorCount;
+                    totals.window = peerWindow;
+                    reporter.report(totals);
+                }
+                continue;
+            }
+            while (reportedFrames < receiveWindow.nextExpected()) {
+                reportedFrames++;
+                if (reportedFrames % 100 == 0 || reportedFrames <= 10) {
+                    logMessage("Progress: " + std::to_string(reportedFrames) + 
+                              "/" + std::to_string(num) + " frames received and validated");
                 }
             }
         }
         
-        logMessage("Phase 1 complete: All frames received and validated.");
+        if (streaming) {
+            logMessage("Phase 1 complete: stream of " + std::to_string(endFrame - 1) + " frames received.");
+        } else {
+            logMessage("Phase 1 complete: All frames received and validated.");
+        }
+        if (storedBytes > 0) {
+            serverResults.compressionRatio = static_cast<double>(serverResults.payloadBytesReceived) / storedBytes;
+        }
+        if (serverResults.receivedNum > 0) {
+            serverResults.headerEfficiency = static_cast<double>(serverResults.messageBytesReceived) /
+                (serverResults.payloadBytesReceived + overheadBytes);
+        }
+        serverResults.fecCorrectedSymbols = fecStats.correctedSymbols;
+        serverResults.fecRepairedFrames = fecStats.repairedFrames;
+        serverResults.fecUncorrectableFrames = fecStats.uncorrectableFrames;
     }
+    serverResults.phase1Seconds = std::chrono::duration<double>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+    if (serverResults.phase1Seconds > 0) {
+        serverResults.rxLineUtilization = (serverResults.totalReceivedBytes * 10.0) / (baudrate * serverResults.phase1Seconds);
+    }
+    resultWriter.writePhase("phase1", serverResults.phase1Seconds, serverResults);
 
     // ===== Phase 2:   Ŭ̾Ʈ   (Multi-threaded Transmission) =====
     // Ƽ  Selective Repeat ARQ  
     logMessage("Phase 2: Server transmitting with Multi-threaded Selective Repeat ARQ...");
+    liveCounters.phase.store(LIVE_PHASE_2, std::memory_order_relaxed);
+    auto phase2Start = std::chrono::high_resolution_clock::now();
     {
-        WindowManager windowMgr(num);
-        
-        //  ӵ غ
-        std::vector<DataFrame> frames(num);
-        for (int i = 0; i < num; ++i) {
-            frames[i].frameNum = i;
-            frames[i].windowSize = WINDOW_SIZE_INIT;
-            frames[i].payload.resize(datasize);
-            
-            // ׽Ʈ  : 255, 254, 253, ... 
-            for (int j = 0; j < datasize; ++j) {
-                frames[i].payload[j] = static_cast<char>(255 - (j % 256));
-            }
-            
-            frames[i].checksum = frames[i].calculateChecksum();
-        }
+        WindowManager windowMgr(streaming ? STREAM_FRAMES_UNBOUNDED : num, maxWindow,
+                                makeWindowPolicy(windowPolicyName, baudrate, frameSize));
+        logMessage(std::string("Window policy: ") + windowMgr.getPolicyName() +
+                   " (initial " + std::to_string(windowMgr.getWindowSize()) +
+                   ", max " + std::to_string(maxWindow) + ")");
         
         // Ƽ  
-        TransmissionManager transmissionMgr(serial, windowMgr, frames, serverResults.retransmitCount);
-        transmissionMgr.start();
-        
-        // Monitor progress
-        int lastBase = 0;
-        while (!windowMgr.isComplete()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            
-            int currentBase = windowMgr.getBase();
-            if (currentBase != lastBase) {
-                // Improved logging: show progress for small tests and milestones
-                if (currentBase % 100 == 0 || currentBase <= 10 || 
-                    currentBase == num || num <= 20) {
-                    logMessage("Progress: " + std::to_string(currentBase) + "/" + 
-                              std::to_string(num) + " frames acknowledged, window: " + 
-                              std::to_string(windowMgr.getWindowSize()));
-                }
-                lastBase = currentBase;
-            }
+        //  TransmissionManager ó   غ (׽Ʈ : 255, 254, 253, ... , ڷƮ  ؽƮ)
+        TransmissionManager transmissionMgr(serial, windowMgr, datasize, downlinkPattern, compression, lengthPrefixed,
+                                            serverResults.retransmitCount, sackAcks, fecParity, credits);
+        FrameSizeController sizer(datasize, std::min(ADAPTIVE_FRAME_MIN, datasize), maxFramePayload, FRAME_OVERHEAD_Z);
+        if (adaptiveMax > 0) {
+            logFrameSizeMode(sizer);
+            transmissionMgr.setAdaptiveFrames(&sizer);
         }
+        transmissionMgr.setCompactHeader(compactSequence);
+        transmissionMgr.setAckCrc(ackCrc);
+        transmissionMgr.setFrameCrc(frameCrc);
+        transmissionMgr.setChannels(channels, muxSchedule, muxWeight);
+        transmissionMgr.setControlTraffic(session.controlRate, std::min(CONTROL_MESSAGE_SIZE, datasize),
+                                          sessionPattern(PAYLOAD_RAMP, false));
+        transmissionMgr.start();
+        bool transmitted = monitorTransmission(windowMgr, transmissionMgr, num, "phase2", std::chrono::steady_clock::time_point::max());
         
         transmissionMgr.stop();
-        logMessage("Phase 2 complete: All frames transmitted and acknowledged.");
+        if (!transmitted) {
+            return;  //  Ʈ ٽ   ( SerialPort )
+        }
+        serverResults.phase2Seconds = std::chrono::duration<double>(
+            std::chrono::high_resolution_clock::now() - phase2Start).count();
+        fillTransmissionStats(serverResults, transmissionMgr, baudrate, serverResults.phase2Seconds);
+        if (streaming) {
+            logMessage("Phase 2 complete: stream of " + std::to_string(windowMgr.getTotalFrames() - 1) +
+                       " frames transmitted and acknowledged.");
+        } else {
+            logMessage("Phase 2 complete: All frames transmitted and acknowledged.");
+        }
+        logWindowDecisions(windowMgr);
+        if (adaptiveMax > 0) {
+            logFrameSizeDecisions(sizer);
+        }
     }
 
     auto endTime = std::chrono::high_resolution_clock::now();
@@ -1561,37 +2133,53 @@ void serverMode(const std::string& comport, int baudrate) {
     if (serverResults.elapsedSeconds > 0) {
         serverResults.throughputMBps = (serverResults.totalReceivedBytes / (1024.0 * 1024.0)) / serverResults.elapsedSeconds;
         serverResults.charactersPerSecond = serverResults.totalReceivedBytes / serverResults.elapsedSeconds;
+        serverResults.goodputMBps = (serverResults.payloadBytesReceived / (1024.0 * 1024.0)) / serverResults.elapsedSeconds;
+        serverResults.messagesPerSecond = serverResults.messagesReceived / serverResults.elapsedSeconds;
     }
 
     logMessage("Data exchange complete.");
     logMessage("Performance: " + std::to_string(serverResults.throughputMBps) + " MB/s, " + 
                std::to_string(serverResults.charactersPerSecond) + " chars/s (CPS)");
+    if (compression) {
+        logMessage("Compression: ratio " + std::to_string(serverResults.compressionRatio) + ", goodput " +
+                   std::to_string(serverResults.goodputMBps) + " MB/s");
+    }
+    if (fecParity > 0) {
+        logMessage("FEC: " + std::to_string(serverResults.fecCorrectedSymbols) + " symbols corrected, " +
+                   std::to_string(serverResults.fecRepairedFrames) + " frames repaired, " +
+                   std::to_string(serverResults.fecUncorrectableFrames) + " uncorrectable");
+    }
     
-    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    resultWriter.writePhase("phase2", serverResults.phase2Seconds, serverResults);
     
-    // 3-way handshake: Wait for client's READY ACK first, then send our READY ACK
-    if (!waitForReadyAck(serial)) {
-        logMessage("Error: Client not ready for result exchange.");
+    // 3-way handshake: Phase 2 ۽ Ƿ  READY ACK    غ Ǿ ˸ Ŭ̾Ʈ READY ACK 
+    // ( Ŭ̾Ʈ 1   READY ACK     ٸǷ  ٲ )
+    auto exchangeStart = std::chrono::high_resolution_clock::now();
+    liveCounters.phase.store(LIVE_PHASE_RESULTS, std::memory_order_relaxed);
+    if (!sendReadyAck(serial)) {
+        logMessage("Error: Failed to synchronize with client.");
         return;
     }
     
-    // Send our READY ACK to signal we're ready to receive client's results
-    if (!sendReadyAck(serial)) {
-        logMessage("Error: Failed to synchronize with client.");
+    if (!waitForReadyAck(serial)) {
+        logMessage("Error: Client not ready for result exchange.");
         return;
     }
     
+    auto syncEnd = std::chrono::high_resolution_clock::now();
+    instrumentation.readySyncSeconds = std::chrono::duration<double>(syncEnd - exchangeStart).count();
+    resultWriter.writePhase("ready_sync", instrumentation.readySyncSeconds, serverResults);
     logMessage("Synchronization complete. Starting result exchange.");
-    // Read client results immediately after sending READY ACK (client will send after receiving our READY ACK)
+    // Read client results immediately after its READY ACK (client sends them right after the READY ACK)
     Results clientResults;
-    if (!readResults(serial, clientResults, "client", 3)) {
+    if (!readResults(serial, clientResults, "client", tlvResults)) {
         logMessage("Error: Failed to receive results from client.");
         return;
     }
     
     logMessage("Results received from client.");
 
-    if (serial.write(reinterpret_cast<char*>(&serverResults), sizeof(Results)) != sizeof(Results)) {
+    if (!sendResults(serial, serverResults, tlvResults)) {
         logMessage("Error: Failed to send results to client.");
     } else {
         logMessage("Server results sent to client.");
@@ -1601,17 +2189,24 @@ void serverMode(const std::string& comport, int baudrate) {
         }
     }
 
+    instrumentation.resultsExchangeSeconds = std::chrono::duration<double>(
+        std::chrono::high_resolution_clock::now() - syncEnd).count();
+    resultWriter.writePhase("results_exchange", instrumentation.resultsExchangeSeconds, serverResults);
+    instrumentation.capture(serial);
+    resultWriter.writePeer("client", clientResults);
+
     logMessage("=== Final Server Report ===");
     logMessage("Test Configuration:");
     logMessage("  - Data size: " + std::to_string(settings.datasize) + " bytes");
-    logMessage("  - Frame count: " + std::to_string(settings.num));
+    logMessage("  - Frame count: " + (streaming ? std::string("stream") : std::to_string(settings.num)));
     logMessage("  - Protocol version: " + std::to_string(settings.protocolVersion));
     
     logMessage("\nServer Transmission Results:");
     logMessage("  - Retransmissions: " + std::to_string(serverResults.retransmitCount));
     
     logMessage("\nServer Reception Results:");
-    logMessage("  - Received frames: " + std::to_string(serverResults.receivedNum) + "/" + std::to_string(settings.num));
+    logMessage("  - Received frames: " + std::to_string(serverResults.receivedNum) +
+               (streaming ? std::string(" (stream)") : "/" + std::to_string(settings.num)));
     logMessage("  - Total bytes: " + std::to_string(serverResults.totalReceivedBytes));
     logMessage("  - Errors: " + std::to_string(serverResults.errorCount));
     logMessage("  - Elapsed time: " + std::to_string(serverResults.elapsedSeconds) + " seconds");
@@ -1619,7 +2214,8 @@ void serverMode(const std::string& comport, int baudrate) {
     logMessage("  - CPS (chars/sec): " + std::to_string(serverResults.charactersPerSecond));
     
     logMessage("\nClient Reception Results:");
-    logMessage("  - Received frames: " + std::to_string(clientResults.receivedNum) + "/" + std::to_string(settings.num));
+    logMessage("  - Received frames: " + std::to_string(clientResults.receivedNum) +
+               (streaming ? std::string(" (stream)") : "/" + std::to_string(settings.num)));
     logMessage("  - Total bytes: " + std::to_string(clientResults.totalReceivedBytes));
     logMessage("  - Errors: " + std::to_string(clientResults.errorCount));
     logMessage("  - Retransmissions: " + std::to_string(clientResults.retransmitCount));
@@ -1627,5 +2223,609 @@ void serverMode(const std::string& comport, int baudrate) {
     logMessage("  - Throughput: " + std::to_string(clientResults.throughputMBps) + " MB/s");
     logMessage("  - CPS (chars/sec): " + std::to_string(clientResults.charactersPerSecond));
     
+    logExtendedResults("Server", serverResults);
+    if (tlvResults) {
+        logExtendedResults("Client", clientResults);
+    }
+    logInstrumentation(serverResults, instrumentation);
+    
+    logMessage("=========================");
+
+    JsonRecord finalRecord = resultWriter.beginFinal();
+    finalRecord.add("protocolVersion", settings.protocolVersion)
+               .add("baudrate", baudrate)
+               .add("datasize", datasize)
+               .add("frames", num)
+               .add("stream", streaming)
+               .add("expectedBytes", static_cast<long long>(frameSize) * num)
+               .add("adaptiveFrameMax", adaptiveMax)
+               .add("resultFormat", tlvResults ? "tlv" : "legacy");
+    addResultsFields(finalRecord, serverResults);
+    addInstrumentationFields(finalRecord, instrumentation);
+    resultWriter.writeFinal(finalRecord);
+    liveCounters.phase.store(LIVE_PHASE_DONE, std::memory_order_relaxed);
+}
+
+void serverMode(const std::string& comport, int baudrate) {
+    logMessage("--- Server Mode (Protocol V" + std::to_string(PROTOCOL_VERSION) + ") ---");
+    SerialPort serial;
+    if (!serial.open(comport, baudrate)) {
+        return;
+    }
+    if (!daemonMode) {
+        serveSession(serial, comport, baudrate);
+        return;
+    }
+    
+    //  : Ʈ   ä    ¸ ʱȭϰ  Ŭ̾Ʈ  ٸ
+    // Ʈ /   ٷ   ϹǷ ݺ   Ⱑ  
+    logMessage("Daemon mode: serving clients on " + comport + " until " +
+               (daemonSessionLimit > 0 ? std::to_string(daemonSessionLimit) + " sessions are done." : "terminated (Ctrl+C)."));
+    for (int session = 1; daemonSessionLimit == 0 || session <= daemonSessionLimit; ++session) {
+        lastErrorMessage.clear();
+        resultWriter.beginSession();
+        serial.resetIoStats();
+        fixedSleepCount = 0;
+        fixedSleepMicros = 0;
+        liveCounters.phase.store(LIVE_PHASE_IDLE, std::memory_order_relaxed);
+        logMessage("=== Daemon session " + std::to_string(session) + " ===");
+        
+        serveSession(serial, comport, baudrate);
+        
+        resultWriter.writeFailure(lastErrorMessage.empty() ? "Session ended before final report" : lastErrorMessage);
+        //  Ŭ̾Ʈ  / õ     ʵ ȸ 
+        if (!serial.purge()) {
+            logMessage("Warning: Failed to purge buffers after session.");
+        }
+        logMessage("Daemon session " + std::to_string(session) +
+                   (lastErrorMessage.empty() ? " finished." : " failed (" + lastErrorMessage + ")."));
+        if (serial.isLinkFailed()) {
+            logMessage("Daemon stopped: " + comport + " did not come back.");
+            return;
+        }
+    }
+}
+
+// ==========================================================
+// Broadcast / Listen Mode:  ä  ܹ 
+// ==========================================================
+// ۽  輱̳    ű⿡ ACK  TransmissionManager   Ƿ,
+// ۽    K   ceil(K x --repair-ratio)    
+//   CRC32 ´ Ӹ ޾ м ȣ ϸ, ջǰų ǵ  Ұŷ ó
+//     ξ ϸ, ʰ    ϸ  
+
+//   (۽  sourceFrames, datasize, framesSent, completeSeconds, throughputMBps )
+struct BroadcastResults {
+    int sourceFrames;            //    K
+    int datasize;                // Ӵ ̷ε ũ (bytes)
+    long long framesSent;        // ۽   ( + )
+    long long framesReceived;    //     CRC ´  
+    long long corruptFrames;     // CRC/    
+    long long foreignFrames;     // ٸ    
+    int sourceFramesReceived;    //     
+    int recoveredFrames;         //      
+    int eliminatedFrames;        //  콺 Ұŷ    
+    int payloadErrors;           //   ׽Ʈ ϰ ٸ   
+    bool complete;               //     
+    double decodeOverhead;       //     / K - 1
+    double completeSeconds;      // ù  ź  Ϸ (۽ : ۽ ҿ ð)
+    double throughputMBps;       //    ó
+};
+
+void broadcastMode(const std::string& comport, int baudrate, int datasize, int num, BroadcastResults* report) {
+    const int repairFrames = static_cast<int>(std::ceil(num * repairRatio));
+    const PayloadPattern pattern = payloadName == "telemetry" ? PATTERN_TELEMETRY_UP : PATTERN_ASCENDING;
+    logMessage("--- Broadcast Mode (one-way, fountain coded) ---");
+    logMessage("Configuration: datasize=" + std::to_string(datasize) + " bytes, source frames=" + std::to_string(num) +
+               ", repair frames=" + std::to_string(repairFrames) + ", payload=" + payloadName);
+    if (datasize <= 0 || num <= 0 || static_cast<long long>(datasize) * num > FOUNTAIN_MAX_BYTES ||
+        static_cast<long long>(num) + repairFrames > UINT_MAX) {
+        logMessage("Error: datasize x num must be positive and at most " + std::to_string(FOUNTAIN_MAX_BYTES) +
+                   " bytes (the listener keeps every source frame until decoding completes).");
+        return;
+    }
+
+    SerialPort serial;
+    if (!serial.open(comport, baudrate)) {
+        return;
+    }
+    logMessage("Port " + comport + " opened successfully at " + std::to_string(baudrate) + " bps.");
+
+    //   ̸  ΰ    XOR 
+    std::vector<char> sources(static_cast<size_t>(datasize) * num);
+    for (int i = 0; i < num; ++i) {
+        fillSourcePayload(sources.data() + static_cast<size_t>(i) * datasize, datasize, pattern, i);
+    }
+
+    FountainCode code(num);
+    FountainFrame frame;
+    frame.sessionId = std::random_device()() ^ static_cast<uint32_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    frame.sourceCount = static_cast<uint32_t>(num);
+    frame.pattern = static_cast<uint8_t>(pattern);
+    frame.payload.resize(datasize);
+    std::vector<char> buffer;
+    std::vector<int> neighbors;
+    std::ostringstream session;
+    session << std::hex << std::setw(8) << std::setfill('0') << frame.sessionId;
+    logMessage("Broadcasting session " + session.str() + " (" + std::to_string(code.degree()) +
+               " source frames per repair frame)...");
+
+    liveCounters.phase.store(LIVE_PHASE_1, std::memory_order_relaxed);
+    BroadcastResults results = BroadcastResults();
+    results.sourceFrames = num;
+    results.datasize = datasize;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (long long id = 0; id < static_cast<long long>(num) + repairFrames; ++id) {
+        frame.symbolId = static_cast<uint32_t>(id);
+        code.neighbors(frame.symbolId, neighbors);
+        std::fill(frame.payload.begin(), frame.payload.end(), 0);
+        for (int s : neighbors) {
+            xorInto(frame.payload.data(), sources.data() + static_cast<size_t>(s) * datasize, datasize);
+        }
+        frame.serialize(buffer);
+        if (serial.write(buffer.data(), static_cast<int>(buffer.size())) != static_cast<int>(buffer.size())) {
+            logMessage("Error: Failed to write broadcast frame " + std::to_string(id) + ".");
+            break;
+        }
+        results.framesSent++;
+        LiveCounters::add(liveCounters.framesSent, 1);
+        LiveCounters::add(liveCounters.bytesSent, static_cast<long long>(buffer.size()));
+        if (id + 1 == num) {
+            logMessage("Source frames sent. Sending " + std::to_string(repairFrames) + " repair frames...");
+        }
+    }
+    if (!serial.flush()) {
+        logMessage("Warning: Failed to flush serial port buffers.");
+    }
+    results.completeSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    results.throughputMBps = results.completeSeconds > 0
+        ? results.framesSent * static_cast<double>(datasize) / results.completeSeconds / (1024.0 * 1024.0) : 0.0;
+    results.complete = results.framesSent == static_cast<long long>(num) + repairFrames;
+    if (report) *report = results;
+
+    logMessage("=== Broadcast Sender Report ===");
+    logMessage("  - Frames sent: " + std::to_string(results.framesSent) + " (" + std::to_string(num) + " source + " +
+               std::to_string(results.framesSent - std::min<long long>(results.framesSent, num)) + " repair)");
+    logMessage("  - Elapsed time: " + std::to_string(results.completeSeconds) + " seconds");
+    logMessage("  - Throughput: " + std::to_string(results.throughputMBps) + " MB/s");
     logMessage("=========================");
+    if (!results.complete) return;
+
+    JsonRecord finalRecord = resultWriter.beginFinal();
+    finalRecord.add("baudrate", baudrate)
+               .add("datasize", datasize)
+               .add("sourceFrames", num)
+               .add("repairFrames", repairFrames)
+               .add("framesSent", results.framesSent)
+               .add("elapsedSeconds", results.completeSeconds)
+               .add("throughputMBps", results.throughputMBps);
+    resultWriter.writeFinal(finalRecord);
+    liveCounters.phase.store(LIVE_PHASE_DONE, std::memory_order_relaxed);
 }
+
+void listenMode(const std::string& comport, int baudrate, BroadcastResults* report) {
+    logMessage("--- Listen Mode (one-way, fountain coded) ---");
+    SerialPort serial;
+    if (!serial.open(comport, baudrate)) {
+        return;
+    }
+    logMessage("Waiting for a broadcast on " + comport + " (timeout: " +
+               std::to_string(FOUNTAIN_START_TIMEOUT_MS / 1000) + " seconds)...");
+
+    BroadcastResults results = BroadcastResults();
+    std::unique_ptr<FountainDecoder> decoder;
+    FountainFrame frame;
+    uint32_t sessionId = 0;
+    PayloadPattern pattern = PATTERN_ASCENDING;
+    std::vector<char> sourceSeen;       //    ޾Ҵ 
+    std::vector<char> rx;               //  ó   Ʈ (rx[0]   ĺ)
+    size_t need = FOUNTAIN_HEADER_SIZE; //  ó ʿ Ʈ  ( Ǵ  ü)
+    auto start = std::chrono::high_resolution_clock::now();
+    auto lastData = std::chrono::steady_clock::now();
+
+    //  ĺ   SOF_FOUNTAIN ٽ ã
+    auto resync = [&rx, &need]() {
+        auto next = std::find(rx.begin() + 1, rx.end(), SOF_FOUNTAIN);
+        rx.erase(rx.begin(), next);
+        need = FOUNTAIN_HEADER_SIZE;
+    };
+
+    liveCounters.phase.store(LIVE_PHASE_2, std::memory_order_relaxed);
+    while (!decoder || !decoder->complete()) {
+        if (rx.size() < need) {
+            size_t offset = rx.size();
+            rx.resize(need);
+            int got = serial.read(rx.data() + offset, static_cast<int>(need - offset), 100);
+            rx.resize(offset + std::max(got, 0));
+            if (got > 0) {
+                lastData = std::chrono::steady_clock::now();
+            } else if (std::chrono::steady_clock::now() - lastData >
+                       std::chrono::milliseconds(decoder ? FOUNTAIN_IDLE_TIMEOUT_MS : FOUNTAIN_START_TIMEOUT_MS)) {
+                break;
+            }
+            continue;
+        }
+        if (rx[0] != SOF_FOUNTAIN) {
+            resync();
+            continue;
+        }
+        if (need == FOUNTAIN_HEADER_SIZE) {
+            //   ڿ DataSize ٸ ջ    絿ȭ ( ̸ŭ ٸ ʵ)
+            uint32_t size = FountainFrame::dataSize(rx.data());
+            if (decoder ? size != static_cast<uint32_t>(results.datasize) : size > static_cast<uint32_t>(FRAME_PAYLOAD_MAX)) {
+                resync();
+            } else {
+                need = FOUNTAIN_OVERHEAD + size;
+            }
+            continue;
+        }
+
+        if (!frame.deserialize(rx.data(), static_cast<int>(need))) {
+            results.corruptFrames++;
+            LiveCounters::add(liveCounters.errors, 1);
+            resync();
+            continue;
+        }
+        rx.erase(rx.begin(), rx.begin() + need);
+        need = FOUNTAIN_HEADER_SIZE;
+
+        if (!decoder) {
+            if (frame.sourceCount == 0 || frame.payload.empty() ||
+                static_cast<long long>(frame.sourceCount) * frame.payload.size() > FOUNTAIN_MAX_BYTES) {
+                results.foreignFrames++;
+                continue;
+            }
+            sessionId = frame.sessionId;
+            pattern = static_cast<PayloadPattern>(frame.pattern);
+            results.sourceFrames = static_cast<int>(frame.sourceCount);
+            results.datasize = static_cast<int>(frame.payload.size());
+            decoder.reset(new FountainDecoder(results.sourceFrames, results.datasize));
+            sourceSeen.assign(results.sourceFrames, 0);
+            start = std::chrono::high_resolution_clock::now();
+            std::ostringstream session;
+            session << std::hex << std::setw(8) << std::setfill('0') << sessionId;
+            logMessage("Receiving broadcast session " + session.str() + ": " + std::to_string(results.sourceFrames) +
+                       " source frames of " + std::to_string(results.datasize) + " bytes");
+        } else if (frame.sessionId != sessionId || frame.sourceCount != static_cast<uint32_t>(results.sourceFrames)) {
+            results.foreignFrames++;
+            continue;
+        }
+
+        results.framesReceived++;
+        LiveCounters::add(liveCounters.framesReceived, 1);
+        LiveCounters::add(liveCounters.bytesReceived, static_cast<long long>(frame.payload.size()));
+        if (frame.symbolId < frame.sourceCount && !sourceSeen[frame.symbolId]) {
+            sourceSeen[frame.symbolId] = 1;
+            results.sourceFramesReceived++;
+        }
+        decoder->addSymbol(frame.symbolId, frame.payload.data());
+    }
+
+    if (!decoder) {
+        logMessage("Error: No broadcast frames received within " + std::to_string(FOUNTAIN_START_TIMEOUT_MS / 1000) + " seconds.");
+        return;
+    }
+    results.complete = decoder->complete();
+    results.completeSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    results.eliminatedFrames = decoder->eliminatedCount();
+    results.recoveredFrames = decoder->recoveredCount() - results.sourceFramesReceived;
+    results.decodeOverhead = static_cast<double>(results.framesReceived) / results.sourceFrames - 1.0;
+    results.throughputMBps = results.complete && results.completeSeconds > 0
+        ? static_cast<double>(results.sourceFrames) * results.datasize / results.completeSeconds / (1024.0 * 1024.0) : 0.0;
+    if (results.complete) {
+        std::vector<char> expected(results.datasize);
+        for (int i = 0; i < results.sourceFrames; ++i) {
+            fillSourcePayload(expected.data(), results.datasize, pattern, i);
+            if (memcmp(expected.data(), decoder->source(i), results.datasize) != 0) {
+                results.payloadErrors++;
+            }
+        }
+    }
+    if (report) *report = results;
+
+    logMessage("=== Broadcast Listener Report ===");
+    logMessage("  - Source frames: " + std::to_string(results.sourceFrames) + " x " + std::to_string(results.datasize) + " bytes");
+    logMessage("  - Recovered: " + std::to_string(decoder->recoveredCount()) + "/" + std::to_string(results.sourceFrames) +
+               (results.complete ? " (complete)" : " (incomplete)"));
+    logMessage("  - Frames used: " + std::to_string(results.framesReceived) + " (" + std::to_string(results.sourceFramesReceived) +
+               " source + " + std::to_string(results.framesReceived - results.sourceFramesReceived) + " repair)");
+    logMessage("  - Source frames rebuilt from repair frames: " + std::to_string(results.recoveredFrames) +
+               " (" + std::to_string(results.eliminatedFrames) + " by Gaussian elimination)");
+    logMessage("  - Corrupt frames dropped: " + std::to_string(results.corruptFrames) +
+               ", other-session frames ignored: " + std::to_string(results.foreignFrames));
+    logMessage("  - Decode overhead: " + std::to_string(results.decodeOverhead * 100.0) + "% (frames used / source frames - 1)");
+    logMessage("  - Time to complete: " + std::to_string(results.completeSeconds) + " seconds");
+    logMessage("  - Throughput: " + std::to_string(results.throughputMBps) + " MB/s");
+    logMessage("  - Payload errors: " + std::to_string(results.payloadErrors));
+    logMessage("=========================");
+    if (!results.complete) {
+        logMessage("Error: Broadcast ended before all source frames were recovered (" +
+                   std::to_string(decoder->recoveredCount()) + "/" + std::to_string(results.sourceFrames) + ").");
+        return;
+    }
+
+    JsonRecord finalRecord = resultWriter.beginFinal();
+    finalRecord.add("baudrate", baudrate)
+               .add("datasize", results.datasize)
+               .add("sourceFrames", results.sourceFrames)
+               .add("framesReceived", results.framesReceived)
+               .add("sourceFramesReceived", results.sourceFramesReceived)
+               .add("recoveredFrames", results.recoveredFrames)
+               .add("eliminatedFrames", results.eliminatedFrames)
+               .add("corruptFrames", results.corruptFrames)
+               .add("foreignFrames", results.foreignFrames)
+               .add("decodeOverhead", results.decodeOverhead)
+               .add("completeSeconds", results.completeSeconds)
+               .add("throughputMBps", results.throughputMBps)
+               .add("payloadErrors", results.payloadErrors);
+    resultWriter.writeFinal(finalRecord);
+    liveCounters.phase.store(LIVE_PHASE_DONE, std::memory_order_relaxed);
+}
+
+// ==========================================================
+// Bench Mode: Ʈ   Selective Repeat  ó Ѱ 
+// ==========================================================
+// client/server   μ  忡 ϰ ޸ ä(mem: Ʈ) 
+// clientMode/serverMode  Phase 1/2  ״ Ͽ /, MB/s,
+// Ӵ CPU ð Ҵ Ƚ datasize x ִ  պ 
+const int BENCH_BAUDRATE = 12000000;  // ŸӾƿ   Ʈ (޸ ä ӵ  )
+
+// μ CPU ð (user + kernel, )
+double processCpuSeconds() {
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return 0.0;
+    }
+    uint64_t kernel = (static_cast<uint64_t>(kernelTime.dwHighDateTime) << 32) | kernelTime.dwLowDateTime;
+    uint64_t user = (static_cast<uint64_t>(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime;
+    return (kernel + user) / 1e7;  // FILETIME : 100ns
+}
+
+// "64,1024,4096"     Ľ
+bool parseIntList(const std::string& text, std::vector<int>& values) {
+    std::istringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        char* end = nullptr;
+        long value = strtol(item.c_str(), &end, 10);
+        if (item.empty() || *end != '\0' || value <= 0) {
+            return false;
+        }
+        values.push_back(static_cast<int>(value));
+    }
+    return !values.empty();
+}
+
+// ȯ:      ְ޾ true
+bool benchMode(const std::vector<int>& datasizes, int num, const std::vector<int>& windows, const std::string& jsonPath) {
+    if (num <= 0) {
+        logMessage("Error: bench needs a positive frame count (streaming sessions run until Ctrl+C).");
+        return false;
+    }
+    std::ofstream json;
+    if (!jsonPath.empty()) {
+        json.open(jsonPath.c_str(), std::ios::out | std::ios::trunc);
+        if (!json.is_open()) {
+            logMessage("Error: Failed to open JSON output file '" + jsonPath + "'.");
+            return false;
+        }
+    }
+
+    //    α״ α Ͽ ϰ ֿܼ  ǥ 
+    consoleLogging = false;
+    autoDebugMode = false;
+    const int savedWindowLimit = windowSizeLimit;
+
+    const double lineMBps = BENCH_BAUDRATE / 10.0 / (1024.0 * 1024.0);
+    std::cout << "In-process benchmark: " << num << " frames per direction, memory channel (no baud limit)" << std::endl;
+    std::cout << "Reference: " << BENCH_BAUDRATE / 1000000 << " Mbaud line rate = " << lineMBps << " MB/s" << std::endl;
+    std::cout << "Window policy: " << windowPolicyName << " (window column = maximum window)" << std::endl;
+    std::cout << "Payload: " << payloadName << ", compression: " << (compressPayloads ? "lz4" : "off")
+              << " (MB/s = uncompressed frame bytes, ratio = payload / wire payload)" << std::endl;
+    std::cout << "FEC parity: " << fecParityRequested << " bytes per codeword, injected BER: " << injectedBitErrorRate
+              << " (repaired = Phase 2 frames fixed by FEC without retransmission)" << std::endl;
+    if (injectedOutageIntervalMs > 0) {
+        std::cout << "Injected disconnect: every " << injectedOutageIntervalMs << " ms for " << MEMORY_OUTAGE_MS
+                  << " ms (retx includes frames resent after each reconnect)" << std::endl;
+    }
+    std::cout << "Frame size: " << (adaptiveFrameSize ? "adaptive from datasize" : "fixed")
+              << " (frame = average Phase 2 payload bytes per frame)" << std::endl;
+    std::cout << "Frame header: " << (compactHeaderRequested ? "compact (--compact-header)" : "fixed") << std::endl;
+    std::cout << "Messages: msg/s = Phase 2 application messages per second, hdr eff = message bytes / (payload + frame header) bytes"
+              << " (without --payload messages every frame is one message)" << std::endl;
+    std::cout << "Control traffic: " << controlRate << " msg/s, mux schedule " << muxScheduleName
+              << (muxScheduleName == "wfq" ? " (weight " + std::to_string(muxWeight) + ")" : std::string())
+              << " (ctl p50/p99 = Phase 1 channel message latency in ms, queued to ACK)" << std::endl;
+    std::cout << std::left << std::setw(10) << "datasize" << std::setw(8) << "window"
+              << std::right << std::setw(12) << "P1 frm/s" << std::setw(12) << "P2 frm/s"
+              << std::setw(12) << "frames/s" << std::setw(10) << "MB/s" << std::setw(10) << "x line"
+              << std::setw(12) << "CPU us/frm" << std::setw(12) << "alloc/frm" << std::setw(8) << "retx"
+              << std::setw(8) << "ratio" << std::setw(10) << "repaired" << std::setw(8) << "frame"
+              << std::setw(12) << "msg/s" << std::setw(9) << "hdr eff" << std::setw(9) << "ctl p50"
+              << std::setw(9) << "ctl p99" << std::endl;
+
+    int runIndex = 0;
+    bool allOk = true;
+    for (size_t d = 0; d < datasizes.size(); ++d) {
+        for (size_t w = 0; w < windows.size(); ++w) {
+            const int datasize = datasizes[d];
+            const int window = std::max(WINDOW_SIZE_MIN, std::min(windows[w], WINDOW_SIZE_MAX));
+            windowSizeLimit = window;
+
+            const std::string link = std::string(MEMORY_PORT_PREFIX) + "bench" + std::to_string(runIndex++);
+            const long long retransmitsBefore = liveCounters.retransmits.load(std::memory_order_relaxed);
+            const long long allocationsBefore = allocationsSoFar();
+            const double cpuBefore = processCpuSeconds();
+
+            Results report = Results();
+            std::thread serverThread(serverMode, link + "/B", BENCH_BAUDRATE);
+            clientMode(link + "/A", BENCH_BAUDRATE, datasize, num, &report);
+            serverThread.join();
+
+            const double cpuSeconds = processCpuSeconds() - cpuBefore;
+            const long long allocations = allocationsSoFar() - allocationsBefore;
+            const long long retransmits = liveCounters.retransmits.load(std::memory_order_relaxed) - retransmitsBefore;
+
+            const bool ok = report.receivedNum == num && report.phase1Seconds > 0 && report.phase2Seconds > 0;
+            allOk = allOk && ok;
+            const double dataSeconds = report.phase1Seconds + report.phase2Seconds;
+            //   Ӹ ũⰡ ٸǷ Phase 2   ̷ε  ( ũ datasize)
+            const double framePayload = report.receivedNum > 0
+                ? static_cast<double>(report.payloadBytesReceived) / report.receivedNum : static_cast<double>(datasize);
+            const double frameBytes = framePayload + FRAME_OVERHEAD_V3;
+            const double totalFrames = 2.0 * num;
+            const double framesPerSecond = ok ? totalFrames / dataSeconds : 0.0;
+            const double phase1FramesPerSecond = ok ? num / report.phase1Seconds : 0.0;
+            const double phase2FramesPerSecond = ok ? num / report.phase2Seconds : 0.0;
+            const double mbps = framesPerSecond * frameBytes / (1024.0 * 1024.0);
+            const double cpuMicrosPerFrame = cpuSeconds * 1e6 / totalFrames;
+            const double allocationsPerFrame = allocations / totalFrames;
+            const double messagesPerSecond = ok ? report.messagesReceived / report.phase2Seconds : 0.0;
+
+            std::cout << std::left << std::setw(10) << datasize << std::setw(8) << window << std::right << std::fixed;
+            if (ok) {
+                std::cout << std::setprecision(0) << std::setw(12) << phase1FramesPerSecond << std::setw(12) << phase2FramesPerSecond
+                          << std::setw(12) << framesPerSecond << std::setprecision(2) << std::setw(10) << mbps
+                          << std::setw(10) << mbps / lineMBps;
+            } else {
+                std::cout << std::setw(56) << "FAILED (" + lastErrorMessage + ")";
+            }
+            std::cout << std::setprecision(2) << std::setw(12) << cpuMicrosPerFrame << std::setw(12) << allocationsPerFrame
+                      << std::setw(8) << retransmits << std::setw(8) << report.compressionRatio
+                      << std::setw(10) << report.fecRepairedFrames << std::setprecision(0) << std::setw(8) << framePayload
+                      << std::setw(12) << messagesPerSecond << std::setprecision(1) << std::setw(8) << report.headerEfficiency * 100.0
+                      << "%" << std::setprecision(2) << std::setw(9) << report.channelLatencyP50Ms
+                      << std::setw(9) << report.channelLatencyP99Ms << std::endl;
+            std::cout.unsetf(std::ios::fixed);
+
+            if (json.is_open()) {
+                JsonRecord record;
+                record.add("type", "bench")
+                      .add("status", ok ? "ok" : "error")
+                      .add("datasize", datasize)
+                      .add("window", window)
+                      .add("windowPolicy", windowPolicyName)
+                      .add("frames", num)
+                      .add("phase1Seconds", report.phase1Seconds)
+                      .add("phase2Seconds", report.phase2Seconds)
+                      .add("phase1FramesPerSecond", phase1FramesPerSecond)
+                      .add("phase2FramesPerSecond", phase2FramesPerSecond)
+                      .add("framesPerSecond", framesPerSecond)
+                      .add("throughputMBps", mbps)
+                      .add("cpuMicrosPerFrame", cpuMicrosPerFrame)
+                      .add("allocationsPerFrame", allocationsPerFrame)
+                      .add("retransmits", retransmits)
+                      .add("payload", payloadName)
+                      .add("compression", compressPayloads)
+                      .add("compressionRatio", report.compressionRatio)
+                      .add("fecParity", fecParityRequested)
+                      .add("injectedBitErrorRate", injectedBitErrorRate)
+                      .add("injectedDisconnectMs", injectedOutageIntervalMs)
+                      .add("fecCorrectedSymbols", report.fecCorrectedSymbols)
+                      .add("fecRepairedFrames", report.fecRepairedFrames)
+                      .add("fecUncorrectableFrames", report.fecUncorrectableFrames)
+                      .add("adaptiveFrameSize", adaptiveFrameSize)
+                      .add("compactHeader", compactHeaderRequested)
+                      .add("averageFrameSize", framePayload)
+                      .add("messagesReceived", report.messagesReceived)
+                      .add("messagesPerSecond", messagesPerSecond)
+                      .add("headerEfficiency", report.headerEfficiency)
+                      .add("controlRate", controlRate)
+                      .add("mux", muxScheduleName)
+                      .add("channelMessagesSent", report.channelMessagesSent)
+                      .add("channelLatencyP50Ms", report.channelLatencyP50Ms)
+                      .add("channelLatencyP99Ms", report.channelLatencyP99Ms);
+                json << record.str() << std::endl;
+            }
+        }
+    }
+
+    consoleLogging = true;
+    autoDebugMode = true;
+    windowSizeLimit = savedWindowLimit;
+    return allOk;
+}
+
+//   ġũ (--broadcast): broadcast/listen  ޸ äη ϰ datasize  а Ϸ ð 
+// --inject-ber ջŲ  CRC ˻翡 Ƿ ս ȸ м ȣ    
+void benchBroadcastMode(const std::vector<int>& datasizes, int num, const std::string& jsonPath) {
+    std::ofstream json;
+    if (!jsonPath.empty()) {
+        json.open(jsonPath.c_str(), std::ios::out | std::ios::trunc);
+        if (!json.is_open()) {
+            logMessage("Error: Failed to open JSON output file '" + jsonPath + "'.");
+            return;
+        }
+    }
+
+    consoleLogging = false;
+    autoDebugMode = false;
+
+    std::cout << "In-process broadcast benchmark: " << num << " source frames + " << static_cast<int>(std::ceil(num * repairRatio))
+              << " repair frames (--repair-ratio " << repairRatio << "), memory channel, no back channel" << std::endl;
+    std::cout << "Payload: " << payloadName << ", injected BER: " << injectedBitErrorRate
+              << " (used = frames received until decoded, overhead = used / source frames - 1)" << std::endl;
+    std::cout << std::left << std::setw(10) << "datasize" << std::right << std::setw(8) << "sent" << std::setw(8) << "used"
+              << std::setw(9) << "corrupt" << std::setw(11) << "recovered" << std::setw(10) << "overhead"
+              << std::setw(14) << "complete ms" << std::setw(10) << "MB/s" << std::endl;
+
+    for (size_t d = 0; d < datasizes.size(); ++d) {
+        const int datasize = datasizes[d];
+        const std::string link = std::string(MEMORY_PORT_PREFIX) + "broadcast" + std::to_string(d);
+
+        BroadcastResults sent = BroadcastResults();
+        BroadcastResults heard = BroadcastResults();
+        std::atomic<bool> sending(true);
+        std::thread sender([&] {
+            broadcastMode(link + "/A", BENCH_BAUDRATE, datasize, num, &sent);
+            sending = false;
+        });
+        listenMode(link + "/B", BENCH_BAUDRATE, &heard);
+        //  ģ ڿ ۽        ֵ ä 
+        SerialPort drain;
+        if (drain.open(link + "/B", BENCH_BAUDRATE)) {
+            char sink[4096];
+            while (sending) {
+                drain.read(sink, sizeof(sink), 10);
+            }
+        }
+        sender.join();
+
+        const bool ok = heard.complete && heard.payloadErrors == 0;
+        std::cout << std::left << std::setw(10) << datasize << std::right << std::setw(8) << sent.framesSent;
+        if (ok) {
+            std::cout << std::setw(8) << heard.framesReceived << std::setw(9) << heard.corruptFrames
+                      << std::setw(11) << heard.recoveredFrames << std::fixed << std::setprecision(2)
+                      << std::setw(9) << heard.decodeOverhead * 100.0 << "%" << std::setprecision(1)
+                      << std::setw(14) << heard.completeSeconds * 1000.0 << std::setprecision(2)
+                      << std::setw(10) << heard.throughputMBps << std::endl;
+            std::cout.unsetf(std::ios::fixed);
+        } else {
+            std::cout << "  FAILED (" << lastErrorMessage << ")" << std::endl;
+        }
+
+        if (json.is_open()) {
+            JsonRecord record;
+            record.add("type", "bench_broadcast")
+                  .add("status", ok ? "ok" : "error")
+                  .add("datasize", datasize)
+                  .add("sourceFrames", num)
+                  .add("repairRatio", repairRatio)
+                  .add("payload", payloadName)
+                  .add("injectedBitErrorRate", injectedBitErrorRate)
+                  .add("framesSent", sent.framesSent)
+                  .add("framesReceived", heard.framesReceived)
+                  .add("corruptFrames", heard.corruptFrames)
+                  .add("recoveredFrames", heard.recoveredFrames)
+                  .add("eliminatedFrames", heard.eliminatedFrames)
+                  .add("decodeOverhead", heard.decodeOverhead)
+                  .add("completeSeconds", heard.completeSeconds)
+                  .add("throughputMBps", heard.throughputMBps);
+            json << record.str() << std::endl;
+        }
+    }
+
+    consoleLogging = true;
+    autoDebugMode = true;
+}
+
@@ -0,0 +1,585 @@
+// ==========================================================
+// SerialProtocol:    Ʈ I/O Լ  (  SerialProtocol.h)
+// ==========================================================
+#include "SerialProtocol.h"
+
+namespace serialcomm {
+
+// ==========================================================
+//  
+// ==========================================================
+std::ofstream logFile;      // α  Ʈ
+std::mutex logMutex;        // α  ȭ ؽ
+std::string lastErrorMessage;  //  "Error:" α (JSON    )
+bool consoleLogging = true;    // false̸ α Ͽ  (bench 忡 ǥ ¸   )
+thread_local LogSink* threadLogSink = nullptr;
+bool debugMode = false;  //   Ȱȭ 
+int windowSizeLimit = WINDOW_SIZE_LEGACY_MAX;  //   ִ  (--window-max, bench 忡 WINDOW_SIZE_MIN-WINDOW_SIZE_MAX  )
+double injectedBitErrorRate = 0.0;       // ޸ äο  Ʈ  (--inject-ber, bench   ȸ )
+int linkRecoverySeconds = 60;            //  Ʈ ٽ   ִ ð (--reconnect, , 0 =  ٷ )
+int injectedOutageIntervalMs = 0;        // ޸ ä ֱ   (--inject-disconnect, и, 0 =  )
+std::atomic<bool> streamStopRequested(false);  // Ʈ   û (Ctrl+C,    )
+LiveCounters liveCounters;  // μ  ǽð ī
+std::atomic<long long> fixedSleepCount(0);
+std::atomic<long long> fixedSleepMicros(0);
+
+// ==========================================================
+//  α 
+// ==========================================================
+void logMessage(const std::string& message) {
+    std::lock_guard<std::mutex> lock(logMutex);
+    auto t = std::time(nullptr);
+    auto tm = *std::localtime(&t);
+    logFile << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << " - " << message << std::endl;
+    if (threadLogSink ? threadLogSink->console : consoleLogging) {
+        std::cout << message << std::endl;
+    }
+    if (message.compare(0, 6, "Error:") == 0) {
+        (threadLogSink ? threadLogSink->lastError : lastErrorMessage) = message;
+    }
+}
+
+void traceMessage(const std::string& message) {
+    std::lock_guard<std::mutex> lock(logMutex);
+    auto t = std::time(nullptr);
+    auto tm = *std::localtime(&t);
+    logFile << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << " - [TRACE] " << message << std::endl;
+}
+
+// ==========================================================
+// μ  ޸ ä (bench )
+// ==========================================================
+std::shared_ptr<MemoryLink> attachMemoryLink(const std::string& name) {
+    static std::mutex registryMutex;
+    static std::map<std::string, std::weak_ptr<MemoryLink> > registry;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::shared_ptr<MemoryLink> link = registry[name].lock();
+    if (!link) {
+        link = std::make_shared<MemoryLink>();
+        registry[name] = link;
+    }
+    return link;
+}
+
+// ==========================================================
+//    (ȸ    ܿ Ʈ ó)
+// ==========================================================
+bool sendSyncFrame(SerialPort& serial, uint8_t flags, uint32_t seq, uint32_t ack) {
+    SyncFrame frame;
+    frame.flags = flags;
+    frame.seq = seq;
+    frame.ack = ack;
+    std::vector<char> buffer;
+    frame.serialize(buffer);
+    return serial.write(buffer.data(), SYNC_FRAME_SIZE) == SYNC_FRAME_SIZE;
+}
+
+void skipToNextStart(SerialPort& serial, const char* buffer, int length, char sof) {
+    int next = 1;
+    while (next < length && buffer[next] != sof && buffer[next] != SOF_SYNC) {
+        next++;
+    }
+    serial.unread(buffer + next, length - next);
+    LOG_DEBUG("Frame boundary lost: skipped " + std::to_string(next) + " bytes");
+}
+
+bool realignFrame(SerialPort& serial, const char* buffer, int length, char sof, int eofOffset) {
+    if (buffer[0] == sof && (eofOffset < 0 || buffer[eofOffset] == EOF_BYTE)) {
+        return false;
+    }
+    skipToNextStart(serial, buffer, length, sof);
+    return true;
+}
+
+void discardFrame(SerialPort& serial, const char* buffer, int length, int fecParity) {
+    if (fecParity == 0) {
+        skipToNextStart(serial, buffer, length, SOF);
+    }
+}
+
+bool readStreamSyncFrame(SerialPort& serial, SyncFrame& frame, DWORD timeoutMs) {
+    char buffer[SYNC_FRAME_SIZE];
+    int received = serial.read(buffer, SYNC_FRAME_SIZE, timeoutMs);
+    if (received == SYNC_FRAME_SIZE && frame.deserialize(buffer, SYNC_FRAME_SIZE)) {
+        return true;
+    }
+    if (received > 1) {
+        serial.unread(buffer + 1, received - 1);
+    }
+    return false;
+}
+
+// ==========================================================
+//   å (WindowManager  ũ  )
+// ==========================================================
+std::unique_ptr<WindowPolicy> makeWindowPolicy(const std::string& name, int baudrate, int frameSize) {
+    if (name == "legacy") return std::unique_ptr<WindowPolicy>(new LegacyWindowPolicy());
+    if (name == "aimd") return std::unique_ptr<WindowPolicy>(new AimdWindowPolicy());
+    if (name == "bdp") return std::unique_ptr<WindowPolicy>(new BdpWindowPolicy(baudrate, frameSize));
+    if (name == "fixed") return std::unique_ptr<WindowPolicy>(new FixedWindowPolicy());
+    return std::unique_ptr<WindowPolicy>();
+}
+
+// ==========================================================
+// READY ACK ȭ Լ (Phase 3  ȯ)
+// ==========================================================
+bool sendReadyAck(SerialPort& serial) {
+    int sent = serial.write(READY_ACK, READY_ACK_LEN);
+    if (sent == READY_ACK_LEN) {
+        logMessage("READY ACK sent.");
+        return true;
+    }
+    logMessage("Error: Failed to send READY ACK.");
+    return false;
+}
+
+bool waitForReadyAck(SerialPort& serial) {
+    logMessage("Waiting for READY ACK...");
+    
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    int matched = 0;  // ݱ ġ  
+    
+    while (true) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) break;
+        DWORD remainingMs = static_cast<DWORD>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count()) + 1;
+        
+        char byte;
+        if (serial.read(&byte, 1, remainingMs) != 1) {
+            continue;  // ŸӾƿ Ǵ Ͻ :  ð   
+        }
+        
+        // READY  SOF_ACKθ ٽ   Ƿ ġ  SOF_ACK θ Ȯ
+        if (byte == READY_ACK[matched]) {
+            matched++;
+        } else {
+            matched = (byte == SOF_ACK) ? 1 : 0;
+        }
+        if (matched == READY_ACK_LEN) {
+            logMessage("READY ACK received.");
+            return true;
+        }
+    }
+    
+    logMessage("Error: Timeout waiting for READY ACK (30 seconds).");
+    return false;
+}
+
+// ==========================================================
+//  ۼ (TLV  ޽ Ǵ   raw ü)
+// ==========================================================
+bool readExact(SerialPort& serial, char* buffer, int length,
+               std::chrono::steady_clock::time_point deadline) {
+    int total = 0;
+    while (total < length) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (remaining <= 0) return false;
+        int bytesRead = serial.read(buffer + total, length - total, static_cast<DWORD>(remaining));
+        if (bytesRead < 0) return false;
+        total += bytesRead;
+    }
+    return true;
+}
+
+int stripFrameCrc(SerialPort& serial, char* buffer, int length) {
+    if (!checkFrameCrc(buffer, length)) {
+        skipToNextStart(serial, buffer, length, SOF);
+        return FRAME_READ_CRC;
+    }
+    buffer[length - 1 - FRAME_CRC_SIZE] = EOF_BYTE;
+    return length - FRAME_CRC_SIZE;
+}
+
+int readCompactRest(SerialPort& serial, char* buffer, int firstRead, int payloadSize, bool compressedFormat,
+                    int compactSequence, bool frameCrc, DWORD timeoutMs) {
+    const uint8_t flags = static_cast<uint8_t>(buffer[1]);
+    const int lengthBytes = compactLengthBytes(flags);
+    if (buffer[0] != SOF || (lengthBytes > 0) != compressedFormat ||
+        ((flags & FRAME_FLAG_SEQ16) != 0) != (compactSequence > 1)) {
+        skipToNextStart(serial, buffer, firstRead, SOF);
+        return -1;
+    }
+    const int headerSize = compactHeaderSize(flags);
+    const int trailer = FRAME_TRAILER_V3 + (frameCrc ? FRAME_CRC_SIZE : 0);
+    int total = headerSize + payloadSize + trailer;
+    if (compressedFormat) {
+        if (serial.read(buffer + firstRead, headerSize - firstRead, timeoutMs) != headerSize - firstRead) {
+            return -1;
+        }
+        uint32_t storedLength = 0;
+        memcpy(&storedLength, buffer + headerSize - lengthBytes, lengthBytes);
+        if (storedLength > static_cast<uint32_t>(payloadSize)) {
+            skipToNextStart(serial, buffer, headerSize, SOF);
+            return -1;
+        }
+        firstRead = headerSize;
+        total = headerSize + static_cast<int>(storedLength) + trailer;
+    }
+    if (total > firstRead && serial.read(buffer + firstRead, total - firstRead, timeoutMs) != total - firstRead) {
+        return -1;
+    }
+    if (realignFrame(serial, buffer, total, SOF, total - 1)) {
+        return -1;
+    }
+    return frameCrc ? stripFrameCrc(serial, buffer, total) : total;
+}
+
+int readDataFrame(SerialPort& serial, std::vector<char>& receiveBuffer, int payloadSize, bool compressedFormat,
+                  int compactSequence, int fecParity, FecStats& fec, DWORD timeoutMs, bool frameCrc) {
+    char* buffer = receiveBuffer.data();
+    frameCrc = frameCrc && fecParity == 0;
+    const int trailer = FRAME_TRAILER_V3 + (frameCrc ? FRAME_CRC_SIZE : 0);
+    
+    //     (    ü   )
+    const int headerSize = (compressedFormat ? FRAME_HEADER_Z : FRAME_HEADER_V3) - 1;
+    const int wireHeader = 1 + fecEncodedSize(headerSize, fecParity);
+    const int compactMin = FRAME_HEADER_COMPACT_MIN + compactSequence - 1 + (compressedFormat ? 1 : 0);
+    int firstRead = compactSequence > 0 ? (compressedFormat ? compactMin : compactMin + payloadSize + trailer)
+                  : compressedFormat ? wireHeader : dataFrameWireSize(payloadSize, false, fecParity, frameCrc);
+    int received = serial.read(buffer, firstRead, timeoutMs);
+    if (received != firstRead) {
+        if (received > 0) serial.unread(buffer, received);
+        return -1;
+    }
+    if (buffer[0] == SOF_SYNC) {
+        serial.unread(buffer, firstRead);
+        return FRAME_READ_SYNC;
+    }
+    if (compactSequence > 0) {
+        return readCompactRest(serial, buffer, firstRead, payloadSize, compressedFormat, compactSequence, frameCrc, timeoutMs);
+    }
+    if (realignFrame(serial, buffer, firstRead, SOF, compressedFormat ? -1 : firstRead - 1)) {
+        return -1;
+    }
+    if (!compressedFormat && fecParity == 0) {
+        return frameCrc ? stripFrameCrc(serial, buffer, firstRead) : firstRead;
+    }
+    
+    int corrected = fecRepair(buffer + 1, buffer + 1, headerSize, fecParity);
+    bool uncorrectable = corrected < 0;
+    corrected = std::max(corrected, 0);
+    
+    int bodySize = payloadSize;
+    if (compressedFormat) {
+        uint32_t storedLength;
+        memcpy(&storedLength, buffer + FRAME_HEADER_Z - 4, sizeof(uint32_t));
+        if (buffer[0] != SOF || storedLength > static_cast<uint32_t>(payloadSize)) {
+            if (!uncorrectable) return -1;
+            fec.uncorrectableFrames++;
+            return FRAME_READ_FEC_UNCORRECTABLE;
+        }
+        bodySize = static_cast<int>(storedLength);
+        int remaining = fecEncodedSize(bodySize, fecParity) + trailer;
+        if (serial.read(buffer + wireHeader, remaining, timeoutMs) != remaining) {
+            return -1;
+        }
+        if (fecParity == 0) {
+            const int total = wireHeader + remaining;
+            return frameCrc ? stripFrameCrc(serial, buffer, total) : total;
+        }
+    }
+    
+    //  :  Ʈ  ٷ ڷ  EOF  ڷ ű
+    const int plainHeader = 1 + headerSize;
+    char eof = buffer[wireHeader + fecEncodedSize(bodySize, fecParity)];
+    int bodyCorrected = fecRepair(buffer + wireHeader, buffer + plainHeader, bodySize, fecParity);
+    buffer[plainHeader + bodySize] = eof;
+    if (bodyCorrected < 0) {
+        uncorrectable = true;
+    } else {
+        corrected += bodyCorrected;
+    }
+    
+    if (uncorrectable) {
+        fec.uncorrectableFrames++;
+        return FRAME_READ_FEC_UNCORRECTABLE;
+    }
+    if (corrected > 0) {
+        fec.correctedSymbols += corrected;
+        fec.repairedFrames++;
+    }
+    return plainHeader + bodySize + FRAME_TRAILER_V3;
+}
+
+bool readControlMessage(SerialPort& serial, char type, std::chrono::steady_clock::time_point deadline,
+                        const std::string& what, const std::string& source,
+                        std::vector<char>& message, int& bodyLength, int& version) {
+    //  ȭ: [SOF_CTRL][type]    1Ʈ ̵
+    char header[CTRL_HEADER_SIZE];
+    int skipped = 0;
+    if (!readExact(serial, header, 2, deadline)) {
+        logMessage("Error: Timeout waiting for " + what + " header from " + source + ".");
+        return false;
+    }
+    while (header[0] != SOF_CTRL || header[1] != type) {
+        header[0] = header[1];
+        skipped++;
+        if (!readExact(serial, header + 1, 1, deadline)) {
+            logMessage("Error: Timeout waiting for " + what + " header from " + source + 
+                       " (skipped " + std::to_string(skipped) + " bytes).");
+            return false;
+        }
+    }
+    if (skipped > 0) {
+        logMessage("Warning: Skipped " + std::to_string(skipped) + " stray bytes before " + what + " from " + source + ".");
+    }
+    if (!readExact(serial, header + 2, CTRL_HEADER_SIZE - 2, deadline)) {
+        logMessage("Error: Timeout reading " + what + " header from " + source + ".");
+        return false;
+    }
+
+    version = static_cast<uint8_t>(header[2]);
+    bodyLength = static_cast<int>(getLE(header + 3, 2));
+    message.assign(header, header + CTRL_HEADER_SIZE);
+    message.resize(CTRL_HEADER_SIZE + bodyLength + CTRL_TRAILER_SIZE);
+    if (!readExact(serial, message.data() + CTRL_HEADER_SIZE, bodyLength + CTRL_TRAILER_SIZE, deadline)) {
+        logMessage("Error: Timeout reading " + what + " body from " + source + 
+                   " (" + std::to_string(bodyLength) + " bytes expected).");
+        return false;
+    }
+
+    uint32_t expectedCrc = static_cast<uint32_t>(getLE(message.data() + CTRL_HEADER_SIZE + bodyLength, 4));
+    if (message.back() != EOF_BYTE || crc32(message.data() + 1, CTRL_HEADER_SIZE - 1 + bodyLength) != expectedCrc) {
+        logMessage("Error: " + what + " message from " + source + " failed CRC/EOF validation.");
+        return false;
+    }
+    return true;
+}
+
+bool sendResults(SerialPort& serial, const Results& results, bool tlvFormat) {
+    std::vector<char> buffer;
+    if (tlvFormat) {
+        encodeResults(results, buffer);
+    } else {
+        LegacyResults legacy = {results.totalReceivedBytes, saturateInt32(results.receivedNum),
+                    saturateInt32(results.errorCount), saturateInt32(results.retransmitCount),
+                    results.elapsedSeconds, results.throughputMBps, results.charactersPerSecond};
+        buffer.assign(reinterpret_cast<char*>(&legacy), reinterpret_cast<char*>(&legacy) + sizeof(legacy));
+    }
+    return serial.write(buffer.data(), buffer.size()) == static_cast<int>(buffer.size());
+}
+
+bool readResults(SerialPort& serial, Results& results, const std::string& source, bool tlvFormat) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(15000);
+    logMessage("Attempting to read results from " + source + " (" +
+               (tlvFormat ? "TLV v" + std::to_string(RESULTS_MSG_VERSION) : std::string("legacy")) + " format)...");
+
+    if (!tlvFormat) {
+        LegacyResults legacy;
+        if (!readExact(serial, reinterpret_cast<char*>(&legacy), sizeof(legacy), deadline)) {
+            logMessage("Error: Timeout reading legacy results from " + source + ".");
+            return false;
+        }
+        results = Results();
+        results.totalReceivedBytes = legacy.totalReceivedBytes;
+        results.receivedNum = legacy.receivedNum;
+        results.errorCount = legacy.errorCount;
+        results.retransmitCount = legacy.retransmitCount;
+        results.elapsedSeconds = legacy.elapsedSeconds;
+        results.throughputMBps = legacy.throughputMBps;
+        results.charactersPerSecond = legacy.charactersPerSecond;
+        logMessage("Results successfully received from " + source + " (" + std::to_string(sizeof(legacy)) + " bytes).");
+        return true;
+    }
+
+    std::vector<char> message;
+    int bodyLength = 0;
+    int version = 0;
+    if (!readControlMessage(serial, CTRL_TYPE_RESULTS, deadline, "results", source, message, bodyLength, version)) {
+        return false;
+    }
+    if (!decodeResults(message.data() + CTRL_HEADER_SIZE, bodyLength, results)) {
+        logMessage("Error: Malformed TLV body in results from " + source + ".");
+        return false;
+    }
+
+    logMessage("Results successfully received from " + source + " (" + std::to_string(message.size()) + 
+               " bytes, message version " + std::to_string(version) + ").");
+    return true;
+}
+
+bool sendCapabilities(SerialPort& serial, const Capabilities& caps) {
+    std::vector<char> buffer;
+    encodeCapabilities(caps, buffer);
+    return serial.write(buffer.data(), buffer.size()) == static_cast<int>(buffer.size());
+}
+
+bool readCapabilities(SerialPort& serial, Capabilities& caps, const std::string& source) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(CAPS_REPLY_TIMEOUT_MS);
+    std::vector<char> message;
+    int bodyLength = 0;
+    int version = 0;
+    if (!readControlMessage(serial, CTRL_TYPE_CAPS, deadline, "capabilities", source, message, bodyLength, version)) {
+        return false;
+    }
+    if (!decodeCapabilities(message.data() + CTRL_HEADER_SIZE, bodyLength, caps)) {
+        logMessage("Error: Malformed TLV body in capabilities from " + source + ".");
+        return false;
+    }
+    return true;
+}
+
+std::string describeCapabilities(const Capabilities& caps) {
+    std::string sack = caps.sackFormats == 0 ? "none" :
+                       std::to_string((caps.sackFormats & CAPS_SACK_256) ? 256 :
+                                      (caps.sackFormats & CAPS_SACK_128) ? 128 : 64) + "-bit";
+    return std::string("checksum=") + (caps.checksums & CHECKSUM_XOR_ROTATE ? "xor-rotate" : "none") +
+           ", sack=" + sack +
+           ", max window=" + std::to_string(caps.maxWindow) +
+           ", compression=" + (caps.compression == 0 ? std::string("none") : (caps.compression & COMPRESSION_LZ4) ? "lz4" : "mask " + std::to_string(caps.compression)) +
+           ", duplex=" + (caps.fullDuplex ? "full" : "half") +
+           ", max payload=" + std::to_string(caps.maxPayload) +
+           ", ack batch=" + std::to_string(caps.ackBatch) +
+           ", payload=" + ((caps.payloads & PAYLOAD_MESSAGES) ? "messages" : (caps.payloads & PAYLOAD_TELEMETRY) ? "telemetry" : "ramp") +
+           ", fec=" + (caps.fecParity == 0 ? std::string("none") : "rs(255," + std::to_string(RS_CODEWORD_MAX - caps.fecParity) + ")") +
+           ", frame size=" + (caps.adaptiveMax == 0 ? std::string("fixed") : "adaptive up to " + std::to_string(caps.adaptiveMax)) +
+           ", streaming=" + (caps.streaming ? "yes" : "no") +
+           ", credits=" + (caps.credits ? "yes" : "no") +
+           ", ack crc=" + (caps.ackCrc ? "yes" : "no") +
+           ", frame crc=" + (caps.frameCrc ? "yes" : "no") +
+           ", header=" + (caps.compactHeader ? "compact" : "fixed") +
+           ", channels=" + std::to_string(caps.channels) +
+           (caps.controlRate > 0 ? " (control " + std::to_string(caps.controlRate) + " msg/s)" : "");
+}
+
+// ==========================================================
+//  ȭ Լ (Phase 0 , SYN / SYN-ACK)
+// ==========================================================
+bool readSyncFrame(SerialPort& serial, SyncFrame& frame, std::chrono::steady_clock::time_point deadline,
+                   bool sofRead) {
+    char buffer[SYNC_FRAME_SIZE];
+    buffer[0] = SOF_SYNC;
+    while (true) {
+        if (!sofRead) {
+            do {
+                if (!readExact(serial, buffer, 1, deadline)) return false;
+            } while (buffer[0] != SOF_SYNC);
+        }
+        sofRead = false;
+        if (!readExact(serial, buffer + 1, SYNC_FRAME_SIZE - 1, deadline)) return false;
+        if (frame.deserialize(buffer, SYNC_FRAME_SIZE)) {
+            return true;
+        }
+        LOG_DEBUG("Discarding corrupted sync frame");
+    }
+}
+
+uint32_t randomSyncSeq() {
+    return std::random_device()() ^ static_cast<uint32_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+ConnectResult connectToServer(SerialPort& serial) {
+    if (!serial.purge()) {
+        logMessage("Warning: Failed to purge buffers before SYN.");
+    }
+    const uint32_t seq = randomSyncSeq();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(SYNC_TIMEOUT_MS);
+    int retryMs = SYNC_RETRY_MIN_MS;
+    int attempts = 0;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (!sendSyncFrame(serial, SYNC_FLAG_SYN, seq, 0)) {
+            logMessage("Error: Failed to send SYN to server.");
+            return CONNECT_FAILED;
+        }
+        attempts++;
+        auto retryAt = std::min(deadline, std::chrono::steady_clock::now() + std::chrono::milliseconds(retryMs));
+        SyncFrame reply;
+        while (readSyncFrame(serial, reply, retryAt)) {
+            if (reply.flags == (SYNC_FLAG_SYN | SYNC_FLAG_ACK) && reply.ack == seq + 1) {
+                logMessage("SYN-ACK received from server (attempt " + std::to_string(attempts) + ").");
+                return CONNECT_OK;
+            }
+            LOG_DEBUG("Ignoring stale sync frame (ack=" + std::to_string(reply.ack) + ")");
+        }
+        retryMs = std::min(retryMs * 2, SYNC_RETRY_MAX_MS);
+    }
+    logMessage("No SYN-ACK from server within " + std::to_string(SYNC_TIMEOUT_MS / 1000) + " seconds (" +
+               std::to_string(attempts) + " SYNs sent).");
+    return CONNECT_NO_REPLY;
+}
+
+int readSettingsAck(SerialPort& serial, char* ack, std::chrono::steady_clock::time_point deadline) {
+    SyncFrame duplicate;
+    while (readExact(serial, ack, 1, deadline)) {
+        if (ack[0] != SOF_SYNC) {
+            return readExact(serial, ack + 1, 2, deadline) ? 3 : 1;
+        }
+        if (!readSyncFrame(serial, duplicate, deadline, true)) {
+            break;
+        }
+        LOG_DEBUG("Skipping duplicate SYN-ACK before settings ACK");
+    }
+    return 0;
+}
+
+bool acceptClient(SerialPort& serial, Settings& settings) {
+    char* raw = reinterpret_cast<char*>(&settings);
+    const uint32_t seq = randomSyncSeq();
+    uint32_t clientSeq = 0;
+    bool synced = false;
+    int skipped = 0;
+    while (raw[0] != SOF_SYNC && (raw[0] < 1 || raw[0] > PROTOCOL_VERSION)) {
+        skipped++;
+        if (serial.read(raw, 1, SYNC_TIMEOUT_MS) != 1) {
+            logMessage("Skipped " + std::to_string(skipped) + " stray bytes; no SYN or settings followed.");
+            return false;
+        }
+    }
+    if (skipped > 0) {
+        logMessage("Warning: Skipped " + std::to_string(skipped) + " stray bytes before the client's first message.");
+    }
+    while (raw[0] == SOF_SYNC) {
+        SyncFrame syn;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(SYNC_TIMEOUT_MS);
+        if (!readSyncFrame(serial, syn, deadline, true)) {
+            logMessage("Incomplete SYN from client.");
+            return false;
+        }
+        if (syn.flags == SYNC_FLAG_SYN) {
+            if (!synced || syn.seq != clientSeq) {
+                logMessage("SYN received from client.");
+            } else {
+                LOG_DEBUG("Duplicate SYN from client");
+            }
+            synced = true;
+            clientSeq = syn.seq;
+            if (!sendSyncFrame(serial, SYNC_FLAG_SYN | SYNC_FLAG_ACK, seq, syn.seq + 1)) {
+                logMessage("Failed to send SYN-ACK to client.");
+                return false;
+            }
+        }
+        //  ޽: ۵ SYN Ǵ Settings
+        if (serial.read(raw, 1, SYNC_TIMEOUT_MS) != 1) {
+            logMessage("Client sent no settings within " + std::to_string(SYNC_TIMEOUT_MS / 1000) + " seconds after SYN-ACK.");
+            return false;
+        }
+    }
+    int rest = serial.read(raw + 1, sizeof(Settings) - 1);
+    if (rest != static_cast<int>(sizeof(Settings) - 1)) {
+        logMessage("Incomplete settings from client (" + std::to_string(1 + std::max(rest, 0)) + " of " +
+                   std::to_string(sizeof(Settings)) + " bytes).");
+        return false;
+    }
+    return true;
+}
+
+int receiveCredit(SerialPort& serial, int frameBytes) {
+    return std::max(0, SERIAL_QUEUE_BYTES - serial.queuedBytes()) / std::max(frameBytes, 1);
+}
+
+void resumeReceiving(SerialPort& serial, long long nextExpected, const SyncFrame* sync) {
+    uint8_t flags = SYNC_FLAG_RESUME;
+    if (sync) {
+        //   RESUME  ̰ų ݴ  ܰ迡  ̸  
+        if (!(sync->flags & SYNC_FLAG_RESUME) || !(sync->flags & SYNC_FLAG_SENDER) || (sync->flags & SYNC_FLAG_ACK)) {
+            return;
+        }
+        flags |= SYNC_FLAG_ACK;
+    }
+    logMessage("Link resumed" + std::string(sync ? " by sender" : "") + ": expecting frame " + std::to_string(nextExpected) + ".");
+    sendSyncFrame(serial, flags, 0, static_cast<uint32_t>(nextExpected));
+}
+
+}  // namespace serialcomm
@@ -0,0 +1,5144 @@
+// ==========================================================
+// SerialProtocol: , , ARQ   ڵũ
+// ==========================================================
+// SerialCommunicator(CLI), Library(SerialLink), Benchmark Բ   
+// Ŭ inline Լ  ,   Ʈ I/O Լ SerialProtocol.cpp 
+//  (logFile, debugMode, ī ) serialcomm ̸ ξ ̺귯 ȣƮ ɺ 浹 ʰ 
+#pragma once
+
+// Windows.h min/max ũ 浹 
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+// winsock2.h windows.h  ؾ  (winsock.h ߺ  )
+#include <winsock2.h>
+#include <windows.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <ctime>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <mutex>
+#include <set>
+#include <map>
+#include <queue>
+#include <condition_variable>
+#include <memory>
+#include <new>
+#include <cstdlib>
+#include <cmath>
+#include <climits>
+#include <deque>
+#include <cstdio>
+#include <random>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace serialcomm {
+
+// ==========================================================
+// Protocol Version 4: ȭ Selective Repeat ARQ with Burst Transmission
+// 
+//  Ư¡:
+// - Selective Repeat ARQ: ̵     
+// -   ũ : Ʈũ ¿  4-32  ڵ 
+// - Ʈ  ACK: 32  ¸   Ȯ
+// - Ƽ : Sender/Receiver  и  ȭ
+// -  ACK :    ACK   ּȭ
+// - 3-way Handshake:  ȯ  Ȯ ȭ
+// - Burst :  ũ⿡  ȭ Ʈ 
+// ==========================================================
+
+// ==========================================================
+//  α 
+// ==========================================================
+extern std::ofstream logFile;      // α  Ʈ
+extern std::mutex logMutex;        // α  ȭ ؽ
+extern std::string lastErrorMessage;  //  "Error:" α (JSON    )
+extern bool consoleLogging;    // false̸ α Ͽ  (bench 忡 ǥ ¸   )
+
+// Ǻ α ó:  μ (̺귯 ũ)    ܼ  ο   Ǹ 
+// 忡 Ǿ    α״ consoleLogging/lastErrorMessage     (logMutex ȣ)
+struct LogSink {
+    bool console;           // ֿܼ 
+    std::string lastError;  //    "Error:" α
+    LogSink() : console(false) {}
+};
+extern thread_local LogSink* threadLogSink;
+
+//     α ó ٲ
+class ScopedLogSink {
+public:
+    explicit ScopedLogSink(LogSink* sink) : saved_(threadLogSink) { threadLogSink = sink; }
+    ~ScopedLogSink() { threadLogSink = saved_; }
+
+private:
+    ScopedLogSink(const ScopedLogSink&);
+    ScopedLogSink& operator=(const ScopedLogSink&);
+    LogSink* saved_;
+};
+
+// Thread-safe α  Լ
+// ְܼ α Ͽ ÿ ޽ 
+void logMessage(const std::string& message);
+
+// α Ͽ  (  ó   Ͽ, ֿܼ  )
+void traceMessage(const std::string& message);
+
+//     (뷮    ڵ Ȱȭ)
+// DEBUG ũΰ ǵ  , debugMode true   α 
+extern bool debugMode;  //   Ȱȭ 
+
+#ifdef DEBUG
+#define LOG_DEBUG(msg) logMessage("[DEBUG] " + std::string(msg))
+#else
+#define LOG_DEBUG(msg) do { if (debugMode) logMessage("[DEBUG] " + std::string(msg)); } while(0)
+#endif
+
+
+// ==========================================================
+// Protocol V4   
+// ==========================================================
+const int PROTOCOL_VERSION = 4;  //   
+
+//   Ʈ (  ĺ)
+const char SOF = 0x02;              // Start of Frame:    Ʈ
+const char SOF_ACK = 0x04;          // Start of ACK Frame: ACK   Ʈ
+const char EOF_BYTE = 0x03;         // End of Frame:    Ʈ
+
+// ̵  ũ  (  )
+const int WINDOW_SIZE_INIT = 16;    // ʱ  ũ ( )
+const int WINDOW_SIZE_MAX = 4096;   // ִ  ũ ( , SACK  )
+const int WINDOW_SIZE_LEGACY_MAX = 32;  // 32Ʈ ACK Ʈʸ   ִ  (⺻ --window-max)
+const int WINDOW_SIZE_MIN = 4;      // ּ  ũ ( )
+extern int windowSizeLimit;  //   ִ  (--window-max, bench 忡 WINDOW_SIZE_MIN-WINDOW_SIZE_MAX  )
+extern double injectedBitErrorRate;       // ޸ äο  Ʈ  (--inject-ber, bench   ȸ )
+extern int linkRecoverySeconds;            //  Ʈ ٽ   ִ ð (--reconnect, , 0 =  ٷ )
+extern int injectedOutageIntervalMs;        // ޸ ä ֱ   (--inject-disconnect, и, 0 =  )
+extern std::atomic<bool> streamStopRequested;  // Ʈ   û (Ctrl+C,    )
+
+//   ŸӾƿ 
+const int MAX_RETRANSMIT_ATTEMPTS = 5;  // ִ  õ Ƚ
+const double TIMEOUT_SAFETY_FACTOR = 2.5;  // ŸӾƿ   ( ð 2.5)
+const int BASE_TIMEOUT_MS = 500;         // ⺻ ŸӾƿ (и)
+const int RESEND_TIMEOUT_MIN_MS = 20;    // Ȯ    ּ  (и)
+const int DAEMON_POLL_MS = 1000;         //     б ֱ ( ⸦  )
+const int LINK_RETRY_MIN_MS = 100;       //  Ʈ ù 翭 õ  (  辿 )
+const int LINK_RETRY_MAX_MS = 2000;      // 翭 õ  
+const int LINK_CHECK_MS = 1000;          // ۽  ð  и Ȯϴ ֱ
+
+//   ũ 
+// V4    : [SOF(1)][FrameNum(4)][WindowSize(2)][Checksum(2)][Payload][EOF(1)]
+// : SOF(1) + FrameNum(4) + WindowSize(2) + Checksum(2) = 9 bytes
+// ƮϷ: EOF(1) = 1 byte
+//  : 10 bytes
+// FrameNum 64Ʈ  ġ  32Ʈ (2^32 Ӹ ȯ, ޴    ġ )
+const int FRAME_HEADER_V3 = 1 + 4 + 2 + 2;  //   ũ: 9 bytes
+const int FRAME_TRAILER_V3 = 1;              //  ƮϷ ũ: 1 byte
+const int FRAME_OVERHEAD_V3 = FRAME_HEADER_V3 + FRAME_TRAILER_V3;  //  : 10 bytes
+
+//     : [SOF(1)][FrameNum(4)][WindowSize(2)][Checksum(2)][Flags(1)][StoredLength(4)][Stored][EOF(1)]
+//   ǿ ϸ, Stored  ̷ε(Flags FRAME_FLAG_COMPRESSED) Ǵ  ̷ε
+// Checksum ׻  ̷ε ̹Ƿ      
+// Ʈ ǵ   ϸ, ۽  ϸ Flags FRAME_FLAG_END_OF_STREAM     ˸
+const int FRAME_HEADER_Z = FRAME_HEADER_V3 + 1 + 4;             //     ũ: 14 bytes
+const int FRAME_OVERHEAD_Z = FRAME_HEADER_Z + FRAME_TRAILER_V3;  //    : 15 bytes
+const uint8_t FRAME_FLAG_COMPRESSED = 0x01;                      // Stored LZ4  
+const uint8_t FRAME_FLAG_END_OF_STREAM = 0x02;                   // Ʈ    (Stored )
+
+//      (    ):
+// [SOF(1)][Flags(1)][FrameNum(1|2)][WindowSize(2)?][Checksum(2)][StoredLength(1|2|4)?][Payload Ǵ Stored][EOF(1)]
+// FrameNum  ġ  8Ʈ Ǵ 16Ʈ (޴  ڽ   ġ )
+// WindowSize ۽  찡 ٲ ӿ, StoredLength ̰ ʿ (//Ʈ) 
+//  ũ  ּ : 6 bytes ( 10 bytes)
+const uint8_t FRAME_FLAG_WINDOW = 0x04;          // WindowSize ʵ 
+const uint8_t FRAME_FLAG_SEQ16 = 0x08;           // FrameNum 16Ʈ ( 8Ʈ)
+const uint8_t FRAME_FLAG_LENGTH_MASK = 0x30;     // StoredLength Ʈ  (0 = , 1/2/3 = 1/2/4 bytes)
+const int FRAME_FLAG_LENGTH_SHIFT = 4;
+const int FRAME_HEADER_COMPACT_MIN = 1 + 1 + 1 + 2;                              //  ª  : 5 bytes
+const int FRAME_OVERHEAD_COMPACT = FRAME_HEADER_COMPACT_MIN + FRAME_TRAILER_V3;  // ּ : 6 bytes
+const int COMPACT_SEQ8_WINDOW_MAX = 127;  // ִ 찡  ̸ 8Ʈ FrameNum  (ۼ  ġ  < )
+
+//   Flags StoredLength Ʈ 
+inline int compactLengthBytes(uint8_t flags) {
+    static const int bytes[4] = {0, 1, 2, 4};
+    return bytes[(flags & FRAME_FLAG_LENGTH_MASK) >> FRAME_FLAG_LENGTH_SHIFT];
+}
+
+//   ũ (SOF , Flags  ޶)
+inline int compactHeaderSize(uint8_t flags) {
+    return 2 + ((flags & FRAME_FLAG_SEQ16) ? 2 : 1) + ((flags & FRAME_FLAG_WINDOW) ? 2 : 0) + 2 + compactLengthBytes(flags);
+}
+
+//    FrameNum Ʈ  (ǵ ִ 쿡 )
+inline int compactSequenceBytes(int maxWindow) {
+    return maxWindow <= COMPACT_SEQ8_WINDOW_MAX ? 1 : 2;
+}
+
+// ȭ  (ɷ  ä   Ǹ):  /   Flags  2Ʈ  ä ȣ
+// ä 0  뷮  Ʈ, ä 1-3 ޽ ä (޽ ϳ = StoredLength ִ  ϳ)
+// äθ   ACK ̸, ä ACK ±  ڰ ä ȣ ('1'-'3', ä 0  ±)
+// ȭ ʴ ǿ ä Ʈ 0 ƴ  谡 ߳  Ǵ
+const uint8_t FRAME_FLAG_CHANNEL_MASK = 0xC0;
+const int FRAME_FLAG_CHANNEL_SHIFT = 6;
+const int MUX_CHANNELS_MAX = 4;          // ä 0  ִ ä  (Flags 2Ʈ)
+const int MUX_CHANNEL_WINDOW = 32;       // ޽ ä ۽  ( , ũ )
+const int MUX_QUEUE_MAX = 4096;          // ޽ ä ⿭ ׾   ִ ޽ 
+const int MUX_SLICE_MS = 5;              // 뷮  Ʈ    (ȸ ð,  ̿ ޽ ä   )
+const int CONTROL_MESSAGE_SIZE = 32;     // --control-rate  ޽ ũ (bytes,  ̷ε庸 ũ ̷ε ũ)
+const int CONTROL_RATE_MAX = 10000;      // --control-rate  (ʴ ޽ )
+const int MUX_WEIGHT_MAX = 64;           // --mux-weight 
+
+inline int frameChannel(uint8_t flags) {
+    return (flags & FRAME_FLAG_CHANNEL_MASK) >> FRAME_FLAG_CHANNEL_SHIFT;
+}
+
+// FEC    : [SOF(1)][RS()][RS()][EOF(1)]
+// (SOF ) (Payload Ǵ Stored)  RS ڵ  иƼ 
+//      /  İ   Ͽ ó
+const int FRAME_READ_FEC_UNCORRECTABLE = -2;                     // readDataFrame:    ڵ 
+const int FRAME_READ_SYNC = -3;                                  // readDataFrame:   ڸ ȭ   ( Ʈ Ʈ ǵ )
+const int FRAME_READ_CRC = -4;                                   // readDataFrame:  CRC32 ġ (  ĺ ٽ е ǵ )
+
+//   Ἲ (ɷ   Ǹ, FEC  ):     EOF տ CRC32(4) ߰
+// CRC32 SOF  CRC ձ(FrameNum   ) . 16Ʈ üũ ̷ε常 Ƿ
+//  Ʈ  FrameNum ٲ  ٸ ȣ ACKǰ,  ȣ  ߿ ߺ 
+//   readDataFrame   CRC  Ƿ ȭ CRC  İ 
+const int FRAME_CRC_SIZE = 4;
+
+// ACK  : [SOF_ACK(1)][ACK(3)][BaseFrameNum(4)][Bitmap(4)][EOF(1)] = 13 bytes
+// BaseFrameNum: Ʈ   ȣ
+// Bitmap: 32Ʈ ִ 32  ACK  ǥ
+// Ʈ ǿ    û  ±׸ ACS  (SACK SAS)
+const int ACK_FRAME_SIZE = 13;
+
+//   ũ (ɷ   Ǹ): ACK/SACK  EOF տ CreditLimit(4) ߰
+// CreditLimit: ۽     ִ  ȣ  (ȸ 32Ʈ ȣ,  ȣ ̸ )
+//    ϰ  Ʈŭ ũ ٿ, ó и ̹ ۰ ġ  ۽  
+const int ACK_CREDIT_SIZE = 4;
+
+// ACK Ἲ (ɷ   Ǹ): ACK/SACK  EOF տ CRC32(4) ߰
+// CRC32 ±׺ CRC ձ(SOF ) . ACK üũ  Ʈ  Ʈ̳  ACK ٲ
+//    ACKǾ ۽  ٽ  Ƿ, CRC  ʴ ACK  ( ð ٽ )
+const int ACK_CRC_SIZE = 4;
+const int SERIAL_QUEUE_BYTES = 1048576;  // SetupComm /۽  ũ (  ũ  )
+
+// SACK  : [SOF_ACK(1)][SAK(3)][CumulativeAck(4)][BitmapBase(4)][Bitmap(SACK_BITMAP_BITS/8)][EOF(1)]
+// CumulativeAck ̸    Ϸ + BitmapBase SACK_BITMAP_BITS    
+// Ʈ     (64/128/256),      Ʈ ǵ
+#ifndef SACK_BITMAP_BITS
+#define SACK_BITMAP_BITS 256
+#endif
+
+// READY ACK  : [SOF_ACK][R][E][A][D][Y][EOF] = 7 bytes
+// Phase 3  ȯ   ȭ ȣ
+const int READY_ACK_LEN = 7;
+const char READY_ACK[] = {0x04, 'R', 'E', 'A', 'D', 'Y', 0x03};
+
+//  ȭ  : [SOF_SYNC][Flags(1)][Seq(4)][Ack(4)][CRC32(4)][EOF] = 15 bytes
+// Ŭ̾Ʈ   ȣ SYN ,  SYN-ACK(ڽ Seq, Ack = Ŭ̾Ʈ Seq + 1) ϸ Settings 
+// Ack  SYN   ϹǷ  õ   SYN-ACK  ־ ߸ ȭ 
+// CRC32 Flags Ack 
+//  ܰ  ȸ  Ǹ  ӿ RESUME ÷׸ ξ   ó ġ ȯ
+// (Ʈ ٽ   RESUME,  RESUME | ACK ,  ۽  SENDER Բ )
+// ۽  Seq  ̽,   Ack     (  ġ  32Ʈ)
+const char SOF_SYNC = 0x07;                 // Start of Sync Frame
+const uint8_t SYNC_FLAG_SYN = 0x01;
+const uint8_t SYNC_FLAG_ACK = 0x02;
+const uint8_t SYNC_FLAG_RESUME = 0x04;      // ȸ   ġ ȯ
+const uint8_t SYNC_FLAG_SENDER = 0x08;      //  ۽   RESUME
+const int SYNC_FRAME_SIZE = 1 + 1 + 4 + 4 + 4 + 1;
+const int SYNC_RETRY_MIN_MS = 200;          // SYN-ACK   ù SYN ۱  (  辿 )
+const int SYNC_RETRY_MAX_MS = 1000;         // SYN   
+const int SYNC_TIMEOUT_MS = 10000;          // SYN-ACK / SYN  Settings  ð
+const int LEGACY_STABILIZATION_MS = 1000;   // SYN-ACK      Settings READY ACK   (SYN  Ŭ̾Ʈ  )
+const int LEGACY_SETTINGS_DELAY_MS = 100;   //  Ŀ Settings   
+
+//  ޽  (TLV ,  ):
+// [SOF_CTRL(1)][Type(1)][Version(1)][BodyLength(2)][TLV...][CRC32(4)][EOF(1)]
+// TLV ׸: [Tag(2)][Length(2)][Value(Length)] -   little-endian
+//   𸣴 Tag Lengthŭ ǳʶٹǷ ʵ带 ߰ص    ڵ 
+const char SOF_CTRL = 0x05;                 // Start of Control Message
+const char CTRL_TYPE_RESULTS = 'R';         // Phase 3  ޽
+const char CTRL_TYPE_CAPS = 'C';            // ɷ  ޽
+const int CTRL_HEADER_SIZE = 1 + 1 + 1 + 2; //  ũ: 5 bytes
+const int CTRL_TRAILER_SIZE = 4 + 1;        // ƮϷ ũ: CRC32(4) + EOF(1)
+const int CTRL_MAX_BODY = 65535;            // BodyLength ʵ ִ밪
+const int RESULTS_MSG_VERSION = 1;          //  ޽ 
+const int CAPS_MSG_VERSION = 1;             // ɷ ޽ 
+
+// Settings.reserved  Ʈ (Ŭ̾Ʈ   ,  ACK ڿ   ȸ)
+// reserved == 0  Ŭ̾ƮԴ  ƹ͵ ߰  
+const int FEATURE_RESULTS_TLV = 0x00000001;         // TLV  ޽ 
+const int FEATURE_SACK_64 = 0x00000002;             // 64Ʈ SACK Ʈ ACK +  
+const int FEATURE_SACK_128 = 0x00000004;            // 128Ʈ SACK Ʈ ACK +  
+const int FEATURE_SACK_256 = 0x00000008;            // 256Ʈ SACK Ʈ ACK +  
+const int FEATURE_SACK = SACK_BITMAP_BITS == 64 ? FEATURE_SACK_64 :
+                         SACK_BITMAP_BITS == 128 ? FEATURE_SACK_128 : FEATURE_SACK_256;  //   SACK 
+const int FEATURE_CAPABILITIES = 0x00000010;        // TLV ɷ  ޽ 
+const int SUPPORTED_FEATURES = FEATURE_RESULTS_TLV | FEATURE_SACK | FEATURE_CAPABILITIES; //  尡 ϴ 
+const int FEATURE_REPLY_TIMEOUT_MS = 500;           //  ȸ  ð (  ȸ )
+
+// ɷ  ޽ (CTRL_TYPE_CAPS):  FEATURE_CAPABILITIES ϸ  ȸ  ȯ
+// Ŭ̾Ʈ   ϰ,    ϴ     ȸ
+// ˰ ũ Ʈ  ȣ (߿ ߰Ǵ   Ŀ  Ʈ Ҵ)
+const int CAPS_REPLY_TIMEOUT_MS = 2000;     // ɷ ޽  ð
+const int CHECKSUM_XOR_ROTATE = 0x00000001; // XOR Rotate 16Ʈ üũ (⺻, ׻ )
+const int SUPPORTED_CHECKSUMS = CHECKSUM_XOR_ROTATE;
+const int COMPRESSION_LZ4 = 0x00000001;     // Ӻ LZ4  
+const int SUPPORTED_COMPRESSION = COMPRESSION_LZ4;  //   
+const int PAYLOAD_RAMP = 0x00000001;        //  ׽Ʈ  (0, 1, 2, ... / 255, 254, ...)
+const int PAYLOAD_TELEMETRY = 0x00000002;   //   ؽƮ ڷƮ 
+const int PAYLOAD_MESSAGES = 0x00000004;    //   ޽  ڵ  ̷ε
+const int SUPPORTED_PAYLOADS = PAYLOAD_RAMP | PAYLOAD_TELEMETRY | PAYLOAD_MESSAGES;
+const int CAPS_SACK_64 = 0x00000001;        // 64Ʈ SACK Ʈ
+const int CAPS_SACK_128 = 0x00000002;       // 128Ʈ SACK Ʈ
+const int CAPS_SACK_256 = 0x00000004;       // 256Ʈ SACK Ʈ
+const int CAPS_SACK = SACK_BITMAP_BITS == 64 ? CAPS_SACK_64 :
+                      SACK_BITMAP_BITS == 128 ? CAPS_SACK_128 : CAPS_SACK_256;  //   SACK 
+const int FRAME_PAYLOAD_MAX = 16 * 1024 * 1024;  //   ִ ִ ̷ε ũ (bytes)
+const int ACK_BATCH_PREFERRED = 1;          // ȣ ACK  ũ (Ӹ  ACK)
+const int FEC_PARITY_MAX = 64;              // ڵ ִ RS иƼ Ʈ (32Ʈ )
+const int ADAPTIVE_FRAME_MIN = 64;          //   ũ  (bytes, datasize   datasize)
+const int ADAPTIVE_FRAME_MAX = 65536;       // Ŭ̾Ʈ ϴ   ũ  (bytes, datasize  ũ datasize)
+const long long STREAM_FRAMES_UNBOUNDED = LLONG_MAX;  // Ʈ (num = 0) ü   (Ʈ   )
+
+//    (broadcast/listen ,  ä ):
+// [SOF_FOUNTAIN(1)][SessionId(4)][SymbolId(4)][SourceCount(4)][DataSize(4)][Pattern(1)][Payload][CRC32(4)][EOF(1)]
+// SymbolId < SourceCount̸  , ̸̻     XOR   (м ȣ)
+//    ߰  ǵ    ӿ ư, CRC32  ʴ  Ұŷ ó
+const char SOF_FOUNTAIN = 0x06;                          // Start of Broadcast Frame
+const int FOUNTAIN_HEADER_SIZE = 1 + 4 + 4 + 4 + 4 + 1;  //    ũ: 18 bytes
+const int FOUNTAIN_TRAILER_SIZE = 4 + 1;                 // ƮϷ ũ: CRC32(4) + EOF(1)
+const int FOUNTAIN_OVERHEAD = FOUNTAIN_HEADER_SIZE + FOUNTAIN_TRAILER_SIZE;  //  : 23 bytes
+const long long FOUNTAIN_MAX_BYTES = 1LL << 30;          //       ִ ִ  (K x DataSize)
+const int FOUNTAIN_START_TIMEOUT_MS = 30000;             // listen : ù    ð
+const int FOUNTAIN_IDLE_TIMEOUT_MS = 2000;               // listen :  ð  Ʈ    Ǵ
+
+// ==========================================================
+//  ü 
+// ==========================================================
+
+// ==========================================================
+// LZ4   / (Ӻ ̷ε )
+// ==========================================================
+// : [Token(1)][ͷ  ߰ Ʈ][ͷ][Offset(2, LE)][ġ  ߰ Ʈ]
+// Token  4Ʈ = ͷ ,  4Ʈ = ġ  - 4 (15̸ 255  ߰ Ʈ ڵ)
+//   ͷ ϸ,   5Ʈ ׻ ͷ
+const int LZ4_MIN_MATCH = 4;
+const int LZ4_LAST_LITERALS = 5;   //   ͷ ܾ ϴ Ʈ 
+const int LZ4_MF_LIMIT = 12;       //    Ÿ ȿ ġ  
+const int LZ4_HASH_BITS = 12;
+const int LZ4_MAX_OFFSET = 65535;
+
+//  ʵ 255  ߰ Ʈ 
+inline bool lz4PutLength(uint8_t* dst, int& op, int capacity, int length) {
+    while (length >= 255) {
+        if (op >= capacity) return false;
+        dst[op++] = 255;
+        length -= 255;
+    }
+    if (op >= capacity) return false;
+    dst[op++] = static_cast<uint8_t>(length);
+    return true;
+}
+
+//  ϳ  (matchLength == 0̸  ͷ )
+inline bool lz4PutSequence(uint8_t* dst, int& op, int capacity, const uint8_t* literals, int literalLength,
+                           int offset, int matchLength) {
+    if (op >= capacity) return false;
+    int matchCode = matchLength > 0 ? matchLength - LZ4_MIN_MATCH : 0;
+    dst[op++] = static_cast<uint8_t>((std::min(literalLength, 15) << 4) | std::min(matchCode, 15));
+    if (literalLength >= 15 && !lz4PutLength(dst, op, capacity, literalLength - 15)) return false;
+    if (literalLength > capacity - op) return false;
+    memcpy(dst + op, literals, literalLength);
+    op += literalLength;
+    if (matchLength == 0) return true;
+    if (capacity - op < 2) return false;
+    dst[op++] = static_cast<uint8_t>(offset & 0xFF);
+    dst[op++] = static_cast<uint8_t>(offset >> 8);
+    return matchCode < 15 || lz4PutLength(dst, op, capacity, matchCode - 15);
+}
+
+// LZ4   (4Ʈ ؽ + greedy ġ)
+// ȯ:  ũ,  dstCapacity  0 (ȣڴ  ״ )
+inline int lz4Compress(const char* src, int srcSize, char* dst, int dstCapacity) {
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(src);
+    uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+    int table[1 << LZ4_HASH_BITS];
+    std::fill(table, table + (1 << LZ4_HASH_BITS), -1);
+
+    int op = 0;
+    int anchor = 0;
+    int ip = 0;
+    const int matchStartLimit = srcSize - LZ4_MF_LIMIT;
+    const int matchEndLimit = srcSize - LZ4_LAST_LITERALS;
+    while (ip < matchStartLimit) {
+        uint32_t sequence;
+        memcpy(&sequence, in + ip, sizeof(sequence));
+        uint32_t hash = (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS);
+        int ref = table[hash];
+        table[hash] = ip;
+        if (ref < 0 || ip - ref > LZ4_MAX_OFFSET || memcmp(in + ref, in + ip, LZ4_MIN_MATCH) != 0) {
+            ip++;
+            continue;
+        }
+
+        int matchLength = LZ4_MIN_MATCH;
+        while (ip + matchLength < matchEndLimit && in[ref + matchLength] == in[ip + matchLength]) {
+            matchLength++;
+        }
+        if (!lz4PutSequence(out, op, dstCapacity, in + anchor, ip - anchor, ip - ref, matchLength)) {
+            return 0;
+        }
+        ip += matchLength;
+        anchor = ip;
+    }
+
+    if (!lz4PutSequence(out, op, dstCapacity, in + anchor, srcSize - anchor, 0, 0)) {
+        return 0;
+    }
+    return op;
+}
+
+// LZ4  
+// ȯ:  ũ,  (߸ Է, ߸ Offset) dstCapacity ʰ  -1
+inline int lz4Decompress(const char* src, int srcSize, char* dst, int dstCapacity) {
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(src);
+    int ip = 0;
+    int op = 0;
+    while (ip < srcSize) {
+        int token = in[ip++];
+        int literalLength = token >> 4;
+        if (literalLength == 15) {
+            int extra;
+            do {
+                if (ip >= srcSize) return -1;
+                extra = in[ip++];
+                literalLength += extra;
+            } while (extra == 255);
+        }
+        if (literalLength > srcSize - ip || literalLength > dstCapacity - op) return -1;
+        memcpy(dst + op, src + ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+        if (ip == srcSize) break;  //   (ͷ)
+
+        if (srcSize - ip < 2) return -1;
+        int offset = in[ip] | (in[ip + 1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > op) return -1;
+        int matchLength = token & 15;
+        if (matchLength == 15) {
+            int extra;
+            do {
+                if (ip >= srcSize) return -1;
+                extra = in[ip++];
+                matchLength += extra;
+            } while (extra == 255);
+        }
+        matchLength += LZ4_MIN_MATCH;
+        if (matchLength > dstCapacity - op) return -1;
+        if (offset >= matchLength) {
+            memcpy(dst + op, dst + op - offset, matchLength);
+        } else {
+            for (int i = 0; i < matchLength; ++i) {
+                dst[op + i] = dst[op - offset + i];  // ġ  (ݺ )
+            }
+        }
+        op += matchLength;
+    }
+    return op;
+}
+
+// ==========================================================
+// Reed-Solomon    ( ȸ   FEC)
+// ==========================================================
+// GF(256) ( ׽ x^8+x^4+x^3+x^2+1)  ü RS(n, n - parity) ȣ, n <= 255
+// ͸ ִ 255 - parity Ʈ  ڵ帶 parity Ʈ ̰ (  ȣ)
+// ڵ帶 parity / 2 Ʈ      
+//  ׽  ^0 .. ^(parity-1)
+const int RS_CODEWORD_MAX = 255;
+
+// GF(256) /α ̺ (exp     ϵ  ֱ з)
+// ȣȭ   б  ǥ(64KB)  ϳ ȸ
+struct GaloisTables {
+    uint8_t exp[2 * RS_CODEWORD_MAX];
+    uint8_t log[256];
+    uint8_t mul[256][256];  // mul[a][b] = a * b
+
+    GaloisTables() {
+        int x = 1;
+        for (int i = 0; i < RS_CODEWORD_MAX; ++i) {
+            exp[i] = exp[i + RS_CODEWORD_MAX] = static_cast<uint8_t>(x);
+            log[x] = static_cast<uint8_t>(i);
+            x <<= 1;
+            if (x & 0x100) x ^= 0x11D;
+        }
+        log[0] = 0;
+        for (int a = 0; a < 256; ++a) {
+            for (int b = 0; b < 256; ++b) {
+                mul[a][b] = (a == 0 || b == 0) ? 0 : exp[log[a] + log[b]];
+            }
+        }
+    }
+
+    uint8_t multiply(uint8_t a, uint8_t b) const {
+        return mul[a][b];
+    }
+
+    uint8_t divide(uint8_t a, uint8_t b) const {  // b != 0
+        return a == 0 ? 0 : exp[log[a] + RS_CODEWORD_MAX - log[b]];
+    }
+
+    // ^power (power    )
+    uint8_t power(int power) const {
+        power %= RS_CODEWORD_MAX;
+        return exp[power < 0 ? power + RS_CODEWORD_MAX : power];
+    }
+};
+
+inline const GaloisTables& galois() {
+    static const GaloisTables tables;
+    return tables;
+}
+
+// иƼ ̺  ׽ g(x) = (x - ^0)(x - ^1)...(x - ^(parity-1))
+//    parity + 1 (g[0] = 1)
+inline const std::vector<uint8_t>& rsGenerator(int parity) {
+    static const std::vector<std::vector<uint8_t> > generators = [] {
+        const GaloisTables& gf = galois();
+        std::vector<std::vector<uint8_t> > g(FEC_PARITY_MAX + 1);
+        g[0].assign(1, 1);
+        for (int p = 1; p <= FEC_PARITY_MAX; ++p) {
+            g[p].assign(p + 1, 0);
+            for (int i = 0; i < p; ++i) {
+                g[p][i] ^= g[p - 1][i];                                  // x * g(x)
+                g[p][i + 1] ^= gf.multiply(g[p - 1][i], gf.exp[p - 1]);  // - ^(p-1) * g(x)
+            }
+        }
+        return g;
+    }();
+    return generators[parity];
+}
+
+// ڵ ϳ иƼ  (LFSR : data * x^parity mod g(x))
+inline void rsEncode(const uint8_t* data, int dataLength, int parity, uint8_t* out) {
+    const GaloisTables& gf = galois();
+    const std::vector<uint8_t>& g = rsGenerator(parity);
+    const uint8_t* coefficients = g.data() + 1;
+    memset(out, 0, parity);
+    for (int i = 0; i < dataLength; ++i) {
+        const uint8_t* row = gf.mul[data[i] ^ out[0]];  // Ǹ  ǥ 
+        for (int j = 0; j < parity - 1; ++j) {
+            out[j] = out[j + 1] ^ row[coefficients[j]];
+        }
+        out[parity - 1] = row[coefficients[parity - 1]];
+    }
+}
+
+// ŵ S_j = c(^j)  (Horner , Ʈ parity   Բ )
+inline void rsSyndromes(const uint8_t* codeword, int length, int parity, uint8_t* syndromes) {
+    const GaloisTables& gf = galois();
+    const uint8_t* rows[FEC_PARITY_MAX];  // rows[j] = ^j ǥ 
+    for (int j = 0; j < parity; ++j) {
+        rows[j] = gf.mul[gf.exp[j]];
+        syndromes[j] = 0;
+    }
+    for (int i = 0; i < length; ++i) {
+        uint8_t c = codeword[i];
+        for (int j = 0; j < parity; ++j) {
+            syndromes[j] = rows[j][syndromes[j]] ^ c;
+        }
+    }
+}
+
+// ü ȣ̹Ƿ ͸ ٽ ȣȭ иƼ  иƼ  ȿ ڵ
+inline bool rsParityMatches(const uint8_t* codeword, int length, int parity) {
+    uint8_t expected[FEC_PARITY_MAX];
+    rsEncode(codeword, length - parity, parity, expected);
+    return memcmp(expected, codeword + length - parity, parity) == 0;
+}
+
+// ڵ ϳ ڸ  (Berlekamp-Massey + Chien Ž + Forney)
+// ȯ:  Ʈ ,  ɷ  -1 (̶ ڵ  )
+inline int rsDecode(uint8_t* codeword, int length, int parity) {
+    const GaloisTables& gf = galois();
+    
+    //   κ ڵ ŵ  ʰ иƼ 񱳷 
+    if (rsParityMatches(codeword, length, parity)) {
+        return 0;
+    }
+    uint8_t syndromes[FEC_PARITY_MAX];
+    rsSyndromes(codeword, length, parity, syndromes);
+    
+    // Berlekamp-Massey:  ġ ׽ (x) (  , [0] = 1)
+    uint8_t lambda[FEC_PARITY_MAX + 1] = {1};
+    uint8_t previous[FEC_PARITY_MAX + 1] = {1};
+    uint8_t saved[FEC_PARITY_MAX + 1];
+    int errors = 0;
+    int shift = 1;
+    uint8_t previousDiscrepancy = 1;
+    for (int n = 0; n < parity; ++n) {
+        uint8_t discrepancy = syndromes[n];
+        for (int i = 1; i <= errors; ++i) {
+            discrepancy ^= gf.multiply(lambda[i], syndromes[n - i]);
+        }
+        if (discrepancy == 0) {
+            shift++;
+            continue;
+        }
+        uint8_t scale = gf.divide(discrepancy, previousDiscrepancy);
+        bool grow = 2 * errors <= n;
+        if (grow) {
+            memcpy(saved, lambda, sizeof(saved));
+        }
+        for (int i = 0; i + shift <= parity; ++i) {
+            lambda[i + shift] ^= gf.multiply(scale, previous[i]);
+        }
+        if (grow) {
+            errors = n + 1 - errors;
+            memcpy(previous, saved, sizeof(previous));
+            previousDiscrepancy = discrepancy;
+            shift = 1;
+        } else {
+            shift++;
+        }
+    }
+    if (2 * errors > parity) {
+        return -1;
+    }
+    
+    // Chien Ž: ġ i  ġ X = ^(length-1-i), (X^-1) = 0 ġ 
+    int positions[FEC_PARITY_MAX / 2];
+    int found = 0;
+    for (int i = 0; i < length; ++i) {
+        int inverse = -(length - 1 - i);
+        uint8_t value = 0;
+        for (int k = 0; k <= errors; ++k) {
+            if (lambda[k]) value ^= gf.multiply(lambda[k], gf.power(inverse * k));
+        }
+        if (value == 0) {
+            if (found == errors) return -1;
+            positions[found++] = i;
+        }
+    }
+    if (found != errors) {
+        return -1;
+    }
+    
+    // Forney:   ׽ (x) = S(x)(x) mod x^parity, ũ e = X * (X^-1) / '(X^-1)
+    uint8_t omega[FEC_PARITY_MAX];
+    for (int i = 0; i < parity; ++i) {
+        uint8_t sum = 0;
+        for (int k = 0; k <= std::min(i, errors); ++k) {
+            sum ^= gf.multiply(syndromes[i - k], lambda[k]);
+        }
+        omega[i] = sum;
+    }
+    uint8_t magnitudes[FEC_PARITY_MAX / 2];
+    for (int e = 0; e < found; ++e) {
+        int inverse = -(length - 1 - positions[e]);
+        uint8_t numerator = 0;
+        for (int i = 0; i < parity; ++i) {
+            if (omega[i]) numerator ^= gf.multiply(omega[i], gf.power(inverse * i));
+        }
+        uint8_t denominator = 0;
+        for (int k = 1; k <= errors; k += 2) {  // GF(2^m)  ̺: Ȧ  ׸ 
+            if (lambda[k]) denominator ^= gf.multiply(lambda[k], gf.power(inverse * (k - 1)));
+        }
+        if (denominator == 0) return -1;
+        magnitudes[e] = gf.multiply(gf.power(-inverse), gf.divide(numerator, denominator));
+    }
+    for (int e = 0; e < found; ++e) {
+        codeword[positions[e]] ^= magnitudes[e];
+    }
+    
+    //    (  ɷ Ѿ ٸ ڵ ߸   Ž)
+    if (!rsParityMatches(codeword, length, parity)) {
+        for (int e = 0; e < found; ++e) {
+            codeword[positions[e]] ^= magnitudes[e];
+        }
+        return -1;
+    }
+    return found;
+}
+
+// length Ʈ parity ȣ  ȸ ũ (parity == 0̸ ״)
+inline int fecEncodedSize(int length, int parity) {
+    if (parity <= 0 || length <= 0) return length;
+    int dataPerCodeword = RS_CODEWORD_MAX - parity;
+    return length + (length + dataPerCodeword - 1) / dataPerCodeword * parity;
+}
+
+// ͸ ڵ   [][иƼ]  buffer ڿ ߰ (parity == 0̸ ͸)
+inline void fecAppend(std::vector<char>& buffer, const char* data, int length, int parity) {
+    if (parity <= 0) {
+        buffer.insert(buffer.end(), data, data + length);
+        return;
+    }
+    int dataPerCodeword = RS_CODEWORD_MAX - parity;
+    for (int offset = 0; offset < length; offset += dataPerCodeword) {
+        int chunk = std::min(dataPerCodeword, length - offset);
+        buffer.insert(buffer.end(), data + offset, data + offset + chunk);
+        size_t parityAt = buffer.size();
+        buffer.resize(parityAt + parity);
+        rsEncode(reinterpret_cast<const uint8_t*>(data + offset), chunk, parity,
+                 reinterpret_cast<uint8_t*>(buffer.data() + parityAt));
+    }
+}
+
+// wire ڵ ϰ  Ʈ out ʷ  (out <= wire̸   ȿ )
+// ȯ:  Ʈ ,    ڵ尡  -1 ( ڵ  ״ )
+inline int fecRepair(char* wire, char* out, int length, int parity) {
+    if (parity <= 0) {
+        if (out != wire) memmove(out, wire, length);
+        return 0;
+    }
+    int dataPerCodeword = RS_CODEWORD_MAX - parity;
+    int corrected = 0;
+    bool uncorrectable = false;
+    char* codeword = wire;
+    for (int offset = 0; offset < length; offset += dataPerCodeword) {
+        int chunk = std::min(dataPerCodeword, length - offset);
+        int fixed = rsDecode(reinterpret_cast<uint8_t*>(codeword), chunk + parity, parity);
+        if (fixed < 0) {
+            uncorrectable = true;
+        } else {
+            corrected += fixed;
+        }
+        memmove(out + offset, codeword, chunk);
+        codeword += chunk + parity;
+    }
+    return uncorrectable ? -1 : corrected;
+}
+
+// ̷ε尡 payloadSize    ִ ȸ ũ (  ũ)
+inline int dataFrameWireSize(int payloadSize, bool compressedFormat, int fecParity, bool frameCrc = false) {
+    int headerSize = (compressedFormat ? FRAME_HEADER_Z : FRAME_HEADER_V3) - 1;  // SOF 
+    return 1 + fecEncodedSize(headerSize, fecParity) + fecEncodedSize(payloadSize, fecParity) + FRAME_TRAILER_V3 +
+           (frameCrc ? FRAME_CRC_SIZE : 0);
+}
+
+//   FEC 
+struct FecStats {
+    long long correctedSymbols;     //  Ʈ 
+    long long repairedFrames;       //     
+    long long uncorrectableFrames;  //  ɷ Ѿ    (۽  )
+
+    FecStats() : correctedSymbols(0), repairedFrames(0), uncorrectableFrames(0) {}
+};
+
+// ȸ 32Ʈ  ȣ 64Ʈ  ġ  (RFC 1982  ȣ )
+// reference(޴    ġ) 2^31 ȿ ִ ġ 
+// ۼ   ġ ̴ ִ (WINDOW_SIZE_MAX) ̳̹Ƿ ȣ ȯص ȣ 
+inline long long unwrapSequence(uint32_t wire, long long reference) {
+    return reference + static_cast<int32_t>(wire - static_cast<uint32_t>(reference));
+}
+
+// CRC-32 (IEEE 802.3, reflected 0xEDB88320) ̺  
+// previous:   CRC ( ִ   ̾  , 0 = ó)
+inline uint32_t crc32(const char* data, size_t length, uint32_t previous = 0) {
+    static const std::vector<uint32_t> table = [] {
+        std::vector<uint32_t> t(256);
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+
+    uint32_t crc = previous ^ 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; ++i) {
+        crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// XOR Rotate üũ:  Ʈ XOR ϰ Ʈ ȸ Ͽ üũ 
+// ̷ε带 DataFrame ű ʰ  ۿ ٷ    (DataFrame::viewStored)
+inline uint16_t xorRotateChecksum(const char* data, size_t length) {
+    uint16_t sum = 0;
+    for (size_t i = 0; i < length; ++i) {
+        sum ^= static_cast<uint8_t>(data[i]);
+        sum = (sum << 1) | (sum >> 15);  // Rotate left (Ʈ  ȸ)
+    }
+    return sum;
+}
+
+//   CRC /: SOF   buffer ڿ [1, size)  CRC32 
+//  EOF  size Ʈ  [1, size - 5)  EOF ٷ  4Ʈ 
+inline void appendFrameCrc(std::vector<char>& buffer) {
+    const uint32_t crc = crc32(buffer.data() + 1, buffer.size() - 1);
+    const char* bytes = reinterpret_cast<const char*>(&crc);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(uint32_t));
+}
+
+inline bool checkFrameCrc(const char* frame, int size) {
+    uint32_t stored;
+    memcpy(&stored, frame + size - 1 - FRAME_CRC_SIZE, sizeof(uint32_t));
+    return crc32(frame + 1, size - 1 - FRAME_CRC_SIZE - 1) == stored;
+}
+
+// V4    ü
+//  ȣ,  ũ, üũ, ̷ε带 ϴ  
+struct DataFrame {
+    uint32_t frameNum;      //   ȣ ( ġ  32Ʈ, 0 )
+    uint16_t windowSize;    //  ̵  ũ
+    uint16_t checksum;      // ̷ε  üũ (XOR Rotate )
+    std::vector<char> payload;  //   
+    bool lengthPrefixed;        //    ([Flags][StoredLength] ) ȭ
+    uint8_t flags;              // FRAME_FLAG_* (  Ŀ )
+    std::vector<char> stored;   //  ̷ε (flags FRAME_FLAG_COMPRESSED   )
+    int fecParity;              // ڵ RS иƼ Ʈ (0 = FEC , FEC  ǿ )
+    int compactSequence;        //    FrameNum Ʈ  (0 =   , 1 Ǵ 2)
+    int overhead;               //    ƮϷ Ʈ  (ȭ  )
+    bool hasCrc;                // EOF տ  CRC32  (  Ἲ  , FEC ǿ  )
+    
+    DataFrame() : frameNum(0), windowSize(0), checksum(0), lengthPrefixed(false), flags(0), fecParity(0),
+                  compactSequence(0), overhead(0), hasCrc(false) {}
+    
+    // Ʈ   ˸   (  Ŀ )
+    bool endOfStream() const { return (flags & FRAME_FLAG_END_OF_STREAM) != 0; }
+    
+    // windowSize ȸ   (  찡 ٲ ӿ )
+    bool hasWindowSize() const { return compactSequence == 0 || (flags & FRAME_FLAG_WINDOW) != 0; }
+    
+    //  ä ȣ (ȭ , 0 = 뷮  Ʈ)
+    int channel() const { return frameChannel(flags); }
+    
+    // üũ  (XOR Rotate üũ)
+    uint16_t calculateChecksum() const {
+        return xorRotateChecksum(payload.data(), payload.size());
+    }
+    
+    //    ȯϰ ̷ε带 ̸  (  ٽ  ʵ  غ ܰ迡 ȣ)
+    //       ״  (flags = 0)
+    void compressPayload() {
+        lengthPrefixed = true;
+        flags = 0;
+        stored.resize(payload.size());
+        int compressedSize = payload.size() > 1
+            ? lz4Compress(payload.data(), static_cast<int>(payload.size()), stored.data(), static_cast<int>(payload.size()) - 1)
+            : 0;
+        if (compressedSize > 0) {
+            stored.resize(compressedSize);
+            flags |= FRAME_FLAG_COMPRESSED;
+        } else {
+            std::vector<char>().swap(stored);
+        }
+    }
+    
+    //   Ʈ 迭 ȭ
+    // : [SOF(1)][FrameNum(4)][WindowSize(2)][Checksum(2)][Payload][EOF(1)]
+    //  : [SOF(1)][FrameNum(4)][WindowSize(2)][Checksum(2)][Flags(1)][StoredLength(4)][Stored][EOF(1)]
+    // FEC : SOF     RS ڵ ȣ (fecParity > 0)
+    //  CRC :  ̵ EOF տ CRC32(4) (hasCrc, FEC  )
+    void serialize(std::vector<char>& buffer) const {
+        const std::vector<char>& body = (flags & FRAME_FLAG_COMPRESSED) ? stored : payload;
+        if (compactSequence > 0) {
+            serializeCompact(body, buffer);
+            return;
+        }
+        char header[FRAME_HEADER_Z - 1];
+        int headerSize = FRAME_HEADER_V3 - 1;
+        memcpy(header, &frameNum, sizeof(uint32_t));
+        memcpy(header + 4, &windowSize, sizeof(uint16_t));
+        memcpy(header + 6, &checksum, sizeof(uint16_t));
+        if (lengthPrefixed) {
+            uint32_t storedLength = static_cast<uint32_t>(body.size());
+            header[8] = static_cast<char>(flags);
+            memcpy(header + 9, &storedLength, sizeof(uint32_t));
+            headerSize = FRAME_HEADER_Z - 1;
+        }
+        
+        buffer.clear();
+        buffer.reserve(1 + fecEncodedSize(headerSize, fecParity) +
+                       fecEncodedSize(static_cast<int>(body.size()), fecParity) + FRAME_CRC_SIZE + FRAME_TRAILER_V3);
+        buffer.push_back(SOF);
+        fecAppend(buffer, header, headerSize, fecParity);
+        fecAppend(buffer, body.data(), static_cast<int>(body.size()), fecParity);
+        if (hasCrc && fecParity == 0) appendFrameCrc(buffer);
+        buffer.push_back(EOF_BYTE);
+    }
+    
+    //    ȭ (FEC ǿ  )
+    // FrameNum  compactSequence, WindowSize  δ flags FRAME_FLAG_WINDOW (۽  )
+    void serializeCompact(const std::vector<char>& body, std::vector<char>& buffer) const {
+        const uint32_t storedLength = static_cast<uint32_t>(body.size());
+        uint8_t headerFlags = flags & (FRAME_FLAG_COMPRESSED | FRAME_FLAG_END_OF_STREAM | FRAME_FLAG_WINDOW | FRAME_FLAG_CHANNEL_MASK);
+        int lengthCode = 0;
+        if (lengthPrefixed) {
+            lengthCode = storedLength <= 0xFF ? 1 : storedLength <= 0xFFFF ? 2 : 3;
+        }
+        if (compactSequence > 1) headerFlags |= FRAME_FLAG_SEQ16;
+        headerFlags |= static_cast<uint8_t>(lengthCode << FRAME_FLAG_LENGTH_SHIFT);
+        
+        char header[16];
+        int headerSize = 0;
+        header[headerSize++] = SOF;
+        header[headerSize++] = static_cast<char>(headerFlags);
+        memcpy(header + headerSize, &frameNum, compactSequence);  //  Ʈ (little-endian)
+        headerSize += compactSequence;
+        if (headerFlags & FRAME_FLAG_WINDOW) {
+            memcpy(header + headerSize, &windowSize, sizeof(uint16_t));
+            headerSize += 2;
+        }
+        memcpy(header + headerSize, &checksum, sizeof(uint16_t));
+        headerSize += 2;
+        memcpy(header + headerSize, &storedLength, compactLengthBytes(headerFlags));
+        headerSize += compactLengthBytes(headerFlags);
+        
+        buffer.clear();
+        buffer.reserve(headerSize + body.size() + FRAME_CRC_SIZE + FRAME_TRAILER_V3);
+        buffer.insert(buffer.end(), header, header + headerSize);
+        buffer.insert(buffer.end(), body.begin(), body.end());
+        if (hasCrc) appendFrameCrc(buffer);
+        buffer.push_back(EOF_BYTE);
+    }
+    
+    // Ʈ 迭κ   ȭ
+    // SOF/EOF    ʵ 
+    bool deserialize(const char* buffer, int length) {
+        if (length < FRAME_OVERHEAD_V3) return false;
+        if (buffer[0] != SOF || buffer[length - 1] != EOF_BYTE) return false;
+        
+        memcpy(&frameNum, buffer + 1, sizeof(uint32_t));
+        memcpy(&windowSize, buffer + 5, sizeof(uint16_t));
+        memcpy(&checksum, buffer + 7, sizeof(uint16_t));
+        
+        int payloadSize = length - FRAME_OVERHEAD_V3;
+        payload.resize(payloadSize);
+        memcpy(payload.data(), buffer + 9, payloadSize);
+        overhead = FRAME_OVERHEAD_V3;
+        
+        return true;
+    }
+    
+    //     ȭ:   payloadSize Ʈ 
+    //  ʵ尡  ̿  ʰų   payloadSize ٸ false (Ʈ    ̷ε)
+    // variableLength:   ũ  (payloadSize , 1Ʈ ̻   ̷ε带 )
+    bool deserializeCompressed(const char* buffer, int length, int payloadSize, bool variableLength = false) {
+        if (length < FRAME_OVERHEAD_Z) return false;
+        if (buffer[0] != SOF || buffer[length - 1] != EOF_BYTE) return false;
+        
+        uint32_t storedLength;
+        memcpy(&frameNum, buffer + 1, sizeof(uint32_t));
+        memcpy(&windowSize, buffer + 5, sizeof(uint16_t));
+        memcpy(&checksum, buffer + 7, sizeof(uint16_t));
+        flags = static_cast<uint8_t>(buffer[9]);
+        memcpy(&storedLength, buffer + 10, sizeof(uint32_t));
+        if (storedLength != static_cast<uint32_t>(length - FRAME_OVERHEAD_Z)) return false;
+        overhead = FRAME_OVERHEAD_Z;
+        return decodeStored(buffer + FRAME_HEADER_Z, storedLength, payloadSize, variableLength);
+    }
+    
+    //      ȭϰ (Stored)    ġ  (payload ä )
+    //   ۷   Ϸ ȣ (޽ )̹Ƿ  Ӱ Ʈ   false
+    // üũ ȣ  xorRotateChecksum(body, storedLength) 
+    bool viewStored(const char* buffer, int length, const char*& body, uint32_t& storedLength) {
+        if (length < FRAME_OVERHEAD_Z) return false;
+        if (buffer[0] != SOF || buffer[length - 1] != EOF_BYTE) return false;
+        
+        memcpy(&frameNum, buffer + 1, sizeof(uint32_t));
+        memcpy(&windowSize, buffer + 5, sizeof(uint16_t));
+        memcpy(&checksum, buffer + 7, sizeof(uint16_t));
+        flags = static_cast<uint8_t>(buffer[9]);
+        memcpy(&storedLength, buffer + 10, sizeof(uint32_t));
+        if (storedLength != static_cast<uint32_t>(length - FRAME_OVERHEAD_Z)) return false;
+        if (flags & (FRAME_FLAG_COMPRESSED | FRAME_FLAG_END_OF_STREAM)) return false;
+        lengthPrefixed = true;
+        overhead = FRAME_OVERHEAD_Z;
+        body = buffer + FRAME_HEADER_Z;
+        return true;
+    }
+    
+    //     ȭ
+    // reference: ޴    ġ ( 32Ʈ), ߸ FrameNum  ġ   32Ʈ ȣ 
+    // payloadSize/variableLength:  ʵ尡 ִ  ó deserializeCompressed 
+    bool deserializeCompact(const char* buffer, int length, int payloadSize, bool variableLength, uint32_t reference) {
+        if (length < FRAME_OVERHEAD_COMPACT) return false;
+        if (buffer[0] != SOF || buffer[length - 1] != EOF_BYTE) return false;
+        
+        flags = static_cast<uint8_t>(buffer[1]);
+        const int headerSize = compactHeaderSize(flags);
+        if (length < headerSize + FRAME_TRAILER_V3) return false;
+        
+        int offset = 2;
+        if (flags & FRAME_FLAG_SEQ16) {
+            uint16_t wire;
+            memcpy(&wire, buffer + offset, sizeof(uint16_t));
+            frameNum = reference + static_cast<int16_t>(wire - static_cast<uint16_t>(reference));
+            compactSequence = 2;
+        } else {
+            uint8_t wire = static_cast<uint8_t>(buffer[offset]);
+            frameNum = reference + static_cast<int8_t>(wire - static_cast<uint8_t>(reference));
+            compactSequence = 1;
+        }
+        offset += compactSequence;
+        windowSize = 0;
+        if (flags & FRAME_FLAG_WINDOW) {
+            memcpy(&windowSize, buffer + offset, sizeof(uint16_t));
+            offset += 2;
+        }
+        memcpy(&checksum, buffer + offset, sizeof(uint16_t));
+        offset += 2;
+        
+        const int lengthBytes = compactLengthBytes(flags);
+        const uint32_t bodyLength = static_cast<uint32_t>(length - headerSize - FRAME_TRAILER_V3);
+        overhead = headerSize + FRAME_TRAILER_V3;
+        lengthPrefixed = lengthBytes > 0;
+        if (!lengthPrefixed) {
+            if (flags & (FRAME_FLAG_COMPRESSED | FRAME_FLAG_END_OF_STREAM)) return false;
+            payload.resize(bodyLength);
+            memcpy(payload.data(), buffer + headerSize, bodyLength);
+            return true;
+        }
+        uint32_t storedLength = 0;
+        memcpy(&storedLength, buffer + offset, lengthBytes);
+        if (storedLength != bodyLength) return false;
+        return decodeStored(buffer + headerSize, storedLength, payloadSize, variableLength);
+    }
+    
+    //  ʵ尡 ִ  (Stored) ̷ε  (Ʈ    ̷ε)
+    // ޽ ä  ǰ ϰ   (payloadSize )
+    bool decodeStored(const char* body, uint32_t storedLength, int payloadSize, bool variableLength) {
+        if (endOfStream()) {
+            payload.clear();
+            return storedLength == 0;
+        }
+        variableLength = variableLength || channel() != 0;
+        
+        payload.resize(payloadSize);
+        if (flags & FRAME_FLAG_COMPRESSED) {
+            int decompressed = lz4Decompress(body, static_cast<int>(storedLength), payload.data(), payloadSize);
+            if (!variableLength) return decompressed == payloadSize;
+            if (decompressed <= 0) return false;
+            payload.resize(decompressed);
+            return true;
+        }
+        if (variableLength) {
+            if (storedLength == 0 || static_cast<int>(storedLength) > payloadSize) return false;
+            payloadSize = static_cast<int>(storedLength);
+            payload.resize(payloadSize);
+        }
+        if (static_cast<int>(storedLength) != payloadSize) return false;
+        memcpy(payload.data(), body, payloadSize);
+        return true;
+    }
+    
+    // üũ 
+    //  üũ  üũ Ͽ  Ἲ Ȯ
+    bool verifyChecksum() const {
+        return checksum == calculateChecksum();
+    }
+};
+
+// ACK ±   ä ȣ (channel0 = 뷮  Ʈ  ),    ڸ -1
+inline int ackTagChannel(char tag, char channel0) {
+    if (tag == channel0) return 0;
+    if (tag >= '1' && tag < '0' + MUX_CHANNELS_MAX) return tag - '0';
+    return -1;
+}
+
+// ACK Ἲ  CRC32 /: size Ʈ ACK  [1, size - 5)  EOF ٷ  4Ʈ 
+inline void writeAckCrc(char* frame, int size) {
+    const uint32_t crc = crc32(frame + 1, size - 1 - ACK_CRC_SIZE - 1);
+    memcpy(frame + size - 1 - ACK_CRC_SIZE, &crc, sizeof(uint32_t));
+}
+
+inline bool checkAckCrc(const char* frame, int size) {
+    uint32_t stored;
+    memcpy(&stored, frame + size - 1 - ACK_CRC_SIZE, sizeof(uint32_t));
+    return crc32(frame + 1, size - 1 - ACK_CRC_SIZE - 1) == stored;
+}
+
+// ACK  ü
+// Ʈ  ִ 32  ACK ¸   
+struct AckFrame {
+    uint32_t baseFrameNum;  // Ʈ  Ǵ  ȣ (ȸ 32Ʈ ȣ)
+    uint32_t bitmap;        // 32Ʈ ִ 32  ACK ¸ Ʈ ǥ
+    bool stopRequest;       // Ʈ :   ۽  Ʈ Ḧ û (± ACS)
+    bool hasCredit;         // CreditLimit ʵ  (ũ  )
+    uint32_t creditLimit;   // ۽     ִ  ȣ  (ȸ 32Ʈ ȣ)
+    int channel;            // ȭ  ޽ ä ACK (± A1K-A3K, 0 = 뷮  Ʈ ACK)
+    bool hasCrc;            // CRC32 ʵ  (ACK Ἲ  )
+    
+    AckFrame() : baseFrameNum(0), bitmap(0), stopRequest(false), hasCredit(false), creditLimit(0), channel(0),
+                 hasCrc(false) {}
+    
+    // ȸ ũ (ũ   CreditLimitŭ, ACK Ἲ   CRC32ŭ )
+    static int wireSize(bool credit, bool crc = false) {
+        return ACK_FRAME_SIZE + (credit ? ACK_CREDIT_SIZE : 0) + (crc ? ACK_CRC_SIZE : 0);
+    }
+    
+    // ACK  Ʈ 迭 ȭ
+    // : [SOF_ACK(1)][ACK(3)][BaseFrameNum(4)][Bitmap(4)]([CreditLimit(4)])([CRC32(4)])[EOF(1)]
+    void serialize(std::vector<char>& buffer) const {
+        const int size = wireSize(hasCredit, hasCrc);
+        buffer.clear();
+        buffer.resize(size);
+        
+        buffer[0] = SOF_ACK;
+        buffer[1] = 'A';
+        buffer[2] = channel > 0 ? static_cast<char>('0' + channel) : 'C';
+        buffer[3] = stopRequest ? 'S' : 'K';
+        memcpy(buffer.data() + 4, &baseFrameNum, sizeof(uint32_t));
+        memcpy(buffer.data() + 8, &bitmap, sizeof(uint32_t));
+        if (hasCredit) {
+            memcpy(buffer.data() + 12, &creditLimit, sizeof(uint32_t));
+        }
+        if (hasCrc) {
+            writeAckCrc(buffer.data(), size);
+        }
+        buffer[size - 1] = EOF_BYTE;
+    }
+    
+    // Ʈ 迭κ ACK  ȭ (̷ CreditLimit   Ǵ)
+    // SOF_ACK/EOF  "ACK"( û "ACS", ޽ ä "A1K"-"A3K") ڿ   ʵ 
+    // crc: ACK Ἲ  ̸ true (CRC32   false)
+    bool deserialize(const char* buffer, int length, bool crc = false) {
+        if (length != wireSize(false, crc) && length != wireSize(true, crc)) return false;
+        if (buffer[0] != SOF_ACK || buffer[length - 1] != EOF_BYTE) return false;
+        if (buffer[1] != 'A' || (buffer[3] != 'K' && buffer[3] != 'S')) return false;
+        if (crc && !checkAckCrc(buffer, length)) return false;
+        channel = ackTagChannel(buffer[2], 'C');
+        if (channel < 0) return false;
+        
+        stopRequest = buffer[3] == 'S';
+        memcpy(&baseFrameNum, buffer + 4, sizeof(uint32_t));
+        memcpy(&bitmap, buffer + 8, sizeof(uint32_t));
+        hasCredit = length == wireSize(true, crc);
+        hasCrc = crc;
+        if (hasCredit) {
+            memcpy(&creditLimit, buffer + 12, sizeof(uint32_t));
+        }
+        
+        return true;
+    }
+    
+    // Ư  ȣ ACKǾ Ȯ
+    // baseFrameNum  offset Ͽ Ʈʿ ش Ʈ Ȯ (ȣ ȯ  ȣ  ̷ )
+    bool isAcked(uint32_t frameNum) const {
+        uint32_t offset = frameNum - baseFrameNum;
+        if (offset >= 32) return false;
+        return (bitmap & (1u << offset)) != 0;
+    }
+    
+    // Ư  ȣ  ACK 
+    // baseFrameNum  offset Ͽ Ʈ ش Ʈ 1 
+    void setAck(uint32_t frameNum) {
+        uint32_t offset = frameNum - baseFrameNum;
+        if (offset < 32) {
+            bitmap |= (1u << offset);
+        }
+    }
+};
+
+// NAK  ü (ACK  ,   )
+// ACK  Ʈ  Ͽ NAK ¸ ǥ
+struct NakFrame {
+    int baseFrameNum;    // Ʈ   ȣ
+    uint32_t bitmap;     // 32Ʈ Ʈ (NAK  ǥ)
+    
+    NakFrame() : baseFrameNum(0), bitmap(0) {}
+    
+    // NAK  Ʈ 迭 ȭ
+    // : [SOF_ACK(1)][NAK(3)][BaseFrameNum(4)][Bitmap(4)][EOF(1)]
+    void serialize(std::vector<char>& buffer) const {
+        buffer.clear();
+        buffer.resize(ACK_FRAME_SIZE);
+        
+        buffer[0] = SOF_ACK;
+        buffer[1] = 'N';
+        buffer[2] = 'A';
+        buffer[3] = 'K';
+        memcpy(buffer.data() + 4, &baseFrameNum, sizeof(int));
+        memcpy(buffer.data() + 8, &bitmap, sizeof(uint32_t));
+        buffer[12] = EOF_BYTE;
+    }
+    
+    // Ʈ 迭κ NAK  ȭ
+    bool deserialize(const char* buffer, int length) {
+        if (length != ACK_FRAME_SIZE) return false;
+        if (buffer[0] != SOF_ACK || buffer[12] != EOF_BYTE) return false;
+        if (buffer[1] != 'N' || buffer[2] != 'A' || buffer[3] != 'K') return false;
+        
+        memcpy(&baseFrameNum, buffer + 4, sizeof(int));
+        memcpy(&bitmap, buffer + 8, sizeof(uint32_t));
+        
+        return true;
+    }
+};
+
+//    Ʈ ġ (value != 0)
+inline int lowestSetBit(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+// ȯ Ʈ:  ġ [base, base + capacity)  /ACK ¸ 
+// ġ ȸ 32Ʈ ȣ ƴ 64Ʈ ̹Ƿ Ʈ ǿ ȯ 
+// /ȸ O(1), base      (Ӵ  ð)
+class SequenceBitmap {
+public:
+    // capacity 64  2 ŵ ø
+    explicit SequenceBitmap(int capacity) : base_(0) {
+        int words = 1;
+        while (words * 64 < capacity) words *= 2;
+        words_.assign(words, 0);
+        mask_ = words * 64 - 1;
+    }
+    
+    long long base() const { return base_; }
+    int capacity() const { return mask_ + 1; }
+    bool inRange(long long seq) const { return seq >= base_ && seq - base_ <= mask_; }
+    
+    // base ̸ ̹  ȣ̹Ƿ true,  () false
+    bool test(long long seq) const {
+        if (seq < base_) return true;
+        if (seq - base_ > mask_) return false;
+        return (words_[(seq & mask_) >> 6] >> (seq & 63)) & 1;
+    }
+    
+    // ȯ:   true ( ̰ų ̹   false)
+    bool set(long long seq) {
+        if (!inRange(seq)) return false;
+        uint64_t& word = words_[(seq & mask_) >> 6];
+        uint64_t bit = 1ull << (seq & 63);
+        if (word & bit) return false;
+        word |= bit;
+        return true;
+    }
+    
+    // base   Ʈ  limit ,   ȯ
+    int advance(long long limit) {
+        int count = 0;
+        while (base_ < limit) {
+            uint64_t& word = words_[(base_ & mask_) >> 6];
+            uint64_t bit = 1ull << (base_ & 63);
+            if (!(word & bit)) break;
+            word &= ~bit;
+            base_++;
+            count++;
+        }
+        return count;
+    }
+    
+    // [from, from + 64)  Ʈ   
+    // ȣڰ base <= from, from + 64 <= base + capacity ؾ  (  ȣ ٸ ĭ ħ)
+    uint64_t extract64(long long from) const {
+        int pos = static_cast<int>(from & mask_);
+        int index = pos >> 6;
+        int shift = pos & 63;
+        uint64_t value = words_[index] >> shift;
+        if (shift != 0) {
+            value |= words_[(index + 1) & (static_cast<int>(words_.size()) - 1)] << (64 - shift);
+        }
+        return value;
+    }
+
+private:
+    std::vector<uint64_t> words_;
+    int mask_;
+    long long base_;
+};
+
+// SACK  (Ʈ  ø , 64/128/256Ʈ)
+//    Ӹ  ACK     Ʈ  Ƿ
+// ACK ϳ ǵǾ  ACK  ¸  
+template<int Bits>
+struct SackFrame {
+    static_assert(Bits == 64 || Bits == 128 || Bits == 256, "SACK bitmap must be 64, 128 or 256 bits");
+    static const int WORDS = Bits / 64;
+    static const int SIZE = 1 + 3 + 4 + 4 + Bits / 8 + 1;
+    
+    uint32_t cumulativeAck;  //  ȣ ̸    Ϸ (ȸ 32Ʈ ȣ)
+    uint32_t bitmapBase;     // bitmap Ʈ 0 شϴ  ȣ
+    uint64_t bitmap[WORDS];  // Ӻ  
+    bool stopRequest;        // Ʈ :   ۽  Ʈ Ḧ û (± SAS)
+    bool hasCredit;          // CreditLimit ʵ  (ũ  )
+    uint32_t creditLimit;    // ۽     ִ  ȣ  (ȸ 32Ʈ ȣ)
+    int channel;             // ȭ  ޽ ä ACK (± S1K-S3K, 0 = 뷮  Ʈ ACK)
+    bool hasCrc;             // CRC32 ʵ  (ACK Ἲ  )
+    
+    SackFrame() : cumulativeAck(0), bitmapBase(0), stopRequest(false), hasCredit(false), creditLimit(0), channel(0),
+                  hasCrc(false) {
+        memset(bitmap, 0, sizeof(bitmap));
+    }
+    
+    static int wireSize(bool credit, bool crc = false) {
+        return SIZE + (credit ? ACK_CREDIT_SIZE : 0) + (crc ? ACK_CRC_SIZE : 0);
+    }
+    
+    // : [SOF_ACK(1)][SAK(3)][CumulativeAck(4)][BitmapBase(4)][Bitmap(Bits/8)]([CreditLimit(4)])([CRC32(4)])[EOF(1)]
+    void serialize(std::vector<char>& buffer) const {
+        const int size = wireSize(hasCredit, hasCrc);
+        buffer.resize(size);
+        buffer[0] = SOF_ACK;
+        buffer[1] = 'S';
+        buffer[2] = channel > 0 ? static_cast<char>('0' + channel) : 'A';
+        buffer[3] = stopRequest ? 'S' : 'K';
+        memcpy(buffer.data() + 4, &cumulativeAck, sizeof(uint32_t));
+        memcpy(buffer.data() + 8, &bitmapBase, sizeof(uint32_t));
+        memcpy(buffer.data() + 12, bitmap, sizeof(bitmap));
+        if (hasCredit) {
+            memcpy(buffer.data() + SIZE - 1, &creditLimit, sizeof(uint32_t));
+        }
+        if (hasCrc) {
+            writeAckCrc(buffer.data(), size);
+        }
+        buffer[size - 1] = EOF_BYTE;
+    }
+    
+    // crc: ACK Ἲ  ̸ true (CRC32   false)
+    bool deserialize(const char* buffer, int length, bool crc = false) {
+        if (length != wireSize(false, crc) && length != wireSize(true, crc)) return false;
+        if (buffer[0] != SOF_ACK || buffer[length - 1] != EOF_BYTE) return false;
+        if (buffer[1] != 'S' || (buffer[3] != 'K' && buffer[3] != 'S')) return false;
+        if (crc && !checkAckCrc(buffer, length)) return false;
+        channel = ackTagChannel(buffer[2], 'A');
+        if (channel < 0) return false;
+        
+        stopRequest = buffer[3] == 'S';
+        memcpy(&cumulativeAck, buffer + 4, sizeof(uint32_t));
+        memcpy(&bitmapBase, buffer + 8, sizeof(uint32_t));
+        memcpy(bitmap, buffer + 12, sizeof(bitmap));
+        hasCredit = length == wireSize(true, crc);
+        hasCrc = crc;
+        if (hasCredit) {
+            memcpy(&creditLimit, buffer + SIZE - 1, sizeof(uint32_t));
+        }
+        return true;
+    }
+    
+    // ȣ ȯ   ACK ȣ ִ , Ʈ ذ ȣ  ̷ 
+    bool isAcked(uint32_t frameNum) const {
+        if (static_cast<int32_t>(frameNum - cumulativeAck) < 0) return true;
+        uint32_t offset = frameNum - bitmapBase;
+        if (offset >= static_cast<uint32_t>(Bits)) return false;
+        return (bitmap[offset >> 6] >> (offset & 63)) & 1;
+    }
+};
+
+typedef SackFrame<SACK_BITMAP_BITS> SackAck;  //  忡 ϴ SACK 
+
+//   ACK :   ϰ ǵ (32Ʈ ACK Ǵ SACK) ACK ȭ
+//  ´    ũ ȯ Ʈ¿ ιǷ  ̿ ϰ ޸𸮰 
+// FEC ǿ ACK  ü ڵ ϳ  иƼ 
+// (Ʈ  Ʈ ٲ    ACKǾ ۽  ٽ  Ƿ)
+// ũ  ǿ ACK   ( ) CreditLimit ˸
+class ReceiveWindow {
+public:
+    // credits: ACK CreditLimit  (ũ  )
+    // channel: ȭ  ޽ ä ȣ (ACK ±׿ Ǹ, 0 = 뷮  Ʈ)
+    // ackCrc: ACK CRC32  (ACK Ἲ  )
+    explicit ReceiveWindow(bool sack, int fecParity = 0, bool credits = false, int channel = 0, bool ackCrc = false)
+        : sack_(sack), fecParity_(fecParity), credits_(credits), channel_(channel), ackCrc_(ackCrc), stopRequest_(false),
+          received_(2 * WINDOW_SIZE_MAX) {}
+    
+    //  ٸ  ġ ( ġ ̸  )
+    long long nextExpected() const { return received_.base(); }
+    
+    // ȸ  ȣ  ġ 
+    long long unwrap(uint32_t frameNum) const { return unwrapSequence(frameNum, received_.base()); }
+    
+    // ۽    ִ  ȣ Ȯ:   յ(base  capacity) ̾ 
+    // ۽  Ȯ  base ִ  ̻ ó Ƿ ۵ ߺ ӵ  ȿ 
+    //   ȣ üũ ´ ̷ε ȿ  ߳ б 
+    bool plausible(uint32_t frameNum) const {
+        const long long seq = unwrap(frameNum);
+        return seq >= received_.base() - received_.capacity() && seq < received_.base() + received_.capacity();
+    }
+    
+    //  ACK Ʈ  û  (Ʈ )
+    void requestStop() { stopRequest_ = true; }
+    
+    // seq  ϰ 濡  ACK  ackBuffer ȭ
+    // freeFrames:  ۿ  ڸ ( , receiveCredit()), ũ  ǿ 
+    // ȯ: ó  ̸ true (ߺ̰ų   ִ  ̸ false)
+    bool acknowledge(long long seq, std::vector<char>& ackBuffer, int freeFrames = 0) {
+        bool isNew = received_.set(seq);
+        received_.advance(LLONG_MAX);
+        const uint32_t credit = static_cast<uint32_t>(creditLimit(seq, freeFrames));
+        
+        if (!sack_) {
+            // 32Ʈ ACK:   ȣ base Ͽ ش Ӹ ǥ (   ǥ )
+            AckFrame ackFrame;
+            ackFrame.baseFrameNum = static_cast<uint32_t>(seq);
+            if (received_.test(seq)) {
+                ackFrame.setAck(ackFrame.baseFrameNum);
+            }
+            ackFrame.stopRequest = stopRequest_;
+            ackFrame.hasCredit = credits_;
+            ackFrame.creditLimit = credit;
+            ackFrame.channel = channel_;
+            ackFrame.hasCrc = ackCrc_;
+            ackFrame.serialize(ackBuffer);
+            appendParity(ackBuffer);
+            return isNew;
+        }
+        
+        // Ʈ   ACK ϵ,    Եǵ ʿϸ  ̵
+        SackAck ack;
+        long long bitmapBase = std::max(received_.base(), seq - SACK_BITMAP_BITS + 1);
+        ack.cumulativeAck = static_cast<uint32_t>(received_.base());
+        ack.bitmapBase = static_cast<uint32_t>(bitmapBase);
+        for (int w = 0; w < SackAck::WORDS; ++w) {
+            ack.bitmap[w] = received_.extract64(bitmapBase + w * 64);
+        }
+        ack.stopRequest = stopRequest_;
+        ack.hasCredit = credits_;
+        ack.creditLimit = credit;
+        ack.channel = channel_;
+        ack.hasCrc = ackCrc_;
+        ack.serialize(ackBuffer);
+        appendParity(ackBuffer);
+        return isNew;
+    }
+
+private:
+    // ۽     ִ ġ :     ۿ  ڸŭ
+    // (ۿ    ڸ ̹   Ƿ ó и   پ)
+    //  ¸   ִ   
+    long long creditLimit(long long seq, int freeFrames) const {
+        long long from = std::max(received_.base(), seq + 1);
+        return std::min(from + std::max(0, freeFrames), received_.base() + received_.capacity());
+    }
+
+    void appendParity(std::vector<char>& ackBuffer) const {
+        if (fecParity_ == 0) return;
+        size_t length = ackBuffer.size();
+        ackBuffer.resize(length + fecParity_);
+        rsEncode(reinterpret_cast<const uint8_t*>(ackBuffer.data()), static_cast<int>(length), fecParity_,
+                 reinterpret_cast<uint8_t*>(ackBuffer.data() + length));
+    }
+
+    bool sack_;                 // SACK  
+    int fecParity_;             // ACK ӿ ̴ RS иƼ Ʈ (0 = )
+    bool credits_;              // ACK CreditLimit  
+    int channel_;               // ACK ±׿ ƴ ä ȣ
+    bool ackCrc_;               // ACK CRC32  
+    bool stopRequest_;          // ACK Ʈ  û  
+    SequenceBitmap received_;   //   (base =  ٸ )
+};
+
+// ==========================================================
+//  ޽  (Nagle )
+// ==========================================================
+// ø̼ ޽ [Length(2)][Message]  ڵ ̾ ٿ   ϳ 
+//  (10 bytes) ACK(13 bytes) ޽ٰ ƴ϶    
+// Length little-endian̸ 0   ( ũ ӿ  ڸ 0 ä)
+const int MESSAGE_HEADER_SIZE = 2;
+const int MESSAGE_MAX_SIZE = 65535;
+
+// ޽  : ũ ѵ(flushBytes) äų ù ޽  flushDelay    
+// ѵ    ȣ  flushDue() Ǵ ( ü ð  ʰ ù ޽ ð )
+class MessagePacker {
+public:
+    // frameBytes:  ϳ ִ ũ ( ̷ε), flushBytes:  ũ ̸̻ ٷ  (0 = frameBytes)
+    MessagePacker(int frameBytes, int flushBytes = 0,
+                  std::chrono::microseconds flushDelay = std::chrono::microseconds(0))
+        : frameBytes_(frameBytes), flushBytes_(flushBytes > 0 ? std::min(flushBytes, frameBytes) : frameBytes),
+          flushDelay_(flushDelay), count_(0) {
+        buffer_.reserve(frameBytes);
+    }
+    
+    int messageCount() const { return count_; }
+    int size() const { return static_cast<int>(buffer_.size()); }
+    bool empty() const { return count_ == 0; }
+    
+    // ޽   ߰.  ڸ   false (take()   ٽ ߰)
+    //  ޽    ʴ ޽ false
+    bool add(const char* data, int length) {
+        if (length <= 0 || length > MESSAGE_MAX_SIZE ||
+            static_cast<int>(buffer_.size()) + MESSAGE_HEADER_SIZE + length > frameBytes_) {
+            return false;
+        }
+        if (count_ == 0) {
+            firstAdded_ = std::chrono::steady_clock::now();
+        }
+        buffer_.push_back(static_cast<char>(length & 0xFF));
+        buffer_.push_back(static_cast<char>(length >> 8));
+        buffer_.insert(buffer_.end(), data, data + length);
+        count_++;
+        return true;
+    }
+    
+    //   Ǿ: ũ ѵ Ұų 1-byte ޽   ʰų, ù ޽  flushDelay 
+    bool flushDue(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) const {
+        if (count_ == 0) return false;
+        int size = static_cast<int>(buffer_.size());
+        return size >= flushBytes_ || size + MESSAGE_HEADER_SIZE + 1 > frameBytes_ || now - firstAdded_ >= flushDelay_;
+    }
+    
+    //     Ǵ ð (  time_point::max())
+    std::chrono::steady_clock::time_point flushDeadline() const {
+        if (count_ == 0) return std::chrono::steady_clock::time_point::max();
+        return firstAdded_ + flushDelay_;
+    }
+    
+    //  Ʈ out ű  (out  ۸   ٽ )
+    // ȯ:  ޽ 
+    int take(std::vector<char>& out) {
+        out.swap(buffer_);
+        buffer_.clear();
+        int messages = count_;
+        count_ = 0;
+        return messages;
+    }
+
+private:
+    int frameBytes_;
+    int flushBytes_;
+    std::chrono::microseconds flushDelay_;
+    std::vector<char> buffer_;
+    int count_;
+    std::chrono::steady_clock::time_point firstAdded_;  //  ù ޽ ߰ ð
+};
+
+// ޽  Ǯ: ̷ε  ޽  ʰ (, ) ʴ 
+class MessageReader {
+public:
+    MessageReader(const char* data, int length) : data_(data), length_(length), offset_(0), truncated_(false) {}
+    
+    //  ޽.  ( 0 ڵ Ǵ  Ʈ  ʵ庸 ª)̰ų ߸ ڵ false
+    bool next(const char*& message, int& length) {
+        if (length_ - offset_ < MESSAGE_HEADER_SIZE) return false;
+        int size = static_cast<uint8_t>(data_[offset_]) | (static_cast<uint8_t>(data_[offset_ + 1]) << 8);
+        if (size == 0) return false;
+        if (size > length_ - offset_ - MESSAGE_HEADER_SIZE) {
+            truncated_ = true;
+            return false;
+        }
+        message = data_ + offset_ + MESSAGE_HEADER_SIZE;
+        length = size;
+        offset_ += MESSAGE_HEADER_SIZE + size;
+        return true;
+    }
+    
+    //  ڵ ̰ ̷ε   (ջ )
+    bool truncated() const { return truncated_; }
+    
+    //    Ʈ ( ũ  0 ä)
+    int offset() const { return offset_; }
+
+private:
+    const char* data_;
+    int length_;
+    int offset_;
+    bool truncated_;
+};
+
+// ׽Ʈ ̷ε 
+// Phase 1 (Ŭ̾Ʈ  ): 0, 1, 2, ... / Phase 2 (  Ŭ̾Ʈ): 255, 254, 253, ...
+// ڷƮ   ȿ  (⸶ ٸ ؽƮ)
+// ޽  16-32 bytes  ڵ带  ũ   ( ȿ )
+enum PayloadPattern {
+    PATTERN_ASCENDING,
+    PATTERN_DESCENDING,
+    PATTERN_TELEMETRY_UP,
+    PATTERN_TELEMETRY_DOWN,
+    PATTERN_MESSAGES_UP,
+    PATTERN_MESSAGES_DOWN
+};
+
+const int TEST_MESSAGE_MIN = 16;  // ޽  ޽ ũ  ( ڷƮ ڵ)
+const int TEST_MESSAGE_MAX = 32;
+
+const size_t TELEMETRY_TEXT_SIZE = 65536;  // ڷƮ ؽƮ ݺ ֱ (bytes)
+
+// ڷƮ α  ؽƮ : ʵ ̸  ݺǰ  ٲ 
+// õ忡  Ƿ ۽/    
+inline std::string buildTelemetryText(uint32_t seed) {
+    std::string text;
+    text.reserve(TELEMETRY_TEXT_SIZE + 128);
+    uint32_t state = seed;
+    char line[128];
+    for (int i = 0; text.size() < TELEMETRY_TEXT_SIZE; ++i) {
+        state = state * 1664525u + 1013904223u;  // LCG
+        snprintf(line, sizeof(line), "seq=%06d node=%02u temp=%+05.1f vbat=%4.2f rssi=%4d state=%s\n",
+                 i, (state >> 28) & 0x0F, 20.0 + ((state >> 8) % 100) / 10.0, 3.30 + ((state >> 16) % 50) / 100.0,
+                 -40 - static_cast<int>((state >> 24) % 60), (state & 0x07) == 0 ? "WARN" : "OK");
+        text += line;
+    }
+    text.resize(TELEMETRY_TEXT_SIZE);
+    return text;
+}
+
+inline const std::string& telemetryText(bool downlink) {
+    static const std::string uplink = buildTelemetryText(0x2545F491u);
+    static const std::string down = buildTelemetryText(0x9E3779B9u);
+    return downlink ? down : uplink;
+}
+
+// Ʈ   (޽  testMessage() ޽  )
+inline char payloadByte(PayloadPattern pattern, size_t index) {
+    switch (pattern) {
+        case PATTERN_ASCENDING:  return static_cast<char>(index % 256);
+        case PATTERN_DESCENDING: return static_cast<char>(255 - (index % 256));
+        default: {
+            const std::string& text = telemetryText(pattern == PATTERN_TELEMETRY_DOWN);
+            return text[index % TELEMETRY_TEXT_SIZE];
+        }
+    }
+}
+
+inline bool isMessagePattern(PayloadPattern pattern) {
+    return pattern == PATTERN_MESSAGES_UP || pattern == PATTERN_MESSAGES_DOWN;
+}
+
+// ޽  index° ޽ out   ȯ (TEST_MESSAGE_MIN-MAX bytes, ⸶ ٸ )
+inline int testMessage(PayloadPattern pattern, int index, char* out) {
+    int length = TEST_MESSAGE_MIN + (index * 7) % (TEST_MESSAGE_MAX - TEST_MESSAGE_MIN + 1);
+    int seed = pattern == PATTERN_MESSAGES_DOWN ? 0x80 : 0;
+    for (int j = 0; j < length; ++j) {
+        out[j] = static_cast<char>(seed + index * 31 + j);
+    }
+    return length;
+}
+
+// ̷ε带 ׽Ʈ  ä
+// ޽   ŭ ޽   ڸ 0 ( )
+inline void fillPayload(std::vector<char>& payload, PayloadPattern pattern) {
+    if (isMessagePattern(pattern)) {
+        const size_t size = payload.size();
+        MessagePacker packer(static_cast<int>(size));
+        char message[TEST_MESSAGE_MAX];
+        for (int i = 0; packer.add(message, testMessage(pattern, i, message)); ++i) {
+        }
+        packer.take(payload);
+        payload.resize(size, 0);
+        return;
+    }
+    for (size_t j = 0; j < payload.size(); ++j) {
+        payload[j] = payloadByte(pattern, j);
+    }
+}
+
+//  ̷ε尡 ׽Ʈ ϰ ġϴ 
+// messages/messageBytes:  ޽  ޽ Ʈ (޽  ƴϸ ̷ε ü ޽ ϳ)
+inline bool validatePayload(const std::vector<char>& payload, PayloadPattern pattern,
+                            int* messages = nullptr, int* messageBytes = nullptr) {
+    int count = 1;
+    int bytes = static_cast<int>(payload.size());
+    if (isMessagePattern(pattern)) {
+        // ޽ ̷ε ȿ   ٷ 
+        MessageReader reader(payload.data(), static_cast<int>(payload.size()));
+        char expected[TEST_MESSAGE_MAX];
+        const char* message;
+        int length;
+        count = 0;
+        bytes = 0;
+        while (reader.next(message, length)) {
+            if (length != testMessage(pattern, count, expected) || memcmp(message, expected, length) != 0) {
+                return false;
+            }
+            count++;
+            bytes += length;
+        }
+        if (reader.truncated()) return false;
+        for (size_t j = reader.offset(); j < payload.size(); ++j) {
+            if (payload[j] != 0) return false;
+        }
+    } else {
+        for (size_t j = 0; j < payload.size(); ++j) {
+            if (payload[j] != payloadByte(pattern, j)) {
+                return false;
+            }
+        }
+    }
+    if (messages) *messages = count;
+    if (messageBytes) *messageBytes = bytes;
+    return true;
+}
+
+// ۽   غ: ׽Ʈ  ̷ε üũ ä,   İ FEC 
+// lengthPrefixed:  Ǵ   ũ  (  StoredLength ̷ε ̸ ˾Ƴ)
+inline void prepareDataFrame(DataFrame& frame, int payloadSize, PayloadPattern pattern,
+                             bool compression, bool lengthPrefixed, int fecParity) {
+    frame.payload.resize(payloadSize);
+    fillPayload(frame.payload, pattern);
+    frame.checksum = frame.calculateChecksum();
+    frame.lengthPrefixed = lengthPrefixed;
+    if (compression) {
+        frame.compressPayload();
+    }
+    frame.fecParity = fecParity;
+}
+
+// Ŭ̾Ʈ   ü
+// Phase 1 Ŭ̾Ʈ  ϴ   
+struct Settings {
+    int protocolVersion;  //   ( 4)
+    int datasize;          // Ӵ ̷ε ũ (bytes)
+    int num;               //     (0 =   ϴ Ʈ )
+    int reserved;          //  Ʈ (FEATURE_*)
+};
+
+//   з
+enum RetransmitReason {
+    RETX_WRITE_ERROR = 0,  // Ʈ  з  
+    RETX_UNACKED = 1,      // ACK    ٽ 
+    RETX_REASON_COUNT
+};
+
+//   ü
+// Phase 3 Ŭ̾Ʈ   ȯϴ   
+//  7 ʵ   raw ü ȯ   (TLV Tag 1-7)
+//   īʹ Ʈ ǿ 2^31   Ƿ 64Ʈ (    INT_MAX ȭ)
+struct Results {
+    long long totalReceivedBytes;  //   Ʈ 
+    long long receivedNum;         //   
+    long long errorCount;          //  ߻ Ƚ
+    long long retransmitCount;     //  Ƚ
+    double elapsedSeconds;          //  ð ()
+    double throughputMBps;         // ó (MB/s)
+    double charactersPerSecond;    // ʴ   (CPS)
+
+    // Ȯ  (TLV  ޽θ )
+    long long ackLatencySamples;   // ACK   
+    double ackLatencyP50Ms;        //    ACK  (߾Ӱ, ms)
+    double ackLatencyP90Ms;        // ACK  90°  (ms)
+    double ackLatencyP99Ms;        // ACK  99°  (ms)
+    double ackLatencyMaxMs;        // ACK  ִ밪 (ms)
+    long long retransmitByReason[RETX_REASON_COUNT];  //    
+    double phase1Seconds;          // Phase 1 ҿ ð ()
+    double phase2Seconds;          // Phase 2 ҿ ð ()
+    double txLineUtilization;      // ۽  ȸ  (0.0-1.0,  )
+    double rxLineUtilization;      //   ȸ  (0.0-1.0, ȿ Ӹ)
+    long long checksumErrors;      // üũ    
+    long long payloadErrors;       // ̷ε     
+    long long frameErrors;         //  ȭ(SOF/EOF/)  Ƚ
+    long long payloadBytesReceived;  //    ̷ε Ʈ 
+    double compressionRatio;       //  ̷ε / ȸ ̷ε ( ,   1.0)
+    double goodputMBps;            //  ̷ε  ó (MB/s)
+    long long fecCorrectedSymbols; // FEC  Ʈ 
+    long long fecRepairedFrames;   // FEC     
+    long long fecUncorrectableFrames;  // FEC  ɷ Ѿ   
+    long long messagesReceived;    //  ø̼ ޽  (޽  ƴϸ  ϳ ޽ ϳ)
+    long long messageBytesReceived;  //  ޽ Ʈ  ( ڵ  ʵ 0 ä )
+    double messagesPerSecond;      // ޽ ó (msg/s)
+    double headerEfficiency;       // ޽ Ʈ / (̷ε +   ƮϷ) Ʈ (0.0-1.0,  ȿ compressionRatio)
+    long long channelMessagesSent;     // ޽ äη  ޽  (ȭ  ۽ ,  ޽ ä հ)
+    long long channelMessagesReceived; // ޽ äο  ޽  ( )
+    long long channelRetransmits;      // ޽ ä   
+    long long channelUnacked;          // ܰ谡   ACK  ߰ų ⿭  ޽ 
+    double channelLatencyP50Ms;        // ޽ ⿭   ACK  (߾Ӱ, ms)
+    double channelLatencyP99Ms;        // ޽ ä  99°  (ms)
+    double channelLatencyMaxMs;        // ޽ ä  ִ밪 (ms)
+};
+
+//   raw  ü (TLV   ȯ  ϴ ̾ ̾ƿ)
+struct LegacyResults {
+    long long totalReceivedBytes;
+    int receivedNum;
+    int errorCount;
+    int retransmitCount;
+    double elapsedSeconds;
+    double throughputMBps;
+    double charactersPerSecond;
+};
+
+//  ޽ TLV Tag
+//  ʵ  Tagθ ߰ϰ  Tag ǹ̿ Ÿ  
+enum ResultsTag {
+    RTAG_TOTAL_RECEIVED_BYTES = 1,   // int64
+    RTAG_RECEIVED_NUM = 2,           // int32
+    RTAG_ERROR_COUNT = 3,            // int32
+    RTAG_RETRANSMIT_COUNT = 4,       // int32
+    RTAG_ELAPSED_SECONDS = 5,        // double
+    RTAG_THROUGHPUT_MBPS = 6,        // double
+    RTAG_CPS = 7,                    // double
+    RTAG_ACK_LATENCY_SAMPLES = 16,   // int64
+    RTAG_ACK_LATENCY_P50 = 17,       // double
+    RTAG_ACK_LATENCY_P90 = 18,       // double
+    RTAG_ACK_LATENCY_P99 = 19,       // double
+    RTAG_ACK_LATENCY_MAX = 20,       // double
+    RTAG_RETX_WRITE_ERROR = 32,      // int32
+    RTAG_RETX_UNACKED = 33,          // int32
+    RTAG_PHASE1_SECONDS = 48,        // double
+    RTAG_PHASE2_SECONDS = 49,        // double
+    RTAG_TX_LINE_UTILIZATION = 64,   // double
+    RTAG_RX_LINE_UTILIZATION = 65,   // double
+    RTAG_CHECKSUM_ERRORS = 80,       // int32
+    RTAG_PAYLOAD_ERRORS = 81,        // int32
+    RTAG_FRAME_ERRORS = 82,          // int32
+    RTAG_PAYLOAD_BYTES = 96,         // int64
+    RTAG_COMPRESSION_RATIO = 97,     // double
+    RTAG_GOODPUT_MBPS = 98,          // double
+    RTAG_FEC_CORRECTED_SYMBOLS = 112,  // int64
+    RTAG_FEC_REPAIRED_FRAMES = 113,    // int32
+    RTAG_FEC_UNCORRECTABLE = 114,      // int32
+    //  int32  ī 64Ʈ  (Ʈ ǿ, int32 Tag ڿ Ͽ ڵ  )
+    RTAG_RECEIVED_NUM_64 = 128,        // int64
+    RTAG_ERROR_COUNT_64 = 129,         // int64
+    RTAG_RETRANSMIT_COUNT_64 = 130,    // int64
+    RTAG_RETX_WRITE_ERROR_64 = 131,    // int64
+    RTAG_RETX_UNACKED_64 = 132,        // int64
+    RTAG_CHECKSUM_ERRORS_64 = 133,     // int64
+    RTAG_PAYLOAD_ERRORS_64 = 134,      // int64
+    RTAG_FRAME_ERRORS_64 = 135,        // int64
+    RTAG_FEC_REPAIRED_FRAMES_64 = 136, // int64
+    RTAG_FEC_UNCORRECTABLE_64 = 137,   // int64
+    RTAG_MESSAGES = 144,               // int64
+    RTAG_MESSAGE_BYTES = 145,          // int64
+    RTAG_MESSAGES_PER_SECOND = 146,    // double
+    RTAG_HEADER_EFFICIENCY = 147,      // double
+    RTAG_CHANNEL_MESSAGES_SENT = 160,      // int64
+    RTAG_CHANNEL_MESSAGES_RECEIVED = 161,  // int64
+    RTAG_CHANNEL_RETRANSMITS = 162,        // int64
+    RTAG_CHANNEL_UNACKED = 163,            // int64
+    RTAG_CHANNEL_LATENCY_P50 = 164,        // double
+    RTAG_CHANNEL_LATENCY_P99 = 165,        // double
+    RTAG_CHANNEL_LATENCY_MAX = 166         // double
+};
+
+//  ɷ ü
+// ɷ  ޽  ,      
+// (  ˰ ũ õ Ʈ ϳ Ǵ 0)
+struct Capabilities {
+    int checksums;     // üũ ˰ ũ (CHECKSUM_*)
+    int maxWindow;     // ִ  ũ ( )
+    int sackFormats;   // SACK Ʈ  ũ (CAPS_SACK_*, 0 = 32Ʈ ACK)
+    int compression;   //   ũ (0 =  )
+    bool fullDuplex;   //    
+    int maxPayload;    // Ӵ ִ ̷ε ũ (bytes)
+    int ackBatch;      // ȣ ACK  ũ (ACK ϳ Ȯϴ   )
+    int payloads;      // ׽Ʈ ̷ε ũ (PAYLOAD_*, Ŭ̾Ʈ ûϴ ϳ )
+    int fecParity;     // ڵ RS иƼ Ʈ (Ŭ̾Ʈ û ,   ִ밪, 0 = FEC )
+    int adaptiveMax;   //   ũ  (bytes, Ŭ̾Ʈ û ,   ִ밪, 0 = datasize )
+    bool streaming;    //    ʴ Ʈ  (num = 0, Ŭ̾Ʈ û  )
+    bool credits;      //   ACK ũ(CreditLimit) Ǿ ۽ 
+    bool compactHeader;  //      (Ŭ̾Ʈ û  , FEC ǿ  )
+    int channels;      //  ä  (ä 0 , 1 = ȭ  , Ŭ̾Ʈ û ,   ִ밪)
+    int controlRate;   //  ۽ ܰ迡 ä 1    ޽ ӵ (msg/s, ȭ Ǹ)
+    bool ackCrc;       // ACK/SACK ӿ CRC32  (ACK_CRC_SIZE,   )
+    bool frameCrc;     //  ӿ CRC32  (FRAME_CRC_SIZE,  ϰ FEC  )
+};
+
+// ɷ ޽ TLV Tag ( int32)
+//  ޽   ׸  Tagθ ߰
+enum CapabilitiesTag {
+    CTAG_CHECKSUMS = 1,
+    CTAG_MAX_WINDOW = 2,
+    CTAG_SACK_FORMATS = 3,
+    CTAG_COMPRESSION = 4,
+    CTAG_FULL_DUPLEX = 5,
+    CTAG_MAX_PAYLOAD = 6,
+    CTAG_ACK_BATCH = 7,
+    CTAG_PAYLOADS = 8,
+    CTAG_FEC_PARITY = 9,
+    CTAG_ADAPTIVE_MAX = 10,
+    CTAG_STREAMING = 11,
+    CTAG_CREDITS = 12,
+    CTAG_COMPACT_HEADER = 13,
+    CTAG_CHANNELS = 14,
+    CTAG_CONTROL_RATE = 15,
+    CTAG_ACK_CRC = 16,
+    CTAG_FRAME_CRC = 17
+};
+
+// ==========================================================
+// TLV ڵ/ڵ ƿƼ
+// ==========================================================
+
+// little-endian  /б (ȣƮ Ʈ  ϰ  ̾  )
+inline void putLE(std::vector<char>& buffer, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+inline uint64_t getLE(const char* data, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+    }
+    return value;
+}
+
+// 64Ʈ ī͸ int32 ʵ忡   INT_MAX ȭ (   ȯ)
+inline int32_t saturateInt32(long long value) {
+    return static_cast<int32_t>(std::max<long long>(INT_MIN, std::min<long long>(value, INT_MAX)));
+}
+
+//  ȭ  (SYN / SYN-ACK / RESUME)
+// : [SOF_SYNC(1)][Flags(1)][Seq(4)][Ack(4)][CRC32(4)][EOF(1)], CRC32 Flags Ack
+struct SyncFrame {
+    uint8_t flags;
+    uint32_t seq;
+    uint32_t ack;
+    
+    SyncFrame() : flags(0), seq(0), ack(0) {}
+    
+    void serialize(std::vector<char>& buffer) const {
+        buffer.clear();
+        buffer.reserve(SYNC_FRAME_SIZE);
+        buffer.push_back(SOF_SYNC);
+        buffer.push_back(static_cast<char>(flags));
+        putLE(buffer, seq, 4);
+        putLE(buffer, ack, 4);
+        putLE(buffer, crc32(buffer.data() + 1, buffer.size() - 1), 4);
+        buffer.push_back(EOF_BYTE);
+    }
+    
+    // SOF_SYNC/EOF CRC32   ʵ 
+    bool deserialize(const char* buffer, int length) {
+        if (length != SYNC_FRAME_SIZE) return false;
+        if (buffer[0] != SOF_SYNC || buffer[SYNC_FRAME_SIZE - 1] != EOF_BYTE) return false;
+        if (crc32(buffer + 1, SYNC_FRAME_SIZE - 6) != static_cast<uint32_t>(getLE(buffer + SYNC_FRAME_SIZE - 5, 4))) return false;
+        flags = static_cast<uint8_t>(buffer[1]);
+        seq = static_cast<uint32_t>(getLE(buffer + 2, 4));
+        ack = static_cast<uint32_t>(getLE(buffer + 6, 4));
+        return true;
+    }
+};
+
+// TLV ׸ ۼ: ޽  [Tag][Length][Value] ׸  ߰
+class TlvWriter {
+public:
+    void putInt32(uint16_t tag, int32_t value) {
+        putHeader(tag, 4);
+        putLE(body_, static_cast<uint32_t>(value), 4);
+    }
+
+    void putInt64(uint16_t tag, int64_t value) {
+        putHeader(tag, 8);
+        putLE(body_, static_cast<uint64_t>(value), 8);
+    }
+
+    // 64Ʈ ī:   д int32 Tag(INT_MAX ȭ) 64Ʈ Tag   
+    void putCounter(uint16_t tag32, uint16_t tag64, long long value) {
+        putInt32(tag32, saturateInt32(value));
+        putInt64(tag64, value);
+    }
+
+    void putDouble(uint16_t tag, double value) {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        putHeader(tag, 8);
+        putLE(body_, bits, 8);
+    }
+
+    const std::vector<char>& body() const { return body_; }
+
+private:
+    void putHeader(uint16_t tag, uint16_t length) {
+        putLE(body_, tag, 2);
+        putLE(body_, length, 2);
+    }
+
+    std::vector<char> body_;
+};
+
+// TLV ׸ ǵ:  ȸϸ ׸ ϳ ȯ (  )
+class TlvReader {
+public:
+    TlvReader(const char* data, int length) : data_(data), length_(length), offset_(0) {}
+
+    //  ׸ б.  ̰ų ׸ ߷  false
+    bool next(uint16_t& tag, const char*& value, uint16_t& valueLength) {
+        if (offset_ + 4 > length_) return false;
+        tag = static_cast<uint16_t>(getLE(data_ + offset_, 2));
+        valueLength = static_cast<uint16_t>(getLE(data_ + offset_ + 2, 2));
+        if (offset_ + 4 + valueLength > length_) return false;
+        value = data_ + offset_ + 4;
+        offset_ += 4 + valueLength;
+        return true;
+    }
+
+    //  ׸  Һߴ Ȯ
+    bool atEnd() const { return offset_ == length_; }
+
+    static int32_t asInt32(const char* value) { return static_cast<int32_t>(getLE(value, 4)); }
+    static int64_t asInt64(const char* value) { return static_cast<int64_t>(getLE(value, 8)); }
+    static double asDouble(const char* value) {
+        uint64_t bits = getLE(value, 8);
+        double result;
+        memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+private:
+    const char* data_;
+    int length_;
+    int offset_;
+};
+
+//  ޽ ȭ:  + TLV  + CRC32 + EOF
+// CRC32 Type   
+inline void serializeControlMessage(char type, uint8_t version, const std::vector<char>& body,
+                                    std::vector<char>& buffer) {
+    buffer.clear();
+    buffer.reserve(CTRL_HEADER_SIZE + body.size() + CTRL_TRAILER_SIZE);
+    buffer.push_back(SOF_CTRL);
+    buffer.push_back(type);
+    buffer.push_back(static_cast<char>(version));
+    putLE(buffer, body.size(), 2);
+    buffer.insert(buffer.end(), body.begin(), body.end());
+    putLE(buffer, crc32(buffer.data() + 1, buffer.size() - 1), 4);
+    buffer.push_back(EOF_BYTE);
+}
+
+//  ü TLV  ޽ ڵ
+inline void encodeResults(const Results& results, std::vector<char>& buffer) {
+    TlvWriter w;
+    w.putInt64(RTAG_TOTAL_RECEIVED_BYTES, results.totalReceivedBytes);
+    w.putCounter(RTAG_RECEIVED_NUM, RTAG_RECEIVED_NUM_64, results.receivedNum);
+    w.putCounter(RTAG_ERROR_COUNT, RTAG_ERROR_COUNT_64, results.errorCount);
+    w.putCounter(RTAG_RETRANSMIT_COUNT, RTAG_RETRANSMIT_COUNT_64, results.retransmitCount);
+    w.putDouble(RTAG_ELAPSED_SECONDS, results.elapsedSeconds);
+    w.putDouble(RTAG_THROUGHPUT_MBPS, results.throughputMBps);
+    w.putDouble(RTAG_CPS, results.charactersPerSecond);
+    w.putInt64(RTAG_ACK_LATENCY_SAMPLES, results.ackLatencySamples);
+    w.putDouble(RTAG_ACK_LATENCY_P50, results.ackLatencyP50Ms);
+    w.putDouble(RTAG_ACK_LATENCY_P90, results.ackLatencyP90Ms);
+    w.putDouble(RTAG_ACK_LATENCY_P99, results.ackLatencyP99Ms);
+    w.putDouble(RTAG_ACK_LATENCY_MAX, results.ackLatencyMaxMs);
+    w.putCounter(RTAG_RETX_WRITE_ERROR, RTAG_RETX_WRITE_ERROR_64, results.retransmitByReason[RETX_WRITE_ERROR]);
+    w.putCounter(RTAG_RETX_UNACKED, RTAG_RETX_UNACKED_64, results.retransmitByReason[RETX_UNACKED]);
+    w.putDouble(RTAG_PHASE1_SECONDS, results.phase1Seconds);
+    w.putDouble(RTAG_PHASE2_SECONDS, results.phase2Seconds);
+    w.putDouble(RTAG_TX_LINE_UTILIZATION, results.txLineUtilization);
+    w.putDouble(RTAG_RX_LINE_UTILIZATION, results.rxLineUtilization);
+    w.putCounter(RTAG_CHECKSUM_ERRORS, RTAG_CHECKSUM_ERRORS_64, results.checksumErrors);
+    w.putCounter(RTAG_PAYLOAD_ERRORS, RTAG_PAYLOAD_ERRORS_64, results.payloadErrors);
+    w.putCounter(RTAG_FRAME_ERRORS, RTAG_FRAME_ERRORS_64, results.frameErrors);
+    w.putInt64(RTAG_PAYLOAD_BYTES, results.payloadBytesReceived);
+    w.putDouble(RTAG_COMPRESSION_RATIO, results.compressionRatio);
+    w.putDouble(RTAG_GOODPUT_MBPS, results.goodputMBps);
+    w.putInt64(RTAG_FEC_CORRECTED_SYMBOLS, results.fecCorrectedSymbols);
+    w.putCounter(RTAG_FEC_REPAIRED_FRAMES, RTAG_FEC_REPAIRED_FRAMES_64, results.fecRepairedFrames);
+    w.putCounter(RTAG_FEC_UNCORRECTABLE, RTAG_FEC_UNCORRECTABLE_64, results.fecUncorrectableFrames);
+    w.putInt64(RTAG_MESSAGES, results.messagesReceived);
+    w.putInt64(RTAG_MESSAGE_BYTES, results.messageBytesReceived);
+    w.putDouble(RTAG_MESSAGES_PER_SECOND, results.messagesPerSecond);
+    w.putDouble(RTAG_HEADER_EFFICIENCY, results.headerEfficiency);
+    w.putInt64(RTAG_CHANNEL_MESSAGES_SENT, results.channelMessagesSent);
+    w.putInt64(RTAG_CHANNEL_MESSAGES_RECEIVED, results.channelMessagesReceived);
+    w.putInt64(RTAG_CHANNEL_RETRANSMITS, results.channelRetransmits);
+    w.putInt64(RTAG_CHANNEL_UNACKED, results.channelUnacked);
+    w.putDouble(RTAG_CHANNEL_LATENCY_P50, results.channelLatencyP50Ms);
+    w.putDouble(RTAG_CHANNEL_LATENCY_P99, results.channelLatencyP99Ms);
+    w.putDouble(RTAG_CHANNEL_LATENCY_MAX, results.channelLatencyMaxMs);
+    serializeControlMessage(CTRL_TYPE_RESULTS, RESULTS_MSG_VERSION, w.body(), buffer);
+}
+
+// TLV  ޽   ü ڵ
+//  Tag 0 , 𸣴 Tag ̰  ٸ ׸ ǳʶ
+inline bool decodeResults(const char* body, int length, Results& results) {
+    results = Results();
+    TlvReader reader(body, length);
+    uint16_t tag;
+    const char* value;
+    uint16_t valueLength;
+
+    while (reader.next(tag, value, valueLength)) {
+        switch (tag) {
+            case RTAG_TOTAL_RECEIVED_BYTES: if (valueLength == 8) results.totalReceivedBytes = TlvReader::asInt64(value); break;
+            case RTAG_RECEIVED_NUM:         if (valueLength == 4) results.receivedNum = TlvReader::asInt32(value); break;
+            case RTAG_ERROR_COUNT:          if (valueLength == 4) results.errorCount = TlvReader::asInt32(value); break;
+            case RTAG_RETRANSMIT_COUNT:     if (valueLength == 4) results.retransmitCount = TlvReader::asInt32(value); break;
+            case RTAG_ELAPSED_SECONDS:      if (valueLength == 8) results.elapsedSeconds = TlvReader::asDouble(value); break;
+            case RTAG_THROUGHPUT_MBPS:      if (valueLength == 8) results.throughputMBps = TlvReader::asDouble(value); break;
+            case RTAG_CPS:                  if (valueLength == 8) results.charactersPerSecond = TlvReader::asDouble(value); break;
+            case RTAG_ACK_LATENCY_SAMPLES:  if (valueLength == 8) results.ackLatencySamples = TlvReader::asInt64(value); break;
+            case RTAG_ACK_LATENCY_P50:      if (valueLength == 8) results.ackLatencyP50Ms = TlvReader::asDouble(value); break;
+            case RTAG_ACK_LATENCY_P90:      if (valueLength == 8) results.ackLatencyP90Ms = TlvReader::asDouble(value); break;
+            case RTAG_ACK_LATENCY_P99:      if (valueLength == 8) results.ackLatencyP99Ms = TlvReader::asDouble(value); break;
+            case RTAG_ACK_LATENCY_MAX:      if (valueLength == 8) results.ackLatencyMaxMs = TlvReader::asDouble(value); break;
+            case RTAG_RETX_WRITE_ERROR:     if (valueLength == 4) results.retransmitByReason[RETX_WRITE_ERROR] = TlvReader::asInt32(value); break;
+            case RTAG_RETX_UNACKED:         if (valueLength == 4) results.retransmitByReason[RETX_UNACKED] = TlvReader::asInt32(value); break;
+            case RTAG_PHASE1_SECONDS:       if (valueLength == 8) results.phase1Seconds = TlvReader::asDouble(value); break;
+            case RTAG_PHASE2_SECONDS:       if (valueLength == 8) results.phase2Seconds = TlvReader::asDouble(value); break;
+            case RTAG_TX_LINE_UTILIZATION:  if (valueLength == 8) results.txLineUtilization = TlvReader::asDouble(value); break;
+            case RTAG_RX_LINE_UTILIZATION:  if (valueLength == 8) results.rxLineUtilization = TlvReader::asDouble(value); break;
+            case RTAG_CHECKSUM_ERRORS:      if (valueLength == 4) results.checksumErrors = TlvReader::asInt32(value); break;
+            case RTAG_PAYLOAD_ERRORS:       if (valueLength == 4) results.payloadErrors = TlvReader::asInt32(value); break;
+            case RTAG_FRAME_ERRORS:         if (valueLength == 4) results.frameErrors = TlvReader::asInt32(value); break;
+            case RTAG_PAYLOAD_BYTES:        if (valueLength == 8) results.payloadBytesReceived = TlvReader::asInt64(value); break;
+            case RTAG_COMPRESSION_RATIO:    if (valueLength == 8) results.compressionRatio = TlvReader::asDouble(value); break;
+            case RTAG_GOODPUT_MBPS:         if (valueLength == 8) results.goodputMBps = TlvReader::asDouble(value); break;
+            case RTAG_FEC_CORRECTED_SYMBOLS: if (valueLength == 8) results.fecCorrectedSymbols = TlvReader::asInt64(value); break;
+            case RTAG_FEC_REPAIRED_FRAMES:  if (valueLength == 4) results.fecRepairedFrames = TlvReader::asInt32(value); break;
+            case RTAG_FEC_UNCORRECTABLE:    if (valueLength == 4) results.fecUncorrectableFrames = TlvReader::asInt32(value); break;
+            case RTAG_RECEIVED_NUM_64:      if (valueLength == 8) results.receivedNum = TlvReader::asInt64(value); break;
+            case RTAG_ERROR_COUNT_64:       if (valueLength == 8) results.errorCount = TlvReader::asInt64(value); break;
+            case RTAG_RETRANSMIT_COUNT_64:  if (valueLength == 8) results.retransmitCount = TlvReader::asInt64(value); break;
+            case RTAG_RETX_WRITE_ERROR_64:  if (valueLength == 8) results.retransmitByReason[RETX_WRITE_ERROR] = TlvReader::asInt64(value); break;
+            case RTAG_RETX_UNACKED_64:      if (valueLength == 8) results.retransmitByReason[RETX_UNACKED] = TlvReader::asInt64(value); break;
+            case RTAG_CHECKSUM_ERRORS_64:   if (valueLength == 8) results.checksumErrors = TlvReader::asInt64(value); break;
+            case RTAG_PAYLOAD_ERRORS_64:    if (valueLength == 8) results.payloadErrors = TlvReader::asInt64(value); break;
+            case RTAG_FRAME_ERRORS_64:      if (valueLength == 8) results.frameErrors = TlvReader::asInt64(value); break;
+            case RTAG_FEC_REPAIRED_FRAMES_64: if (valueLength == 8) results.fecRepairedFrames = TlvReader::asInt64(value); break;
+            case RTAG_FEC_UNCORRECTABLE_64: if (valueLength == 8) results.fecUncorrectableFrames = TlvReader::asInt64(value); break;
+            case RTAG_MESSAGES:             if (valueLength == 8) results.messagesReceived = TlvReader::asInt64(value); break;
+            case RTAG_MESSAGE_BYTES:        if (valueLength == 8) results.messageBytesReceived = TlvReader::asInt64(value); break;
+            case RTAG_MESSAGES_PER_SECOND:  if (valueLength == 8) results.messagesPerSecond = TlvReader::asDouble(value); break;
+            case RTAG_HEADER_EFFICIENCY:    if (valueLength == 8) results.headerEfficiency = TlvReader::asDouble(value); break;
+            case RTAG_CHANNEL_MESSAGES_SENT:     if (valueLength == 8) results.channelMessagesSent = TlvReader::asInt64(value); break;
+            case RTAG_CHANNEL_MESSAGES_RECEIVED: if (valueLength == 8) results.channelMessagesReceived = TlvReader::asInt64(value); break;
+            case RTAG_CHANNEL_RETRANSMITS:  if (valueLength == 8) results.channelRetransmits = TlvReader::asInt64(value); break;
+            case RTAG_CHANNEL_UNACKED:      if (valueLength == 8) results.channelUnacked = TlvReader::asInt64(value); break;
+            case RTAG_CHANNEL_LATENCY_P50:  if (valueLength == 8) results.channelLatencyP50Ms = TlvReader::asDouble(value); break;
+            case RTAG_CHANNEL_LATENCY_P99:  if (valueLength == 8) results.channelLatencyP99Ms = TlvReader::asDouble(value); break;
+            case RTAG_CHANNEL_LATENCY_MAX:  if (valueLength == 8) results.channelLatencyMaxMs = TlvReader::asDouble(value); break;
+            default: break;  //   ߰ Tag: 
+        }
+    }
+
+    return reader.atEnd();
+}
+
+// ɷ ü TLV ɷ ޽ ڵ
+inline void encodeCapabilities(const Capabilities& caps, std::vector<char>& buffer) {
+    TlvWriter w;
+    w.putInt32(CTAG_CHECKSUMS, caps.checksums);
+    w.putInt32(CTAG_MAX_WINDOW, caps.maxWindow);
+    w.putInt32(CTAG_SACK_FORMATS, caps.sackFormats);
+    w.putInt32(CTAG_COMPRESSION, caps.compression);
+    w.putInt32(CTAG_FULL_DUPLEX, caps.fullDuplex ? 1 : 0);
+    w.putInt32(CTAG_MAX_PAYLOAD, caps.maxPayload);
+    w.putInt32(CTAG_ACK_BATCH, caps.ackBatch);
+    w.putInt32(CTAG_PAYLOADS, caps.payloads);
+    w.putInt32(CTAG_FEC_PARITY, caps.fecParity);
+    w.putInt32(CTAG_ADAPTIVE_MAX, caps.adaptiveMax);
+    w.putInt32(CTAG_STREAMING, caps.streaming ? 1 : 0);
+    w.putInt32(CTAG_CREDITS, caps.credits ? 1 : 0);
+    w.putInt32(CTAG_COMPACT_HEADER, caps.compactHeader ? 1 : 0);
+    w.putInt32(CTAG_CHANNELS, caps.channels);
+    w.putInt32(CTAG_CONTROL_RATE, caps.controlRate);
+    w.putInt32(CTAG_ACK_CRC, caps.ackCrc ? 1 : 0);
+    w.putInt32(CTAG_FRAME_CRC, caps.frameCrc ? 1 : 0);
+    serializeControlMessage(CTRL_TYPE_CAPS, CAPS_MSG_VERSION, w.body(), buffer);
+}
+
+// TLV ɷ ޽  ɷ ü ڵ
+//  Tag    ⺻ (XOR üũ, 32Ʈ ACK,  ,  ACK) ä
+inline bool decodeCapabilities(const char* body, int length, Capabilities& caps) {
+    caps.checksums = CHECKSUM_XOR_ROTATE;
+    caps.maxWindow = WINDOW_SIZE_LEGACY_MAX;
+    caps.sackFormats = 0;
+    caps.compression = 0;
+    caps.fullDuplex = false;
+    caps.maxPayload = FRAME_PAYLOAD_MAX;
+    caps.ackBatch = 1;
+    caps.payloads = PAYLOAD_RAMP;
+    caps.fecParity = 0;
+    caps.adaptiveMax = 0;
+    caps.streaming = false;
+    caps.credits = false;
+    caps.compactHeader = false;
+    caps.channels = 1;
+    caps.controlRate = 0;
+    caps.ackCrc = false;
+    caps.frameCrc = false;
+
+    TlvReader reader(body, length);
+    uint16_t tag;
+    const char* value;
+    uint16_t valueLength;
+
+    while (reader.next(tag, value, valueLength)) {
+        if (valueLength != 4) continue;  //  ׸ int32
+        int32_t v = TlvReader::asInt32(value);
+        switch (tag) {
+            case CTAG_CHECKSUMS:    caps.checksums = v; break;
+            case CTAG_MAX_WINDOW:   caps.maxWindow = v; break;
+            case CTAG_SACK_FORMATS: caps.sackFormats = v; break;
+            case CTAG_COMPRESSION:  caps.compression = v; break;
+            case CTAG_FULL_DUPLEX:  caps.fullDuplex = v != 0; break;
+            case CTAG_MAX_PAYLOAD:  caps.maxPayload = v; break;
+            case CTAG_ACK_BATCH:    caps.ackBatch = v; break;
+            case CTAG_PAYLOADS:     caps.payloads = v; break;
+            case CTAG_FEC_PARITY:   caps.fecParity = v; break;
+            case CTAG_ADAPTIVE_MAX: caps.adaptiveMax = v; break;
+            case CTAG_STREAMING:    caps.streaming = v != 0; break;
+            case CTAG_CREDITS:      caps.credits = v != 0; break;
+            case CTAG_COMPACT_HEADER: caps.compactHeader = v != 0; break;
+            case CTAG_CHANNELS:     caps.channels = v; break;
+            case CTAG_CONTROL_RATE: caps.controlRate = v; break;
+            case CTAG_ACK_CRC:      caps.ackCrc = v != 0; break;
+            case CTAG_FRAME_CRC:    caps.frameCrc = v != 0; break;
+            default: break;  //   ߰ Tag: 
+        }
+    }
+
+    return reader.atEnd();
+}
+
+// ũ   Ʈ  (mask == 0̸ 0)
+inline int highestBit(int mask) {
+    int bit = 0;
+    while (mask != 0) {
+        bit = mask & -mask;
+        mask &= mask - 1;
+    }
+    return bit;
+}
+
+// ǵ ׽Ʈ ̷ε忡 ⺰   (޽ ڷƮ ƴϸ   )
+inline PayloadPattern sessionPattern(int payloads, bool clientToServer) {
+    if (payloads & PAYLOAD_MESSAGES) {
+        return clientToServer ? PATTERN_MESSAGES_UP : PATTERN_MESSAGES_DOWN;
+    }
+    if (payloads & PAYLOAD_TELEMETRY) {
+        return clientToServer ? PATTERN_TELEMETRY_UP : PATTERN_TELEMETRY_DOWN;
+    }
+    return clientToServer ? PATTERN_ASCENDING : PATTERN_DESCENDING;
+}
+
+//  尡 ϴ ɷ (ִ  --window-max)
+inline Capabilities localCapabilities() {
+    Capabilities caps;
+    caps.checksums = SUPPORTED_CHECKSUMS;
+    caps.maxWindow = windowSizeLimit;
+    caps.sackFormats = CAPS_SACK;
+    caps.compression = SUPPORTED_COMPRESSION;
+    caps.fullDuplex = false;
+    caps.maxPayload = FRAME_PAYLOAD_MAX;
+    caps.ackBatch = ACK_BATCH_PREFERRED;
+    caps.payloads = SUPPORTED_PAYLOADS;
+    caps.fecParity = FEC_PARITY_MAX;
+    caps.adaptiveMax = FRAME_PAYLOAD_MAX;
+    caps.streaming = true;
+    caps.credits = true;
+    caps.compactHeader = true;
+    caps.channels = MUX_CHANNELS_MAX;
+    caps.controlRate = 0;
+    caps.ackCrc = true;
+    caps.frameCrc = true;
+    return caps;
+}
+
+// ɷ :   ϴ    
+// ˰  ũ ֻ Ʈ, ũ   , SACK  츦 32 
+inline Capabilities negotiateCapabilities(const Capabilities& local, const Capabilities& remote) {
+    Capabilities agreed;
+    agreed.checksums = highestBit(local.checksums & remote.checksums);
+    agreed.sackFormats = highestBit(local.sackFormats & remote.sackFormats);
+    agreed.compression = highestBit(local.compression & remote.compression);
+    agreed.fullDuplex = local.fullDuplex && remote.fullDuplex;
+    agreed.streaming = local.streaming && remote.streaming;
+    agreed.credits = local.credits && remote.credits;
+    agreed.ackCrc = local.ackCrc && remote.ackCrc;
+    agreed.maxPayload = std::min(local.maxPayload, remote.maxPayload);
+    agreed.ackBatch = std::max(1, std::min(local.ackBatch, remote.ackBatch));
+    agreed.payloads = highestBit(local.payloads & remote.payloads);
+    agreed.fecParity = std::max(0, std::min(local.fecParity, remote.fecParity)) & ~1;  //  ɷ parity / 2
+    agreed.compactHeader = local.compactHeader && remote.compactHeader && agreed.fecParity == 0;  // FEC  ũ  ڵ
+    agreed.frameCrc = local.frameCrc && remote.frameCrc && agreed.fecParity == 0;  // FEC  RS ڵ ˻簡 
+    agreed.adaptiveMax = std::max(0, std::min(std::min(local.adaptiveMax, remote.adaptiveMax), agreed.maxPayload));
+    agreed.maxWindow = std::max(WINDOW_SIZE_MIN, std::min(local.maxWindow, remote.maxWindow));
+    agreed.channels = std::max(1, std::min(std::min(local.channels, remote.channels), MUX_CHANNELS_MAX));
+    agreed.controlRate = agreed.channels > 1 ? std::max(0, std::max(local.controlRate, remote.controlRate)) : 0;  // û  
+    if (agreed.sackFormats == 0) {
+        agreed.maxWindow = std::min(agreed.maxWindow, WINDOW_SIZE_LEGACY_MAX);
+    }
+    return agreed;
+}
+
+// ɷ ޽ ְ ʴ    (Settings.reserved  Ʈ   )
+inline Capabilities capabilitiesFromFeatures(int agreedFeatures) {
+    Capabilities caps = localCapabilities();
+    caps.sackFormats = (agreedFeatures & FEATURE_SACK) != 0 ? CAPS_SACK : 0;
+    caps.compression = 0;
+    caps.fullDuplex = false;
+    caps.ackBatch = 1;
+    caps.payloads = PAYLOAD_RAMP;
+    caps.fecParity = 0;
+    caps.adaptiveMax = 0;
+    caps.streaming = false;
+    caps.credits = false;
+    caps.compactHeader = false;
+    caps.channels = 1;
+    caps.controlRate = 0;
+    caps.ackCrc = false;
+    caps.frameCrc = false;
+    if (caps.sackFormats == 0) {
+        caps.maxWindow = std::min(caps.maxWindow, WINDOW_SIZE_LEGACY_MAX);
+    }
+    return caps;
+}
+
+// ==========================================================
+// м ȣ (LT ȣ, ܹ  )
+// ==========================================================
+//  ä Ƿ ۽    K ״  (ü ȣ)    XOR
+//   ʿ ŭ ̾ .      SymbolId K õ 
+//  Ȱ ϹǷ ӿ  
+//    ̵ K    :  1 ĺ Ǯ  peeling  ϰ,
+// peeling ߸   GF(2) 콺 Ұŷ ǯ (Raptor ȣ inactivation ȣ  )
+//  κ ̹  ¿ LT ȣ ָ (  ln K)    κ
+//     Ƿ,  2K  սǷ Ƶ  Ӹ    
+// (K = 1000 սǷ 2-50%  ʿ  K  1-3%)
+const double FOUNTAIN_DEGREE_FACTOR = 2.0;   //    = FOUNTAIN_DEGREE_FACTOR x K
+const int FOUNTAIN_ELIMINATION_MAX = 8192;   // 콺 Ұŷ Ǯ ִ    (Ʈ  8MB)
+
+// SymbolId   (splitmix64): ۽/   ̿    
+struct FountainRandom {
+    uint64_t state;
+
+    FountainRandom(uint32_t symbolId, int sourceCount)
+        : state((static_cast<uint64_t>(symbolId) << 32) ^ static_cast<uint32_t>(sourceCount)) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    int below(int n) { return static_cast<int>(((next() >> 32) * static_cast<uint64_t>(n)) >> 32); }
+};
+
+// dst ^= src (8Ʈ ,  Ʈ )
+inline void xorInto(char* dst, const char* src, size_t length) {
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t a, b;
+        memcpy(&a, dst + i, 8);
+        memcpy(&b, src + i, 8);
+        a ^= b;
+        memcpy(dst + i, &a, 8);
+    }
+    for (; i < length; ++i) {
+        dst[i] ^= src[i];
+    }
+}
+
+//   XOR   
+class FountainCode {
+public:
+    explicit FountainCode(int sourceCount)
+        : sourceCount_(sourceCount),
+          degree_(std::min(sourceCount, static_cast<int>(std::ceil(FOUNTAIN_DEGREE_FACTOR * std::sqrt(static_cast<double>(sourceCount)))))) {}
+
+    int sourceCount() const { return sourceCount_; }
+    int degree() const { return degree_; }
+
+    // symbolId  XORϴ   ε (  ڱ ڽ ϳ)
+    void neighbors(uint32_t symbolId, std::vector<int>& out) const {
+        out.clear();
+        if (symbolId < static_cast<uint32_t>(sourceCount_)) {
+            out.push_back(static_cast<int>(symbolId));
+            return;
+        }
+        // ڶ ŭ ̰   ߺ ϱ⸦ ݺ ( ĵ  ٸ ε)
+        FountainRandom random(symbolId, sourceCount_);
+        while (static_cast<int>(out.size()) < degree_) {
+            while (static_cast<int>(out.size()) < degree_) {
+                out.push_back(random.below(sourceCount_));
+            }
+            std::sort(out.begin(), out.end());
+            out.erase(std::unique(out.begin(), out.end()), out.end());
+        }
+    }
+
+private:
+    int sourceCount_;
+    int degree_;  //   
+};
+
+//     : Ӹ  ġ ޸Ͽ ߸    ãƳ  ְ 
+inline void fillSourcePayload(char* out, int datasize, PayloadPattern pattern, int index) {
+    size_t offset = static_cast<size_t>(index) * (datasize + 1);
+    for (int j = 0; j < datasize; ++j) {
+        out[j] = payloadByte(pattern, offset + j);
+    }
+}
+
+//   (SymbolId  Ǵ  )
+struct FountainFrame {
+    uint32_t sessionId;     //   ĺ (ٸ  Ӱ  ʵ)
+    uint32_t symbolId;      // ɺ ȣ (< sourceCount̸  )
+    uint32_t sourceCount;   //    K
+    uint8_t pattern;        //  ̷ε  (PayloadPattern)
+    std::vector<char> payload;
+
+    FountainFrame() : sessionId(0), symbolId(0), sourceCount(0), pattern(0) {}
+
+    // : [SOF_FOUNTAIN(1)][SessionId(4)][SymbolId(4)][SourceCount(4)][DataSize(4)][Pattern(1)][Payload][CRC32(4)][EOF(1)]
+    void serialize(std::vector<char>& buffer) const {
+        buffer.clear();
+        buffer.reserve(payload.size() + FOUNTAIN_OVERHEAD);
+        buffer.push_back(SOF_FOUNTAIN);
+        putLE(buffer, sessionId, 4);
+        putLE(buffer, symbolId, 4);
+        putLE(buffer, sourceCount, 4);
+        putLE(buffer, payload.size(), 4);
+        buffer.push_back(static_cast<char>(pattern));
+        buffer.insert(buffer.end(), payload.begin(), payload.end());
+        putLE(buffer, crc32(buffer.data() + 1, buffer.size() - 1), 4);
+        buffer.push_back(EOF_BYTE);
+    }
+
+    //  DataSize ʵ ( ü ̸ ˱      ȣ)
+    static uint32_t dataSize(const char* header) {
+        return static_cast<uint32_t>(getLE(header + 13, 4));
+    }
+
+    // SOF/EOF CRC32    true
+    bool deserialize(const char* buffer, int length) {
+        if (length < FOUNTAIN_OVERHEAD) return false;
+        if (buffer[0] != SOF_FOUNTAIN || buffer[length - 1] != EOF_BYTE) return false;
+        if (dataSize(buffer) != static_cast<uint32_t>(length - FOUNTAIN_OVERHEAD)) return false;
+        if (crc32(buffer + 1, length - 1 - FOUNTAIN_TRAILER_SIZE) != getLE(buffer + length - FOUNTAIN_TRAILER_SIZE, 4)) return false;
+
+        sessionId = static_cast<uint32_t>(getLE(buffer + 1, 4));
+        symbolId = static_cast<uint32_t>(getLE(buffer + 5, 4));
+        sourceCount = static_cast<uint32_t>(getLE(buffer + 9, 4));
+        pattern = static_cast<uint8_t>(buffer[17]);
+        payload.assign(buffer + FOUNTAIN_HEADER_SIZE, buffer + length - FOUNTAIN_TRAILER_SIZE);
+        return true;
+    }
+};
+
+// м ȣ ȣ:  ɺ  ӿ  XOR  ϰ Ǯ  ִ ŭ  ǯ
+class FountainDecoder {
+public:
+    FountainDecoder(int sourceCount, int symbolSize)
+        : code_(sourceCount), symbolSize_(symbolSize), sources_(static_cast<size_t>(sourceCount) * symbolSize),
+          known_(sourceCount, 0), watchers_(sourceCount), recovered_(0), pending_(0),
+          nextElimination_(0), eliminated_(0) {}
+
+    bool complete() const { return recovered_ == code_.sourceCount(); }
+    int recoveredCount() const { return recovered_; }
+    int eliminatedCount() const { return eliminated_; }  // 콺 Ұŷ Ǭ  
+    bool isKnown(int index) const { return known_[index] != 0; }
+    const char* source(int index) const { return sources_.data() + static_cast<size_t>(index) * symbolSize_; }
+
+    // ɺ ϳ ߰ (data symbolSize Ʈ)
+    void addSymbol(uint32_t symbolId, const char* data) {
+        if (complete()) return;
+        code_.neighbors(symbolId, neighbors_);
+
+        Equation equation;
+        equation.data.assign(data, data + symbolSize_);
+        for (int s : neighbors_) {
+            if (known_[s]) {
+                xorInto(equation.data.data(), source(s), symbolSize_);
+            } else {
+                equation.unknowns.push_back(s);
+            }
+        }
+        if (equation.unknowns.empty()) return;  // ̹ ƴ   ߺ ɺ
+        if (equation.unknowns.size() == 1) {
+            recover(equation.unknowns[0], equation.data.data());
+            return;
+        }
+
+        int index = static_cast<int>(equations_.size());
+        for (int s : equation.unknowns) {
+            watchers_[s].push_back(index);
+        }
+        equations_.push_back(std::move(equation));
+        pending_++;
+        tryElimination();
+    }
+
+private:
+    struct Equation {
+        std::vector<int> unknowns;  //  𸣴  ε ( Ǯ )
+        std::vector<char> data;     // ƴ  XOR  
+    };
+
+    char* sourceData(int index) { return sources_.data() + static_cast<size_t>(index) * symbolSize_; }
+
+    //  ϳ Ȯϰ,     ٿ  1 Ǵ   ǯ (peeling)
+    void recover(int index, const char* data) {
+        std::vector<int> ready(1, index);
+        memcpy(sourceData(index), data, symbolSize_);
+        known_[index] = 1;
+        recovered_++;
+        while (!ready.empty()) {
+            int s = ready.back();
+            ready.pop_back();
+            for (int e : watchers_[s]) {
+                Equation& equation = equations_[e];
+                if (equation.unknowns.empty()) continue;
+                xorInto(equation.data.data(), source(s), symbolSize_);
+                equation.unknowns.erase(std::find(equation.unknowns.begin(), equation.unknowns.end(), s));
+                if (equation.unknowns.size() == 1) {
+                    int next = equation.unknowns[0];
+                    if (!known_[next]) {
+                        memcpy(sourceData(next), equation.data.data(), symbolSize_);
+                        known_[next] = 1;
+                        recovered_++;
+                        ready.push_back(next);
+                    }
+                    equation.unknowns.clear();
+                }
+                if (equation.unknowns.empty()) {
+                    std::vector<char>().swap(equation.data);
+                    pending_--;
+                }
+            }
+            std::vector<int>().swap(watchers_[s]);
+        }
+    }
+
+    // peeling  ¿       ̸̻ 콺 Ұ õ
+    //   (rank) Ʈ   Ȯϰ, Ǯ    ̷ε忡   
+    void tryElimination() {
+        const int unknown = code_.sourceCount() - recovered_;
+        if (unknown == 0 || unknown > FOUNTAIN_ELIMINATION_MAX || pending_ < unknown || pending_ < nextElimination_) return;
+        // ϸ    1/16ŭ    ٽ õ 
+        nextElimination_ = pending_ + std::max(1, unknown / 16);
+
+        std::vector<int> column(code_.sourceCount(), -1);
+        std::vector<int> columnSource;
+        for (int s = 0; s < code_.sourceCount(); ++s) {
+            if (!known_[s]) {
+                column[s] = static_cast<int>(columnSource.size());
+                columnSource.push_back(s);
+            }
+        }
+        std::vector<int> rows;
+        for (size_t e = 0; e < equations_.size(); ++e) {
+            if (!equations_[e].unknowns.empty()) rows.push_back(static_cast<int>(e));
+        }
+        const int words = (unknown + 63) / 64;
+        std::vector<uint64_t> bits(rows.size() * words, 0);
+        for (size_t r = 0; r < rows.size(); ++r) {
+            for (int s : equations_[rows[r]].unknowns) {
+                bits[r * words + column[s] / 64] |= 1ULL << (column[s] % 64);
+            }
+        }
+
+        if (eliminate(bits, words, unknown, rows.size(), nullptr) < unknown) return;
+
+        // Ǯ  :  ҰŸ ̷ε忡  (Gauss-Jordan̹Ƿ r° ǹ  r°  )
+        for (size_t r = 0; r < rows.size(); ++r) {
+            std::fill(bits.begin() + r * words, bits.begin() + (r + 1) * words, 0);
+            for (int s : equations_[rows[r]].unknowns) {
+                bits[r * words + column[s] / 64] |= 1ULL << (column[s] % 64);
+            }
+        }
+        eliminate(bits, words, unknown, rows.size(), &rows);
+        for (int c = 0; c < unknown; ++c) {
+            memcpy(sourceData(columnSource[c]), equations_[rows[c]].data.data(), symbolSize_);
+            known_[columnSource[c]] = 1;
+        }
+        for (int e : rows) {
+            equations_[e].unknowns.clear();
+            std::vector<char>().swap(equations_[e].data);
+        }
+        for (int s : columnSource) {
+            std::vector<int>().swap(watchers_[s]);
+        }
+        recovered_ += unknown;
+        eliminated_ += unknown;
+        pending_ = 0;
+    }
+
+    // GF(2) Gauss-Jordan Ұ, ã ǹ  ȯ
+    // payloadRows ־  ȯ XOR ش  ̷ε忡 
+    int eliminate(std::vector<uint64_t>& bits, int words, int columns, size_t rowCount, std::vector<int>* payloadRows) {
+        size_t rank = 0;
+        for (int c = 0; c < columns && rank < rowCount; ++c) {
+            const int word = c / 64;
+            const uint64_t mask = 1ULL << (c % 64);
+            size_t pivot = rank;
+            while (pivot < rowCount && !(bits[pivot * words + word] & mask)) pivot++;
+            if (pivot == rowCount) continue;
+            if (pivot != rank) {
+                std::swap_ranges(bits.begin() + pivot * words, bits.begin() + (pivot + 1) * words, bits.begin() + rank * words);
+                if (payloadRows) std::swap((*payloadRows)[pivot], (*payloadRows)[rank]);
+            }
+            for (size_t r = 0; r < rowCount; ++r) {
+                if (r == rank || !(bits[r * words + word] & mask)) continue;
+                for (int w = word; w < words; ++w) {
+                    bits[r * words + w] ^= bits[rank * words + w];
+                }
+                if (payloadRows) {
+                    xorInto(equations_[(*payloadRows)[r]].data.data(), equations_[(*payloadRows)[rank]].data.data(), symbolSize_);
+                }
+            }
+            rank++;
+        }
+        return static_cast<int>(rank);
+    }
+
+    FountainCode code_;
+    int symbolSize_;
+    std::vector<char> sources_;            //    (K x symbolSize)
+    std::vector<char> known_;              //   
+    std::vector<Equation> equations_;      //   2 ̻ 
+    std::vector<std::vector<int> > watchers_;  //      ε
+    std::vector<int> neighbors_;           // addSymbol ۾ 
+    int recovered_;
+    int pending_;                          //  Ǯ   
+    int nextElimination_;                  //  콺 ҰŸ õ pending_ 
+    int eliminated_;
+};
+
+// ==========================================================
+// LatencyHistogram:  ޸ α   ׷
+// ==========================================================
+// ũ   2 ŵ  16    
+//    6% ̳      ޸𸮷 
+class LatencyHistogram {
+public:
+    LatencyHistogram() : count_(0), maxUs_(0) {
+        memset(buckets_, 0, sizeof(buckets_));
+    }
+
+    void record(uint64_t us) {
+        buckets_[bucketIndex(us)]++;
+        count_++;
+        if (us > maxUs_) maxUs_ = us;
+    }
+
+    // ٸ ׷ ǥ   ( ä  ĥ )
+    void merge(const LatencyHistogram& other) {
+        for (int i = 0; i < BUCKET_COUNT; ++i) {
+            buckets_[i] += other.buckets_[i];
+        }
+        count_ += other.count_;
+        if (other.maxUs_ > maxUs_) maxUs_ = other.maxUs_;
+    }
+
+    long long count() const { return count_; }
+    double maxMs() const { return maxUs_ / 1000.0; }
+    uint64_t maxValue() const { return maxUs_; }
+
+    //  (0.0-1.0) : ش  ߾Ӱ иʷ ȯ
+    double percentileMs(double p) const {
+        return percentile(p) / 1000.0;
+    }
+
+    //   ״  (Ʈ   ð ̿  )
+    double percentile(double p) const {
+        if (count_ == 0) return 0.0;
+        long long rank = static_cast<long long>(p * count_ + 0.5);
+        if (rank < 1) rank = 1;
+        if (rank > count_) rank = count_;
+
+        long long seen = 0;
+        for (int i = 0; i < BUCKET_COUNT; ++i) {
+            seen += buckets_[i];
+            if (seen >= rank) {
+                double mid = (bucketLower(i) + bucketLower(i + 1)) / 2.0;
+                return std::min(mid, static_cast<double>(maxUs_));
+            }
+        }
+        return static_cast<double>(maxUs_);
+    }
+
+private:
+    static const int SUB_BUCKETS = 16;          //     
+    static const int MAGNITUDES = 40;           // 2^40us ( 12) ǥ
+    static const int BUCKET_COUNT = SUB_BUCKETS * MAGNITUDES;
+
+    static int bucketIndex(uint64_t us) {
+        if (us < SUB_BUCKETS) return static_cast<int>(us);
+        int magnitude = 0;
+        uint64_t v = us;
+        while (v >= 2 * SUB_BUCKETS) {
+            v >>= 1;
+            magnitude++;
+        }
+        int index = (magnitude + 1) * SUB_BUCKETS + static_cast<int>(v - SUB_BUCKETS);
+        return std::min(index, BUCKET_COUNT - 1);
+    }
+
+    static double bucketLower(int index) {
+        if (index < SUB_BUCKETS) return index;
+        int magnitude = index / SUB_BUCKETS - 1;
+        int sub = index % SUB_BUCKETS;
+        return static_cast<double>((SUB_BUCKETS + sub) * (1ull << magnitude));
+    }
+
+    long long buckets_[BUCKET_COUNT];
+    long long count_;
+    uint64_t maxUs_;
+};
+
+// ==========================================================
+// ǽð  ī
+// ==========================================================
+// ۼ δ relaxed   ī͸  (ý ȣ )
+// Խô SerialCommunicator.cpp  ޸ Խ(--stats-shm) Ʈ Ʈ(--metrics-port) 
+
+//  ܰ (LiveStatsShm.phase)
+enum LivePhase {
+    LIVE_PHASE_IDLE = 0,        // Ʈ  /  
+    LIVE_PHASE_SETTINGS = 1,    //  ȯ
+    LIVE_PHASE_1 = 2,           // Phase 1 (Ŭ̾Ʈ  )
+    LIVE_PHASE_2 = 3,           // Phase 2 (  Ŭ̾Ʈ)
+    LIVE_PHASE_RESULTS = 4,     // READY ȭ   ȯ
+    LIVE_PHASE_DONE = 5         //  Ʈ  Ϸ
+};
+
+// ۼ ο ϴ ī ( memory_order_relaxed)
+struct LiveCounters {
+    std::atomic<long long> bytesSent;       // ۽ Ʈ ( + ACK,  )
+    std::atomic<long long> bytesReceived;   //     Ʈ
+    std::atomic<long long> framesSent;      // ۽    ( )
+    std::atomic<long long> framesAcked;     //  ACK   
+    std::atomic<long long> framesReceived;  //   Ϸ   
+    std::atomic<long long> retransmits;     //    
+    std::atomic<long long> errors;          //   (üũ/̷ε/)
+    std::atomic<int> windowSize;            //  ۽  ũ
+    std::atomic<int> phase;                 //  ܰ (LivePhase)
+    std::atomic<long long> srttUs;          // Ȱ RTT (   ACK, ũ)
+
+    LiveCounters()
+        : bytesSent(0), bytesReceived(0), framesSent(0), framesAcked(0), framesReceived(0),
+          retransmits(0), errors(0), windowSize(0), phase(LIVE_PHASE_IDLE), srttUs(0) {}
+
+    static void add(std::atomic<long long>& counter, long long value) {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    // RTT  ݿ (TCP SRTT  1/8  ̵ , ACK  忡 ȣ)
+    void addRttSample(long long sampleUs) {
+        long long srtt = srttUs.load(std::memory_order_relaxed);
+        srttUs.store(srtt == 0 ? sampleUs : srtt + (sampleUs - srtt) / 8, std::memory_order_relaxed);
+    }
+};
+
+extern LiveCounters liveCounters;  // μ  ǽð ī
+
+//   :     ֵ   ð 
+// (Windows Ÿ̸ ػ  û ð   찡 )
+extern std::atomic<long long> fixedSleepCount;
+extern std::atomic<long long> fixedSleepMicros;
+
+template <typename Rep, typename Period>
+void timedSleep(const std::chrono::duration<Rep, Period>& duration) {
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(duration);
+    LiveCounters::add(fixedSleepCount, 1);
+    LiveCounters::add(fixedSleepMicros, std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+// SerialPort ⺰ I/O  (б readMutex,  writeMutex Ʒ )
+// ̹   ó     ϱ  
+struct IoStats {
+    long long requests;             // read()/write() ȣ 
+    long long calls;                // ReadFile/WriteFile ȣ 
+    long long bytes;                // Ϸ Ʈ 
+    long long partialCalls;         // û  Ϸ ȣ 
+    long long waitTimeouts;         // WAIT_TIMEOUT ߻ Ƚ
+    long long cancelIoCalls;        // CancelIo ȣ 
+    long long errors;               //   
+    uint64_t waitUs;                // Ϸ ⿡   ð (ũ)
+    LatencyHistogram bytesPerCall;  // ȣ Ϸ Ʈ 
+    LatencyHistogram completionUs;  // ȣ Ϸ ɸ ð 
+
+    IoStats() : requests(0), calls(0), bytes(0), partialCalls(0), waitTimeouts(0),
+                cancelIoCalls(0), errors(0), waitUs(0) {}
+
+    void recordCompletion(DWORD requested, DWORD completed, uint64_t elapsedUs) {
+        bytes += completed;
+        if (completed < requested) partialCalls++;
+        bytesPerCall.record(completed);
+        completionUs.record(elapsedUs);
+    }
+};
+
+inline uint64_t elapsedMicros(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+// ==========================================================
+// μ  ޸ ä (bench )
+// ==========================================================
+// "mem:≮>/A" "mem:≮>/B" Ʈ  μ ȿ    ä 
+// Ʈ     ü ó Ѱ踦 ϱ  
+const char MEMORY_PORT_PREFIX[] = "mem:";
+// ۽ڴ ACK   Ȯ   ϹǷ,  ȸó Ⱑ   뷮 
+// (1MBó ũ  ߺ  ׿ ACK и  )
+const size_t MEMORY_PIPE_CAPACITY = 4096;
+const unsigned MEMORY_PIPE_ERROR_SEED = 20240521;  // Ʈ    õ (ึ   )
+const int MEMORY_OUTAGE_MS = 200;                  // --inject-disconnect:  ޸ ä ٽ    ð
+
+// ܹ Ʈ  ( ũ  )
+class MemoryPipe {
+public:
+    MemoryPipe() : buffer_(MEMORY_PIPE_CAPACITY), head_(0), count_(0), random_(MEMORY_PIPE_ERROR_SEED), bitsUntilError_(-1) {}
+
+    //     , ŸӾƿ    ϸ  Ʈ  ȯ
+    int write(const char* data, int length, DWORD timeoutMs) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        std::unique_lock<std::mutex> lock(mutex_);
+        int written = 0;
+        while (written < length) {
+            if (!cv_.wait_until(lock, deadline, [this] { return count_ < buffer_.size(); })) {
+                break;
+            }
+            size_t chunk = std::min(static_cast<size_t>(length - written), buffer_.size() - count_);
+            for (size_t i = 0; i < chunk; ++i) {
+                buffer_[(head_ + count_ + i) % buffer_.size()] = data[written + i];
+            }
+            injectErrors(head_ + count_, chunk);
+            count_ += chunk;
+            written += static_cast<int>(chunk);
+            cv_.notify_all();
+        }
+        return written;
+    }
+
+    // SerialPort::read  ǹ: length Ʈ ̰ų ŸӾƿ  
+    int read(char* data, int length, DWORD timeoutMs) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        std::unique_lock<std::mutex> lock(mutex_);
+        int received = 0;
+        while (received < length) {
+            if (!cv_.wait_until(lock, deadline, [this] { return count_ > 0; })) {
+                break;
+            }
+            size_t chunk = std::min(static_cast<size_t>(length - received), count_);
+            for (size_t i = 0; i < chunk; ++i) {
+                data[received + i] = buffer_[(head_ + i) % buffer_.size()];
+            }
+            head_ = (head_ + chunk) % buffer_.size();
+            count_ -= chunk;
+            received += static_cast<int>(chunk);
+            cv_.notify_all();
+        }
+        return received;
+    }
+
+    //  ʰ  Ʈ  (ClearCommError cbInQue ش)
+    int queued() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return static_cast<int>(count_);
+    }
+
+    // ۿ  Ʈ   (PurgeComm(PURGE_RXCLEAR) ش)
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        head_ = 0;
+        count_ = 0;
+        cv_.notify_all();
+    }
+
+private:
+    //  ȸ  (--inject-ber):   Ʈ    ̾   Ʈ Ʈ 
+    void injectErrors(size_t start, size_t count) {
+        if (injectedBitErrorRate <= 0.0) return;
+        std::geometric_distribution<long long> gap(injectedBitErrorRate);
+        if (bitsUntilError_ < 0) bitsUntilError_ = gap(random_);
+        long long bits = static_cast<long long>(count) * 8;
+        while (bitsUntilError_ < bits) {
+            buffer_[(start + bitsUntilError_ / 8) % buffer_.size()] ^= static_cast<char>(1 << (bitsUntilError_ % 8));
+            bitsUntilError_ += 1 + gap(random_);
+        }
+        bitsUntilError_ -= bits;
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<char> buffer_;
+    size_t head_;
+    size_t count_;
+    std::mt19937 random_;
+    long long bitsUntilError_;  //  Ʈ   Ʈ  (-1 =   )
+};
+
+//  ä: pipes[0] A  B, pipes[1] B  A
+// ȸ   (--inject-disconnect): injectedOutageIntervalMs ä  ȸ ִ Ʈ ,
+// MEMORY_OUTAGE_MS  ٽ     (USB ȯ⸦ ̾Ҵ ȴ Ȳ)
+struct MemoryLink {
+    MemoryPipe pipes[2];
+    
+    MemoryLink() : epoch_(0), nextOutage_(std::chrono::steady_clock::now() + std::chrono::milliseconds(injectedOutageIntervalMs)) {}
+    
+    //   ȣ ȯ ( ð   ): Ʈ   ȣ ٸ   Ǵ
+    unsigned checkOutage() {
+        if (injectedOutageIntervalMs <= 0) return 0;
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = std::chrono::steady_clock::now();
+        if (now >= nextOutage_) {
+            epoch_++;
+            pipes[0].clear();
+            pipes[1].clear();
+            downUntil_ = now + std::chrono::milliseconds(MEMORY_OUTAGE_MS);
+            nextOutage_ = downUntil_ + std::chrono::milliseconds(injectedOutageIntervalMs);
+        }
+        return epoch_;
+    }
+    
+    //   ٽ   ִ 
+    bool available() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::chrono::steady_clock::now() >= downUntil_;
+    }
+
+private:
+    std::mutex mutex_;
+    unsigned epoch_;                                    //   ϴ  ȣ
+    std::chrono::steady_clock::time_point downUntil_;   //  ð  ٽ   
+    std::chrono::steady_clock::time_point nextOutage_;  //   ð
+};
+
+//  ̸ Ʈ   MemoryLink ϵ ̸ 
+std::shared_ptr<MemoryLink> attachMemoryLink(const std::string& name);
+
+// ==========================================================
+// SerialPort Ŭ (Overlapped I/O  񵿱 ø )
+// ==========================================================
+// Windows API Overlapped I/O Ͽ 񵿱 ø  
+// б/ ۾ ÿ   ,  ۾  ؽ ȣ
+// ġ (USB ȯ и ) Ʈ ݰ LINK_RETRY_MIN_MS  辿 ø  ٽ ,
+// ٽ   б/ ȣ  (linkRecoverySeconds ȿ  ϸ  ȣ  )
+class SerialPort {
+public:
+    // :  ڵ ʱȭϰ OVERLAPPED ü 0 ʱȭ
+    SerialPort() : hComm(INVALID_HANDLE_VALUE), readEvent(NULL), writeEvent(NULL), baudRate(0), memorySide(0),
+                   memoryEpoch(0), linkGeneration(0), linkBroken(false), linkFailed(false), reconnects(0), downMicros(0) {
+        ZeroMemory(&readOverlapped, sizeof(OVERLAPPED));
+        ZeroMemory(&writeOverlapped, sizeof(OVERLAPPED));
+    }
+    
+    // Ҹ:   ڵ ϰ 
+    ~SerialPort() {
+        closeHandles();
+    }
+    
+    // ø Ʈ   ʱȭ
+    // Overlapped I/O  Ʈ ,  Ķ ,  ũ 
+    // reopening:  Ʈ ٽ  ̸ true (ġ     õ α׿  )
+    bool open(const std::string& comport, int baudrate, bool reopening = false) {
+        portName = comport;
+        if (comport.compare(0, strlen(MEMORY_PORT_PREFIX), MEMORY_PORT_PREFIX) == 0) {
+            return openMemory(comport, baudrate);
+        }
+        std::string devicePath = "\\\\.\\" + comport;  // Windows COM10 ̻  ʿ
+        
+        // Overlapped I/O  ø Ʈ 
+        hComm = CreateFileA(devicePath.c_str(),
+                            GENERIC_READ | GENERIC_WRITE,
+                            0,
+                            NULL,
+                            OPEN_EXISTING,
+                            FILE_FLAG_OVERLAPPED,  // 񵿱 I/O 
+                            NULL);
+
+        if (hComm == INVALID_HANDLE_VALUE) {
+            if (!reopening) logMessage("Error: Unable to open " + comport);
+            return false;
+        }
+
+        // б/ ۾ ϷḦ ˸ ̺Ʈ ü 
+        readEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+        writeEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+        
+        if (!readEvent || !writeEvent) {
+            logMessage("Error: Failed to create event objects");
+            closeHandles();
+            return false;
+        }
+
+        // OVERLAPPED ü ̺Ʈ ڵ 
+        readOverlapped.hEvent = readEvent;
+        writeOverlapped.hEvent = writeEvent;
+
+        // DCB ü ʱȭ   Ʈ  б
+        DCB dcbSerialParams = { 0 };
+        dcbSerialParams.DCBlength = sizeof(dcbSerialParams);
+
+        if (!GetCommState(hComm, &dcbSerialParams)) {
+            logMessage("Error getting device state");
+            CloseHandle(hComm);
+            hComm = INVALID_HANDLE_VALUE;
+            return false;
+        }
+
+        //  Ķ 
+        dcbSerialParams.BaudRate = baudrate;
+        dcbSerialParams.ByteSize = 8;           // 8Ʈ 
+        dcbSerialParams.StopBits = ONESTOPBIT; // 1  Ʈ
+        dcbSerialParams.Parity = NOPARITY;      // иƼ 
+        
+        // ܺ   ÷ο Ʈ Ȱȭ
+        // DTR/RTS Ȱȭϵ, CTS/DSR/XON/XOFF ÷ο Ʈ Ȱȭ
+        dcbSerialParams.fOutxCtsFlow = FALSE;   // CTS ÷ο Ʈ Ȱȭ
+        dcbSerialParams.fOutxDsrFlow = FALSE;   // DSR ÷ο Ʈ Ȱȭ
+        dcbSerialParams.fDtrControl = DTR_CONTROL_ENABLE;  // DTR Ȱȭ
+        dcbSerialParams.fRtsControl = RTS_CONTROL_ENABLE;  // RTS Ȱȭ
+        dcbSerialParams.fOutX = FALSE;          // XON/XOFF ۽ ÷ο Ʈ Ȱȭ
+        dcbSerialParams.fInX = FALSE;           // XON/XOFF  ÷ο Ʈ Ȱȭ
+
+        if (!SetCommState(hComm, &dcbSerialParams)) {
+            logMessage("Error setting device state");
+            CloseHandle(hComm);
+            hComm = INVALID_HANDLE_VALUE;
+            return false;
+        }
+
+        // ŸӾƿ : Overlapped I/O 0 Ͽ 񵿱 
+        COMMTIMEOUTS timeouts = { 0 };
+        timeouts.ReadIntervalTimeout = 0;
+        timeouts.ReadTotalTimeoutConstant = 0;
+        timeouts.ReadTotalTimeoutMultiplier = 0;
+        timeouts.WriteTotalTimeoutConstant = 0;
+        timeouts.WriteTotalTimeoutMultiplier = 0;
+
+        if (!SetCommTimeouts(hComm, &timeouts)) {
+            logMessage("Error setting timeouts");
+            CloseHandle(hComm);
+            hComm = INVALID_HANDLE_VALUE;
+            return false;
+        }
+
+        //     ũ⸦ 128KB 1MB 
+        if (!SetupComm(hComm, SERIAL_QUEUE_BYTES, SERIAL_QUEUE_BYTES)) {
+            logMessage("Warning: Failed to set buffer size to 1MB");
+        }
+
+        baudRate = baudrate;
+        
+        // Ʈ      
+        DWORD flags = PURGE_RXCLEAR | PURGE_TXCLEAR | PURGE_RXABORT | PURGE_TXABORT;
+        if (!PurgeComm(hComm, flags)) {
+            logMessage("Warning: Failed to purge buffers on open");
+        } else {
+            logMessage("Port buffers purged on open.");
+        }
+
+        return true;
+    }
+    
+    //  
+    //  ۾ writeMutex ȣǾ ÿ ϳ  ۾  
+    // ȸ  ٽ  (Ǵ  ) ٸ  -1 ȯ (  ʹ ȣ  ٽ )
+    int write(const char* buffer, int length) {
+        if (linkFailed) return -1;
+        const unsigned generation = linkGeneration;
+        int written;
+        {
+            std::lock_guard<std::mutex> lock(writeMutex);
+            written = memoryLink ? writeMemory(buffer, length) : writePort(buffer, length);
+        }
+        if (linkBroken) recoverLink(generation);
+        return written;
+    }
+    
+    //  б
+    // б ۾ readMutex ȣǾ ÿ ϳ б ۾  
+    // unread() ǵ  Ʈ  ȯ   Ʈ 
+    // ȸ  write()   ٸ  ׶  Ʈ ( -1) ȯ
+    int read(char* buffer, int length, DWORD timeoutMs = 0) {
+        if (linkFailed) return -1;
+        const unsigned generation = linkGeneration;
+        int received;
+        {
+            std::lock_guard<std::mutex> lock(readMutex);
+            int taken = std::min(length, static_cast<int>(pushback.size()));
+            std::copy(pushback.begin(), pushback.begin() + taken, buffer);
+            pushback.erase(pushback.begin(), pushback.begin() + taken);
+            if (taken == length) return length;
+            received = memoryLink ? readMemory(buffer + taken, length - taken, timeoutMs)
+                                  : readPort(buffer + taken, length - taken, timeoutMs);
+            if (taken > 0) received = taken + std::max(received, 0);
+        }
+        if (linkBroken) recoverLink(generation);
+        return received;
+    }
+    
+    //  Ʈ ǵ :  read()  Ʈ ȯ (߳    Ʈ ٽ   )
+    void unread(const char* data, int length) {
+        std::lock_guard<std::mutex> lock(readMutex);
+        pushback.insert(pushback.begin(), data, data + length);
+    }
+    
+    //   ÷
+    // ø Ʈ  ۿ ִ  ͸  
+    // Phase 3  ȯ  ȭ  
+    bool flush() {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (memoryLink) return true;
+        if (hComm == INVALID_HANDLE_VALUE) return false;
+        return FlushFileBuffers(hComm) != 0;
+    }
+    
+    //   Ʈ ȯ
+    int getBaudRate() const { return baudRate; }
+    
+    //     Ʈ  (̹   + unread() ǵ  Ʈ)
+    //   ũ : ó и   Ŀ
+    int queuedBytes() {
+        std::lock_guard<std::mutex> lock(readMutex);
+        int queued = static_cast<int>(pushback.size());
+        if (memoryLink) {
+            return queued + memoryLink->pipes[1 - memorySide].queued();
+        }
+        DWORD errors = 0;
+        COMSTAT status;
+        if (hComm != INVALID_HANDLE_VALUE && ClearCommError(hComm, &errors, &status)) {
+            queued += static_cast<int>(status.cbInQue);
+        }
+        return queued;
+    }
+    
+    // I/O    (  ؽ  Ƿ   ȣ  )
+    void getIoStats(IoStats& readOut, IoStats& writeOut) {
+        {
+            std::lock_guard<std::mutex> lock(readMutex);
+            readOut = readStats;
+        }
+        std::lock_guard<std::mutex> lock(writeMutex);
+        writeOut = writeStats;
+    }
+    
+    // I/O  ʱȭ (  Ǹ    )
+    void resetIoStats() {
+        {
+            std::lock_guard<std::mutex> lock(readMutex);
+            readStats = IoStats();
+        }
+        std::lock_guard<std::mutex> lock(writeMutex);
+        writeStats = IoStats();
+        reconnects = 0;
+        downMicros = 0;
+    }
+    
+    // ȸ  : ٽ  Ƚ  ִ  ð ()
+    int getReconnectCount() const { return reconnects.load(); }
+    double getLinkDownSeconds() const { return downMicros.load() / 1e6; }
+    
+    // Ʈ ٽ   : ȣ   ٲ    ͸  (RESUME ȯ)
+    unsigned getLinkGeneration() const { return linkGeneration.load(); }
+    
+    //  Ʈ linkRecoverySeconds ȿ ٽ   ( б/  )
+    bool isLinkFailed() const { return linkFailed.load(); }
+    
+    // /۽  :    ̳  Ʈ     ʵ 
+    // ޸ ä   ( ) 
+    bool purge() {
+        std::lock_guard<std::mutex> readLock(readMutex);
+        std::lock_guard<std::mutex> writeLock(writeMutex);
+        pushback.clear();
+        if (memoryLink) {
+            memoryLink->pipes[1 - memorySide].clear();
+            return true;
+        }
+        if (hComm == INVALID_HANDLE_VALUE) return false;
+        return PurgeComm(hComm, PURGE_RXCLEAR | PURGE_TXCLEAR | PURGE_RXABORT | PURGE_TXABORT) != 0;
+    }
+
+private:
+    HANDLE hComm;                    // ø Ʈ ڵ
+    OVERLAPPED readOverlapped;       // б ۾ OVERLAPPED ü
+    OVERLAPPED writeOverlapped;      //  ۾ OVERLAPPED ü
+    HANDLE readEvent;                // б ۾ Ϸ ̺Ʈ
+    HANDLE writeEvent;               //  ۾ Ϸ ̺Ʈ
+    std::mutex readMutex;            // б ۾ ȭ ؽ
+    std::mutex writeMutex;            //  ۾ ȭ ؽ
+    int baudRate;                    //  Ʈ 
+    IoStats readStats;               // б  (readMutex ȣ)
+    IoStats writeStats;              //   (writeMutex ȣ)
+    std::shared_ptr<MemoryLink> memoryLink;  // ޸ ä (mem: Ʈ )
+    int memorySide;                  // 0 = A , 1 = B 
+    unsigned memoryEpoch;            // ޸ ä    ȣ (--inject-disconnect)
+    std::string portName;            //   ٽ  Ʈ ̸
+    std::vector<char> pushback;      // unread() ǵ  Ʈ (readMutex ȣ)
+    std::mutex recoveryMutex;        //   常 
+    std::atomic<unsigned> linkGeneration;  // Ʈ ٽ  Ƚ ()
+    std::atomic<bool> linkBroken;    // ġ    (  )
+    std::atomic<bool> linkFailed;    //  
+    std::atomic<int> reconnects;     // ٽ  Ƚ (, resetIoStats ʱȭ)
+    std::atomic<long long> downMicros;  //  ִ  ð (ũ)
+    
+    // ڵ  (ٽ   Ҹ )
+    void closeHandles() {
+        if (readEvent) CloseHandle(readEvent);
+        if (writeEvent) CloseHandle(writeEvent);
+        readEvent = NULL;
+        writeEvent = NULL;
+        if (hComm != INVALID_HANDLE_VALUE) {
+            CloseHandle(hComm);
+            hComm = INVALID_HANDLE_VALUE;
+        }
+    }
+    
+    // б/   ġ Ȯ: Ʈ  ClearCommError ϹǷ   ǥ
+    void checkLink() {
+        DWORD errors = 0;
+        COMSTAT status;
+        if (!ClearCommError(hComm, &errors, &status)) {
+            linkBroken = true;
+        }
+    }
+    
+    //  Ʈ : б/⸦   ä ٽ   ϸ õ
+    // generation:  ȣ    (  ٸ 尡 ̹  ƹ͵  )
+    void recoverLink(unsigned generation) {
+        std::lock_guard<std::mutex> recoveryLock(recoveryMutex);
+        if (linkGeneration != generation || linkFailed) return;
+        std::lock_guard<std::mutex> readLock(readMutex);
+        std::lock_guard<std::mutex> writeLock(writeMutex);
+        
+        const auto downStart = std::chrono::steady_clock::now();
+        const auto deadline = downStart + std::chrono::seconds(linkRecoverySeconds);
+        logMessage("Link lost on " + portName + "; reopening (up to " + std::to_string(linkRecoverySeconds) + " s)...");
+        if (!memoryLink) closeHandles();
+        pushback.clear();
+        int retryMs = LINK_RETRY_MIN_MS;
+        int attempts = 0;
+        while (true) {
+            if (std::chrono::steady_clock::now() + std::chrono::milliseconds(retryMs) > deadline) {
+                linkFailed = true;
+                logMessage("Error: Link on " + portName + " not restored within " + std::to_string(linkRecoverySeconds) +
+                           " s (" + std::to_string(attempts) + " attempts).");
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(retryMs));
+            attempts++;
+            if (memoryLink ? reopenMemory() : open(portName, baudRate, true)) break;
+            retryMs = std::min(retryMs * 2, LINK_RETRY_MAX_MS);
+        }
+        
+        long long downUs = elapsedMicros(downStart);
+        downMicros += downUs;
+        reconnects++;
+        linkBroken = false;
+        linkGeneration++;
+        logMessage("Link restored on " + portName + " after " + std::to_string(downUs / 1000) + " ms (attempt " +
+                   std::to_string(attempts) + ").");
+    }
+    
+    //  ޸ ä ٽ  (MEMORY_OUTAGE_MS  )
+    bool reopenMemory() {
+        if (!memoryLink->available()) return false;
+        memoryEpoch = memoryLink->checkOutage();
+        return true;
+    }
+    
+    // ø Ʈ  (񵿱 Overlapped I/O, writeMutex  ¿ ȣ)
+    int writePort(const char* buffer, int length) {
+        if (hComm == INVALID_HANDLE_VALUE) return -1;
+
+        DWORD bytesWritten = 0;
+        writeStats.requests++;
+        writeStats.calls++;
+        auto callStart = std::chrono::steady_clock::now();
+        
+        // OVERLAPPED ü ʱȭ  ̺Ʈ 
+        ZeroMemory(&writeOverlapped, sizeof(OVERLAPPED));
+        writeOverlapped.hEvent = writeEvent;
+        ResetEvent(writeOverlapped.hEvent);
+        
+        // 񵿱  ۾ 
+        BOOL result = WriteFile(hComm, buffer, length, &bytesWritten, &writeOverlapped);
+        
+        if (!result) {
+            DWORD error = GetLastError();
+            if (error == ERROR_IO_PENDING) {
+                // 񵿱 ۾  ̹Ƿ Ϸ 
+                DWORD timeout = calculateTimeout(length);
+                auto waitStart = std::chrono::steady_clock::now();
+                DWORD waitResult = WaitForSingleObject(writeOverlapped.hEvent, timeout);
+                writeStats.waitUs += elapsedMicros(waitStart);
+                
+                if (waitResult == WAIT_OBJECT_0) {
+                    //  ۾ Ϸ,  Ȯ
+                    if (GetOverlappedResult(hComm, &writeOverlapped, &bytesWritten, FALSE)) {
+                        writeStats.recordCompletion(length, bytesWritten, elapsedMicros(callStart));
+                        return bytesWritten;
+                    }
+                } else if (waitResult == WAIT_TIMEOUT) {
+                    // ŸӾƿ ߻, ۾ 
+                    logMessage("Error: Write timeout (" + std::to_string(timeout) + "ms)");
+                    writeStats.waitTimeouts++;
+                    writeStats.cancelIoCalls++;
+                    CancelIo(hComm);
+                    return -1;
+                }
+            }
+            logMessage("Error writing to serial port: " + std::to_string(error));
+            writeStats.errors++;
+            checkLink();
+            return -1;
+        }
+        
+        //   Ϸ 
+        writeStats.recordCompletion(length, bytesWritten, elapsedMicros(callStart));
+        return bytesWritten;
+    }
+    
+    // ø Ʈ б (񵿱 Overlapped I/O, readMutex  ¿ ȣ)
+    // û ̸ŭ аų ŸӾƿ ߻  ݺ б 
+    int readPort(char* buffer, int length, DWORD timeoutMs) {
+        if (hComm == INVALID_HANDLE_VALUE) return -1;
+
+        DWORD totalBytesRead = 0;
+        readStats.requests++;
+        
+        // ŸӾƿ     ũ  ڵ 
+        if (timeoutMs == 0) {
+            timeoutMs = calculateTimeout(length);
+        }
+        
+        // û ̸ŭ   ݺ
+        while (totalBytesRead < length) {
+            DWORD bytesReadInThisCall = 0;
+            DWORD requested = length - totalBytesRead;
+            readStats.calls++;
+            auto callStart = std::chrono::steady_clock::now();
+            
+            // OVERLAPPED ü ʱȭ  ̺Ʈ 
+            ZeroMemory(&readOverlapped, sizeof(OVERLAPPED));
+            readOverlapped.hEvent = readEvent;
+            ResetEvent(readOverlapped.hEvent);
+            
+            // 񵿱 б ۾  ( ̸ŭ б)
+            BOOL result = ReadFile(hComm, 
+                                  buffer + totalBytesRead, 
+                                  requested, 
+                                  &bytesReadInThisCall, 
+                                  &readOverlapped);
+            
+            if (!result) {
+                DWORD error = GetLastError();
+                if (error == ERROR_IO_PENDING) {
+                    // 񵿱 ۾  ̹Ƿ Ϸ 
+                    auto waitStart = std::chrono::steady_clock::now();
+                    DWORD waitResult = WaitForSingleObject(readOverlapped.hEvent, timeoutMs);
+                    readStats.waitUs += elapsedMicros(waitStart);
+                    
+                    if (waitResult == WAIT_OBJECT_0) {
+                        // б ۾ Ϸ,  Ȯ
+                        if (GetOverlappedResult(hComm, &readOverlapped, &bytesReadInThisCall, FALSE)) {
+                            readStats.recordCompletion(requested, bytesReadInThisCall, elapsedMicros(callStart));
+                            if (bytesReadInThisCall > 0) {
+                                totalBytesRead += bytesReadInThisCall;
+                            } else {
+                                //  ̻  Ͱ 
+                                break;
+                            }
+                        } else {
+                            readStats.errors++;
+                            checkLink();
+                            return -1;
+                        }
+                    } else if (waitResult == WAIT_TIMEOUT) {
+                        // ŸӾƿ ߻
+                        readStats.waitTimeouts++;
+                        if (totalBytesRead > 0) {
+                            // Ϻζ о ȯ
+                            break;
+                        }
+                        // ƹ͵   ۾ ϰ  ȯ
+                        readStats.cancelIoCalls++;
+                        CancelIo(hComm);
+                        return -1;
+                    }
+                } else {
+                    readStats.errors++;
+                    checkLink();
+                    return -1;
+                }
+            } else {
+                //   Ϸ 
+                readStats.recordCompletion(requested, bytesReadInThisCall, elapsedMicros(callStart));
+                if (bytesReadInThisCall > 0) {
+                    totalBytesRead += bytesReadInThisCall;
+                } else {
+                    //  ̻  Ͱ 
+                    break;
+                }
+            }
+        }
+        
+        return totalBytesRead;
+    }
+    
+    // "mem:≮>/A|B" Ʈ : Ʈ ŸӾƿ 꿡 
+    bool openMemory(const std::string& comport, int baudrate) {
+        size_t slash = comport.rfind('/');
+        std::string side = slash == std::string::npos ? "" : comport.substr(slash + 1);
+        if (side != "A" && side != "B") {
+            logMessage("Error: Memory port must end with /A or /B: " + comport);
+            return false;
+        }
+        memoryLink = attachMemoryLink(comport.substr(0, slash));
+        memorySide = (side == "A") ? 0 : 1;
+        memoryEpoch = memoryLink->checkOutage();
+        baudRate = baudrate;
+        return true;
+    }
+    
+    int writeMemory(const char* buffer, int length) {
+        writeStats.requests++;
+        if (memoryLink->checkOutage() != memoryEpoch) {
+            writeStats.errors++;
+            linkBroken = true;
+            return -1;
+        }
+        writeStats.calls++;
+        auto callStart = std::chrono::steady_clock::now();
+        DWORD timeout = calculateTimeout(length);
+        int written = memoryLink->pipes[memorySide].write(buffer, length, timeout);
+        writeStats.waitUs += elapsedMicros(callStart);
+        if (written < length) {
+            logMessage("Error: Write timeout (" + std::to_string(timeout) + "ms)");
+            writeStats.waitTimeouts++;
+            return -1;
+        }
+        writeStats.recordCompletion(length, written, elapsedMicros(callStart));
+        return written;
+    }
+    
+    int readMemory(char* buffer, int length, DWORD timeoutMs) {
+        if (timeoutMs == 0) {
+            timeoutMs = calculateTimeout(length);
+        }
+        readStats.requests++;
+        if (memoryLink->checkOutage() != memoryEpoch) {
+            readStats.errors++;
+            linkBroken = true;
+            return -1;
+        }
+        readStats.calls++;
+        auto callStart = std::chrono::steady_clock::now();
+        int received = memoryLink->pipes[1 - memorySide].read(buffer, length, timeoutMs);
+        readStats.waitUs += elapsedMicros(callStart);
+        if (received < length) {
+            readStats.waitTimeouts++;
+        }
+        if (received == 0) {
+            return -1;
+        }
+        readStats.recordCompletion(length, received, elapsedMicros(callStart));
+        return received;
+    }
+    
+    //  ũ  ŸӾƿ 
+    //  ð 2.5 + ⺻ ŸӾƿ(500ms) Ͽ  ŸӾƿ  
+    // ּ 200ms, ִ 60ʷ 
+    DWORD calculateTimeout(int dataSize) const {
+        if (baudRate == 0) return 5000;
+        
+        //  ð : ( ũ * 10Ʈ/Ʈ) / Ʈ * 1000ms *  
+        // 10Ʈ = 8Ʈ  + 1 ŸƮ Ʈ + 1  Ʈ
+        double transmitTime = (static_cast<double>(dataSize) * 10.0 / baudRate) * 1000.0 * TIMEOUT_SAFETY_FACTOR;
+        DWORD timeout = static_cast<DWORD>(transmitTime) + BASE_TIMEOUT_MS;
+        
+        if (timeout < 200) timeout = 200;    // ּ ŸӾƿ: 200ms
+        // 뷮     ŸӾƿ  (ִ 60)
+        if (timeout > 60000) timeout = 60000;  // ִ ŸӾƿ: 60 (ſ ū Ϳ)
+        
+        return timeout;
+    }
+};
+
+// ==========================================================
+//    (ȸ    ܿ Ʈ ó)
+// ==========================================================
+//    Ϻΰ   ̷ д  ߰ ϹǷ,   Ʈ ٽ 
+
+bool sendSyncFrame(SerialPort& serial, uint8_t flags, uint32_t seq, uint32_t ack);
+
+// 谡 ߳ б⿡ ù Ʈ    ĺ(sof Ǵ SOF_SYNC)͸ Ʈ ǵ 
+void skipToNextStart(SerialPort& serial, const char* buffer, int length, char sof);
+
+//    Ȯ:  Ʈ sof̰ EOF ڸ(eofOffset,  -1) EOF  谡 ´  Ǵ
+// ϳ  ̷ε     ߳ бⰡ Ӹ  ڸ ݺ  
+//  Ʈ  ´ ߳ б⵵ Ƿ (:  ̷ε 02     ڸ 03 )
+// ȣ    ϸ discardFrame  ĺ ٽ ã
+// ߳   ĺ(sof Ǵ SOF_SYNC)͸ Ʈ ǵ ΰ true
+bool realignFrame(SerialPort& serial, const char* buffer, int length, char sof, int eofOffset);
+
+// (ȭ, üũ,  ȣ )     1Ʈ    ĺ ٽ 
+// SOF/EOF ´ ߳ б  ̾ д  Ź  ڸ Ƿ,   踦 ٽ ãƾ Ǯ
+// 谡 ¾Ҵ ջ ̸ ǵ  Ʈ ȿ   SOF ãǷ Ҵ  
+// FEC  readDataFrame ۸   ٲ ȸ Ʈ ǵ  Ƿ ״ 
+void discardFrame(SerialPort& serial, const char* buffer, int length, int fecParity);
+
+// /ACK  ڸ SOF_SYNC   ȭ  ϳ  (ȣ   Ʈ  ǵ )
+// ջưų timeoutMs ȿ   ʾ SOF_SYNC  Ʈ   ǵ   false
+bool readStreamSyncFrame(SerialPort& serial, SyncFrame& frame, DWORD timeoutMs);
+
+// ==========================================================
+//   å (WindowManager  ũ  )
+// ==========================================================
+// ũ Ư( UART, FTDI, CH340,   )  ȸ ӵ ϴ  ٸǷ
+//   --window-policy .  ޼ WindowManager windowMutex  ¿ ȣ
+class WindowPolicy {
+public:
+    virtual ~WindowPolicy() {}
+    
+    // å ̸ (--window-policy ,  α׿ )
+    virtual const char* name() const = 0;
+    
+    //   ũ
+    virtual int initialWindow(int maxWindow) const {
+        return std::min(WINDOW_SIZE_INIT, maxWindow);
+    }
+    
+    //   ACK: ackedFrames = ̹ ACK Ȯε  
+    // rttMs = Ȱ RTT, minRttMs =  ּ RTT (ǥ  0)
+    //   ũ⸦ ȯϰ, ũ⸦ ٲٴ  reason  
+    virtual int onAck(int window, int maxWindow, int ackedFrames, double rttMs, double minRttMs,
+                      const char*& reason) = 0;
+    
+    // ս ȣ (  Ǵ  Ÿ̸ )
+    virtual int onLoss(int window, int maxWindow, const char*& reason) = 0;
+};
+
+//  ޸ƽ:  3ȸ   2,  3ȸ   , RTT > 2000ms̸ 
+class LegacyWindowPolicy : public WindowPolicy {
+public:
+    LegacyWindowPolicy() : consecutiveSuccesses(0), consecutiveFailures(0) {}
+    
+    const char* name() const { return "legacy"; }
+    
+    int onAck(int window, int maxWindow, int, double rttMs, double, const char*& reason) {
+        consecutiveSuccesses++;
+        consecutiveFailures = 0;
+        
+        //  3ȸ    ũ⸦ 2  ( 5ȸ->3ȸ, 1.5->2 )
+        if (consecutiveSuccesses >= 3) {
+            int newSize = std::min(window * 2, maxWindow);  //  : 1.5  2
+            if (newSize != window) {
+                reason = "3 consecutive successes";
+                window = newSize;
+            }
+            consecutiveSuccesses = 0;
+        }
+        
+        // RTT   : RTT > 2000ms̸  ũǷ   ( 1000ms -> 2000ms ȭ)
+        if (rttMs > 2000.0) {
+            int newSize = std::max(window / 2, WINDOW_SIZE_MIN);
+            if (newSize != window) {
+                reason = "RTT above 2000ms";
+                window = newSize;
+            }
+            consecutiveSuccesses = 0;
+        }
+        return window;
+    }
+    
+    int onLoss(int window, int, const char*& reason) {
+        consecutiveFailures++;
+        consecutiveSuccesses = 0;
+        
+        //  3ȸ    ũ⸦   ( 2ȸ->3ȸ ȭϿ  )
+        if (consecutiveFailures >= 3) {
+            int newSize = std::max(window / 2, WINDOW_SIZE_MIN);
+            if (newSize != window) {
+                reason = "3 consecutive failures";
+                window = newSize;
+            }
+            consecutiveFailures = 0;
+        }
+        return window;
+    }
+
+private:
+    int consecutiveSuccesses;  //   Ƚ ( Ȯ)
+    int consecutiveFailures;   //   Ƚ ( ҿ)
+};
+
+//  AIMD:  ϳ з ACK  1  , սǸ 
+class AimdWindowPolicy : public WindowPolicy {
+public:
+    AimdWindowPolicy() : ackedSinceIncrease(0) {}
+    
+    const char* name() const { return "aimd"; }
+    
+    int initialWindow(int maxWindow) const {
+        return std::min(WINDOW_SIZE_MIN, maxWindow);
+    }
+    
+    int onAck(int window, int maxWindow, int ackedFrames, double, double, const char*& reason) {
+        ackedSinceIncrease += ackedFrames;
+        if (ackedSinceIncrease >= window && window < maxWindow) {
+            ackedSinceIncrease = 0;
+            reason = "additive increase";
+            return window + 1;
+        }
+        return window;
+    }
+    
+    int onLoss(int window, int, const char*& reason) {
+        ackedSinceIncrease = 0;
+        int newSize = std::max(window / 2, WINDOW_SIZE_MIN);
+        if (newSize != window) {
+            reason = "multiplicative decrease";
+        }
+        return newSize;
+    }
+
+private:
+    int ackedSinceIncrease;  //    ACK  
+};
+
+// BDP :  = Ʈ  ּ RTT   Ʈ  (ȸ ä  ʿ  )
+// Ȱ RTT ۽ ť  ð ϹǷ    ּ RTT 
+class BdpWindowPolicy : public WindowPolicy {
+public:
+    BdpWindowPolicy(int baudrate, int frameSize)
+        : frameBits(static_cast<double>(frameSize) * 10.0), baudrate(baudrate) {}
+    
+    const char* name() const { return "bdp"; }
+    
+    int onAck(int window, int maxWindow, int, double, double minRttMs, const char*& reason) {
+        if (minRttMs <= 0.0 || baudrate <= 0) {
+            return window;  // RTT ǥ   
+        }
+        double bdpFrames = baudrate * (minRttMs / 1000.0) / frameBits;
+        int target = static_cast<int>(std::ceil(bdpFrames));
+        target = std::max(WINDOW_SIZE_MIN, std::min(target, maxWindow));
+        if (target != window) {
+            reason = "bandwidth-delay product";
+        }
+        return target;
+    }
+    
+    // BDP ũ 뷮  ǹǷ սǿ   ( )
+    int onLoss(int window, int, const char*&) {
+        return window;
+    }
+
+private:
+    double frameBits;  //  ϳ ȸ Ʈ  (Ʈ 10Ʈ)
+    int baudrate;
+};
+
+//  : ׻ ִ (--window-max) 
+class FixedWindowPolicy : public WindowPolicy {
+public:
+    const char* name() const { return "fixed"; }
+    int initialWindow(int maxWindow) const { return maxWindow; }
+    int onAck(int window, int, int, double, double, const char*&) { return window; }
+    int onLoss(int window, int, const char*&) { return window; }
+};
+
+// ̸ å  (   ̸̸ nullptr)
+std::unique_ptr<WindowPolicy> makeWindowPolicy(const std::string& name, int baudrate, int frameSize);
+
+// ==========================================================
+// WindowManager Ŭ: ̵  ˰    ũ 
+// ==========================================================
+// Selective Repeat ARQ  ̵ 츦 ϴ Ŭ
+// Thread-safe  Ƽ ȯ濡 ϰ  
+class WindowManager {
+public:
+    // : ʱ  ũ ̽  ȣ ʱȭ
+    // policy    ޸ƽ(LegacyWindowPolicy) 
+    // Ʈ  totalFrames = STREAM_FRAMES_UNBOUNDED ϰ finishStream()  
+    WindowManager(long long totalFrames, int maxWindow = WINDOW_SIZE_LEGACY_MAX,
+                  std::unique_ptr<WindowPolicy> windowPolicy = std::unique_ptr<WindowPolicy>())
+        : baseSeq(0),                    //    ȣ
+          nextNewSeq(0),                 //      ù  ȣ
+          maxWindowSize(maxWindow),      // ִ  ũ
+          totalFrames(totalFrames),       // ü  
+          ackedFrames(maxWindow),        //   ACK  (base = baseSeq)
+          creditLimit(LLONG_MAX),        //   ũ  (ũ ޱ   )
+          policy(windowPolicy ? std::move(windowPolicy)
+                              : std::unique_ptr<WindowPolicy>(new LegacyWindowPolicy())),
+          version(0) {                   //   ī (  )
+        windowSize = policy->initialWindow(maxWindowSize);  // ʱ  ũ (legacy: 16 )
+        liveCounters.windowSize.store(windowSize, std::memory_order_relaxed);
+    }
+    
+    //   å ̸
+    const char* getPolicyName() const { return policy->name(); }
+    
+    // å  ũ⸦ ٲ Ƚ (/)
+    void getDecisionCounts(int& increases, int& decreases) const {
+        std::lock_guard<std::mutex> lock(windowMutex);
+        increases = windowIncreases;
+        decreases = windowDecreases;
+    }
+    
+    //   ̽  ȣ ȯ
+    long long getBase() const {
+        std::lock_guard<std::mutex> lock(windowMutex);
+        return baseSeq;
+    }
+    
+    // ü   (Ʈ     STREAM_FRAMES_UNBOUNDED)
+    long long getTotalFrames() const {
+        std::lock_guard<std::mutex> lock(windowMutex);
+        return totalFrames;
+    }
+    
+    // ִ  ũ (  ٲ )
+    int getMaxWindowSize() const { return maxWindowSize; }
+    
+    // Ʈ  :    ù ġ Ʈ   ϰ ü   Ȯ
+    // ۽ 忡 ȣ (  takeNewFrames Ʈ  ӱ )
+    // ȯ: Ʈ   ġ (Ʈ  ƴϰų ̹   -1)
+    long long finishStream() {
+        std::lock_guard<std::mutex> lock(windowMutex);
+        if (totalFrames != STREAM_FRAMES_UNBOUNDED) return -1;
+        totalFrames = nextNewSeq + 1;
+        notifyChangeLocked();
+        return nextNewSeq;
+    }
+    
+    //   ũ ȯ
+    int getWindowSize() const {
+        std::lock_guard<std::mutex> lock(windowMutex);
+        return windowSize;
+    }
+    
+    // Ư  ȣ     ִ Ȯ
+    bool isInWindow(long long frameNum) const {
+        std::lock_guard<std::mutex> lock(windowMutex);
+        return (frameNum >= baseSeq && frameNum < baseSeq + windowSize);
+    }
+    
+    // Ư  ȣ  ACK · ǥ (O(1))
+    // ȯ:  ACK  true (̹ ACKưų  ̸ false)
+    bool markAcked(long long frameNum) {
+        std::lock_guard<std::mutex> lock(windowMutex);
+        return frameNum < totalFrames && ackedFrames.set(frameNum);
+    }
+    
+    // Ư  ȣ ACKǾ Ȯ (̽   ACK  )
+    bool isAcked(long long frameNum) const {
+        std::lock_guard<std::mutex> lock(windowMutex);
+        return ackedFrames.test(frameNum);
+    }
+    
+    //  ȿ       ִ maxCount  out ߰
+    //  ġ Ŀ ϹǷ  ũ ϰ    
+    //   ũ     ̶   (  )
+    int takeNewFrames(std::vector<long long>& out, int maxCount) {
+        std::lock_guard<std::mutex> lock(windowMutex);
+        int taken = 0;
+        long long windowEnd = std::min(baseSeq + windowSize, totalFrames);
+        if (creditLimit < windowEnd && nextNewSeq >= creditLimit) {
+            creditStalls++;
+        }
+        windowEnd = std::min(windowEnd, creditLimit);
+        while (taken < maxCount && nextNewSeq < windowEnd) {
+            out.push_back(nextNewSeq++);
+            taken++;
+        }
+        return taken;
+    }
+    
+    //   ACK ˸ ũ  ݿ ( ֱ ACK  ״ )
+    //  þ     ְ Ǹ ۽ڸ 
+    void setCreditLimit(long long limit) {
+        std::lock_guard<std::mutex> lock(windowMutex);
+        bool opened = limit > creditLimit && nextNewSeq >= creditLimit;
+        creditLimit = limit;
+        if (opened) {
+            notifyChangeLocked();
+        }
+    }
+    
+    // 쿡 ڸ  ũ      Ƚ
+    long long getCreditStalls() const {
+        std::lock_guard<std::mutex> lock(windowMutex);
+        return creditStalls;
+    }
+    
+    //  ̵: ӵ ACK Ӹŭ 츦  ̵
+    // ȯ: ̵  
+    int slideWindow() {
+        std::lock_guard<std::mutex> lock(windowMutex);
+        int slidCount = 0;
+        
+        // ̽   ACK Ӹŭ  ̵
+        slidCount = ackedFrames.advance(totalFrames);
+        baseSeq = ackedFrames.base();
+        
+        if (slidCount > 0) {
+            notifyChangeLocked();  // 찡 : ۽ڿ    
+        }
+        return slidCount;
+    }
+    
+    //    Ϸ  Ȯ (̽  ü   ʰ)
+    bool isComplete() const {
+        std::lock_guard<std::mutex> lock(windowMutex);
+        return baseSeq >= totalFrames;
+    }
+    
+    //   ī (̵/ Ȯ  )
+    unsigned long long getVersion() const {
+        std::lock_guard<std::mutex> lock(windowMutex);
+        return version;
+    }
+    
+    // knownVersion  찡 ǰų deadline   
+    // ȯ: Ǿ true, ŸӾƿ̸ false
+    bool waitForChange(unsigned long long knownVersion, std::chrono::steady_clock::time_point deadline) const {
+        std::unique_lock<std::mutex> lock(windowMutex);
+        return windowChanged.wait_until(lock, deadline, [this, knownVersion] { return version != knownVersion; });
+    }
+    
+    // ̽  knownBase ٲų deadline    (Ϸ ÿ ̽ ٲǷ Բ )
+    long long waitForBaseChange(long long knownBase,
+                                std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max()) const {
+        std::unique_lock<std::mutex> lock(windowMutex);
+        windowChanged.wait_until(lock, deadline, [this, knownBase] { return baseSeq != knownBase; });
+        return baseSeq;
+    }
+    
+    //   带   (   )
+    void wakeWaiters() {
+        std::lock_guard<std::mutex> lock(windowMutex);
+        notifyChangeLocked();
+    }
+    
+    //   ũ  ( å ϰ, ũⰡ ٲ  α׿ )
+    // success:    (false =   Ǵ  Ÿ̸ )
+    // rtt: Ȱ Round Trip Time (и), minRtt:  ּ RTT (и)
+    // ackedCount: ̹ ACK  Ȯε  
+    void adjustWindow(bool success, double rtt, double minRtt = 0.0, int ackedCount = 1) {
+        std::lock_guard<std::mutex> lock(windowMutex);
+        
+        const char* reason = nullptr;
+        int newSize = success ? policy->onAck(windowSize, maxWindowSize, ackedCount, rtt, minRtt, reason)
+                              : policy->onLoss(windowSize, maxWindowSize, reason);
+        newSize = std::max(1, std::min(newSize, maxWindowSize));
+        
+        if (newSize != windowSize) {
+            traceMessage(std::string("Window ") + policy->name() + ": " + std::to_string(windowSize) +
+                         " -> " + std::to_string(newSize) + " (" + (reason ? reason : "policy") +
+                         ", base=" + std::to_string(baseSeq) + ", srtt=" + std::to_string(rtt) + "ms" +
+                         ", minRtt=" + std::to_string(minRtt) + "ms)");
+            if (newSize > windowSize) {
+                windowIncreases++;
+                windowSize = newSize;
+                notifyChangeLocked();  //    ִ  
+            } else {
+                windowDecreases++;
+                windowSize = newSize;
+            }
+        }
+        liveCounters.windowSize.store(windowSize, std::memory_order_relaxed);
+    }
+    
+    //    ȯ (  ACK  ӵ)
+    std::vector<long long> getFramesToSend() const {
+        std::lock_guard<std::mutex> lock(windowMutex);
+        std::vector<long long> frames;
+        
+        //    ACK  Ӹ ߰
+        for (long long i = baseSeq; i < baseSeq + windowSize && i < totalFrames; ++i) {
+            if (!ackedFrames.test(i)) {
+                frames.push_back(i);
+            }
+        }
+        
+        return frames;
+    }
+
+private:
+    // windowMutex  ¿ ȣ
+    void notifyChangeLocked() {
+        version++;
+        windowChanged.notify_all();
+    }
+    
+    mutable std::mutex windowMutex;   //    ȭ ؽ
+    mutable std::condition_variable windowChanged;  //   ˸
+    long long baseSeq;                //    ġ
+    long long nextNewSeq;             //    ù  ġ (takeNewFrames Ŀ)
+    int windowSize;                   //   ũ ( )
+    int maxWindowSize;                // ִ  ũ ( )
+    long long totalFrames;            // ü   (Ʈ     STREAM_FRAMES_UNBOUNDED)
+    SequenceBitmap ackedFrames;       //   Ӻ ACK  (ȯ Ʈ)
+    long long creditLimit;            //   ũ  ( ġ ̸  Ӹ )
+    long long creditStalls = 0;       // ũ      Ƚ
+    std::unique_ptr<WindowPolicy> policy;  //  ũ  å
+    int windowIncreases = 0;          // å 츦 Ű Ƚ
+    int windowDecreases = 0;          // å 츦  Ƚ
+    unsigned long long version;       //   ī
+};
+
+// ==========================================================
+// ????????? ?? ????????? ?????? ????????? ???
+// ==========================================================
+template<typename T>
+class SafeQueue {
+public:
+    void push(const T& item) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push(item);
+        cv_.notify_one();
+    }
+    
+    bool pop(T& item, int timeoutMs = -1) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        
+        if (timeoutMs < 0) {
+            cv_.wait(lock, [this] { return !queue_.empty() || stopped_; });
+        } else {
+            if (!cv_.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                             [this] { return !queue_.empty() || stopped_; })) {
+                return false;  // Timeout
+            }
+        }
+        
+        if (stopped_ && queue_.empty()) {
+            return false;
+        }
+        
+        item = queue_.front();
+        queue_.pop();
+        return true;
+    }
+    
+    void stop() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+        cv_.notify_all();
+    }
+    
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queue_.size();
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::queue<T> queue_;
+    bool stopped_ = false;
+};
+
+// ==========================================================
+// ACK Batcher: Accumulates ACKs and sends them in batches
+// ==========================================================
+class AckBatcher {
+public:
+    AckBatcher(int batchSize = 5, int flushIntervalMs = 10) 
+        : batchSize_(batchSize), flushIntervalMs_(flushIntervalMs), pendingCount_(0) {
+        lastFlushTime_ = std::chrono::steady_clock::now();
+    }
+    
+    // Add an ACK to the batch
+    void addAck(int frameNum, AckFrame& ackFrame) {
+        ackFrame.setAck(frameNum);
+        pendingCount_++;
+    }
+    
+    // Check if we should flush the batch
+    bool shouldFlush() const {
+        if (pendingCount_ >= batchSize_) return true;
+        
+        auto now = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastFlushTime_).count();
+        return (elapsed >= flushIntervalMs_ && pendingCount_ > 0);
+    }
+    
+    // Flush the ACKs
+    void flush(SerialPort& serial, AckFrame& ackFrame, std::vector<char>& ackSendBuffer) {
+        if (pendingCount_ > 0) {
+            ackFrame.serialize(ackSendBuffer);
+            serial.write(ackSendBuffer.data(), ackSendBuffer.size());
+            
+            // CRITICAL: Reset bitmap after flush to avoid sending stale ACKs
+            ackFrame.bitmap = 0;
+            
+            pendingCount_ = 0;
+            lastFlushTime_ = std::chrono::steady_clock::now();
+        }
+    }
+    
+    int getPendingCount() const { return pendingCount_; }
+
+private:
+    int batchSize_;
+    int flushIntervalMs_;
+    int pendingCount_;
+    std::chrono::steady_clock::time_point lastFlushTime_;
+};
+
+// ==========================================================
+//   ũ  (--adaptive-size,  MTU Ž  )
+// ==========================================================
+//   üũ  ʴ  ACK Ƿ, ȸ  ۽   Ÿ
+//  ũ ó   FRAME_SIZE_SAMPLE (  ACK / )    :
+// - ս    2 Ű (ѱ)
+// - սǷ p Ʈ  q = -ln(1 - p) / (ũ + ) ϰ, 尡 H 
+//   ȿ L / (L + H)  (1 - q)^(L + H) ִ ϴ L = (-H + (H + 4H / q)) / 2 ̵ (  ~2)
+// q ǥ   Ͽ  .  ޼ TransmissionManager statsMutex_  ¿ ȣ
+const int FRAME_SIZE_SAMPLE = 32;  // ũ       
+
+class FrameSizeController {
+public:
+    // initialSize:  ũ (datasize), minSize/maxSize:  , overhead: Ӵ   (bytes)
+    FrameSizeController(int initialSize, int minSize, int maxSize, int overhead)
+        : size_(std::max(minSize, std::min(initialSize, maxSize))), minSize_(minSize), maxSize_(maxSize),
+          overhead_(overhead), outcomes_(0), losses_(0), byteErrorRate_(-1.0), increases_(0), decreases_(0) {}
+    
+    //    ̷ε ũ
+    int current() const { return size_; }
+    
+    //   ũⰡ size    (lost = ACK  ۵)
+    //  ũ     ũ սǷ  ʵ 
+    void recordOutcome(int size, bool lost) {
+        if (size != size_) return;
+        outcomes_++;
+        if (lost) losses_++;
+        if (outcomes_ < FRAME_SIZE_SAMPLE) return;
+        
+        const double frameBytes = static_cast<double>(size_ + overhead_);
+        const double lossRate = std::min(losses_, FRAME_SIZE_SAMPLE - 1) / static_cast<double>(FRAME_SIZE_SAMPLE);
+        const double sampleRate = -std::log(1.0 - lossRate) / frameBytes;
+        byteErrorRate_ = byteErrorRate_ < 0.0 ? sampleRate : (byteErrorRate_ + sampleRate) / 2.0;
+        
+        int target;
+        const char* reason;
+        if (byteErrorRate_ <= 0.0) {
+            target = size_ * 2;
+            reason = "no loss";
+        } else {
+            const double h = overhead_;
+            double best = (-h + std::sqrt(h * h + 4.0 * h / byteErrorRate_)) / 2.0;
+            best = std::max(size_ / 2.0, std::min(best, size_ * 2.0));
+            target = static_cast<int>(best);
+            reason = "estimated byte error rate";
+        }
+        target = std::max(minSize_, std::min(target, maxSize_));
+        
+        if (target != size_) {
+            traceMessage("Frame size: " + std::to_string(size_) + " -> " + std::to_string(target) + " (" + reason +
+                         ", " + std::to_string(losses_) + "/" + std::to_string(outcomes_) + " lost, q=" +
+                         std::to_string(byteErrorRate_) + ")");
+            (target > size_ ? increases_ : decreases_)++;
+            size_ = target;
+        }
+        outcomes_ = 0;
+        losses_ = 0;
+    }
+    
+    int minSize() const { return minSize_; }
+    int maxSize() const { return maxSize_; }
+    
+    //   ( Ϸ  α׿)
+    void getDecisionCounts(int& increases, int& decreases) const {
+        increases = increases_;
+        decreases = decreases_;
+    }
+
+private:
+    int size_;               //  ̷ε ũ (bytes)
+    int minSize_;
+    int maxSize_;
+    int overhead_;
+    int outcomes_;           //  ũ   
+    int losses_;             //  ۵  
+    double byteErrorRate_;   //  Ʈ  (-1 =  ǥ )
+    int increases_;
+    int decreases_;
+};
+
+// ==========================================================
+// ޽ ä (ȭ )
+// ==========================================================
+// 뷮  Ʈ(ä 0)  ȸ  ΰ ޽    ä 1-3
+// ۽ڴ 뷮  Ʈ  迡 MUX_SLICE_MS з   ,  ̿ ٿ  ä   
+
+// ۽  ä  (--mux)
+enum MuxSchedule {
+    MUX_STRICT,  // ޽ ä 켱:    ִ ä    (ä ȣ  )
+    MUX_WFQ,     //   (deficit round robin): 뷮  1Ʈ äθ ġŭ Ʈ   
+    MUX_FIFO     //  : Ʈ  ʰ Ʈ ̿ ä  
+};
+
+inline bool parseMuxSchedule(const std::string& name, MuxSchedule& schedule) {
+    if (name == "strict") schedule = MUX_STRICT;
+    else if (name == "wfq") schedule = MUX_WFQ;
+    else if (name == "fifo") schedule = MUX_FIFO;
+    else return false;
+    return true;
+}
+
+// ۽  ޽ ä: ޽ ϳ ä ȣ Ǹ   ϳ ,
+// ä     (MUX_CHANNEL_WINDOW)  
+//  ޽ ⿭  ð ACK  (뷮  ڿ ٸ ð )
+//  ȣϴ (TransmissionManager channelMutex_) 
+class ChannelSender {
+public:
+    // fecParity/compactSequence/frameCrc:    (ä  ׻ StoredLength ִ ,  )
+    // window: ۽  ( , ޽ ũ ̺귯  ִ 츦 )
+    ChannelSender(int channel, int fecParity, int compactSequence, bool frameCrc, int window = MUX_CHANNEL_WINDOW)
+        : channel_(channel), fecParity_(fecParity), compactSequence_(compactSequence), frameCrc_(frameCrc), window_(window),
+          base_(0), nextSeq_(0), sent_(0), resent_(0), rejected_(0) {
+        int slots = 1;
+        while (slots < window_) slots *= 2;
+        slots_.resize(slots);
+        slotMask_ = slots - 1;
+    }
+    
+    int channel() const { return channel_; }
+    long long base() const { return base_; }
+    long long nextSequence() const { return nextSeq_; }
+    
+    // ޽ ⿭  ߰ (⿭   false)
+    bool enqueue(const char* data, int length, std::chrono::steady_clock::time_point enqueueTime) {
+        return enqueue(nullptr, 0, data, length, enqueueTime);
+    }
+    
+    // ոӸ(prefix,   ) ͸ ̾  ޽ ϳ ߰ (߰    ̷ε ٷ )
+    bool enqueue(const char* prefix, int prefixLength, const char* data, int length,
+                 std::chrono::steady_clock::time_point enqueueTime) {
+        if (queue_.size() >= static_cast<size_t>(MUX_QUEUE_MAX)) {
+            rejected_++;
+            return false;
+        }
+        queue_.push_back(QueuedMessage());
+        std::vector<char>& payload = queue_.back().data;
+        payload.reserve(prefixLength + length);
+        payload.assign(prefix, prefix + prefixLength);
+        payload.insert(payload.end(), data, data + length);
+        queue_.back().enqueueTime = enqueueTime;
+        return true;
+    }
+    
+    // ⿭    ִ ޽ 
+    int queueSpace() const { return MUX_QUEUE_MAX - static_cast<int>(queue_.size()); }
+    
+    //   ϳ  out ȭ:  ð  Ȯ  ,     ޽
+    // ȯ:    true
+    bool takeFrame(std::chrono::steady_clock::time_point now, std::chrono::milliseconds timeout, std::vector<char>& out) {
+        for (long long seq = base_; seq < nextSeq_; ++seq) {
+            Slot& s = slot(seq);
+            if (!s.acked && now - s.lastSendTime >= timeout) {
+                s.lastSendTime = now;
+                s.sendCount++;
+                resent_++;
+                s.frame.serialize(out);
+                return true;
+            }
+        }
+        if (queue_.empty() || nextSeq_ - base_ >= window_) {
+            return false;
+        }
+        Slot& s = slot(nextSeq_);
+        s.frame.payload.swap(queue_.front().data);
+        s.enqueueTime = queue_.front().enqueueTime;
+        queue_.pop_front();
+        s.frame.frameNum = static_cast<uint32_t>(nextSeq_);
+        s.frame.checksum = s.frame.calculateChecksum();
+        s.frame.lengthPrefixed = true;
+        s.frame.flags = static_cast<uint8_t>(channel_ << FRAME_FLAG_CHANNEL_SHIFT);
+        s.frame.fecParity = fecParity_;
+        s.frame.compactSequence = compactSequence_;
+        s.frame.hasCrc = frameCrc_;
+        s.acked = false;
+        s.lastSendTime = now;
+        s.sendCount = 1;
+        nextSeq_++;
+        sent_++;
+        s.frame.serialize(out);
+        return true;
+    }
+    
+    //  ޽ ⿭  ִ (찡   ٸ  )
+    bool backlogged() const { return !queue_.empty(); }
+    
+    //  ̸  ð (Ȯ   time_point::max())
+    std::chrono::steady_clock::time_point nextResend(std::chrono::milliseconds timeout) const {
+        auto earliest = std::chrono::steady_clock::time_point::max();
+        for (long long seq = base_; seq < nextSeq_; ++seq) {
+            const Slot& s = slots_[static_cast<size_t>(seq & slotMask_)];
+            if (!s.acked) earliest = std::min(earliest, s.lastSendTime + timeout);
+        }
+        return earliest;
+    }
+    
+    // seq ACK  ǥϰ  , տ  ACK ŭ 츦 о (  ġ )
+    // ȯ:    ̸ ۺ ACK RTT ǥ (ũ, Karn ˰), ƴϸ -1
+    long long markAcked(long long seq, std::chrono::steady_clock::time_point now) {
+        if (seq < base_ || seq >= nextSeq_) return -1;
+        Slot& s = slot(seq);
+        if (s.acked) return -1;
+        s.acked = true;
+        latency_.record(std::chrono::duration_cast<std::chrono::microseconds>(now - s.enqueueTime).count());
+        while (base_ < nextSeq_ && slot(base_).acked) {
+            base_++;
+        }
+        return s.sendCount == 1 ? std::chrono::duration_cast<std::chrono::microseconds>(now - s.lastSendTime).count() : -1;
+    }
+    
+    // 
+    long long sentMessages() const { return sent_; }       // ó  ޽ 
+    long long resentFrames() const { return resent_; }     //   
+    long long rejectedMessages() const { return rejected_; }  // ⿭     ޽ 
+    const LatencyHistogram& latency() const { return latency_; }
+    
+    // ACK   ޽  (⿭  ޽ )
+    long long unackedMessages() const {
+        long long count = static_cast<long long>(queue_.size());
+        for (long long seq = base_; seq < nextSeq_; ++seq) {
+            if (!slots_[static_cast<size_t>(seq & slotMask_)].acked) count++;
+        }
+        return count;
+    }
+
+private:
+    struct QueuedMessage {
+        std::vector<char> data;
+        std::chrono::steady_clock::time_point enqueueTime;
+    };
+    struct Slot {
+        DataFrame frame;
+        bool acked;
+        std::chrono::steady_clock::time_point enqueueTime;
+        std::chrono::steady_clock::time_point lastSendTime;
+        int sendCount;
+        Slot() : acked(true), sendCount(0) {}
+    };
+    
+    Slot& slot(long long seq) { return slots_[static_cast<size_t>(seq & slotMask_)]; }
+    
+    int channel_;
+    int fecParity_;
+    int compactSequence_;
+    bool frameCrc_;
+    int window_;                       // ۽  ( )
+    std::deque<QueuedMessage> queue_;  //     ޽
+    std::vector<Slot> slots_;          //    (seq & slotMask_)
+    long long slotMask_;
+    long long base_;                   //   Ȯ ġ
+    long long nextSeq_;                //   ޽ ġ
+    long long sent_;
+    long long resent_;
+    long long rejected_;
+    LatencyHistogram latency_;
+};
+
+// ==========================================================
+// TransmissionManager: Ƽ  ۽   
+// ==========================================================
+// Sender Thread Receiver Thread иϿ ÿ ۼ 
+//  ڿ Ͽ Selective Repeat ARQ  
+//  ó   ִ  ũ  غϹǷ ü   ϰ ޸𸮰 
+class TransmissionManager {
+public:
+    // : ø Ʈ,  ,   ,  ī  
+    // datasize/pattern/compression/lengthPrefixed/fecParity:  غ  prepareDataFrame ѱ 
+    // sackAcks:  SACK  true (ACK   )
+    // credits:  ũ  true (ACK CreditLimit    )
+    TransmissionManager(SerialPort& serial, WindowManager& windowMgr, int datasize, PayloadPattern pattern,
+                        bool compression, bool lengthPrefixed, long long& retransmitCount,
+                        bool sackAcks = false, int fecParity = 0, bool credits = false)
+        : serial_(serial), windowMgr_(windowMgr), datasize_(datasize), pattern_(pattern),
+          compression_(compression), lengthPrefixed_(lengthPrefixed), retransmitCount_(retransmitCount),
+          sack_(sackAcks), fecParity_(fecParity), credits_(credits), ackCrc_(false), stopped_(false), sizer_(nullptr),
+          compactSequence_(0), frameCrc_(false), streaming_(windowMgr.getTotalFrames() == STREAM_FRAMES_UNBOUNDED), endOfStream_(-1),
+          peerStopRequested_(false), localStopRequested_(false), resentFrames_(0), failedFrames_(0),
+          bytesWritten_(0), srttUs_(0), minRttUs_(0), schedule_(MUX_STRICT), muxWeight_(1),
+          sliceBytes_(std::max(1, serial.getBaudRate() / 10000 * MUX_SLICE_MS)), controlRate_(0) {
+        //   Ȯ ӳ ĭ ġ ʵ ִ  ̻ 2 ŵ ũ
+        int slots = 1;
+        while (slots < windowMgr.getMaxWindowSize()) slots *= 2;
+        slots_.resize(slots);
+        slotMask_ = slots - 1;
+    }
+    
+    //   ũ :  ó   sizer  ũ غ (start()  ȣ)
+    //  ó  ũ ״ ٽ 
+    void setAdaptiveFrames(FrameSizeController* sizer) {
+        sizer_ = sizer;
+    }
+    
+    //   :  FrameNum sequenceBytes Ʈ     (start()  ȣ)
+    void setCompactHeader(int sequenceBytes) {
+        compactSequence_ = sequenceBytes;
+    }
+    
+    // ACK Ἲ : ޴ ACK CRC32 Ȯϰ    (start()  ȣ)
+    void setAckCrc(bool ackCrc) {
+        ackCrc_ = ackCrc;
+    }
+    
+    //   Ἲ :   Ӹ EOF տ CRC32  (start()  ȣ)
+    void setFrameCrc(bool frameCrc) {
+        frameCrc_ = frameCrc;
+    }
+    
+    // ȭ : ä 0(뷮 ) ܿ ޽ ä 1..channels-1  (setCompactHeader, setFrameCrc , start()  ȣ)
+    // weight: WFQ ٿ 뷮  1Ʈ äθ   ִ Ʈ
+    void setChannels(int channels, MuxSchedule schedule, int weight) {
+        channelSenders_.clear();
+        for (int c = 1; c < channels; ++c) {
+            channelSenders_.emplace_back(new ChannelSender(c, fecParity_, compactSequence_, frameCrc_));
+        }
+        deficits_.assign(channelSenders_.size(), 0);
+        schedule_ = schedule;
+        muxWeight_ = std::max(1, weight);
+    }
+    
+    //  Ʈ  (--control-rate): ʴ rate size Ʈ ޽ ä 1  (setChannels , start()  ȣ)
+    // ޽   ̹Ƿ   validatePayload 
+    void setControlTraffic(int rate, int size, PayloadPattern pattern) {
+        if (channelSenders_.empty() || rate <= 0) return;
+        controlRate_ = rate;
+        controlMessage_.resize(size);
+        fillPayload(controlMessage_, pattern);
+        controlInterval_ = std::chrono::microseconds(std::max(1LL, 1000000LL / rate));
+    }
+    
+    // ޽ ä(1..channels-1) ޽ ϳ  ( 忡 ȣ )
+    // ȯ: ⿭ ־ true (ȭ ʴ ,  ä̰ų ⿭   false)
+    bool sendMessage(int channel, const char* data, int length) {
+        if (channel < 1 || channel > static_cast<int>(channelSenders_.size())) return false;
+        {
+            std::lock_guard<std::mutex> lock(channelMutex_);
+            if (!channelSenders_[channel - 1]->enqueue(data, length, std::chrono::steady_clock::now())) {
+                return false;
+            }
+        }
+        windowMgr_.wakeWaiters();  //   ۽ڰ ٷ  
+        return true;
+    }
+    
+    // ۽    
+    void start() {
+        stopped_ = false;
+        senderThread_ = std::thread(&TransmissionManager::senderThreadFunc, this);
+        receiverThread_ = std::thread(&TransmissionManager::receiverThreadFunc, this);
+    }
+    
+    // ۽     
+    void stop() {
+        stopped_ = true;
+        windowMgr_.wakeWaiters();  //    ۽ڸ  
+        if (senderThread_.joinable()) senderThread_.join();
+        if (receiverThread_.joinable()) receiverThread_.join();
+    }
+    
+    //    Ȯ
+    bool isStopped() const { return stopped_.load(); }
+    
+    //  Ʈ ٽ       (   )
+    bool linkFailed() const { return serial_.isLinkFailed(); }
+    
+    // Ʈ   (--duration): ۽ڰ   ġ Ʈ   
+    void endStream() {
+        localStopRequested_ = true;
+        windowMgr_.wakeWaiters();
+    }
+    
+    //  ȸ (stop()  ȣ,  δ  ߿ ȣ )
+    const LatencyHistogram& ackLatency() const { return ackLatency_; }  //    ACK 
+    long long resentFrames() const { return resentFrames_.load(); }     // ACK   ٽ   
+    long long failedFrames() const { return failedFrames_.load(); }     // Ʈ  з ٽ   
+    long long bytesWritten() const { return bytesWritten_.load(); }     //    ۽ Ʈ 
+    
+    // ޽ ä  ( ޽ ä հ, ȭ ʴ  0)
+    long long channelMessagesSent() const { return sumChannels(&ChannelSender::sentMessages); }
+    long long channelResentFrames() const { return sumChannels(&ChannelSender::resentFrames); }
+    long long channelUnacked() const { return sumChannels(&ChannelSender::unackedMessages); }
+    long long channelRejected() const { return sumChannels(&ChannelSender::rejectedMessages); }
+    LatencyHistogram channelLatency() const {
+        std::lock_guard<std::mutex> lock(channelMutex_);
+        LatencyHistogram merged;
+        for (size_t i = 0; i < channelSenders_.size(); ++i) {
+            merged.merge(channelSenders_[i]->latency());
+        }
+        return merged;
+    }
+    
+    //  ȣ  ACK  out ű  ׷  ( )
+    void takeIntervalLatency(LatencyHistogram& out) {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        out = intervalLatency_;
+        intervalLatency_ = LatencyHistogram();
+    }
+
+private:
+    // ۽  ĭ:  ġ seq  slots_[seq & slotMask_] 
+    // ĭ  ġ ACKǾ 츦  ڿ  ġ Ѿ
+    struct FrameSlot {
+        DataFrame frame;                                      // ȭ  (۽ 常 )
+        long long seq;                                        // ĭ ִ  ġ (-1 =  )
+        std::chrono::steady_clock::time_point firstSendTime;  //   ð (ACK  )
+        std::chrono::steady_clock::time_point lastSendTime;   //   ð ( Ǵ)
+        int sendCount;                                        //  Ƚ
+        int firstSendSize;                                    //   ̷ε ũ ( )
+        FrameSlot() : seq(-1), sendCount(0), firstSendSize(0) {}
+    };
+    
+    FrameSlot& slot(long long seq) { return slots_[static_cast<size_t>(seq & slotMask_)]; }
+    
+    // seq ġ  ĭ غ (۽ 常  Ƿ  ʿ)
+    // ׽Ʈ ̷ε ġ ϹǷ ũⰡ  ĭ غ  ̷ε带 ȣ ٲ ٽ 
+    void prepareSlot(FrameSlot& s, long long seq, int payloadSize) {
+        if (seq == endOfStream_) {
+            // Ʈ  : ̷ε     ( ̷ε üũ 0)
+            s.frame.payload.clear();
+            std::vector<char>().swap(s.frame.stored);
+            s.frame.checksum = 0;
+            s.frame.lengthPrefixed = true;
+            s.frame.flags = FRAME_FLAG_END_OF_STREAM;
+            s.frame.fecParity = fecParity_;
+        } else if (s.seq < 0 || static_cast<int>(s.frame.payload.size()) != payloadSize) {
+            prepareDataFrame(s.frame, payloadSize, pattern_, compression_, lengthPrefixed_, fecParity_);
+        }
+        s.frame.frameNum = static_cast<uint32_t>(seq);
+        s.frame.compactSequence = compactSequence_;
+        s.frame.hasCrc = frameCrc_;
+    }
+    
+    // ۽  Լ:  ð  Ȯ Ӱ     Ʈ 
+    //  ü  ʰ  ⿭( )   Ŀ Ƿ    
+    void senderThreadFunc() {
+        std::vector<char> sendBuffer;
+        std::vector<char> burstBuffer;
+        std::vector<char> channelBuffer;
+        std::vector<size_t> frameEnds;  // Ʈ     ġ ( )
+        std::vector<long long> framesToSend;
+        uint16_t sentWindow = 0;  //   ǿ  Ǿ   ũ
+        
+        //  ũ⿡  Ʈ    (   ũ  Ʈ ٽ )
+        int frameSize = (sizer_ ? sizer_->current() : datasize_) + FRAME_OVERHEAD_V3;
+        int maxBurstFrames = burstFramesFor(frameSize);
+        
+        // 뷮   Ʈ ũ⸦ Ͽ ŸӾƿ 
+        if (maxBurstFrames == 1 && !sizer_) {
+            logMessage("Large frame detected (" + std::to_string(frameSize) + 
+                      " bytes). Using single-frame transmission.");
+        }
+        
+        // Ȯ    ð:  ü ȸ  ð 2 (ּ RESEND_TIMEOUT_MIN_MS)
+        // ׺  ϸ ȸ   ִ  ߺ ϰ 
+        //  쿡   ġ ĿǷ RTT ǥ  Ȱ RTT 4 
+        auto resendTimeout = [this, &frameSize]() {
+            double windowLineMs = static_cast<double>(windowMgr_.getWindowSize()) * frameSize * 10.0 * 1000.0 /
+                                  std::max(serial_.getBaudRate(), 1);
+            int timeoutMs = std::max(RESEND_TIMEOUT_MIN_MS, static_cast<int>(std::min(2.0 * windowLineMs, 3600000.0)));
+            long long srttUs;
+            {
+                std::lock_guard<std::mutex> lock(statsMutex_);
+                srttUs = srttUs_;
+            }
+            if (srttUs > 0) {
+                timeoutMs = std::min(timeoutMs, std::max(RESEND_TIMEOUT_MIN_MS, static_cast<int>(4 * srttUs / 1000)));
+            }
+            return std::chrono::milliseconds(timeoutMs);
+        };
+        
+        //    Ϸ Ǵ  ȣ ݺ
+        while (!stopped_ && !windowMgr_.isComplete() && !serial_.isLinkFailed()) {
+            // Ʈ   û(Ctrl+C, ܰ ð  Ǵ   ACK  û):   ġ Ʈ   
+            // ̹    ϸ ACK ٸǷ    ʹ  ޵
+            if (streaming_ && endOfStream_ < 0 && (peerStopRequested_ || localStopRequested_ || streamStopRequested)) {
+                endOfStream_ = windowMgr_.finishStream();
+                logMessage(std::string("Stream stop requested by ") + (peerStopRequested_ ? "peer" : "local side") +
+                           ": ending the stream at frame " + std::to_string(endOfStream_) + ".");
+            }
+            
+            //     о θ,   ̵嵵 ġ 
+            unsigned long long windowVersion = windowMgr_.getVersion();
+            framesToSend.clear();
+            int nextSize = datasize_;
+            if (sizer_) {
+                {
+                    std::lock_guard<std::mutex> lock(statsMutex_);
+                    nextSize = sizer_->current();
+                }
+                frameSize = nextSize + FRAME_OVERHEAD_V3;
+                maxBurstFrames = burstFramesFor(frameSize);
+            }
+            
+            // 1)  ⿭ (   )  ð  Ȯ  
+            auto now = std::chrono::steady_clock::now();
+            auto timeout = resendTimeout();
+            auto nextResend = now + timeout;
+            {
+                std::lock_guard<std::mutex> lock(statsMutex_);
+                while (!pendingFrames_.empty() && static_cast<int>(framesToSend.size()) < maxBurstFrames) {
+                    const PendingFrame& pending = pendingFrames_.front();
+                    if (pending.sendTime != slot(pending.frameNum).lastSendTime || windowMgr_.isAcked(pending.frameNum)) {
+                        pendingFrames_.pop_front();  // ACKưų Ŀ ٽ    ׸
+                        continue;
+                    }
+                    if (now - pending.sendTime < timeout) {
+                        nextResend = pending.sendTime + timeout;
+                        break;
+                    }
+                    framesToSend.push_back(pending.frameNum);
+                    pendingFrames_.pop_front();
+                }
+            }
+            
+            // 2)  Ʈ ڸ     ä
+            windowMgr_.takeNewFrames(framesToSend, maxBurstFrames - static_cast<int>(framesToSend.size()));
+            
+            if (framesToSend.empty()) {
+                // 찡  :   ޽ ä  ,
+                // ACK 찡 ų  ޽ ų  ̸ (Ǵ  ޽ ) ð   
+                if (!channelSenders_.empty()) {
+                    serviceChannels(0, true, timeout, channelBuffer);
+                    nextResend = std::min(nextResend, nextChannelEvent(timeout));
+                }
+                windowMgr_.waitForChange(windowVersion, nextResend);
+                continue;
+            }
+            
+            int burstSize = static_cast<int>(framesToSend.size());
+            
+            // Ʈ :   ϳ ۿ    
+            burstBuffer.clear();
+            frameEnds.clear();
+            int estimatedSize = burstSize * frameSize;
+            burstBuffer.reserve(estimatedSize);
+            
+            //  ӵ ȭϿ Ʈ ۿ ߰ (ó    ũ غ)
+            for (int i = 0; i < burstSize; ++i) {
+                long long frameNum = framesToSend[i];
+                FrameSlot& s = slot(frameNum);
+                if (s.seq != frameNum) {
+                    prepareSlot(s, frameNum, nextSize);
+                }
+                s.frame.windowSize = static_cast<uint16_t>(windowMgr_.getWindowSize());
+                if (compactSequence_ > 0) {
+                    //    ũⰡ ٲ  ù ӿ  (    )
+                    s.frame.flags = s.frame.windowSize != sentWindow ? (s.frame.flags | FRAME_FLAG_WINDOW)
+                                                                      : (s.frame.flags & ~FRAME_FLAG_WINDOW);
+                    sentWindow = s.frame.windowSize;
+                }
+                s.frame.serialize(sendBuffer);
+                burstBuffer.insert(burstBuffer.end(), sendBuffer.begin(), sendBuffer.end());
+                frameEnds.push_back(burstBuffer.size());
+            }
+            
+            //  ð  Ƚ  (ACK    ð ),  ⿭ ߰
+            auto sendTime = std::chrono::steady_clock::now();
+            int resentInBurst = 0;
+            {
+                std::lock_guard<std::mutex> lock(statsMutex_);
+                for (int i = 0; i < burstSize; ++i) {
+                    long long frameNum = framesToSend[i];
+                    FrameSlot& s = slot(frameNum);
+                    if (s.seq != frameNum) {
+                        s.seq = frameNum;  // ĭ  ġ ѱ ( ġ ̹ ACK)
+                        s.sendCount = 0;
+                    }
+                    s.lastSendTime = sendTime;
+                    pendingFrames_.push_back(PendingFrame(frameNum, sendTime));
+                    if (s.sendCount++ == 0) {
+                        s.firstSendTime = sendTime;
+                        s.firstSendSize = static_cast<int>(s.frame.payload.size());
+                    } else {
+                        resentInBurst++;
+                        if (sizer_ && s.sendCount == 2) {
+                            sizer_->recordOutcome(s.firstSendSize, true);  // ù  ACK  = ս
+                        }
+                    }
+                }
+            }
+            resentFrames_ += resentInBurst;
+            LiveCounters::add(liveCounters.retransmits, resentInBurst);
+            if (resentInBurst > 0) {
+                windowMgr_.adjustWindow(false, 0);  //  Ÿ̸  = ս ȣ
+            }
+            
+            // Ʈ  
+            int written = writeBurst(burstBuffer, frameEnds, timeout, channelBuffer);
+            if (written != burstSize) {
+                int failed = burstSize - written;
+                LOG_DEBUG("Error sending burst of " + std::to_string(burstSize) + " frames");
+                retransmitCount_ += failed;
+                failedFrames_ += failed;
+                LiveCounters::add(liveCounters.retransmits, failed);
+                windowMgr_.adjustWindow(false, 0);  //    ũ 
+                
+                //     ð ٸ ʵ  ׸ ⿭  տ 
+                std::lock_guard<std::mutex> lock(statsMutex_);
+                for (int i = burstSize - 1; i >= written; --i) {
+                    FrameSlot& s = slot(framesToSend[i]);
+                    s.lastSendTime = std::chrono::steady_clock::time_point();
+                    pendingFrames_.push_front(PendingFrame(framesToSend[i], s.lastSendTime));
+                }
+            } else {
+                LOG_DEBUG("Sent burst of " + std::to_string(burstSize) + " frames");
+            }
+        }
+    }
+    
+    // Ʈ ȸ : ȭ   迡 sliceBytes_ (  )   ,
+    //  ٿ  ޽ ä    (fifo  Ʈ ü  )
+    // ȯ:     (Ⱑ  ʹ    ó)
+    int writeBurst(const std::vector<char>& burst, const std::vector<size_t>& frameEnds,
+                   std::chrono::milliseconds timeout, std::vector<char>& channelBuffer) {
+        const int frames = static_cast<int>(frameEnds.size());
+        const bool slicing = !channelSenders_.empty() && schedule_ != MUX_FIFO;
+        size_t start = 0;
+        int written = 0;
+        while (written < frames) {
+            int last = written + 1;
+            if (!slicing) {
+                last = frames;
+            } else {
+                while (last < frames && frameEnds[last] - start <= static_cast<size_t>(sliceBytes_)) last++;
+            }
+            const size_t length = frameEnds[last - 1] - start;
+            if (serial_.write(burst.data() + start, length) != static_cast<int>(length)) {
+                return written;
+            }
+            bytesWritten_ += length;
+            LiveCounters::add(liveCounters.bytesSent, length);
+            LiveCounters::add(liveCounters.framesSent, last - written);
+            written = last;
+            start = frameEnds[last - 1];
+            if (!channelSenders_.empty()) {
+                serviceChannels(static_cast<long long>(length), false, timeout, channelBuffer);
+            }
+        }
+        return written;
+    }
+    
+    // ޽ ä   (۽ ):  Ʈ   ä ȣ   ŭ ä  
+    // bulkBytes:    뷮  Ʈ (WFQ ), idle: 뷮    (ٰ ϰ  )
+    void serviceChannels(long long bulkBytes, bool idle, std::chrono::milliseconds timeout, std::vector<char>& buffer) {
+        generateControlTraffic(std::chrono::steady_clock::now());
+        const bool limited = schedule_ == MUX_WFQ && !idle;
+        for (size_t i = 0; i < channelSenders_.size(); ++i) {
+            if (limited) deficits_[i] += bulkBytes * muxWeight_;
+            while (!stopped_ && !serial_.isLinkFailed() && (!limited || deficits_[i] > 0)) {
+                {
+                    std::lock_guard<std::mutex> lock(channelMutex_);
+                    if (!channelSenders_[i]->takeFrame(std::chrono::steady_clock::now(), timeout, buffer)) {
+                        deficits_[i] = 0;  //    ä  ׾  
+                        break;
+                    }
+                }
+                //   ä  ä  ð ٽ 
+                if (serial_.write(buffer.data(), buffer.size()) == static_cast<int>(buffer.size())) {
+                    bytesWritten_ += buffer.size();
+                    LiveCounters::add(liveCounters.bytesSent, buffer.size());
+                }
+                if (limited) deficits_[i] -= static_cast<long long>(buffer.size());
+            }
+        }
+    }
+    
+    //  ð   ޽ ä 1 ⿭  (  ð ϹǷ ۽ڰ ʰ  ð )
+    void generateControlTraffic(std::chrono::steady_clock::time_point now) {
+        if (controlRate_ <= 0) return;
+        if (nextControl_ == std::chrono::steady_clock::time_point()) {
+            nextControl_ = now;
+        }
+        std::lock_guard<std::mutex> lock(channelMutex_);
+        while (nextControl_ <= now) {
+            channelSenders_[0]->enqueue(controlMessage_.data(), static_cast<int>(controlMessage_.size()), nextControl_);
+            nextControl_ += controlInterval_;
+        }
+    }
+    
+    // ޽ ä ʿ ۽ڰ    ̸ ð ( Ǵ   ޽)
+    std::chrono::steady_clock::time_point nextChannelEvent(std::chrono::milliseconds timeout) const {
+        auto earliest = controlRate_ > 0 ? nextControl_ : std::chrono::steady_clock::time_point::max();
+        std::lock_guard<std::mutex> lock(channelMutex_);
+        for (size_t i = 0; i < channelSenders_.size(); ++i) {
+            earliest = std::min(earliest, channelSenders_[i]->nextResend(timeout));
+        }
+        return earliest;
+    }
+    
+    long long sumChannels(long long (ChannelSender::*counter)() const) const {
+        std::lock_guard<std::mutex> lock(channelMutex_);
+        long long total = 0;
+        for (size_t i = 0; i < channelSenders_.size(); ++i) {
+            total += (channelSenders_[i].get()->*counter)();
+        }
+        return total;
+    }
+    
+    //   Լ: ACK  Ͽ   Ʈ
+    // Ӹ ACK ó   ϾǷ  ũ ϰ ACK   
+    // ȸ  Ŀ RESUME ġ ȯϰ, ߳ ACK    Ʈ ٽ 
+    void receiverThreadFunc() {
+        const int ackSize = sack_ ? SackAck::wireSize(credits_, ackCrc_) : AckFrame::wireSize(credits_, ackCrc_);
+        const int wireAckSize = ackSize + fecParity_;  // FEC : ACK  + иƼ
+        const int maxWindow = windowMgr_.getMaxWindowSize();
+        std::vector<char> ackBuffer(wireAckSize);
+        std::vector<long long> newlyAcked;
+        long long cumulativeDone = 0;  //  ACK ó ģ ġ (SACK)
+        unsigned linkGeneration = serial_.getLinkGeneration();
+        
+        //    Ϸ Ǵ  ȣ ݺ
+        while (!stopped_ && !windowMgr_.isComplete() && !serial_.isLinkFailed()) {
+            //   Ʈ ٽ :      ϰ,   ġ 
+            if (serial_.getLinkGeneration() != linkGeneration) {
+                linkGeneration = serial_.getLinkGeneration();
+                expireInFlight();
+                sendSyncFrame(serial_, SYNC_FLAG_RESUME | SYNC_FLAG_SENDER, static_cast<uint32_t>(windowMgr_.getBase()), 0);
+            }
+            
+            // ACK   (100ms ŸӾƿ, Ϻθ  ǵ ΰ  ̾ )
+            int received = serial_.read(ackBuffer.data(), wireAckSize, 100);
+            if (received != wireAckSize) {
+                if (received > 0) serial_.unread(ackBuffer.data(), received);
+                continue;
+            }
+            
+            // ACK 32Ʈ ȣ   ̽   ġ 
+            // (   [base, base + ִ ) ȿ ְ,   ġ markAcked )
+            const long long base = windowMgr_.getBase();
+            bool stopRequest = false;
+            newlyAcked.clear();
+            if (ackBuffer[0] == SOF_SYNC) {
+                serial_.unread(ackBuffer.data(), wireAckSize);
+                SyncFrame sync;
+                if (!readStreamSyncFrame(serial_, sync, 100) || !handleResume(sync, base, maxWindow, newlyAcked)) {
+                    continue;
+                }
+            } else if (fecParity_ > 0 && rsDecode(reinterpret_cast<uint8_t*>(ackBuffer.data()), wireAckSize, fecParity_) < 0) {
+                //    ACK  (ش   ð ٽ )
+                realignFrame(serial_, ackBuffer.data(), wireAckSize, SOF_ACK, ackSize - 1);
+                continue;
+            } else if (sack_) {
+                SackAck sack;
+                if (!sack.deserialize(ackBuffer.data(), ackSize, ackCrc_)) {
+                    skipToNextStart(serial_, ackBuffer.data(), wireAckSize, SOF_ACK);  // SOF/EOF ´ ߳ б⵵ ٽ ã
+                    continue;
+                }
+                if (sack.channel != 0) {
+                    handleChannelAck(sack);
+                    continue;
+                }
+                stopRequest = sack.stopRequest;
+                if (sack.hasCredit) {
+                    windowMgr_.setCreditLimit(unwrapSequence(sack.creditLimit, base));
+                }
+                
+                //  ACK: ó   湮 (ջ  ָ  ʵ   ִ  )
+                long long cumulative = std::min(unwrapSequence(sack.cumulativeAck, base), base + maxWindow);
+                for (cumulativeDone = std::max(cumulativeDone, base); cumulativeDone < cumulative; ++cumulativeDone) {
+                    if (windowMgr_.markAcked(cumulativeDone)) {
+                        newlyAcked.push_back(cumulativeDone);
+                    }
+                }
+                
+                //  ACK:  Ʈ 湮
+                const long long bitmapBase = unwrapSequence(sack.bitmapBase, base);
+                for (int w = 0; w < SackAck::WORDS; ++w) {
+                    uint64_t bits = sack.bitmap[w];
+                    while (bits != 0) {
+                        long long frameNum = bitmapBase + w * 64 + lowestSetBit(bits);
+                        bits &= bits - 1;
+                        if (windowMgr_.markAcked(frameNum)) {
+                            newlyAcked.push_back(frameNum);
+                        }
+                    }
+                }
+            } else {
+                AckFrame ackFrame;
+                if (!ackFrame.deserialize(ackBuffer.data(), ackSize, ackCrc_)) {
+                    skipToNextStart(serial_, ackBuffer.data(), wireAckSize, SOF_ACK);  // SOF/EOF ´ ߳ б⵵ ٽ ã
+                    continue;
+                }
+                if (ackFrame.channel != 0) {
+                    handleChannelAck(ackFrame);
+                    continue;
+                }
+                stopRequest = ackFrame.stopRequest;
+                if (ackFrame.hasCredit) {
+                    windowMgr_.setCreditLimit(unwrapSequence(ackFrame.creditLimit, base));
+                }
+                
+                // Ʈʿ ACK  Ȯ (ִ 32)
+                const long long first = unwrapSequence(ackFrame.baseFrameNum, base);
+                for (int i = 0; i < 32; ++i) {
+                    // ACKǾ   ڿ ϵ  
+                    if (ackFrame.isAcked(ackFrame.baseFrameNum + i) && windowMgr_.markAcked(first + i)) {
+                        newlyAcked.push_back(first + i);
+                    }
+                }
+            }
+            
+            //   Ʈ  û: ۽ڰ   ġ Ʈ    
+            if (stopRequest && streaming_ && !peerStopRequested_) {
+                peerStopRequested_ = true;
+                windowMgr_.wakeWaiters();
+            }
+            
+            // ο ACK   ũ   ̵
+            if (!newlyAcked.empty()) {
+                for (size_t i = 0; i < newlyAcked.size(); ++i) {
+                    recordAckLatency(newlyAcked[i]);
+                }
+                LiveCounters::add(liveCounters.framesAcked, newlyAcked.size());
+                double srttMs, minRttMs;
+                {
+                    std::lock_guard<std::mutex> lock(statsMutex_);
+                    srttMs = srttUs_ / 1000.0;
+                    minRttMs = minRttUs_ / 1000.0;
+                }
+                windowMgr_.adjustWindow(true, srttMs, minRttMs, static_cast<int>(newlyAcked.size()));
+                windowMgr_.slideWindow();            //  ̵
+            }
+        }
+    }
+    
+    // ޽ ä ACK: ä   ġ  ACK ޽ ǥ (ä ACK ũ  û )
+    void handleChannelAck(const SackAck& sack) {
+        if (sack.channel > static_cast<int>(channelSenders_.size())) return;
+        {
+            std::lock_guard<std::mutex> lock(channelMutex_);
+            ChannelSender& channel = *channelSenders_[sack.channel - 1];
+            const auto now = std::chrono::steady_clock::now();
+            const long long base = channel.base();
+            const long long cumulative = std::min(unwrapSequence(sack.cumulativeAck, base), channel.nextSequence());
+            for (long long seq = base; seq < cumulative; ++seq) {
+                channel.markAcked(seq, now);
+            }
+            const long long bitmapBase = unwrapSequence(sack.bitmapBase, base);
+            for (int w = 0; w < SackAck::WORDS; ++w) {
+                uint64_t bits = sack.bitmap[w];
+                while (bits != 0) {
+                    channel.markAcked(bitmapBase + w * 64 + lowestSetBit(bits), now);
+                    bits &= bits - 1;
+                }
+            }
+        }
+        windowMgr_.wakeWaiters();  // 찡  ä  ޽  
+    }
+    
+    void handleChannelAck(const AckFrame& ackFrame) {
+        if (ackFrame.channel > static_cast<int>(channelSenders_.size())) return;
+        {
+            std::lock_guard<std::mutex> lock(channelMutex_);
+            ChannelSender& channel = *channelSenders_[ackFrame.channel - 1];
+            const auto now = std::chrono::steady_clock::now();
+            const long long first = unwrapSequence(ackFrame.baseFrameNum, channel.base());
+            for (int i = 0; i < 32; ++i) {
+                if (ackFrame.isAcked(ackFrame.baseFrameNum + i)) {
+                    channel.markAcked(first + i, now);
+                }
+            }
+        }
+        windowMgr_.wakeWaiters();
+    }
+    
+    //   RESUME ó:   ˸       ACK óϰ,  Ȯ   
+    //  ۽   RESUME(SENDER) ݴ  ܰ迡  ̹Ƿ 
+    // ȯ: ó true ( ACK ġ newlyAcked ߰)
+    bool handleResume(const SyncFrame& sync, long long base, int maxWindow, std::vector<long long>& newlyAcked) {
+        if (!(sync.flags & SYNC_FLAG_RESUME) || (sync.flags & SYNC_FLAG_SENDER)) {
+            return false;
+        }
+        long long resumeAt = std::min(unwrapSequence(sync.ack, base), base + maxWindow);
+        for (long long frameNum = base; frameNum < resumeAt; ++frameNum) {
+            if (windowMgr_.markAcked(frameNum)) {
+                newlyAcked.push_back(frameNum);
+            }
+        }
+        expireInFlight();
+        if (!(sync.flags & SYNC_FLAG_ACK)) {
+            sendSyncFrame(serial_, SYNC_FLAG_RESUME | SYNC_FLAG_ACK | SYNC_FLAG_SENDER, static_cast<uint32_t>(base), sync.ack);
+        }
+        logMessage("Link resumed: receiver expects frame " + std::to_string(std::max(resumeAt, base)) +
+                   ", resending unacknowledged frames.");
+        return true;
+    }
+    
+    // Ȯ    ð   ǥ: ȸ      Ÿ̸ӱ ٸ ʰ ٽ 
+    void expireInFlight() {
+        {
+            std::lock_guard<std::mutex> lock(statsMutex_);
+            for (size_t i = 0; i < pendingFrames_.size(); ++i) {
+                PendingFrame& pending = pendingFrames_[i];
+                FrameSlot& s = slot(pending.frameNum);
+                if (pending.sendTime == s.lastSendTime) {
+                    s.lastSendTime = std::chrono::steady_clock::time_point();
+                    pending.sendTime = s.lastSendTime;
+                }
+            }
+        }
+        windowMgr_.wakeWaiters();
+    }
+    
+    //  ACK      ð ׷ 
+    void recordAckLatency(long long frameNum) {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        const FrameSlot& s = slot(frameNum);
+        if (s.seq != frameNum || s.sendCount == 0) return;
+        auto latency = std::chrono::steady_clock::now() - s.firstSendTime;
+        long long latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+        ackLatency_.record(latencyUs);
+        intervalLatency_.record(latencyUs);
+        liveCounters.addRttSample(latencyUs);
+        
+        //  å RTT: ۵   ۿ  ACK ȣϹǷ  (Karn ˰)
+        if (s.sendCount == 1) {
+            srttUs_ = (srttUs_ == 0) ? latencyUs : srttUs_ + (latencyUs - srttUs_) / 8;
+            minRttUs_ = (minRttUs_ == 0) ? latencyUs : std::min(minRttUs_, latencyUs);
+            if (sizer_) {
+                sizer_->recordOutcome(s.firstSendSize, false);
+            }
+        }
+    }
+    
+    //  ũ(Ʈ)  Ʈ  : ū ϼ   ŸӾƿ 
+    static int burstFramesFor(int frameSize) {
+        if (frameSize > 50000) return 1;   // ſ ū    ϳ 
+        if (frameSize > 10000) return 4;   // ū  ִ 4 Ʈ 
+        if (frameSize > 1000) return 8;    // ߰ ũ  ִ 8 Ʈ 
+        return 16;                         // ⺻
+    }
+    
+    SerialPort& serial_;              // ø Ʈ 
+    WindowManager& windowMgr_;        //   
+    int datasize_;                    // Ӵ ̷ε ũ (   ũ)
+    PayloadPattern pattern_;          //  غ   ׽Ʈ 
+    bool compression_;                //   
+    bool lengthPrefixed_;             //   ([Flags][StoredLength] )  
+    long long& retransmitCount_;      //  ī 
+    bool sack_;                       // SACK  ACK  
+    int fecParity_;                   // Ӱ ACK  RS иƼ Ʈ (FEC , 0 = )
+    bool credits_;                    // ACK   ũ Ǹ (ũ  )
+    bool ackCrc_;                     // ACK CRC32 Ǹ (ACK Ἲ  )
+    std::atomic<bool> stopped_;       //   ÷
+    std::thread senderThread_;         // ۽ 
+    std::thread receiverThread_;       //  
+    FrameSizeController* sizer_;      //   ũ  (nullptr = datasize )
+    int compactSequence_;             //   FrameNum Ʈ  (0 =   )
+    bool frameCrc_;                   //  ӿ CRC32  (  Ἲ  )
+    bool streaming_;                  // Ʈ  ( û  Ʈ   )
+    long long endOfStream_;           // Ʈ   ġ (-1 =   , ۽ 常 )
+    std::atomic<bool> peerStopRequested_;  //   ACK Ʈ Ḧ û
+    std::atomic<bool> localStopRequested_; // endStream() Ʈ Ḧ û
+    
+    std::vector<FrameSlot> slots_;    // ۽  (ĭ   statsMutex_ ȣ)
+    long long slotMask_;              //  ũ - 1
+    std::mutex statsMutex_;           //   ȣ ؽ
+    
+    //  ⿭ ׸:   ̸, ٽ ų ACKǸ  ׸ Ǿ 
+    struct PendingFrame {
+        long long frameNum;
+        std::chrono::steady_clock::time_point sendTime;
+        PendingFrame(long long frame, std::chrono::steady_clock::time_point time) : frameNum(frame), sendTime(time) {}
+    };
+    std::deque<PendingFrame> pendingFrames_;                         //  ⿭ (statsMutex_ ȣ)
+    LatencyHistogram ackLatency_;                                    // ACK  ׷
+    LatencyHistogram intervalLatency_;                               //   ACK  (statsMutex_ ȣ)
+    std::atomic<long long> resentFrames_;                            // ACK   ۵  
+    std::atomic<long long> failedFrames_;                            // Ʈ  з ٽ   
+    std::atomic<long long> bytesWritten_;                            //  ۽ Ʈ 
+    long long srttUs_;                                               // Ȱ RTT (   Ӹ, ũ)
+    long long minRttUs_;                                             // ּ RTT (ũ)
+    
+    // ȭ  ޽ ä (channelSenders_[c - 1] = ä c,   ȭ )
+    std::vector<std::unique_ptr<ChannelSender>> channelSenders_;     // ä ⿭  (channelMutex_ ȣ)
+    mutable std::mutex channelMutex_;                                // ޽ ä ȣ ؽ
+    std::vector<long long> deficits_;                                // WFQ: äθ    (۽ 常 )
+    MuxSchedule schedule_;                                           // ä  (--mux)
+    int muxWeight_;                                                  // WFQ ġ (--mux-weight)
+    int sliceBytes_;                                                 // 뷮   ũ (MUX_SLICE_MS  ȸ  Ʈ)
+    int controlRate_;                                                //  ޽   (ʴ, 0 =   )
+    std::vector<char> controlMessage_;                               //  ޽ 
+    std::chrono::microseconds controlInterval_;                      //  ޽ 
+    std::chrono::steady_clock::time_point nextControl_;              //   ޽  ð (۽ 常 )
+};
+
+// ==========================================================
+// READY ACK ȭ Լ (Phase 3  ȯ)
+// ==========================================================
+// Phase 3  ȯ   ȭϱ  3-way handshake 
+
+// READY ACK 
+// 濡  ȯ غ Ϸ ȣ 
+bool sendReadyAck(SerialPort& serial);
+
+// READY ACK  
+// κ READY ACK    (ִ 30)
+//      Ʈ Ʈ READY  ãǷ   ȯϰ,
+// Phase 2  ߺ  Ʈ տ ־ 谡 ߳ 
+bool waitForReadyAck(SerialPort& serial);
+
+// ==========================================================
+//  ۼ (TLV  ޽ Ǵ   raw ü)
+// ==========================================================
+
+//  ̸    ݺ (κ б  ʰ )
+// deadline Ϸ ϸ false
+// read()  ( ð  Ʈ , Ʈ ,  з  ȸ) ٷ false:  ϴ б⸦ ݺ 
+bool readExact(SerialPort& serial, char* buffer, int length,
+               std::chrono::steady_clock::time_point deadline);
+
+//  CRC : EOF  length Ʈ  CRC32 ϰ   (EOF CRC ڸ ű)
+// ȯ: CRC   ,     ĺ ٽ е ǵ ΰ FRAME_READ_CRC
+int stripFrameCrc(SerialPort& serial, char* buffer, int length);
+
+//      (readDataFrame  ʵ    firstRead Ʈ   ȣ)
+// Flags   ũ⸦  ڶ ŭ ̾ Ƿ ۿ   ̾
+// Flags  (FrameNum ,  ʵ )  ʰų SOF/EOF ߳   Ʈ ٽ е ǵ 
+int readCompactRest(SerialPort& serial, char* buffer, int firstRead, int payloadSize, bool compressedFormat,
+                    int compactSequence, bool frameCrc, DWORD timeoutMs);
+
+//   ϳ 
+//    (frameSize),     StoredLength    
+//   (compactSequence > 0)  ʵ尡     а Flags ˷ ִ ŭ ̾ 
+// FEC (fecParity > 0)   ڵ带 Ͽ receiveBuffer FEC   
+//  CRC (frameCrc, FEC  ) CRC32      
+// ȯ:   ü , ŸӾƿ/κ / ʵ   -1,
+//            ڵ尡  FRAME_READ_FEC_UNCORRECTABLE,  CRC   FRAME_READ_CRC,
+//          ڸ ȭ (RESUME)  FRAME_READ_SYNC (readStreamSyncFrame ̾ )
+// κ  Ʈ Ʈ ǵ ΰ, 谡 ߳    Ʈ ٽ е  (realignFrame)
+// (receiveBuffer dataFrameWireSize() ̻̾ )
+int readDataFrame(SerialPort& serial, std::vector<char>& receiveBuffer, int payloadSize, bool compressedFormat,
+                  int compactSequence, int fecParity, FecStats& fec, DWORD timeoutMs, bool frameCrc = false);
+
+//  ޽ : [SOF_CTRL][type]  ĵϿ տ  ܿ Ʈ ǳʶٰ, CRC32 EOF Ἲ 
+//   message  EOF ü ޽, bodyLength version  ̿ ޽  ȯ
+// what α׿  ޽ ̸ (: "results")
+bool readControlMessage(SerialPort& serial, char type, std::chrono::steady_clock::time_point deadline,
+                        const std::string& what, const std::string& source,
+                        std::vector<char>& message, int& bodyLength, int& version);
+
+//  :  TLV  ޽ ϸ TLV, ƴϸ  raw ü  
+bool sendResults(SerialPort& serial, const Results& results, bool tlvFormat);
+
+//  : 15 ȿ ü ޽  
+// TLV  readControlMessage ܿ Ʈ ǳʶٰ CRC32 EOF Ἲ 
+bool readResults(SerialPort& serial, Results& results, const std::string& source, bool tlvFormat);
+
+// ɷ ޽  (Ŭ̾Ʈ  Ǵ   )
+bool sendCapabilities(SerialPort& serial, const Capabilities& caps);
+
+// ɷ ޽  (CAPS_REPLY_TIMEOUT_MS ȿ ü ޽  )
+bool readCapabilities(SerialPort& serial, Capabilities& caps, const std::string& source);
+
+// ɷ ü α׿   ڿ ȯ
+std::string describeCapabilities(const Capabilities& caps);
+
+// ==========================================================
+//  ȭ Լ (Phase 0 , SYN / SYN-ACK)
+// ==========================================================
+//  (Ʈ ȭ,    )    ϴ   ܰ 
+
+// ȭ  : SOF_SYNC ǳʶٰ CRC32 EOF , ջ    SOF_SYNC ٽ ã
+// sofRead: ȣ  SOF_SYNC Ʈ ̹   true
+// deadline ùٸ   false (SYN  ⿡ ̹Ƿ ŸӾƿ α׸  )
+bool readSyncFrame(SerialPort& serial, SyncFrame& frame, std::chrono::steady_clock::time_point deadline,
+                   bool sofRead = false);
+
+// ȭ  ȣ:  ȸ ̾ ǳ ġ ʵ Ƿ 
+uint32_t randomSyncSeq();
+
+// connectToServer : CONNECT_NO_REPLY SYNC_TIMEOUT_MS  SYN-ACK  
+// ( ų SYN ڵũ  ̹Ƿ ȣ    õ )
+enum ConnectResult {
+    CONNECT_OK,
+    CONNECT_NO_REPLY,
+    CONNECT_FAILED
+};
+
+// Ŭ̾Ʈ  ȭ (SYN  SYN-ACK)
+//   ܿ Ʈ   SYN , ´ SYN-ACK ϴ  ȯ
+//    ʾҰų ȸ  ʾ   SYNC_RETRY_MIN_MS  辿 ø  ٽ 
+ConnectResult connectToServer(SerialPort& serial);
+
+// Settings  ACK :  SYN  SYN-ACK տ    Ƿ ȭ  ǳʶ
+// ȯ:   Ʈ  (3̸ ack  ü)
+int readSettingsAck(SerialPort& serial, char* ack, std::chrono::steady_clock::time_point deadline);
+
+//  Ŭ̾Ʈ : settings ù Ʈ ̹  ¿ ȣ
+// ù Ʈ SOF_SYNC̸ SYN SYN-ACK   Settings, ƴϸ SYN 𸣴  Ŭ̾Ʈ Settings ٷ 
+//  Ŭ̾Ʈ Settings  (1-PROTOCOL_VERSION)  Ʈ ϹǷ,   ƴ Ʈ  ǳʶ
+// ۵ SYN   (Ŭ̾Ʈ Ack ´ ù SYN-ACK ϰ  ǳʶ)
+//    α׿  false ( δ ȣ  Ǵ)
+bool acceptClient(SerialPort& serial, Settings& settings);
+
+//   ũ:  (SERIAL_QUEUE_BYTES)    Ʈ  ڸ   
+// frameBytes:    ũ (  Ӹ ٸ)
+int receiveCredit(SerialPort& serial, int frameBytes);
+
+//    ȸ :    RESUME ˸
+// ۽      ACK óϰ  Ȯ   
+// sync:   ڸ  ۽  RESUME (RESUME | ACK ),   Ʈ ٽ   nullptr
+void resumeReceiving(SerialPort& serial, long long nextExpected, const SyncFrame* sync);
+
+// ==========================================================
+// NDJSON ڵ  (CLI Benchmark --json-out )
+// ==========================================================
+// ź JSON ü 
+class JsonRecord {
+public:
+    JsonRecord() : first_(true) { out_ << '{'; }
+
+    JsonRecord& add(const std::string& key, const std::string& value) {
+        writeKey(key);
+        out_ << '"' << escape(value) << '"';
+        return *this;
+    }
+    JsonRecord& add(const std::string& key, const char* value) { return add(key, std::string(value)); }
+    JsonRecord& add(const std::string& key, long long value) {
+        writeKey(key);
+        out_ << value;
+        return *this;
+    }
+    JsonRecord& add(const std::string& key, int value) { return add(key, static_cast<long long>(value)); }
+    JsonRecord& add(const std::string& key, double value) {
+        writeKey(key);
+        // JSON NaN/Infinity ǥ  Ƿ null 
+        if (value != value || value > 1e308 || value < -1e308) {
+            out_ << "null";
+        } else {
+            out_ << std::setprecision(10) << value;
+        }
+        return *this;
+    }
+    JsonRecord& add(const std::string& key, bool value) {
+        writeKey(key);
+        out_ << (value ? "true" : "false");
+        return *this;
+    }
+
+    std::string str() const { return out_.str() + '}'; }
+
+private:
+    void writeKey(const std::string& key) {
+        if (!first_) out_ << ',';
+        first_ = false;
+        out_ << '"' << escape(key) << "\":";
+    }
+
+    static std::string escape(const std::string& value) {
+        std::string escaped;
+        for (char c : value) {
+            switch (c) {
+                case '"':  escaped += "\\\""; break;
+                case '\\': escaped += "\\\\"; break;
+                case '\n': escaped += "\\n"; break;
+                case '\r': escaped += "\\r"; break;
+                case '\t': escaped += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char hex[8];
+                        snprintf(hex, sizeof(hex), "\\u%04x", static_cast<unsigned char>(c));
+                        escaped += hex;
+                    } else {
+                        escaped += c;
+                    }
+            }
+        }
+        return escaped;
+    }
+
+    std::ostringstream out_;
+    bool first_;
+};
+
+}  // namespace serialcomm
@@ -12,6 +12,7 @@
 #include <iomanip>
 #include <functional>
 #include <atomic>
+#include <fstream>
 
 // Structure to hold the results from a single test run
 struct TestResult {
@@ -276,6 +277,109 @@ TestResult ParseTestSummary(const std::string& output, const std::string& role,
 }
 
 
+// Build a unique path for the NDJSON result file written by SerialCommunicator --json-out
+std::string MakeResultFilePath(const std::string& role, size_t pairIndex) {
+    char tempDir[MAX_PATH] = {0};
+    DWORD length = GetTempPathA(MAX_PATH, tempDir);
+    std::string dir = (length > 0 && length < MAX_PATH) ? std::string(tempDir) : std::string(".\\");
+
+    std::ostringstream oss;
+    oss << dir << "SerialCommunicator_" << role << "_" << pairIndex << "_" << GetCurrentProcessId() << ".ndjson";
+    return oss.str();
+}
+
+// Look up a field in a flat JSON record (one object per line, no nesting)
+bool FindJsonField(const std::string& record, const std::string& key, std::string& value) {
+    const std::string pattern = "\"" + key + "\":";
+    size_t pos = record.find(pattern);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    pos += pattern.size();
+    value.clear();
+
+    if (pos < record.size() && record[pos] == '"') {
+        for (++pos; pos < record.size() && record[pos] != '"'; ++pos) {
+            if (record[pos] == '\\' && pos + 1 < record.size()) {
+                ++pos;
+            }
+            value += record[pos];
+        }
+        return pos < record.size();
+    }
+
+    size_t end = record.find_first_of(",}", pos);
+    if (end == std::string::npos) {
+        return false;
+    }
+    value = record.substr(pos, end - pos);
+    return !value.empty();
+}
+
+long long JsonInt(const std::string& record, const std::string& key) {
+    std::string value;
+    return (FindJsonField(record, key, value) && value != "null") ? std::stoll(value) : 0;
+}
+
+double JsonDouble(const std::string& record, const std::string& key) {
+    std::string value;
+    return (FindJsonField(record, key, value) && value != "null") ? std::stod(value) : 0.0;
+}
+
+// Parse the last "final" record from a SerialCommunicator NDJSON result file.
+// Returns false if the file or the final record is missing (older executable), so the caller
+// can fall back to scraping the console report.
+bool ParseResultFile(const std::string& path, const std::string& role, int port, TestResult& result) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string line;
+    std::string finalRecord;
+    while (std::getline(file, line)) {
+        std::string type;
+        if (FindJsonField(line, "type", type) && type == "final") {
+            finalRecord = line;
+        }
+    }
+    if (finalRecord.empty()) {
+        return false;
+    }
+
+    result = TestResult();
+    result.role = role;
+    result.port = port;
+
+    std::string status;
+    if (!FindJsonField(finalRecord, "status", status) || status != "ok") {
+        std::string error;
+        result.success = false;
+        result.failureReason = FindJsonField(finalRecord, "error", error) ? error : "SerialCommunicator reported failure";
+        return true;
+    }
+
+    try {
+        result.totalPackets = JsonInt(finalRecord, "receivedNum");
+        result.totalBytes = JsonInt(finalRecord, "totalReceivedBytes");
+        result.checksumErrors = JsonInt(finalRecord, "checksumErrors");
+        result.contentMismatches = JsonInt(finalRecord, "payloadErrors") + JsonInt(finalRecord, "frameErrors");
+        result.sequenceErrors = 0;
+        result.retransmitCount = static_cast<int>(JsonInt(finalRecord, "retransmitCount"));
+        result.elapsedSeconds = JsonDouble(finalRecord, "elapsedSeconds");
+        result.throughputMBps = JsonDouble(finalRecord, "throughputMBps");
+        result.charactersPerSecond = JsonDouble(finalRecord, "charactersPerSecond");
+        result.duration = result.elapsedSeconds;
+        result.throughput = result.throughputMBps * 8.0; // Convert MB/s to Mbps for compatibility
+        result.success = true;
+    } catch (const std::exception& e) {
+        result.success = false;
+        result.failureReason = "Result file parse error: " + std::string(e.what());
+    }
+    return true;
+}
+
+
 void PrintResults(std::vector<TestResult>& results, long long expectedPackets, long long expectedBytes, const std::vector<std::string>& comports) {
     std::cout << "\n--- FINAL TEST SUMMARY (Protocol V2) ---" << std::endl;
     std::cout << std::left << std::setw(8) << "Role"
@@ -437,14 +541,25 @@ int main(int argc, char* argv[]) {
         std::vector<std::thread> threads;
         std::vector<std::string> outputs(portPairs.size() * 2);
 
+        // Structured results (--json-out), indexed like outputs: servers first, then clients
+        std::vector<std::string> resultFiles(portPairs.size() * 2);
         for (size_t j = 0; j < portPairs.size(); ++j) {
-            threads.emplace_back([j, &portPairs, &outputs, datasize, numPackets, baudrate, &executable, &saveLogs]() {
+            resultFiles[j] = MakeResultFilePath("server", j);
+            resultFiles[portPairs.size() + j] = MakeResultFilePath("client", j);
+        }
+        for (const auto& path : resultFiles) {
+            DeleteFileA(path.c_str());
+        }
+
+        for (size_t j = 0; j < portPairs.size(); ++j) {
+            threads.emplace_back([j, &portPairs, &outputs, &resultFiles, datasize, numPackets, baudrate, &executable, &saveLogs]() {
                 std::string serverPort = portPairs[j].first;
                 std::string clientPort = portPairs[j].second;
                 
                 // 1. Launch Server
                 std::stringstream serverCmd;
-                serverCmd << executable << " server " << serverPort << " " << baudrate;
+                serverCmd << executable << " server " << serverPort << " " << baudrate
+                          << " --json-out \"" << resultFiles[j] << "\"";
                 std::cout << "Server command: " << serverCmd.str() << std::endl;
 
                 ProcessHandles serverHandles;
@@ -497,7 +612,8 @@ int main(int argc, char* argv[]) {
                 // 3. Launch Client
                 std::stringstream clientCmd;
                 clientCmd << executable << " client " << clientPort << " " << baudrate 
-                          << " " << datasize << " " << numPackets;
+                          << " " << datasize << " " << numPackets
+                          << " --json-out \"" << resultFiles[portPairs.size() + j] << "\"";
                 std::cout << "Client command: " << clientCmd.str() << std::endl;
                 
                 std::string clientOutput = ExecuteProcessAndCaptureOutput(clientCmd.str());
@@ -598,14 +714,24 @@ int main(int argc, char* argv[]) {
         std::vector<TestResult> all_results;
         for (size_t j = 0; j < portPairs.size(); ++j) {
             // Store port pair index in port field for identification
-            TestResult serverResult = ParseTestSummary(outputs[j], "Server", static_cast<int>(j));
+            // Prefer the structured result file; fall back to the console report for older executables
+            TestResult serverResult;
+            if (!ParseResultFile(resultFiles[j], "Server", static_cast<int>(j), serverResult)) {
+                serverResult = ParseTestSummary(outputs[j], "Server", static_cast<int>(j));
+            }
             serverResult.port = static_cast<int>(j); // Store index for display
             all_results.push_back(serverResult);
             
-            TestResult clientResult = ParseTestSummary(outputs[portPairs.size() + j], "Client", static_cast<int>(j));
+            TestResult clientResult;
+            if (!ParseResultFile(resultFiles[portPairs.size() + j], "Client", static_cast<int>(j), clientResult)) {
+                clientResult = ParseTestSummary(outputs[portPairs.size() + j], "Client", static_cast<int>(j));
+            }
             clientResult.port = static_cast<int>(j); // Store index for display
             all_results.push_back(clientResult);
         }
+        for (const auto& path : resultFiles) {
+            DeleteFileA(path.c_str());
+        }
         
         // Expected bytes: datasize + 6 bytes overhead per frame
         long long expectedBytes = (datasize + 6) * numPackets;
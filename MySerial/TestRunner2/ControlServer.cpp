@@ -10,11 +10,14 @@
 namespace TestRunner2 {
 
 ControlServer::ControlServer(int controlPort,
-                             std::string serialExecutable)
+                             std::string serialExecutable,
+                             int metricsPort)
     : m_controlPort(controlPort),
       m_serialExecutable(std::move(serialExecutable)),
       m_serverSocket(INVALID_SOCKET),
-      m_running(false) {
+      m_running(false),
+      m_metricsPort(metricsPort),
+      m_metricsServer(m_metrics) {
 }
 
 ControlServer::~ControlServer() {
@@ -29,6 +32,12 @@ bool ControlServer::Start() {
         WSACleanup();
         return false;
     }
+    if (m_metricsPort > 0 && !m_metricsServer.Start(m_metricsPort)) {
+        closesocket(m_serverSocket);
+        m_serverSocket = INVALID_SOCKET;
+        WSACleanup();
+        return false;
+    }
 
     m_running = true;
     std::cout << "[ControlServer] Listening on port " << m_controlPort << std::endl;
@@ -38,6 +47,7 @@ bool ControlServer::Start() {
 
 void ControlServer::Stop() {
     m_running = false;
+    m_metricsServer.Stop();
     if (m_serverSocket != INVALID_SOCKET) {
         closesocket(m_serverSocket);
         m_serverSocket = INVALID_SOCKET;
@@ -171,6 +181,7 @@ void ControlServer::HandleClient(SOCKET clientSocket) {
 
                 //  Run Ϸ  Ŭ̾Ʈ  ϴ ݹ
                 auto onRunCompleted = [this, &ctx, clientSocket](const RunResult& runResult) {
+                    m_metrics.RecordRun(runResult);
                     std::lock_guard<std::mutex> lock(ctx.sendMutex);
                     if (!SendMessage(clientSocket, SerializeRunCompleted(runResult))) {
                         std::cerr << "[ControlServer] Failed to send RUN_COMPLETED message for run " 
@@ -180,7 +191,9 @@ void ControlServer::HandleClient(SOCKET clientSocket) {
 
                 std::vector<RunResult> runResults;
                 std::string errorMessage;
+                m_metrics.testRunning.store(1, std::memory_order_relaxed);
                 bool success = m_processManager.ExecutePlan(configCopy, runResults, errorMessage, onRunCompleted);
+                m_metrics.testRunning.store(0, std::memory_order_relaxed);
 
                 //    
                 std::cout << "\n##################################################" << std::endl;
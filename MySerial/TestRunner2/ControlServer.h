@@ -15,6 +15,7 @@
 #pragma comment(lib, "ws2_32.lib")
 
 #include "ProcessManager.h"
+#include "MetricsServer.h"
 #include <atomic>
 #include <string>
 #include <vector>
@@ -26,7 +27,8 @@ namespace TestRunner2 {
 class ControlServer {
 public:
     ControlServer(int controlPort,
-                  std::string serialExecutable);
+                  std::string serialExecutable,
+                  int metricsPort = 0);
     ~ControlServer();
 
     bool Start();
@@ -65,6 +67,9 @@ private:
     SOCKET m_serverSocket;
     std::atomic<bool> m_running;
     ProcessManager m_processManager;
+    int m_metricsPort;
+    RunnerMetrics m_metrics;
+    MetricsServer m_metricsServer;
 };
 
 } // namespace TestRunner2
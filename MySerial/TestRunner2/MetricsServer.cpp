@@ -0,0 +1,88 @@
+#include "MetricsServer.h"
+
+#include <iostream>
+#include <sstream>
+
+namespace TestRunner2 {
+
+void RunnerMetrics::RecordRun(const RunResult& run) {
+    const auto relaxed = std::memory_order_relaxed;
+    runsCompleted.fetch_add(1, relaxed);
+    (run.success ? runsPassed : runsFailed).fetch_add(1, relaxed);
+
+    double throughputSum = 0.0;
+    int throughputCount = 0;
+    for (const auto& port : run.portResults) {
+        (port.success ? portPairsPassed : portPairsFailed).fetch_add(1, relaxed);
+        for (const TestResult* result : {&port.serverResult, &port.clientResult}) {
+            bytesReceived.fetch_add(result->totalBytes, relaxed);
+            packetsReceived.fetch_add(result->totalPackets, relaxed);
+            retransmits.fetch_add(result->retransmitCount, relaxed);
+            errors.fetch_add(result->sequenceErrors + result->checksumErrors + result->contentMismatches, relaxed);
+            throughputSum += result->throughput;
+            throughputCount++;
+        }
+    }
+
+    lastThroughputMbps.store(throughputCount > 0 ? throughputSum / throughputCount : 0.0, relaxed);
+    lastRunDurationSeconds.store(run.totalDuration, relaxed);
+}
+
+MetricsServer::MetricsServer(const RunnerMetrics& metrics)
+    : m_metrics(metrics) {
+}
+
+MetricsServer::~MetricsServer() {
+    Stop();
+}
+
+// Winsock must already be initialized by the caller (ControlServer).
+bool MetricsServer::Start(int port) {
+    m_startTime = std::chrono::steady_clock::now();
+    std::string error;
+    if (!m_listener.start(port, [this]() { return Render(); }, error)) {
+        std::cerr << "[MetricsServer] " << error << std::endl;
+        return false;
+    }
+    std::cout << "[MetricsServer] Serving http://127.0.0.1:" << port << "/metrics" << std::endl;
+    return true;
+}
+
+void MetricsServer::Stop() {
+    m_listener.stop();
+}
+
+std::string MetricsServer::Render() const {
+    using metricshttp::appendMetric;
+    const auto relaxed = std::memory_order_relaxed;
+    std::ostringstream out;
+    appendMetric(out, "testrunner2_runs_completed_total", "counter",
+                 "Completed test runs.", static_cast<double>(m_metrics.runsCompleted.load(relaxed)));
+    appendMetric(out, "testrunner2_runs_passed_total", "counter",
+                 "Test runs where every port pair passed.", static_cast<double>(m_metrics.runsPassed.load(relaxed)));
+    appendMetric(out, "testrunner2_runs_failed_total", "counter",
+                 "Test runs with at least one failing port pair.", static_cast<double>(m_metrics.runsFailed.load(relaxed)));
+    appendMetric(out, "testrunner2_port_pairs_passed_total", "counter",
+                 "Port pair executions that passed validation.", static_cast<double>(m_metrics.portPairsPassed.load(relaxed)));
+    appendMetric(out, "testrunner2_port_pairs_failed_total", "counter",
+                 "Port pair executions that failed validation.", static_cast<double>(m_metrics.portPairsFailed.load(relaxed)));
+    appendMetric(out, "testrunner2_bytes_received_total", "counter",
+                 "Bytes received by SerialCommunicator servers and clients.", static_cast<double>(m_metrics.bytesReceived.load(relaxed)));
+    appendMetric(out, "testrunner2_packets_received_total", "counter",
+                 "Packets received by SerialCommunicator servers and clients.", static_cast<double>(m_metrics.packetsReceived.load(relaxed)));
+    appendMetric(out, "testrunner2_retransmits_total", "counter",
+                 "Frame retransmissions reported by SerialCommunicator.", static_cast<double>(m_metrics.retransmits.load(relaxed)));
+    appendMetric(out, "testrunner2_errors_total", "counter",
+                 "Sequence, checksum and content errors reported by SerialCommunicator.", static_cast<double>(m_metrics.errors.load(relaxed)));
+    appendMetric(out, "testrunner2_test_running", "gauge",
+                 "1 while a test plan is executing.", m_metrics.testRunning.load(relaxed));
+    appendMetric(out, "testrunner2_last_throughput_mbps", "gauge",
+                 "Mean per-process throughput of the last completed run (Mbps).", m_metrics.lastThroughputMbps.load(relaxed));
+    appendMetric(out, "testrunner2_last_run_duration_seconds", "gauge",
+                 "Duration of the last completed run.", m_metrics.lastRunDurationSeconds.load(relaxed));
+    appendMetric(out, "testrunner2_uptime_seconds", "gauge", "Seconds since the metrics listener started.",
+                 std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count());
+    return out.str();
+}
+
+} // namespace TestRunner2
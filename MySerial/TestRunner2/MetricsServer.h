@@ -0,0 +1,62 @@
+#pragma once
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <windows.h>
+
+#pragma comment(lib, "ws2_32.lib")
+
+#include "Message.h"
+#include "../MetricsHttp.h"
+#include <atomic>
+#include <chrono>
+#include <string>
+
+namespace TestRunner2 {
+
+// Aggregated test counters. The test worker updates them with relaxed atomics;
+// the metrics listener only reads them, so scraping never blocks a running test.
+struct RunnerMetrics {
+    std::atomic<long long> runsCompleted{0};
+    std::atomic<long long> runsPassed{0};
+    std::atomic<long long> runsFailed{0};
+    std::atomic<long long> portPairsPassed{0};
+    std::atomic<long long> portPairsFailed{0};
+    std::atomic<long long> bytesReceived{0};
+    std::atomic<long long> packetsReceived{0};
+    std::atomic<long long> retransmits{0};
+    std::atomic<long long> errors{0};
+    std::atomic<int> testRunning{0};
+    std::atomic<double> lastThroughputMbps{0.0};
+    std::atomic<double> lastRunDurationSeconds{0.0};
+
+    void RecordRun(const RunResult& run);
+};
+
+// Serves GET /metrics in the Prometheus text exposition format (0.0.4) through the
+// listener shared with SerialCommunicator (../MetricsHttp.h): 127.0.0.1 only, one request at a time.
+class MetricsServer {
+public:
+    explicit MetricsServer(const RunnerMetrics& metrics);
+    ~MetricsServer();
+
+    bool Start(int port);
+    void Stop();
+
+private:
+    std::string Render() const;
+
+    const RunnerMetrics& m_metrics;
+    metricshttp::Listener m_listener;
+    std::chrono::steady_clock::time_point m_startTime;
+};
+
+} // namespace TestRunner2
@@ -8,9 +8,15 @@
 #include <vector>
 #include <ctime>
 #include <iomanip>
+#include <fstream>
+#include <atomic>
+
+#include "nlohmann/json.hpp"
 
 namespace TestRunner2 {
 
+using json = nlohmann::json;
+
 namespace {
 
 std::string Trim(const std::string& value) {
@@ -37,6 +43,19 @@ void TerminateProcessIfRunning(ProcessHandles& handles) {
     }
 }
 
+// SerialCommunicator --json-out    (ӽ , Ʈ ָ )
+std::string MakeResultFilePath(const std::string& role, const std::string& portName) {
+    static std::atomic<unsigned long> sequence{0};
+    char tempDir[MAX_PATH] = {0};
+    DWORD length = GetTempPathA(MAX_PATH, tempDir);
+    std::string dir = (length > 0 && length < MAX_PATH) ? std::string(tempDir) : std::string(".\\");
+
+    std::ostringstream oss;
+    oss << dir << "SerialCommunicator_" << role << "_" << portName << "_"
+        << GetCurrentProcessId() << "_" << sequence++ << ".ndjson";
+    return oss.str();
+}
+
 } // namespace
 
 ProcessHandles::ProcessHandles() : stdOutRead(NULL), stdOutWrite(NULL) {
@@ -178,14 +197,22 @@ PortTestResult ProcessManager::ExecutePortPair(const SerialTestConfig& config,
     const long long expectedBytes = (config.dataSize + 6) * config.numPackets;
     const long long expectedPackets = config.numPackets;
 
+    //  NDJSON Ϸ ް,   (   ) ܼ Ʈ Ľ
+    const std::string serverResultPath = MakeResultFilePath("server", portPair.first);
+    const std::string clientResultPath = MakeResultFilePath("client", portPair.second);
+    DeleteFileA(serverResultPath.c_str());
+    DeleteFileA(clientResultPath.c_str());
+
     std::stringstream serverCmd;
     serverCmd << "\"" << config.serialExecutable << "\""
-              << " server " << portPair.first << " " << config.baudrate;
+              << " server " << portPair.first << " " << config.baudrate
+              << " --json-out \"" << serverResultPath << "\"";
 
     std::stringstream clientCmd;
     clientCmd << "\"" << config.serialExecutable << "\""
               << " client " << portPair.second << " " << config.baudrate
-              << " " << config.dataSize << " " << config.numPackets;
+              << " " << config.dataSize << " " << config.numPackets
+              << " --json-out \"" << clientResultPath << "\"";
 
     ProcessHandles serverHandles;
     if (!LaunchProcess(serverCmd.str(), serverHandles)) {
@@ -207,6 +234,7 @@ PortTestResult ProcessManager::ExecutePortPair(const SerialTestConfig& config,
         result.clientResult.failureReason = "Server not ready.";
         result.success = false;
         CloseProcessHandles(serverHandles);
+        DeleteFileA(serverResultPath.c_str());
         return result;
     }
 
@@ -220,6 +248,7 @@ PortTestResult ProcessManager::ExecutePortPair(const SerialTestConfig& config,
         CloseProcessHandles(serverHandles);
         result.success = false;
         result.errorMessage = "Failed to launch client process for " + portPair.second;
+        DeleteFileA(serverResultPath.c_str());
         return result;
     }
 
@@ -336,16 +365,24 @@ PortTestResult ProcessManager::ExecutePortPair(const SerialTestConfig& config,
     CloseProcessHandles(clientHandles);
     CloseProcessHandles(serverHandles);
 
-    result.serverResult = ParseTestSummary(serverOutput,
-                                           "Server",
-                                           portPair.first,
-                                           expectedPackets,
-                                           expectedBytes);
-    result.clientResult = ParseTestSummary(clientOutput,
-                                           "Client",
-                                           portPair.second,
-                                           expectedPackets,
-                                           expectedBytes);
+    if (!ParseResultFile(serverResultPath, "Server", portPair.first,
+                         expectedPackets, expectedBytes, result.serverResult)) {
+        result.serverResult = ParseTestSummary(serverOutput,
+                                               "Server",
+                                               portPair.first,
+                                               expectedPackets,
+                                               expectedBytes);
+    }
+    if (!ParseResultFile(clientResultPath, "Client", portPair.second,
+                         expectedPackets, expectedBytes, result.clientResult)) {
+        result.clientResult = ParseTestSummary(clientOutput,
+                                               "Client",
+                                               portPair.second,
+                                               expectedPackets,
+                                               expectedBytes);
+    }
+    DeleteFileA(serverResultPath.c_str());
+    DeleteFileA(clientResultPath.c_str());
 
     // Set duration for both server and client (they share the same execution window)
     result.serverResult.duration = durationSec;
@@ -608,6 +645,66 @@ TestResult ProcessManager::ParseTestSummary(const std::string& output,
     return result;
 }
 
+// SerialCommunicator  NDJSON  Ͽ  "final" ڵ带 
+//  ų final ڵ尡  false (ȣ  ܼ Ʈ Ľ ü)
+bool ProcessManager::ParseResultFile(const std::string& path,
+                                     const std::string& role,
+                                     const std::string& portName,
+                                     long long expectedPackets,
+                                     long long expectedBytes,
+                                     TestResult& result) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    json finalRecord;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (Trim(line).empty()) {
+            continue;
+        }
+        json record = json::parse(line, nullptr, false);
+        if (!record.is_discarded() && record.is_object() && record.value("type", "") == "final") {
+            finalRecord = record;
+        }
+    }
+    if (finalRecord.is_null()) {
+        return false;
+    }
+
+    result = TestResult();
+    result.role = role;
+    result.portName = portName;
+    result.expectedPackets = expectedPackets;
+    result.expectedBytes = expectedBytes;
+
+    if (finalRecord.value("status", "") != "ok") {
+        result.success = false;
+        result.failureReason = finalRecord.value("error", std::string("SerialCommunicator reported failure"));
+        return true;
+    }
+
+    try {
+        result.totalPackets = finalRecord.value("receivedNum", 0LL);
+        result.totalBytes = finalRecord.value("totalReceivedBytes", 0LL);
+        result.checksumErrors = finalRecord.value("checksumErrors", 0LL);
+        result.contentMismatches = finalRecord.value("payloadErrors", 0LL) + finalRecord.value("frameErrors", 0LL);
+        result.sequenceErrors = 0;
+        result.retransmitCount = finalRecord.value("retransmitCount", 0);
+        result.elapsedSeconds = finalRecord.value("elapsedSeconds", 0.0);
+        result.throughputMBps = finalRecord.value("throughputMBps", 0.0);
+        result.cps = finalRecord.value("charactersPerSecond", 0.0);
+        result.duration = result.elapsedSeconds;
+        result.throughput = result.throughputMBps * 8.0; // MB/s to Mbps
+        result.success = true;
+    } catch (const std::exception& e) {
+        result.success = false;
+        result.failureReason = "Result file parse error: " + std::string(e.what());
+    }
+    return true;
+}
+
 bool ProcessManager::WaitForServerReady(ProcessHandles& handles,
                                         std::string& accumulatedOutput,
                                         int timeoutMs) {
@@ -58,6 +58,12 @@ private:
                                 const std::string& portName,
                                 long long expectedPackets,
                                 long long expectedBytes);
+    bool ParseResultFile(const std::string& path,
+                         const std::string& role,
+                         const std::string& portName,
+                         long long expectedPackets,
+                         long long expectedBytes,
+                         TestResult& result);
 
     bool WaitForServerReady(ProcessHandles& handles,
                             std::string& accumulatedOutput,
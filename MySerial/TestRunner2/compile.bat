@@ -98,7 +98,7 @@ echo Direct Compilation Mode
 echo ========================================
 echo.
 
-set "SOURCE_FILES=main.cpp ControlClient.cpp ControlServer.cpp Message.cpp ProcessManager.cpp"
+set "SOURCE_FILES=main.cpp ControlClient.cpp ControlServer.cpp MetricsServer.cpp Message.cpp ProcessManager.cpp"
 
 REM Check for g++ (MinGW)
 where g++ >nul 2>nul
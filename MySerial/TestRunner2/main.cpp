@@ -14,7 +14,7 @@ void PrintUsage(const char* programName) {
     std::cout << "TestRunner2 - SerialCommunicator Remote Controller" << std::endl;
     std::cout << "==================================================\n" << std::endl;
     std::cout << "Server mode:" << std::endl;
-    std::cout << "  " << programName << " --mode server [--control-port <port>] [--serial-exe <path>]\n" << std::endl;
+    std::cout << "  " << programName << " --mode server [--control-port <port>] [--serial-exe <path>] [--metrics-port <port>]\n" << std::endl;
     std::cout << "Client mode:" << std::endl;
     std::cout << "  " << programName << " --mode client --server <ip> --comports <list> [options]\n" << std::endl;
     std::cout << "Options:" << std::endl;
@@ -24,6 +24,7 @@ void PrintUsage(const char* programName) {
     std::cout << "  --baudrate <bps>      Serial baudrate (default 115200)" << std::endl;
     std::cout << "  --save-logs <true|false> Toggle SerialCommunicator logs" << std::endl;
     std::cout << "  --serial-exe <path>   Path to SerialCommunicator.exe" << std::endl;
+    std::cout << "  --metrics-port <port> Serve Prometheus metrics on 127.0.0.1 (server mode)" << std::endl;
     std::cout << std::endl;
 }
 
@@ -63,7 +64,12 @@ int main(int argc, char* argv[]) {
             serialExe = args["serial-exe"];
         }
 
-        ControlServer server(controlPort, serialExe);
+        int metricsPort = 0;
+        if (args.count("metrics-port")) {
+            metricsPort = std::stoi(args["metrics-port"]);
+        }
+
+        ControlServer server(controlPort, serialExe, metricsPort);
         if (!server.Start()) {
             std::cerr << "Failed to start server." << std::endl;
             return 1;
@@ -12,7 +12,7 @@ REM ========================================
 where g++ >nul 2>nul
 if %ERRORLEVEL% EQU 0 (
     echo Using MinGW g++ compiler...
-    g++ -std=c++11 SerialCommunicator.cpp -o SerialCommunicator.exe -static-libgcc -static-libstdc++ -O2
+    g++ -std=c++11 SerialCommunicator.cpp SerialProtocol.cpp -o SerialCommunicator.exe -static-libgcc -static-libstdc++ -O2 -lws2_32
     if %ERRORLEVEL% EQU 0 (
         echo.
         echo ========================================
@@ -35,7 +35,7 @@ REM ========================================
 where cl >nul 2>nul
 if %ERRORLEVEL% EQU 0 (
     echo Using MSVC compiler...
-    cl /EHsc /std:c++14 /O2 /nologo SerialCommunicator.cpp /link /out:SerialCommunicator.exe
+    cl /EHsc /std:c++14 /O2 /nologo SerialCommunicator.cpp SerialProtocol.cpp /link /out:SerialCommunicator.exe
     if %ERRORLEVEL% EQU 0 (
         echo.
         echo ========================================
@@ -69,7 +69,7 @@ if exist "%VCVARS_BAT%" (
     echo call "%VCVARS_BAT%" ^>nul 2^>^&1 >> _temp_compile.bat
     echo echo. >> _temp_compile.bat
     echo echo Compiling with MSVC... >> _temp_compile.bat
-    echo cl /EHsc /std:c++14 /O2 /nologo SerialCommunicator.cpp /link /out:SerialCommunicator.exe 2^>^&1 >> _temp_compile.bat
+    echo cl /EHsc /std:c++14 /O2 /nologo SerialCommunicator.cpp SerialProtocol.cpp /link /out:SerialCommunicator.exe 2^>^&1 >> _temp_compile.bat
     echo exit /b %%ERRORLEVEL%% >> _temp_compile.bat
     
     call _temp_compile.bat
@@ -94,7 +94,7 @@ if exist "%VCVARS_BAT%" (
         echo ========================================
         echo.
         echo You can try running this manually from Developer Command Prompt:
-        echo   cl /EHsc /std:c++14 /O2 SerialCommunicator.cpp
+        echo   cl /EHsc /std:c++14 /O2 SerialCommunicator.cpp SerialProtocol.cpp
         goto :error
     )
 )
@@ -114,7 +114,7 @@ echo.
 echo For MinGW: https://www.mingw-w64.org/
 echo.
 echo Or open "Developer Command Prompt for VS 2022" and run:
-echo   cl /EHsc /std:c++14 /O2 SerialCommunicator.cpp
+echo   cl /EHsc /std:c++14 /O2 SerialCommunicator.cpp SerialProtocol.cpp
 echo ========================================
 goto :error
 